@@ -59,7 +59,11 @@ HEAPSIZE = 0x4000;  /* Size of heap buffer used by HeapMem */
 /* The starting address of the application.  Normally the interrupt vectors  */
 /* must be located at the beginning of the application.                      */
 #define FLASH_BASE              0x0
-#define FLASH_SIZE              0x50000
+#define FLASH_SIZE              0x4A000
+#define SETTINGS_BASE           0x4A000
+#define SETTINGS_SIZE           0x4000
+#define FLASH_CCFG_BASE         0x4E000
+#define FLASH_CCFG_SIZE         0x2000
 #define STARTUP_VECTORS_R		0x50000
 #define HTML_BASE				0x51000
 #define HTML_SIZE				0x3000
@@ -68,6 +72,8 @@ HEAPSIZE = 0x4000;  /* Size of heap buffer used by HeapMem */
 #define MTU_BASE				0x20012000
 #define MTU_SIZE				0x1500
 #define STARTUP_VECTORS_W		0x20013500
+#define WARM_START_BASE			0x20013520
+#define WARM_START_SIZE			0x100
 #define GPRAM_BASE              0x11000000
 #define GPRAM_SIZE              0x2000
 
@@ -79,9 +85,18 @@ MEMORY
     /* Application stored in and executes from internal flash */
     FLASH (RX) : origin = FLASH_BASE, length = FLASH_SIZE
 
+    /* Settings store (NVS region CONFIG_NVS_SETTINGS, two sectors),
+     * kept out of FLASH so the application is never placed there */
+    SETTINGS (R) : origin = SETTINGS_BASE, length = SETTINGS_SIZE
+
+    /* Last sector of the former FLASH region, holds CCFG */
+    FLASH_CCFG (RX) : origin = FLASH_CCFG_BASE, length = FLASH_CCFG_SIZE
+
     /* Startup Vectors burned into memory */
 	STV_R (R)  : origin = STARTUP_VECTORS_R, length = 0x20
 	STV_W (W)  : origin = STARTUP_VECTORS_W, length = 0x20
+    /* State of W5500 kept over RestartMCU() (source/utils/warm_start.c) */
+	WARM_START (W) : origin = WARM_START_BASE, length = WARM_START_SIZE
     /* Application uses internal RAM for data */
     SRAM (RWX) : origin = RAM_BASE, length = RAM_SIZE
     /* Application can use GPRAM region as RAM if cache is disabled in the CCFG
@@ -116,9 +131,10 @@ SECTIONS
     .pinit          :   > FLASH
     .init_array     :   > FLASH
     .emb_text       :   >> FLASH
-    .ccfg           :   > FLASH (HIGH)
+    .ccfg           :   > FLASH_CCFG (HIGH)
     startup_vectors_r :   > STV_R, type = NOLOAD
-    startup_vectors_w :   > STV_W
+    startup_vectors_w :   > STV_W, type = NOLOAD
+    warm_start      :   > WARM_START, type = NOLOAD
     html            :   > HTML, type = NOLOAD
     .vtable         :   > SRAM
     .vtable_ram     :   > SRAM
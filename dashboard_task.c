@@ -13,6 +13,8 @@
 
 #include <stdbool.h>
 
+#include <stdlib.h>
+
 #include <string.h>
 
 #include <ti/drivers/SPI.h>
@@ -29,17 +31,23 @@
 
 #include <ti/sysbios/knl/Task.h>
 
+#include <ti/sysbios/knl/Clock.h>
+
 #include <ti/sysbios/knl/Semaphore.h>
 
 #include <ti/sysbios/BIOS.h>
 
 #include <dashboard_task.h>
 
-#include <source/utils/log.h>
+#include <sniffing_task.h>
+
+#include <source/utils/trace.h>
 
 #include <source/utils/restart.h>
 
-#include <source/utils/stv.h>
+#include <source/utils/boot_profile.h>
+
+#include <source/config/config.h>
 
 #include <source/html/html.h>
 
@@ -47,6 +55,20 @@
 
 #include <source/oled_gui/gui.h>
 
+#include <source/frame_parser/ieee_parser.h>
+
+#include <source/frame_parser/ble_parser.h>
+
+#include <source/trigger/trigger.h>
+
+#include <source/http/http_reader.h>
+
+#include <source/http/rest_api.h>
+
+#include <source/http/sse.h>
+
+#include <source/ethernet/EthernetIrq.h>
+
 #include <ti/sysbios/family/arm/m3/Hwi.h>
 
 #include "ti_radio_config.h"
@@ -60,12 +82,11 @@
 
 #define PORT                (80)
 
-#define INPUT_BUFFER_SIZE   (256)
-
 #define READ_BUFFER_SIZE    (32)
 
 extern Semaphore_Handle Init_SemaphoreHandle;
 extern Semaphore_Handle Dashboard_SemaphoreHandle;
+extern Event_Handle     Sniffing_EventHandle;
 
 // ==============================================================================================================
 
@@ -77,17 +98,73 @@ EthernetServer ethernetServer;
 // ==============================================================================================================
 
 
+// === STATIC VARIABLES =========================================================================================
+
+//
+// Server sockets with events from EthernetIrq_Service(),
+// one bit per socket. Set by whichever task services the
+// INT line (dashboard or sniffing), so they are changed
+// only with task switching disabled.
+//
+static uint8_t readySockets  = 0;   // RECV, request to serve
+static uint8_t closedSockets = 0;   // DISCON or TIMEOUT
+
+//
+// Listening socket got connected, another one has to listen
+//
+static bool    bAccept       = false;
+
+//
+// Request being read. Requests are read as their data arrive
+// (RECV), a request which came in pieces keeps the buffer for
+// its socket, RECV of other sockets waits in deferredSockets.
+//
+static HttpRequest_t request;
+static uint8_t       requestSock     = MAX_SOCK_NUM;
+static uint8_t       deferredSockets = 0;
+
+//
+// Connections waiting for the next request (keep-alive) or for
+// the rest of one, closed after HTTP_READER_TIMEOUT_TICKS idle
+//
+static uint8_t       openSockets     = 0;
+static uint32_t      lastActivity[MAX_SOCK_NUM];
+
+//
+// Netmask changed, it takes effect after a restart. Restart
+// waits until all parameters of the request are applied and
+// committed and the response has been sent.
+//
+static bool    bRestart      = false;
+
+// ==============================================================================================================
+
+
 // === INTERNAL FUNCTIONS =======================================================================================
 
 void SendHtmlToClient(EthernetClient*);
 
-void UpdateDashboardInfo(void);
+void HandleQuery(char*);
+
+void HandleDashboard(EthernetClient*, HttpRequest_t*);
 
-void HandleRestApi(char*);
+void RegisterHandlers(void);
 
-void SetStatusProperty(const char, const char*);
+static void ArmServerSockets(void);
+static void OnServerEvent(uint8_t, uint8_t);
+static void ServeClient(uint8_t);
+static void CloseClient(uint8_t);
+static HttpReader_Status_t ReadRequest(EthernetClient*);
+static uint32_t GetIdleTimeout(void);
+static void CloseIdleClients(void);
 
-char* StrTok(char*, const char);
+static void OnConfigChanged(Config_Id_t, const char*);
+static bool ParseValue(const char*, uint32_t, uint32_t, uint32_t*);
+static bool SetTriggerState(const char*);
+static bool SetTriggerPattern(const char*);
+static bool SetTriggerOffset(const char*);
+static bool SetTriggerPostFrames(const char*);
+static bool SetEventInterval(const char*);
 
 // ==============================================================================================================
 
@@ -96,157 +173,429 @@ char* StrTok(char*, const char);
 
 void Dashboard_Main(UArg a0, UArg a1)
 {
-    static bool readDestination;
+    uint8_t  sock;
+    uint8_t  ready;
+    uint8_t  closed;
+    uint32_t timeout;
+    UInt     key;
 
-    char incomingBuffer[INPUT_BUFFER_SIZE];
+    RegisterHandlers();
 
-    unsigned int key;
+    RestApi_Init();
 
     EthernetServer_begin(&ethernetServer, PORT);
 
-    Ethernet_SetConnectInterruptForAllSockets();
+    ArmServerSockets();
+
+    BootProfile_Mark(BOOT_PHASE_DASHBOARD);
 
     GPIO_enableInt(CONFIG_GPIO_W5500_INT_CONST);
 
+    //
+    // INT may have fallen before the callback was enabled,
+    // the line would stay low without another edge then
+    //
+    EthernetIrq_Signal();
+
     for (;;)
     {
-        Semaphore_pend(Dashboard_SemaphoreHandle, BIOS_WAIT_FOREVER);
+        //
+        // Wake up on W5500 interrupt, when the next event
+        // of the stream is due or a connection goes idle
+        //
+        timeout = Sse_GetPendTimeout();
 
-        EthernetClient ethernetClient = EthernetServer_available(&ethernetServer);
+        if ( GetIdleTimeout() < timeout )
+        {
+            timeout = GetIdleTimeout();
+        }
+
+        Semaphore_pend(Dashboard_SemaphoreHandle, timeout);
+
+        EthernetIrq_Service();
 
-        readDestination = false;
+        Sse_Service();
 
-        bool currentLineIsBlank = true;
+        key = Task_disable();
 
-        while ( EthernetClient_connected(&ethernetClient) )
+        ready         = readySockets;
+        closed        = closedSockets;
+        readySockets  = 0;
+        closedSockets = 0;
+
+        Task_restore(key);
+
+        if ( requestSock == MAX_SOCK_NUM )
         {
-            if ( EthernetClient_available(&ethernetClient) )
+            ready          |= deferredSockets;
+            deferredSockets = 0;
+        }
+
+        for ( sock = 0; sock < MAX_SOCK_NUM; sock++ )
+        {
+            if ( ready & ( 1 << sock ) )
             {
-                if ( !readDestination )
-                {
-                    EthernetClient_readBytesUntil(&ethernetClient, '\n', incomingBuffer, INPUT_BUFFER_SIZE);
+                ServeClient(sock);
+            }
 
-                    readDestination = true;
-                }
+            if ( closed & ( 1 << sock ) )
+            {
+                CloseClient(sock);
+            }
+        }
 
-                uint8_t c = EthernetClient_read(&ethernetClient);
+        CloseIdleClients();
 
-                if ( c == '\n' && currentLineIsBlank )
-                {
-                    HandleRestApi(incomingBuffer);
+        //
+        // Request which held the buffer is done,
+        // come around for the deferred ones
+        //
+        if ( requestSock == MAX_SOCK_NUM && deferredSockets != 0 )
+        {
+            Semaphore_post(Dashboard_SemaphoreHandle);
+        }
+
+        if ( bRestart )
+        {
+            RestartMCU();
+        }
 
-                    SendHtmlToClient(&ethernetClient);
+        //
+        // Listening socket got connected (or was
+        // closed), open another one to listen
+        //
+        if ( bAccept )
+        {
+            bAccept = false;
 
-                    EthernetServer_begin(&ethernetServer, PORT);
+            EthernetServer_accept(&ethernetServer);
 
-                    break;
-                }
+            ArmServerSockets();
+        }
+
+        Ethernet_maintain();
+    }
+}
 
-                if ( c == '\n' )
-                {
-                    currentLineIsBlank = true;
-                }
-                else if ( c != '\r' )
-                {
-                    currentLineIsBlank = false;
-                }
-            }
 
+/*
+ * === ArmServerSockets
+ * Enables interrupts of server sockets which have none yet
+ * (new listening socket). Socket taken by the event stream
+ * is not the server's anymore and is left alone.
+ */
+static void ArmServerSockets(void)
+{
+    uint8_t sock;
 
+    for ( sock = 0; sock < MAX_SOCK_NUM; sock++ )
+    {
+        if ( Ethernet_server_port[sock] == PORT && EthernetIrq_GetMask(sock) == 0 )
+        {
+            EthernetIrq_Register(sock, ETHIRQ_CON | ETHIRQ_RECV | ETHIRQ_DISCON | ETHIRQ_TIMEOUT, OnServerEvent);
         }
+    }
 
-        Ethernet_maintain();
+    return;
+}
+
+
+static void OnServerEvent(uint8_t sock, uint8_t events)
+{
+    UInt key;
+
+    if ( events & ETHIRQ_CON )
+    {
+        bAccept = true;
     }
+
+    key = Task_disable();
+
+    if ( events & ETHIRQ_RECV )
+    {
+        readySockets |= (uint8_t)( 1 << sock );
+    }
+
+    if ( events & ( ETHIRQ_DISCON | ETHIRQ_TIMEOUT ) )
+    {
+        closedSockets |= (uint8_t)( 1 << sock );
+    }
+
+    Task_restore(key);
+
+    return;
 }
 
 
 /*
- * === StrTok
- *
+ * === ServeClient
+ * Serves requests which arrived on a server socket. Socket stays
+ * registered for RECV for the whole connection: whatever it holds is
+ * read and served, then the task goes back to its loop. Request which
+ * is not complete yet is resumed by the next RECV, kept-alive
+ * connection waits for the next request the same way. Connection
+ * is closed after a response without keep-alive, on an error and
+ * when idle (CloseIdleClients()). Event stream takes the socket
+ * over, ethernetClient is invalidated then.
  *
  * Parameters:
- *      msg[in]                 - message that gets printed before
- *                                actual diagnostics data
- *      pEntity[in]             - pointer to entity to be printed
- *                                (diagnostics data)
- *      entityType[in]          - type of entity
+ *      sock[in]        - socket which signalled RECV
  * Returns:
  *      N/A
  */
-char* StrTok(char* string, const char token)
+static void ServeClient(uint8_t sock)
 {
-    static char* p;
-    char* lastP = NULL;
+    HttpReader_Status_t status;
+    HttpRouteHandler_t  handler;
+    EthernetClient      ethernetClient;
 
-    if ( string != NULL )
+    if ( Ethernet_server_port[sock] != PORT )
     {
-        p = string;
+        return;
+    }
+
+    if ( requestSock != MAX_SOCK_NUM && requestSock != sock )
+    {
+        deferredSockets |= (uint8_t)( 1 << sock );
+
+        return;
+    }
 
-        while ( *p != token )
+    EthernetClient_begin(&ethernetClient, sock);
+
+    openSockets       |= (uint8_t)( 1 << sock );
+    lastActivity[sock] = Clock_getTicks();
+
+    for (;;)
+    {
+        if ( requestSock != sock )
         {
-            if ( *p != '\0' )
-            {
-                p++;
-            }
-            else
-            {
-                return NULL;
-            }
+            HttpReader_Begin(&request);
         }
 
-        p++;
+        status = ReadRequest(&ethernetClient);
 
-        return NULL;
-    }
-    else
-    {
-        if ( *p == '\0' )
+        if ( status == HTTP_READER_PENDING )
         {
-            return NULL;
+            //
+            // RECV may be stale, its data could have been
+            // read along with the previous request
+            //
+            requestSock = ( request.len != 0 ) ? sock : MAX_SOCK_NUM;
+
+            return;
         }
 
-        lastP = p;
+        requestSock = MAX_SOCK_NUM;
 
-        while ( *p != token )
+        if ( status != HTTP_READER_OK )
         {
-            if ( *p != '\0' )
-            {
-                p++;
-            }
-            else
-            {
-                return lastP;
-            }
+            break;
+        }
+
+        handler = HandlerFuncs_LookupRoute(request.pPath);
+
+        if ( handler != NULL )
+        {
+            handler(&ethernetClient, &request);
+        }
+        else
+        {
+            RestApi_SendError(&ethernetClient, "404 Not Found", "not found", request.bKeepAlive);
         }
 
-        *p = '\0';
+        if ( ethernetClient._sock == MAX_SOCK_NUM )
+        {
+            openSockets &= (uint8_t)~( 1 << sock );
 
-        p++;
+            return;
+        }
 
-        return lastP;
+        if ( !request.bKeepAlive )
+        {
+            break;
+        }
     }
+
+    if ( status == HTTP_READER_MALFORMED )
+    {
+        RestApi_SendError(&ethernetClient, "400 Bad Request", "malformed request", false);
+    }
+    else if ( status == HTTP_READER_TOO_LARGE )
+    {
+        RestApi_SendError(&ethernetClient, "431 Request Header Fields Too Large", "request too large", false);
+    }
+
+    CloseClient(sock);
+
+    return;
 }
 
 
-void SendHtmlToClient(EthernetClient *pClient)
+/*
+ * === ReadRequest
+ * Reads header block of the request and its body, when it fits
+ * the buffer. Body which does not is left to the handler to refuse,
+ * the connection is not kept then.
+ */
+static HttpReader_Status_t ReadRequest(EthernetClient* pClient)
 {
-    int32_t offset = 0;
+    HttpReader_Status_t status = HTTP_READER_OK;
 
-    UpdateDashboardInfo();
+    if ( request.headerLen == 0 )
+    {
+        status = HttpReader_Read(pClient, &request);
+    }
 
-    for (;;)
+    if ( status == HTTP_READER_OK )
+    {
+        status = HttpReader_ReadBody(pClient, &request);
+    }
+
+    if ( status == HTTP_READER_TOO_LARGE && request.headerLen != 0 )
+    {
+        request.bKeepAlive = false;
+
+        status = HTTP_READER_OK;
+    }
+
+    return status;
+}
+
+
+/*
+ * === CloseClient
+ * Releases the socket of a connection: closed by the peer (or timed
+ * out), served or idle. Events of the socket are released first, so
+ * that DISCON of the socket being closed is not reported by whichever
+ * task services the INT line meanwhile. Sn_IR keeps that DISCON though,
+ * and the socket gets it once it listens again and is armed; there
+ * is no connection to close then.
+ */
+static void CloseClient(uint8_t sock)
+{
+    EthernetClient ethernetClient;
+
+    if ( Ethernet_server_port[sock] != PORT || W5500_readSnSR(sock) == SnSR_LISTEN )
+    {
+        return;
+    }
+
+    EthernetIrq_Unregister(sock);
+
+    EthernetClient_begin(&ethernetClient, sock);
+
+    EthernetClient_stop(&ethernetClient);
+
+    openSockets &= (uint8_t)~( 1 << sock );
+
+    if ( requestSock == sock )
     {
-        offset = Html_CopyHtmlToMtuBuffer(offset);
+        requestSock = MAX_SOCK_NUM;
+    }
+
+    bAccept = true;
+
+    return;
+}
 
-        EthernetClient_print(pClient, (const char*)MTU_BUF_MEM_START);
 
-        if (offset == -1)
+/*
+ * === GetIdleTimeout
+ * How long the dashboard task may block before a connection
+ * goes idle.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      uint32_t            - Clock ticks, 0 when a connection is idle,
+ *                            BIOS_WAIT_FOREVER when none is open
+ */
+static uint32_t GetIdleTimeout(void)
+{
+    uint32_t timeout = BIOS_WAIT_FOREVER;
+    uint32_t elapsed;
+    uint8_t  sock;
+
+    for ( sock = 0; sock < MAX_SOCK_NUM; sock++ )
+    {
+        if ( ( openSockets & ( 1 << sock ) ) == 0 )
         {
-            break;
+            continue;
+        }
+
+        elapsed = Clock_getTicks() - lastActivity[sock];
+
+        if ( elapsed >= HTTP_READER_TIMEOUT_TICKS )
+        {
+            return 0;
+        }
+
+        if ( HTTP_READER_TIMEOUT_TICKS - elapsed < timeout )
+        {
+            timeout = HTTP_READER_TIMEOUT_TICKS - elapsed;
         }
     }
 
-    EthernetClient_stop(pClient);
+    return timeout;
+}
+
+
+static void CloseIdleClients(void)
+{
+    uint8_t sock;
+
+    for ( sock = 0; sock < MAX_SOCK_NUM; sock++ )
+    {
+        if ( ( openSockets & ( 1 << sock ) ) && Clock_getTicks() - lastActivity[sock] >= HTTP_READER_TIMEOUT_TICKS )
+        {
+            CloseClient(sock);
+        }
+    }
+
+    return;
+}
+
+
+/*
+ * === HandleDashboard
+ * Route "/": applies settings from the query string
+ * (form of the dashboard) and sends the dashboard page.
+ */
+void HandleDashboard(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    HandleQuery(pRequest->pQuery);
+
+    //
+    // Page is sent with "Connection: close",
+    // ServeClient() closes the socket
+    //
+    pRequest->bKeepAlive = false;
+
+    SendHtmlToClient(pClient);
+
+    return;
+}
+
+
+void SendHtmlToClient(EthernetClient *pClient)
+{
+    Html_Cursor_t cursor = {0};
+    uint16_t      len;
+
+    UpdateDashboardInfo();
+
+    while (( len = Html_CopyHtmlToMtuBuffer(&cursor) ))
+    {
+        EthernetClient_write(pClient, (const uint8_t*)MTU_BUF_MEM_START, len);
+    }
 
     return;
 }
@@ -254,22 +603,29 @@ void SendHtmlToClient(EthernetClient *pClient)
 
 void UpdateDashboardInfo(void)
 {
-    char        tempBuf[17] = {0};
+    char        tempBuf[MAXLEN + 1] = {0};
+    BleParser_Record_t lastRecord;
     IPAddress   tmpIp;
+    Config_Id_t id;
+    uint8_t     i;
     extern rfc_bleGenericRxOutput_t bleStats;
     extern rfc_ieeeRxOutput_t ieeeStats;
 
     ///////////////////////////
-    // Update Target IP address
+    // Update settings, tokens
+    // come from CONFIG_FIELDS
     //
-    IPAddress_Init_str(&tmpIp, (uint8_t*)STVW_TARGET_IP_ADDRESS);
-
-    IPAddress_toString(tmpIp, tempBuf);
+    for ( id = (Config_Id_t)0; id < CONFIG_FIELD_COUNT; id++ )
+    {
+        Config_Format(id, tempBuf);
 
-    Html_SetKeyValueInBuffer('t', tempBuf);
+        Html_SetKeyValueInBuffer(Config_GetToken(id), tempBuf);
+    }
 
     ///////////////////////////
     // Update Device IP address
+    // (address in use, may come
+    // from DHCP)
     //
     tmpIp = Ethernet_localIP();
 
@@ -295,51 +651,28 @@ void UpdateDashboardInfo(void)
 
     Html_SetKeyValueInBuffer('s', tempBuf);
 
-    ///////////////////////////
-    // Update Network Mask
-    //
-    tempBuf[0] = STV_ReadFromAddress(STVW_USING_DHCP) == STV_DHCP_TRUE ? '1' : '0';
-
-    tempBuf[1] = '\0';
-
-    Html_SetKeyValueInBuffer('h', tempBuf);
-
-    ///////////////////////////
-    // Update 'sniffing' status
-    //
-    tempBuf[0] = STV_ReadFromAddress(STVW_RUNNING_STATUS) == 0x52 ? '1' : '0';
-
-    tempBuf[1] = '\0';
-
-    Html_SetKeyValueInBuffer('r', tempBuf);
-
-    ///////////////////////////
-    // Update Current Protocol
-    // TODO
-    Html_SetKeyValueInBuffer('p', "0");
-
     ///////////////////////////
     //  Update RXOK BLE Frames
     // TODO
-    sprintf(tempBuf, "%d", bleStats.nRxOk);
+    Html_FormatUint(tempBuf, bleStats.nRxOk);
     Html_SetKeyValueInBuffer('v', tempBuf);
 
     ///////////////////////////
     // Update RXNOK BLE Frames
     // TODO
-    sprintf(tempBuf, "%d", bleStats.nRxNok);
+    Html_FormatUint(tempBuf, bleStats.nRxNok);
     Html_SetKeyValueInBuffer('w', tempBuf);
 
     ///////////////////////////
     // Update RXOK 802_15_4 Frames
     // TODO
-    sprintf(tempBuf, "%d", ieeeStats.nRxData + ieeeStats.nRxBeacon + ieeeStats.nRxMacCmd);
+    Html_FormatUint(tempBuf, ieeeStats.nRxData + ieeeStats.nRxBeacon + ieeeStats.nRxMacCmd);
     Html_SetKeyValueInBuffer('x', tempBuf);
 
     ///////////////////////////
     // Update RXNOK 802_15_4 Frames
     // TODO
-    sprintf(tempBuf, "%d", ieeeStats.nRxNok);
+    Html_FormatUint(tempBuf, ieeeStats.nRxNok);
     Html_SetKeyValueInBuffer('y', tempBuf);
 
     ///////////////////////////
@@ -347,113 +680,313 @@ void UpdateDashboardInfo(void)
     //
     if ( Radio_GetCurrentProtocol() == BluetoothLowEnergy )
     {
-        sprintf(tempBuf, "%d", bleStats.lastRssi);
+        Html_FormatInt(tempBuf, bleStats.lastRssi);
     }
     else
     {
-        sprintf(tempBuf, "%d", ieeeStats.lastRssi);
+        Html_FormatInt(tempBuf, ieeeStats.lastRssi);
     }
     Html_SetKeyValueInBuffer('z', tempBuf);
 
+    ///////////////////////////
+    // Update last advertiser
+    // and record count
+    //
+    if ( BleParser_GetLastRecord(&lastRecord) )
+    {
+        for ( i = 0; i < 6; i++ )
+        {
+            Html_FormatHexByte(&tempBuf[3 * i], lastRecord.advA[5 - i]);
+
+            tempBuf[3 * i + 2] = ( i < 5 ) ? ':' : '\0';
+        }
+    }
+    else
+    {
+        tempBuf[0] = '-';
+
+        tempBuf[1] = '\0';
+    }
+    Html_SetKeyValueInBuffer('l', tempBuf);
+
+    Html_FormatUint(tempBuf, BleParser_GetRecordCount());
+    Html_SetKeyValueInBuffer('c', tempBuf);
+
+    ///////////////////////////
+    // Update trigger state
+    // and settings
+    //
+    Html_FormatUint(tempBuf, Trigger_GetState());
+    Html_SetKeyValueInBuffer('a', tempBuf);
+
+    Html_SetKeyValueInBuffer('b', (char*)Trigger_GetPattern());
+
+    Html_FormatUint(tempBuf, Trigger_GetOffset());
+    Html_SetKeyValueInBuffer('i', tempBuf);
+
+    Html_FormatUint(tempBuf, Trigger_GetPostFrames());
+    Html_SetKeyValueInBuffer('f', tempBuf);
+
+    ///////////////////////////
+    // Update event stream
+    // interval
+    //
+    Html_FormatUint(tempBuf, Sse_GetInterval());
+    Html_SetKeyValueInBuffer('u', tempBuf);
+
     return;
 }
 
 
-void HandleRestApi(char* buf)
+void HandleQuery(char* pQuery)
 {
     char* key;
     char* value;
-    char* p;
+
+    bool  bChanged = false;
 
     //
-    // Replace 2nd ' ' (space) from
-    // buffer, thus cutting the URL
+    // All parameters of the form are published at once
     //
-    p = buf;
-    while ( *p != ' ') p++;
-    p++;
-    while ( *p != ' ') p++;
-    *p = '\0';
+    Config_BeginUpdate();
 
-    StrTok(buf, '?');
-    key = StrTok(NULL, '=');
-    value = StrTok(NULL, '&');
-
-    while ( key != NULL )
+    while ( HttpReader_NextParam(&pQuery, &key, &value) )
     {
-        Log_print("Key: ", key, Buffer);
-
-        Log_print("Value: ", value, Buffer);
+        TRACE(DASHBOARD_PARAM, *key, strlen(value));
 
         SetStatusProperty(*key, value);
 
-        key = StrTok(NULL, '=');
+        bChanged = true;
+    }
 
-        value = StrTok(NULL, '&');
+    Config_EndUpdate();
+
+    if ( bChanged )
+    {
+        Config_Commit();
     }
 
     return;
 }
 
 
-void SetStatusProperty(const char key, const char* value)
+/*
+ * === SetStatusProperty
+ * Applies value of a dashboard key (token dictionary). Keys of
+ * CONFIG_FIELDS are checked and stored by the config registry,
+ * other keys go to the handler registered for them.
+ *
+ * Parameters:
+ *      key[in]      - dashboard key ('a'..'z')
+ *      value[in]    - value as text
+ * Returns:
+ *      bool         - false when key is unknown or value invalid
+ */
+bool SetStatusProperty(const char key, const char* value)
 {
-    IPAddress tmpIp;
-    IPAddress_fromString(&tmpIp, value);
+    Config_Id_t id = Config_FindToken(key);
+    uint32_t    previous;
+
+    if ( id == CONFIG_NO_FIELD )
+    {
+        return HandlerFuncs_CallHandlerFunction(key, value);
+    }
 
-    switch (key)
+    previous = Config_Get(id);
+
+    Config_BeginUpdate();
+
+    if ( !Config_SetFromString(id, value) )
     {
-    case 't':
-        STV_WriteStringAtAddress(STVW_TARGET_IP_ADDRESS, (uint8_t*)&tmpIp, 4);
+        Config_EndUpdate();
+
+        return false;
+    }
+
+    if ( Config_Get(id) != previous )
+    {
+        OnConfigChanged(id, value);
+    }
+
+    Config_EndUpdate();
+
+    return true;
+}
+
+
+/*
+ * === RegisterHandlers
+ * Registers handlers of dashboard keys and the "/" route.
+ */
+void RegisterHandlers(void)
+{
+    HandlerFuncs_RegisterHandlerFunction('a', &SetTriggerState);
+    HandlerFuncs_RegisterHandlerFunction('b', &SetTriggerPattern);
+    HandlerFuncs_RegisterHandlerFunction('i', &SetTriggerOffset);
+    HandlerFuncs_RegisterHandlerFunction('f', &SetTriggerPostFrames);
+    HandlerFuncs_RegisterHandlerFunction('u', &SetEventInterval);
+
+    // TODO 'k' RX Channel!
+
+    HandlerFuncs_RegisterRoute("/", &HandleDashboard);
+
+    return;
+}
+
+
+/*
+ * === OnConfigChanged
+ * Side effects of a changed setting: OLED, protocol
+ * change of the sniffing task, restart for new netmask
+ * (deferred, see bRestart).
+ */
+static void OnConfigChanged(Config_Id_t id, const char* value)
+{
+    switch ( id )
+    {
+    case CONFIG_ID_TARGET_IP:
         GUI_ChangeTargetIp(value);
         break;
 
-    case 'd':
-        STV_WriteStringAtAddress(STVW_DEVICE_IP_ADDRESS, (uint8_t*)&tmpIp, 4);
+    case CONFIG_ID_NETMASK:
+        bRestart = true;
         break;
 
-    case 'g':
-        STV_WriteStringAtAddress(STVW_GATEWAY_IP_ADDRESS, (uint8_t*)&tmpIp, 4);
+    case CONFIG_ID_RUNNING:
+        GUI_ChangeRx(Config_GetRunning());
         break;
 
-    case 's':
-        STV_WriteStringAtAddress(STVW_NETWORK_MASK, (uint8_t*)&tmpIp, 4);
-        RestartMCU(); // <== not working
+    case CONFIG_ID_PROTOCOL:
+        GUI_ChangeProto(Config_GetProtocol());
+        Config_SignalRfChange();
         break;
 
-    case 'h':
-        // TODO make sure, DHCP changing is working
-        STV_WriteAtAddress(STVW_USING_DHCP, *value == '1' ? 0x59 : 0x4E);
+    default:
         break;
+    }
 
-    case 'r':
-        STV_WriteAtAddress(STVW_RUNNING_STATUS, *value == '1' ? 0x52 : 0x00);
-        GUI_ChangeRx((bool)(*value - '0'));
-        break;
+    return;
+}
 
-    case 'p':
-        // TODO Is this alright?
-        STV_WriteAtAddress(STVW_RF_PROTOCOL, *value == '0' ? 0xB5 : *value == '1' ? 0x15 : 0x0);
-        GUI_ChangeProto((uint8_t)(*value - '0'));
-        STV_WriteAtAddress(STVW_SIGNAL_RF_CHANGE, 0xFF);
-        break;
 
-    case 'k':
-        // TODO RX Channel!
-        break;
+/*
+ * === ParseValue
+ * Parses a decimal value of a dashboard key. Values that are not
+ * a plain number or out of range are refused, as the control
+ * protocol does (CONTROL_BAD_VALUE), nothing is clamped.
+ *
+ * Parameters:
+ *      value[in]       - value as text
+ *      min[in]         - smallest valid value
+ *      max[in]         - largest valid value
+ *      pResult[out]    - parsed value
+ * Returns:
+ *      bool            - false when value is invalid
+ */
+static bool ParseValue(const char* value, uint32_t min, uint32_t max, uint32_t* pResult)
+{
+    char*         pEnd;
+    unsigned long result;
 
+    //
+    // strtoul() would take leading whitespace and a sign
+    //
+    if ( *value < '0' || *value > '9' )
+    {
+        return false;
+    }
+
+    result = strtoul(value, &pEnd, 10);
 
+    if ( *pEnd != '\0' || result < min || result > max )
+    {
+        return false;
     }
+
+    *pResult = (uint32_t)result;
+
+    return true;
 }
 
 
+static bool SetTriggerState(const char* value)
+{
+    if ( ( *value != '0' && *value != '1' ) || value[1] != '\0' )
+    {
+        return false;
+    }
+
+    Trigger_Arm(*value == '1');
+
+    return true;
+}
+
+
+static bool SetTriggerPattern(const char* value)
+{
+    return Trigger_SetPattern(value);
+}
+
+
+static bool SetTriggerOffset(const char* value)
+{
+    uint32_t offset;
+
+    if ( !ParseValue(value, 0, UINT16_MAX, &offset) )
+    {
+        return false;
+    }
+
+    Trigger_SetOffset((uint16_t)offset);
+
+    return true;
+}
+
+
+static bool SetTriggerPostFrames(const char* value)
+{
+    uint32_t count;
+
+    if ( !ParseValue(value, 0, TRIGGER_POST_FRAMES_MAX, &count) )
+    {
+        return false;
+    }
+
+    Trigger_SetPostFrames((uint8_t)count);
+
+    return true;
+}
+
+
+static bool SetEventInterval(const char* value)
+{
+    uint32_t ms;
+
+    if ( !ParseValue(value, SSE_INTERVAL_MIN_MS, SSE_INTERVAL_MAX_MS, &ms) )
+    {
+        return false;
+    }
+
+    Sse_SetInterval((uint16_t)ms);
+
+    return true;
+}
+
+
+/*
+ * === HandleInterrupt
+ * W5500 INT callback (hwi context). SPI must not be used here,
+ * a task may be in the middle of a transaction. Events are read
+ * and dispatched by EthernetIrq_Service() of whichever task gets
+ * to it first, dashboard and sniffing task are woken up for that.
+ */
 void HandleInterrupt(void)
 {
-    //uint16_t hwi = Hwi_disable();
-    //uint16_t key = Task_disable();
-    Ethernet_ClearConnectInterruptForAllSockets();
+    EthernetIrq_Signal();
+
     Semaphore_post(Dashboard_SemaphoreHandle);
-    //Task_restore(key);
-    //Hwi_restore(hwi);
+
+    Event_post(Sniffing_EventHandle, SNIFF_EVENT_ETHERNET);
+
     return;
 }
@@ -14,4 +14,8 @@ void Dashboard_Main(UArg, UArg);
 
 void HandleInterrupt();
 
+void UpdateDashboardInfo(void);
+
+bool SetStatusProperty(const char, const char*);
+
 #endif /* DASHBOARD_TASK_H_ */
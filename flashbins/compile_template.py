@@ -0,0 +1,78 @@
+# Compiles dashboard HTML template to binary image for flash (0x51000).
+#
+# Instead of raw HTML with '$x' tokens which the device had to scan byte
+# by byte, the image contains a segment table followed by static data:
+#
+#   0x00  char[4]   magic "MSTP"
+#   0x04  uint16    number of segments
+#   0x06  uint16    length of static data
+#   0x08  segments, 4 bytes each (little-endian):
+#           static span: uint16 offset from image start, uint16 length
+#           key slot:    uint16 key ('a'..'z'),          uint16 0x8000
+#   ....  static data (HTTP preamble + HTML without '\n', '\t', '\r')
+#
+# See source/html/html.h for the matching definitions.
+import sys
+import struct
+
+MAGIC         = b"MSTP"
+HEADER_SIZE   = 8
+SEGMENT_SIZE  = 4
+SEG_SLOT      = 0x8000
+HTML_SIZE     = 0x3000
+TOKEN         = "$"
+
+if len(sys.argv) < 2:
+    print("Too few arguments. Insert a filename to convert!")
+    sys.exit(1)
+
+file_to_convert = sys.argv[1]
+result_file     = file_to_convert.replace(".html", ".bin")
+preamble        = "HTTP/1.1 200 OK\nContent-Type: text/html\nConnection: close\n\n"
+
+source = open(file_to_convert, "r").read()
+source = preamble + "".join(c for c in source if c not in ['\n', '\t', '\r'])
+
+#
+# Split template into static spans and key slots,
+# adjacent static text ends up in one span
+#
+segments = []   # ("static", bytes) or ("slot", key)
+static   = ""
+i = 0
+while i < len(source):
+    if source[i] == TOKEN and i + 1 < len(source) and "a" <= source[i + 1] <= "z":
+        if static:
+            segments.append(("static", static.encode("utf-8")))
+            static = ""
+        segments.append(("slot", source[i + 1]))
+        i += 2
+    else:
+        static += source[i]
+        i += 1
+if static:
+    segments.append(("static", static.encode("utf-8")))
+
+table_size = HEADER_SIZE + SEGMENT_SIZE * len(segments)
+table      = b""
+data       = b""
+
+for kind, value in segments:
+    if kind == "static":
+        if len(value) >= SEG_SLOT:
+            sys.exit("Static span too long: %d" % len(value))
+        table += struct.pack("<HH", table_size + len(data), len(value))
+        data  += value
+    else:
+        table += struct.pack("<HH", ord(value), SEG_SLOT)
+
+image = MAGIC + struct.pack("<HH", len(segments), len(data)) + table + data
+
+if len(image) > HTML_SIZE:
+    sys.exit("Image does not fit into HTML flash region: %d > %d" % (len(image), HTML_SIZE))
+
+with open(result_file, "wb") as bin_file:
+    bin_file.write(image)
+
+slots = sum(1 for kind, _ in segments if kind == "slot")
+print(f"> Template compiled: {len(segments) - slots} static spans, {slots} slots, image size: {len(image)}")
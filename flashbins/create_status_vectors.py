@@ -1,21 +1,106 @@
-STV_MAC_ADDRESS = bytearray([0x00, 0x00, 0x00, 0x11, 0x22, 0x33])
-STV_USING_DHCP = bytearray([0x4E])
-STV_DEVICE_IP_ADDRESS = bytearray([192, 168, 5, 11])
-STV_GATEWAY_IP_ADDRESS = bytearray([192, 168, 5, 1])
-STV_NETWORK_MASK = bytearray([255, 255, 255, 0])
-STV_TARGET_IP_ADDRESS = bytearray([192, 168, 5, 2])
-STV_RF_PROTO = bytearray([0xB5])
-STV_RUNNING_STATUS = bytearray([0x00])
-
-
-FILENAME = "status_vectors.bin"
-
-with open(FILENAME, "wb") as f:
-    f.write(STV_MAC_ADDRESS)
-    f.write(STV_USING_DHCP)
-    f.write(STV_DEVICE_IP_ADDRESS)
-    f.write(STV_GATEWAY_IP_ADDRESS)
-    f.write(STV_NETWORK_MASK)
-    f.write(STV_TARGET_IP_ADDRESS)
-    f.write(STV_RF_PROTO)
-    f.write(STV_RUNNING_STATUS)
\ No newline at end of file
+#!/usr/bin/env python3
+# Creates factory image (status_vectors.bin, loaded at 0x50000 by load_bins.js).
+#
+#   0x50000  MAC address (6 bytes), 2 bytes padding
+#   0x50008  uint32 magic "MSFD", uint16 layout version, uint16 length
+#   0x50010  Config_Values_t
+#
+# Fields, their order, sizes and defaults are read from CONFIG_FIELDS
+# (source/config/config_schema.h), so the image always matches the
+# firmware built from the same tree. The image is used only while the
+# config store is empty (first boot or erased NVS region).
+#
+# Examples:
+#   create_status_vectors.py
+#   create_status_vectors.py --mac 00:00:00:11:22:34 --set deviceIp=192.168.5.12 --set dhcp=1
+import argparse
+import os
+import re
+import struct
+
+ROOT    = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+SCHEMA  = os.path.join(ROOT, "source", "config", "config_schema.h")
+CONFIG  = os.path.join(ROOT, "source", "config", "config.h")
+
+FACTORY_MAGIC = 0x4446534D
+SIZES         = {"IPAddress": 4, "uint8_t": 1, "uint16_t": 2, "uint32_t": 4}
+FORMATS       = {1: "<B", 2: "<H", 4: "<I"}
+
+
+def c_int(text, defines):
+    text = text.strip()
+    ip = re.match(r"CONFIG_IP\((\d+),\s*(\d+),\s*(\d+),\s*(\d+)\)", text)
+    if ip:
+        return struct.unpack("<I", bytes(int(b) for b in ip.groups()))[0]
+    if text in defines:
+        return defines[text]
+    return int(text, 0)
+
+
+def read_schema():
+    defines = {"IEEE_MAX_MPDU_LEN": 127}
+    with open(CONFIG) as f:
+        version = int(re.search(r"#define CONFIG_LAYOUT_VERSION\s+\((\d+)\)", f.read()).group(1))
+
+    fields = []
+    with open(SCHEMA) as f:
+        for line in f:
+            m = re.match(r"\s*X\((.*)\)\s*\\?\s*$", line)
+            if not m:
+                continue
+            # ID, Name, member, type, kind, token, "json name", min, max, default
+            cols = [c.strip() for c in re.split(r",(?![^(]*\))", m.group(1))]
+            fields.append({
+                "member":  cols[2],
+                "name":    cols[6].strip('"'),
+                "size":    SIZES[cols[3]],
+                "ip":      cols[4] == "CONFIG_KIND_IP",
+                "min":     c_int(cols[7], defines),
+                "max":     c_int(cols[8], defines),
+                "default": c_int(cols[9], defines),
+            })
+    return version, fields
+
+
+def main():
+    version, fields = read_schema()
+    names = {f["name"]: f for f in fields}
+
+    parser = argparse.ArgumentParser(description="multiSniff factory image")
+    parser.add_argument("--mac", default="00:00:00:11:22:33")
+    parser.add_argument("--set", action="append", default=[], metavar="NAME=VALUE",
+                        help="override default, names: " + ", ".join(names))
+    parser.add_argument("-o", "--output", default="status_vectors.bin")
+    args = parser.parse_args()
+
+    values = {f["name"]: f["default"] for f in fields}
+    for item in args.set:
+        name, value = item.split("=", 1)
+        field = names[name]
+        if field["ip"]:
+            values[name] = struct.unpack("<I", bytes(int(b) for b in value.split(".")))[0]
+        else:
+            values[name] = int(value, 0)
+            if not field["min"] <= values[name] <= field["max"]:
+                parser.error("%s out of range %d..%d" % (name, field["min"], field["max"]))
+
+    payload = b""
+    for f in fields:
+        if len(payload) % f["size"]:
+            raise SystemExit("%s is not aligned, check CONFIG_FIELDS order" % f["member"])
+        payload += struct.pack(FORMATS[f["size"]], values[f["name"]])
+
+    # sizeof(Config_Values_t) includes tail padding
+    length = (len(payload) + 3) & ~3
+    payload += b"\x00" * (length - len(payload))
+
+    mac = bytes(int(b, 16) for b in args.mac.split(":"))
+
+    with open(args.output, "wb") as f:
+        f.write(mac + b"\xFF\xFF")
+        f.write(struct.pack("<IHH", FACTORY_MAGIC, version, length))
+        f.write(payload)
+
+
+if __name__ == "__main__":
+    main()
@@ -11,11 +11,17 @@
 
 #include <source/ethernet/Ethernet.h>
 
+#include <source/ethernet/EthernetIrq.h>
+
 #include <source/oled_gui/gui.h>
 
 #include <source/utils/log.h>
 
-#include <source/utils/restart.h>
+#include <source/utils/warm_start.h>
+
+#include <source/utils/boot_profile.h>
+
+#include <source/utils/trace.h>
 
 #include <ti/drivers/GPIO.h>
 
@@ -25,7 +31,7 @@
 
 #include <ti/sysbios/knl/Semaphore.h>
 
-#include <source/utils/stv.h>
+#include <source/config/config.h>
 
 #include <source/html/html.h>
 
@@ -78,6 +84,10 @@ extern void Main_CreateDashboardTask();
 
 extern void Main_CreateSniffingTask();
 
+extern void Main_CreateMonitorTask();
+
+extern void Main_CreateGuiTask();
+
 // ==============================================================================================================
 
 
@@ -86,63 +96,104 @@ extern void Main_CreateSniffingTask();
 void Init_Main(UArg a0, UArg a1)
 {
     uint8_t     retVal = 0;
+    bool        bWarm;
+    bool        bStatic;
     IPAddress   dvcIp, tgtIp, gtwIp, dnsIp, msk;
     char        pDvcIpBuf[16] = {0};
     char        pTgtIpBuf[16] = {0};
     char        pMacStr[17] = {0};
 
+    BootProfile_Mark(BOOT_PHASE_INIT);
+
+    Trace_Init();
+
     ///////////////////////////
-    // Driver Initialization:
-    // Initialization functions are called
-    // and startup vectors copied
-    // from flash to RAM
+    // Settings:
+    // Loaded from the config store first,
+    // the radio needs the protocol
     //
-    SPI_begin();
+    Config_LoadIfNotYet();
 
-    GUI_Init();
+    BootProfile_Mark(BOOT_PHASE_CONFIG);
 
-    STV_CopyStvFromFlashIfNotYet();
+    ///////////////////////////
+    // Radio:
+    // Sniffing task opens Radio Core and starts RX right away,
+    // frames are buffered in the radio queue while OLED and
+    // network come up. It waits for Init_SemaphoreHandle
+    // before it touches W5500. Yield lets it start now, it gives
+    // the CPU back whenever it waits for the Radio Core.
+    //
+    Main_CreateSniffingTask();
+
+    Task_yield();
+
+    ///////////////////////////
+    // Driver Initialization:
+    // GUI task initializes the OLED and shows
+    // what GUI_Change* post, nothing here waits for I2C
+    //
+    Main_CreateGuiTask();
+
+    SPI_begin();
 
     ///////////////////////////
     // Ethernet initialization:
-    // According to STV, use either DHCP or static address.
-    // Note, that if DHCP fails (request timeout occurs),
-    // device is restarted with STV_DHCP flag set to STV_DHCP_FALSE.
-    // Device then sets itself static IP address.
+    // After RestartMCU() W5500 keeps its configuration, link
+    // and DHCP lease, take it over when it still matches the config.
+    // Otherwise, according to config, use either DHCP or static address.
+    // Note, that if DHCP fails (request timeout occurs), static
+    // address is set for this boot only, the config keeps DHCP
+    // and the next boot asks for a lease again.
     //
+    bWarm   = WarmStart_Resume();
 
-    if ( STV_ReadFromAddress(STVW_USING_DHCP) == STV_DHCP_TRUE )
+    bStatic = !Config_GetDhcp();
+
+    if ( bWarm )
+    {
+        Log_print("Warm restart, W5500 kept", NULL, None);
+    }
+    else if ( !bStatic )
     {
         GUI_ChangeDeviceIp("DHCP pending...");
 
         Log_print("Waiting for DHCP...", NULL, None);
 
-        retVal = Ethernet_begin_mac((uint8_t*)STVR_MAC_ADDRESS);
-
+        retVal = Ethernet_begin_mac((uint8_t*)CONFIG_FACTORY_MAC);
 
         if ( retVal != 1 )
         {
             Log_print("DHCP failed, switching to static", NULL, None);
 
-            STV_WriteAtAddress(STVW_USING_DHCP, STV_DHCP_FALSE);
-
-            RestartMCU();
+            bStatic = true;
         }
     }
-    else if ( STV_ReadFromAddress(STVW_USING_DHCP) == STV_DHCP_FALSE )
+
+    if ( !bWarm && bStatic )
     {
-        IPAddress_Init_str(&dvcIp, (uint8_t*)STVW_DEVICE_IP_ADDRESS);
+        dvcIp = Config_GetDeviceIp();
 
-        IPAddress_Init_str(&gtwIp, (uint8_t*)STVW_GATEWAY_IP_ADDRESS);
+        gtwIp = Config_GetGatewayIp();
 
-        IPAddress_Init_str(&msk, (uint8_t*)STVW_NETWORK_MASK);
+        msk = Config_GetNetmask();
 
         dnsIp.dword = 0x01010101;
 
-        Ethernet_begin_mac_ip_dns_gateway_subnet((uint8_t*)STVR_MAC_ADDRESS,
+        Ethernet_begin_mac_ip_dns_gateway_subnet((uint8_t*)CONFIG_FACTORY_MAC,
                                                  dvcIp, dnsIp, gtwIp, msk);
     }
 
+    //
+    // Socket interrupts stay masked until
+    // their owners register for them
+    //
+    EthernetIrq_Init();
+
+    WarmStart_NetworkUp();
+
+    BootProfile_Mark(BOOT_PHASE_NETWORK);
+
     dvcIp = Ethernet_localIP();
 
     IPAddress_toString(dvcIp, pDvcIpBuf);
@@ -154,7 +205,7 @@ void Init_Main(UArg a0, UArg a1)
     ///////////////////////////
     // Target IP Setting:
     //
-    IPAddress_Init_str(&tgtIp, (uint8_t*)STVW_TARGET_IP_ADDRESS);
+    tgtIp = Config_GetTargetIp();
 
     Log_print("Target IP: ", &tgtIp, IpAddress);
 
@@ -165,19 +216,22 @@ void Init_Main(UArg a0, UArg a1)
     ///////////////////////////
     // Other settings:
     //
-    mac2string((uint8_t*)STVR_MAC_ADDRESS, pMacStr);
+    mac2string((uint8_t*)CONFIG_FACTORY_MAC, pMacStr);
 
     Html_SetKeyValueInBuffer('m', pMacStr);
 
     GUI_ChangeRx(false);
 
-    GUI_ChangeProto(STV_ReadFromAddress(STVW_RF_PROTOCOL) == STV_RF_PROTO_BLE ? 0 : 1);
+    GUI_ChangeProto(Config_GetProtocol());
 
+    //
+    // Network is up, sniffing task may start forwarding
+    //
     Semaphore_post(Init_SemaphoreHandle);
 
     Main_CreateDashboardTask();
 
-    Main_CreateSniffingTask();
+    Main_CreateMonitorTask();
 
     return;
 }
@@ -25,6 +25,10 @@
 
 #include <ti/sysbios/knl/Semaphore.h>
 
+#include <ti/sysbios/knl/Event.h>
+
+#include <ti/sysbios/knl/Mailbox.h>
+
 #include "ti_drivers_config.h"
 
 #include "ti_radio_config.h"
@@ -49,6 +53,8 @@
 
 #include <sniffing_task.h>
 
+#include <monitor_task.h>
+
 #include <source/utils/log.h>
 
 
@@ -94,6 +100,11 @@ void Main_CreateDashboardTask()
 
 /*
  * === Sniffing Task
+ * Buffers of the task (frame, BLE record batch, RF object, control
+ * batch) are static, the stack takes the call chains only: UDP write
+ * down to SPI, and Config_Commit() down to NVS_write()/NVS_erase().
+ * Peak use is in GET /api/monitor, the monitor raises an alarm below
+ * MONITOR_HEADROOM_ALARM bytes left.
  */
 Task_Handle sniffingTaskHandle;
 Task_Params sniffingTaskParams;
@@ -108,6 +119,40 @@ void Main_CreateSniffingTask()
     return;
 }
 
+
+/*
+ * === Monitor Task
+ */
+Task_Handle monitorTaskHandle;
+Task_Params monitorTaskParams;
+
+void Main_CreateMonitorTask()
+{
+    Task_Params_init(&monitorTaskParams);
+    monitorTaskParams.stackSize = 768;
+    monitorTaskParams.priority  = 1;
+    monitorTaskHandle = Task_create((Task_FuncPtr)Monitor_Main, &monitorTaskParams, Error_IGNORE);
+
+    return;
+}
+
+
+/*
+ * === GUI Task
+ */
+Task_Handle guiTaskHandle;
+Task_Params guiTaskParams;
+
+void Main_CreateGuiTask()
+{
+    Task_Params_init(&guiTaskParams);
+    guiTaskParams.stackSize = 768;
+    guiTaskParams.priority  = 1;
+    guiTaskHandle = Task_create((Task_FuncPtr)GUI_Main, &guiTaskParams, Error_IGNORE);
+
+    return;
+}
+
 // ==============================================================================================================
 
 
@@ -121,6 +166,25 @@ Semaphore_Params Dashboard_SemaphoreParams;
 // ==============================================================================================================
 
 
+// === EVENT STRUCTS ============================================================================================
+
+Event_Handle     Config_EventHandle;
+
+Event_Handle     Sniffing_EventHandle;
+
+Semaphore_Handle Config_WriterSemaphoreHandle;
+Semaphore_Params Config_WriterSemaphoreParams;
+
+// ==============================================================================================================
+
+
+// === MAILBOX STRUCTS ==========================================================================================
+
+Mailbox_Handle   GUI_MailboxHandle;
+
+// ==============================================================================================================
+
+
 // === PROGRAM ENTRY POINT ======================================================================================
 
 int main()
@@ -135,6 +199,16 @@ int main()
     Dashboard_SemaphoreParams.mode = Semaphore_Mode_BINARY;
     Dashboard_SemaphoreHandle = Semaphore_create(0, &Dashboard_SemaphoreParams, NULL);
 
+    Config_EventHandle = Event_create(NULL, NULL);
+
+    Sniffing_EventHandle = Event_create(NULL, NULL);
+
+    Semaphore_Params_init(&Config_WriterSemaphoreParams);
+    Config_WriterSemaphoreParams.mode = Semaphore_Mode_BINARY;
+    Config_WriterSemaphoreHandle = Semaphore_create(1, &Config_WriterSemaphoreParams, NULL);
+
+    GUI_MailboxHandle = Mailbox_create(sizeof(GUI_Message_t), GUI_MAILBOX_DEPTH, NULL, NULL);
+
     Main_CreateInitTask();
 
     BIOS_start();
@@ -0,0 +1,228 @@
+/*
+ * monitor_task.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <ti/sysbios/knl/Task.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+
+#include <ti/sysbios/utils/Load.h>
+
+#include <source/oled_gui/gui.h>
+
+#include <source/utils/trace.h>
+
+#include <monitor_task.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define TICKS_PER_MS            (100)       // Clock.tickPeriod = 10 us
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+extern Task_Handle initTaskHandle;
+
+extern Task_Handle dashboardTaskHandle;
+
+extern Task_Handle sniffingTaskHandle;
+
+extern Task_Handle monitorTaskHandle;
+
+extern Task_Handle guiTaskHandle;
+
+static Task_Handle* const taskHandles[MONITOR_TASK_COUNT] =
+{
+    [MONITOR_STACK_INIT]      = &initTaskHandle,
+    [MONITOR_STACK_DASHBOARD] = &dashboardTaskHandle,
+    [MONITOR_STACK_SNIFFING]  = &sniffingTaskHandle,
+    [MONITOR_STACK_MONITOR]   = &monitorTaskHandle,
+    [MONITOR_STACK_GUI]       = &guiTaskHandle
+};
+
+static const char* const stackNames[MONITOR_STACK_COUNT] =
+{
+    [MONITOR_STACK_INIT]      = "init",
+    [MONITOR_STACK_DASHBOARD] = "dashboard",
+    [MONITOR_STACK_SNIFFING]  = "sniffing",
+    [MONITOR_STACK_MONITOR]   = "monitor",
+    [MONITOR_STACK_GUI]       = "gui",
+    [MONITOR_STACK_HWI]       = "hwi"
+};
+
+static Monitor_Sample_t sample;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint8_t loadOf(Load_Stat* pStat)
+{
+    uint32_t load = Load_calculateLoad(pStat);
+
+    return ( load > 100 ) ? 100 : (uint8_t)load;
+}
+
+/*
+ * === takeSample
+ * Load statistics are updated here rather than in the Idle task
+ * (Load.updateInIdle = false): the sniffing task sleeps on
+ * Sniffing_EventHandle only once the radio queue is empty, so
+ * Idle may not run for long while capturing.
+ */
+static void takeSample(Monitor_Sample_t* pSample)
+{
+    Task_Stat     taskStat;
+    Load_Stat     loadStat;
+    Hwi_StackInfo hwiStack;
+    uint8_t       i;
+
+    Load_update();
+
+    pSample->ticks   = Clock_getTicks();
+    pSample->cpuLoad = (uint8_t)Load_getCPULoad();
+    pSample->hwiLoad = Load_getGlobalHwiLoad(&loadStat) ? loadOf(&loadStat) : 0;
+    pSample->swiLoad = Load_getGlobalSwiLoad(&loadStat) ? loadOf(&loadStat) : 0;
+
+    for ( i = 0; i < MONITOR_TASK_COUNT; i++ )
+    {
+        pSample->taskLoad[i]  = 0;
+        pSample->stackSize[i] = 0;
+        pSample->stackPeak[i] = 0;
+
+        if ( *taskHandles[i] == NULL )
+        {
+            continue;
+        }
+
+        if ( Load_getTaskLoad(*taskHandles[i], &loadStat) )
+        {
+            pSample->taskLoad[i] = loadOf(&loadStat);
+        }
+
+        Task_stat(*taskHandles[i], &taskStat);
+
+        pSample->stackSize[i] = (uint16_t)taskStat.stackSize;
+        pSample->stackPeak[i] = (uint16_t)taskStat.used;
+    }
+
+    Hwi_getStackInfo(&hwiStack, true);
+
+    pSample->stackSize[MONITOR_STACK_HWI] = (uint16_t)hwiStack.hwiStackSize;
+    pSample->stackPeak[MONITOR_STACK_HWI] = (uint16_t)hwiStack.hwiStackPeak;
+
+    return;
+}
+
+/*
+ * === checkHeadroom
+ * Raises alarm of every stack whose headroom fell below
+ * MONITOR_HEADROOM_ALARM. High-water marks never go down,
+ * so an alarm stays raised (and is traced once).
+ */
+static void checkHeadroom(Monitor_Sample_t* pSample)
+{
+    uint16_t headroom;
+    uint8_t  i;
+    UInt     key;
+
+    for ( i = 0; i < MONITOR_STACK_COUNT; i++ )
+    {
+        if ( pSample->stackSize[i] == 0 || ( pSample->alarms & ( 1 << i ) ) )
+        {
+            continue;
+        }
+
+        headroom = pSample->stackSize[i] - pSample->stackPeak[i];
+
+        if ( headroom < MONITOR_HEADROOM_ALARM )
+        {
+            pSample->alarms |= ( 1 << i );
+
+            //
+            // Task ring of the trace has one producer at a
+            // time, tasks above this one may preempt it
+            //
+            key = Task_disable();
+
+            TRACE(MONITOR_STACK_LOW, i, headroom);
+
+            Task_restore(key);
+        }
+    }
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === MAIN TASK FUNCTION =======================================================================================
+
+/*
+ * === Monitor_Main
+ * Samples CPU load (total, Hwi, Swi, per task) and stack high-water
+ * marks every MONITOR_PERIOD_MS, shows load and stack alarm on the
+ * OLED. Runs below the other tasks (priority 1), when the sniffing
+ * task sleeps on its event or at the next idle moment under load.
+ */
+void Monitor_Main(UArg a0, UArg a1)
+{
+    Monitor_Sample_t next;
+    UInt             key;
+
+    for (;;)
+    {
+        Task_sleep(MONITOR_PERIOD_MS * TICKS_PER_MS);
+
+        next.alarms = sample.alarms;
+
+        takeSample(&next);
+
+        checkHeadroom(&next);
+
+        //
+        // Readers run at a higher priority, they
+        // must not see the copy half written
+        //
+        key = Task_disable();
+
+        sample = next;
+
+        Task_restore(key);
+
+        GUI_ChangeMonitor(sample.cpuLoad, sample.alarms != 0);
+    }
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void Monitor_GetSample(Monitor_Sample_t* pSample)
+{
+    *pSample = sample;
+
+    return;
+}
+
+const char* Monitor_GetStackName(Monitor_Stack_t stack)
+{
+    return stackNames[stack];
+}
+
+// ==============================================================================================================
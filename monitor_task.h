@@ -0,0 +1,94 @@
+/*
+ * monitor_task.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef MONITOR_TASK_H_
+#define MONITOR_TASK_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <xdc/std.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Sampled every second, matches Load.windowInMs
+//
+#define MONITOR_PERIOD_MS           (1000)
+
+//
+// Stack alarm is raised when less than this
+// was never touched (high-water mark)
+//
+#define MONITOR_HEADROOM_ALARM      (128)
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+/*
+ * === Monitor_Stack_t
+ * Stacks watched by the monitor, task stacks first.
+ */
+typedef enum Monitor_Stack
+{
+    MONITOR_STACK_INIT = 0,
+    MONITOR_STACK_DASHBOARD,
+    MONITOR_STACK_SNIFFING,
+    MONITOR_STACK_MONITOR,
+    MONITOR_STACK_GUI,
+    MONITOR_STACK_HWI,              // system stack: Hwi, Swi and main()
+    MONITOR_STACK_COUNT
+} Monitor_Stack_t;
+
+#define MONITOR_TASK_COUNT          (MONITOR_STACK_HWI)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === Monitor_Sample_t
+ * One sample, loads are percent of the last Load window.
+ * A stack of a task not created yet has size 0.
+ */
+typedef struct Monitor_Sample
+{
+    uint32_t ticks;                             // Clock ticks when taken
+    uint8_t  cpuLoad;
+    uint8_t  hwiLoad;
+    uint8_t  swiLoad;
+    uint8_t  taskLoad[MONITOR_TASK_COUNT];
+    uint16_t stackSize[MONITOR_STACK_COUNT];
+    uint16_t stackPeak[MONITOR_STACK_COUNT];    // high-water mark
+    uint8_t  alarms;                            // bit per stack, headroom below MONITOR_HEADROOM_ALARM
+} Monitor_Sample_t;
+
+_Static_assert(MONITOR_STACK_COUNT <= 8, "alarms has a bit per stack");
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void        Monitor_Main(UArg, UArg);
+
+void        Monitor_GetSample(Monitor_Sample_t* pSample);
+
+const char* Monitor_GetStackName(Monitor_Stack_t stack);
+
+// ==============================================================================================================
+
+#endif /* MONITOR_TASK_H_ */
@@ -0,0 +1,1051 @@
+/*
+ * bench.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: benchmark suite. Boots the firmware (main() of
+// main.c is built as Firmware_main()), acts as the network peer and
+// the radio, and reports per scenario:
+//      capture - frames/s on the host, SPI bytes, frames and modelled
+//                SPI time per forwarded frame, and the frame rate the
+//                SPI link of the target allows at that cost
+//      HTTP    - requests/s on the host, response and SPI bytes per
+//                request, on fresh and on a kept-alive connection;
+//                SPI frames/s while a kept-alive connection waits
+//                for the next request, next to none being open
+//      OLED    - I2C bytes, transfers and bus time per screen update
+//                of the GUI fields, posted to the GUI task the way the
+//                tasks do, and the time until it is shown (refresh rate
+//                limit); display RAM of the SSD1306 model checked
+//                against the LCD buffer after every update
+// Host rates only compare builds with each other, SPI figures are
+// what the target pays.
+//
+// Usage: multiSniff_sim [--bridge[=HTTP port]] [flashbins directory]
+//
+// With --bridge the firmware runs on its own instead, reachable
+// from host tools through 127.0.0.1 (bridge.c).
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+
+#include <sched.h>
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include <time.h>
+
+#include <unistd.h>
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define FLASHBINS_DEFAULT       "../flashbins"
+#define FACTORY_PAGE_ADDR       (0x50000)
+#define HTML_TEMPLATE_ADDR      (0x51000)
+
+//
+// Ports of the firmware (sniffing_task.c, control.h,
+// dashboard_task.c) and of the bench as the peer
+//
+#define SNIFF_PORT              (2014)
+#define CONTROL_PORT            (2015)
+#define HTTP_PORT               (80)
+#define BENCH_CONTROL_PORT      (40000)
+#define BENCH_HTTP_PORT         (50000)
+#define BRIDGE_HTTP_PORT        (8080)
+
+#define SR_LISTEN               (0x14)
+#define SR_ESTABLISHED          (0x17)
+#define SR_CLOSE_WAIT           (0x1C)
+#define SR_UDP                  (0x22)
+
+//
+// Control protocol, see control.h
+//
+#define CONTROL_VERSION         (1)
+#define CONTROL_OP_SET          (0x01)
+#define CONTROL_OP_ACK          (0x80)
+#define CONTROL_KEY_PROTOCOL    (0x02)
+#define CONTROL_KEY_TARGET_IP   (0x03)
+#define CONTROL_KEY_RUNNING     (0x04)
+#define CONTROL_KEY_IEEE_DECODE (0x05)
+#define CONTROL_KEY_OUTPUT_MODE (0x07)
+
+//
+// Datagram types, see sniffing_task.h
+//
+#define SNIFF_TYPE_MASK         (0x0F)
+#define SNIFF_TYPE_BLE_RECORDS  (0x02)
+#define SNIFF_TYPE_STATS        (0x03)
+
+#define PROTOCOL_BLE            (0)
+#define PROTOCOL_IEEE           (1)
+
+#define CAPTURE_FRAMES          (5000)
+#define HTTP_REQUESTS           (100)
+#define OLED_UPDATES            (10)
+#define OLED_BURST              (10)
+#define OLED_RAM_SIZE           (1024)
+
+#define BOOT_TIMEOUT_MS         (10000)
+#define ACK_TIMEOUT_MS          (2000)
+#define FRAME_TIMEOUT_MS        (2000)
+#define RESPONSE_TIMEOUT_MS     (2000)
+#define IDLE_MS                 (100)
+#define HTTP_IDLE_MS            (500)
+#define OLED_TIMEOUT_MS         (1000)
+
+#define NS_PER_MS               (1000000ULL)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct Bench_Sink
+{
+    pthread_mutex_t lock;
+    uint64_t        datagrams;      // to SNIFF_PORT
+    uint64_t        frames;         // forwarded frames, records count each
+    uint64_t        tcpBytes;
+    bool            bAck;
+    uint16_t        ackId;
+    uint8_t         ackStatus;
+} Bench_Sink_t;
+
+typedef struct Bench_Capture
+{
+    const char*     pName;
+    uint8_t         protocol;
+    uint8_t         ieeeDecode;
+    uint8_t         outputMode;
+} Bench_Capture_t;
+
+typedef struct Bench_Oled
+{
+    const char*     pName;
+    void            (*fxn)(uint32_t n);     // n-th update, values alternate
+    bool            bSync;                  // SSD1306_UpdateScreen(), not the GUI task
+} Bench_Oled_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static Bench_Sink_t          sinkState = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+static const uint8_t         benchIp[4] = { 192, 168, 5, 1 };
+
+static uint16_t              requestId;
+
+static const Bench_Capture_t captures[] =
+{
+    { "BLE raw",        PROTOCOL_BLE,  0, 0 },
+    { "BLE records",    PROTOCOL_BLE,  0, 1 },
+    { "IEEE raw",       PROTOCOL_IEEE, 0, 0 },
+    { "IEEE summary",   PROTOCOL_IEEE, 1, 0 }
+};
+
+static const char* const     httpPaths[] =
+{
+    "/",
+    "/api/stats",
+    "/metrics"
+};
+
+static const char            keepAlivePath[] = "/api/stats";
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+extern int Firmware_main(void);
+
+//
+// gui.h, ssd1306.h
+//
+extern bool        GUI_IsIdle(void);
+
+extern void        GUI_ChangeDeviceIp(const char* deviceIp);
+
+extern void        GUI_ChangeTargetIp(const char* targetIp);
+
+extern void        GUI_ChangeProto(uint8_t proto);
+
+extern void        GUI_ChangeRx(bool rx);
+
+extern void        GUI_ChangeChannel(uint8_t ch);
+
+extern void        GUI_ChangeMonitor(uint8_t cpuLoad, bool bStackLow);
+
+extern uint8_t     SSD1306_UpdateScreen(void);
+
+extern void        SSD1306_InvalidateScreen(void);
+
+extern char* const SSD1306_Lcd;
+
+static void sleepMs(uint32_t ms)
+{
+    struct timespec ts = { .tv_sec = ms / 1000, .tv_nsec = ( ms % 1000 ) * 1000000L };
+
+    nanosleep(&ts, NULL);
+
+    return;
+}
+
+static bool timedOut(uint64_t startNs, uint32_t timeoutMs)
+{
+    return Sim_GetNanos() - startNs > timeoutMs * NS_PER_MS;
+}
+
+/*
+ * === onSend
+ * Sink of the W5500 model: counts forwarded frames and
+ * response bytes, picks up control acks.
+ */
+static void onSend(uint8_t sock, bool bUdp, const uint8_t* pDstIp, uint16_t dstPort, const uint8_t* pData, uint16_t len)
+{
+    (void)sock;
+    (void)pDstIp;
+
+    pthread_mutex_lock(&sinkState.lock);
+
+    if ( !bUdp )
+    {
+        sinkState.tcpBytes += len;
+    }
+    else if ( dstPort == SNIFF_PORT && len > 0 && ( pData[0] & SNIFF_TYPE_MASK ) != SNIFF_TYPE_STATS )
+    {
+        sinkState.datagrams++;
+
+        //
+        // Record count follows the type byte and LE16 sequence
+        //
+        sinkState.frames += ( ( pData[0] & SNIFF_TYPE_MASK ) == SNIFF_TYPE_BLE_RECORDS && len > 3 ) ? pData[3] : 1;
+    }
+    else if ( dstPort == BENCH_CONTROL_PORT && len >= 6 && pData[1] == ( CONTROL_OP_SET | CONTROL_OP_ACK ) )
+    {
+        sinkState.bAck      = true;
+        sinkState.ackId     = (uint16_t)( pData[2] | ( pData[3] << 8 ) );
+        sinkState.ackStatus = pData[4];
+    }
+
+    pthread_mutex_unlock(&sinkState.lock);
+
+    return;
+}
+
+static void readSink(Bench_Sink_t* pCopy)
+{
+    pthread_mutex_lock(&sinkState.lock);
+
+    pCopy->datagrams = sinkState.datagrams;
+    pCopy->frames    = sinkState.frames;
+    pCopy->tcpBytes  = sinkState.tcpBytes;
+    pCopy->bAck      = sinkState.bAck;
+    pCopy->ackId     = sinkState.ackId;
+    pCopy->ackStatus = sinkState.ackStatus;
+
+    pthread_mutex_unlock(&sinkState.lock);
+
+    return;
+}
+
+/*
+ * === sendSet
+ * SET request of the control protocol, waits for its ack.
+ *
+ * Parameters:
+ *      pFields[in]     - key, length, value triplets
+ *      len[in]         - length of the fields
+ * Returns:
+ *      true when acked with CONTROL_OK
+ */
+static bool sendSet(const uint8_t* pFields, uint16_t len)
+{
+    uint8_t      datagram[64];
+    Bench_Sink_t copy;
+    uint64_t     start = Sim_GetNanos();
+
+    requestId++;
+
+    datagram[0] = CONTROL_VERSION;
+    datagram[1] = CONTROL_OP_SET;
+    datagram[2] = (uint8_t)requestId;
+    datagram[3] = (uint8_t)( requestId >> 8 );
+
+    memcpy(&datagram[4], pFields, len);
+
+    pthread_mutex_lock(&sinkState.lock);
+
+    sinkState.bAck = false;
+
+    pthread_mutex_unlock(&sinkState.lock);
+
+    if ( !SimW5500_PushUdp(CONTROL_PORT, benchIp, BENCH_CONTROL_PORT, datagram, 4 + len) )
+    {
+        return false;
+    }
+
+    do
+    {
+        sleepMs(1);
+
+        readSink(&copy);
+
+        if ( copy.bAck && copy.ackId == requestId )
+        {
+            return copy.ackStatus == 0;
+        }
+    }
+    while ( !timedOut(start, ACK_TIMEOUT_MS) );
+
+    return false;
+}
+
+/*
+ * === buildBle
+ * ADV_IND as BLE5 generic RX delivers it: header, length,
+ * AdvA (varies, one record per advertiser), AdvData, CRC.
+ */
+static uint16_t buildBle(uint8_t* pFrame, uint32_t n)
+{
+    static const uint8_t advData[] = { 0x02, 0x01, 0x06, 0x08, 0x09, 'm', 'u', 'l', 't', 'i', 'S', 'n' };
+    uint16_t             len       = 0;
+
+    pFrame[len++] = 0x40;                           // ADV_IND, random TxAdd
+    pFrame[len++] = 6 + sizeof(advData);
+
+    pFrame[len++] = (uint8_t)n;
+    pFrame[len++] = (uint8_t)( n >> 8 );
+    pFrame[len++] = 0x5A;
+    pFrame[len++] = 0x11;
+    pFrame[len++] = 0x22;
+    pFrame[len++] = 0xC3;
+
+    memcpy(&pFrame[len], advData, sizeof(advData));
+    len += sizeof(advData);
+
+    pFrame[len++] = 0x55;                           // CRC, not checked
+    pFrame[len++] = 0x55;
+    pFrame[len++] = 0x55;
+
+    return len;
+}
+
+/*
+ * === buildIeee
+ * 802.15.4 data frame, short addresses, PAN ID compression,
+ * 20 bytes of payload and FCS.
+ */
+static uint16_t buildIeee(uint8_t* pFrame, uint32_t n)
+{
+    uint16_t len = 0;
+    uint16_t i;
+
+    pFrame[len++] = 0x41;                           // data, PAN ID compression
+    pFrame[len++] = 0x88;                           // short destination and source
+    pFrame[len++] = (uint8_t)n;                     // sequence number
+    pFrame[len++] = 0xCD;                           // PAN ID
+    pFrame[len++] = 0xAB;
+    pFrame[len++] = 0xFF;                           // destination
+    pFrame[len++] = 0xFF;
+    pFrame[len++] = (uint8_t)n;                     // source
+    pFrame[len++] = 0x12;
+
+    for ( i = 0; i < 20; i++ )
+    {
+        pFrame[len++] = (uint8_t)( n + i );
+    }
+
+    pFrame[len++] = 0x00;                           // FCS, not checked
+    pFrame[len++] = 0x00;
+
+    return len;
+}
+
+static bool waitForBoot(void)
+{
+    uint64_t start = Sim_GetNanos();
+
+    while ( SimW5500_FindSocket(SR_LISTEN, HTTP_PORT) < 0 || SimW5500_FindSocket(SR_UDP, CONTROL_PORT) < 0 )
+    {
+        if ( timedOut(start, BOOT_TIMEOUT_MS) )
+        {
+            return false;
+        }
+
+        sleepMs(10);
+    }
+
+    return true;
+}
+
+/*
+ * === waitForIdle
+ * Waits until no frame has been forwarded for IDLE_MS.
+ *
+ * Returns:
+ *      time of the last forwarded frame
+ */
+static uint64_t waitForIdle(void)
+{
+    Bench_Sink_t copy;
+    uint64_t     frames;
+    uint64_t     lastNs = Sim_GetNanos();
+
+    readSink(&copy);
+
+    frames = copy.frames;
+
+    while ( !timedOut(lastNs, IDLE_MS) )
+    {
+        sleepMs(1);
+
+        readSink(&copy);
+
+        if ( copy.frames != frames )
+        {
+            frames = copy.frames;
+            lastNs = Sim_GetNanos();
+        }
+    }
+
+    return lastNs;
+}
+
+static void runCapture(const Bench_Capture_t* pCapture)
+{
+    const uint8_t       fields[] =
+    {
+        CONTROL_KEY_TARGET_IP,   4, benchIp[0], benchIp[1], benchIp[2], benchIp[3],
+        CONTROL_KEY_PROTOCOL,    1, pCapture->protocol,
+        CONTROL_KEY_IEEE_DECODE, 1, pCapture->ieeeDecode,
+        CONTROL_KEY_OUTPUT_MODE, 1, pCapture->outputMode,
+        CONTROL_KEY_RUNNING,     1, 1
+    };
+    uint8_t             frame[64];
+    Bench_Sink_t        sinkBefore;
+    Bench_Sink_t        sinkAfter;
+    SimW5500_Counters_t spiBefore;
+    SimW5500_Counters_t spiAfter;
+    uint64_t            startNs;
+    uint64_t            endNs;
+    uint64_t            frames;
+    uint64_t            waitNs;
+    uint32_t            injected = 0;
+    uint32_t            lost     = 0;
+    uint32_t            n;
+    uint16_t            len;
+    double              cyclesPerFrame;
+
+    if ( !sendSet(fields, sizeof(fields)) )
+    {
+        printf("%-14s control SET not acked\n", pCapture->pName);
+
+        return;
+    }
+
+    waitForIdle();
+
+    readSink(&sinkBefore);
+    SimW5500_GetCounters(&spiBefore);
+
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < CAPTURE_FRAMES; )
+    {
+        //
+        // Back-pressure: the queue is drained as fast as
+        // the firmware gets through HandleIncomingRfPacket()
+        //
+        waitNs = Sim_GetNanos();
+
+        while ( !SimRf_CanReceive() && !timedOut(waitNs, FRAME_TIMEOUT_MS) )
+        {
+            sched_yield();
+        }
+
+        //
+        // Free entries are filled holding the CPU, the firmware
+        // finds the queue full as on the target when frames come
+        // faster than they are forwarded (records are batched)
+        //
+        Sim_Enter();
+
+        do
+        {
+            len = ( pCapture->protocol == PROTOCOL_BLE ) ? buildBle(frame, n) : buildIeee(frame, n);
+
+            if ( SimRf_Inject(frame, len, -60) )
+            {
+                injected++;
+            }
+            else
+            {
+                lost++;
+            }
+
+            n++;
+        }
+        while ( n < CAPTURE_FRAMES && SimRf_CanReceive() );
+
+        Sim_Leave();
+    }
+
+    endNs = waitForIdle();
+
+    readSink(&sinkAfter);
+    SimW5500_GetCounters(&spiAfter);
+
+    frames = sinkAfter.frames - sinkBefore.frames;
+
+    if ( frames == 0 )
+    {
+        printf("%-14s no frames forwarded (%u injected, %u lost)\n", pCapture->pName, injected, lost);
+
+        return;
+    }
+
+    cyclesPerFrame = (double)( spiAfter.cycles - spiBefore.cycles ) / frames;
+
+    printf("%-14s %8.0f %8.1f %8.1f %8.1f %8.1f %9.0f %6u\n",
+           pCapture->pName,
+           frames * 1e9 / ( endNs - startNs ),
+           (double)( spiAfter.bytes - spiBefore.bytes ) / frames,
+           (double)( spiAfter.frames - spiBefore.frames ) / frames,
+           (double)( sinkAfter.datagrams - sinkBefore.datagrams ) / frames,
+           cyclesPerFrame * 1e6 / SIM_CPU_HZ,
+           SIM_CPU_HZ / cyclesPerFrame,
+           lost + ( ( injected > frames ) ? injected - (uint32_t)frames : 0 ));
+
+    return;
+}
+
+/*
+ * === runHttp
+ * Requests on fresh connections ("Connection: close"), the
+ * firmware closes the socket once the response is sent.
+ */
+static void runHttp(const char* pPath)
+{
+    char                request[128];
+    Bench_Sink_t        sinkBefore;
+    Bench_Sink_t        sinkAfter;
+    SimW5500_Counters_t spiBefore;
+    SimW5500_Counters_t spiAfter;
+    uint64_t            startNs;
+    uint64_t            endNs;
+    uint64_t            waitNs;
+    uint32_t            served = 0;
+    uint32_t            i;
+    int                 len;
+    int                 sock;
+
+    len = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: 192.168.5.11\r\nConnection: close\r\n\r\n", pPath);
+
+    readSink(&sinkBefore);
+    SimW5500_GetCounters(&spiBefore);
+
+    startNs = Sim_GetNanos();
+
+    for ( i = 0; i < HTTP_REQUESTS; i++ )
+    {
+        waitNs = Sim_GetNanos();
+
+        while ( ( sock = SimW5500_FindSocket(SR_LISTEN, HTTP_PORT) ) < 0 && !timedOut(waitNs, RESPONSE_TIMEOUT_MS) )
+        {
+            sched_yield();
+        }
+
+        if ( sock < 0 || !SimW5500_Connect((uint8_t)sock, benchIp, (uint16_t)( BENCH_HTTP_PORT + i )) )
+        {
+            break;
+        }
+
+        SimW5500_Push((uint8_t)sock, (const uint8_t*)request, (uint16_t)len);
+
+        while ( SimW5500_GetStatus((uint8_t)sock) == SR_ESTABLISHED && !timedOut(waitNs, RESPONSE_TIMEOUT_MS) )
+        {
+            sched_yield();
+        }
+
+        if ( SimW5500_GetStatus((uint8_t)sock) == SR_ESTABLISHED )
+        {
+            SimW5500_PeerClose((uint8_t)sock);
+
+            break;
+        }
+
+        served++;
+    }
+
+    endNs = Sim_GetNanos();
+
+    readSink(&sinkAfter);
+    SimW5500_GetCounters(&spiAfter);
+
+    if ( served == 0 )
+    {
+        printf("%-14s no response\n", pPath);
+
+        return;
+    }
+
+    printf("%-14s %8.0f %8.0f %8.0f %8.1f %6u\n",
+           pPath,
+           served * 1e9 / ( endNs - startNs ),
+           (double)( sinkAfter.tcpBytes - sinkBefore.tcpBytes ) / served,
+           (double)( spiAfter.bytes - spiBefore.bytes ) / served,
+           (double)( spiAfter.cycles - spiBefore.cycles ) / served * 1e3 / SIM_CPU_HZ,
+           HTTP_REQUESTS - served);
+
+    return;
+}
+
+/*
+ * === idleSpiRate
+ * SPI frames/s while the bench sends nothing for HTTP_IDLE_MS.
+ */
+static double idleSpiRate(void)
+{
+    SimW5500_Counters_t before;
+    SimW5500_Counters_t after;
+    uint64_t            startNs;
+
+    SimW5500_GetCounters(&before);
+
+    startNs = Sim_GetNanos();
+
+    while ( !timedOut(startNs, HTTP_IDLE_MS) )
+    {
+        usleep(1000);
+    }
+
+    SimW5500_GetCounters(&after);
+
+    return (double)( after.frames - before.frames ) * 1e9 / ( Sim_GetNanos() - startNs );
+}
+
+/*
+ * === runHttpKeepAlive
+ * Requests one after another on a single kept-alive connection,
+ * next one is sent when the response to the previous one starts.
+ * Then SPI traffic while the connection is left open and idle
+ * (firmware has to wait for RECV, not poll the socket), and once
+ * it is closed.
+ */
+static void runHttpKeepAlive(const char* pPath)
+{
+    char                request[128];
+    Bench_Sink_t        sinkBefore;
+    Bench_Sink_t        sinkAfter;
+    Bench_Sink_t        sink;
+    SimW5500_Counters_t spiBefore;
+    SimW5500_Counters_t spiAfter;
+    uint64_t            startNs;
+    uint64_t            endNs;
+    uint64_t            waitNs;
+    uint32_t            served = 0;
+    int                 len;
+    int                 sock;
+    double              openRate;
+
+    len = snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\nHost: 192.168.5.11\r\n\r\n", pPath);
+
+    waitNs = Sim_GetNanos();
+
+    while ( ( sock = SimW5500_FindSocket(SR_LISTEN, HTTP_PORT) ) < 0 && !timedOut(waitNs, RESPONSE_TIMEOUT_MS) )
+    {
+        sched_yield();
+    }
+
+    if ( sock < 0 || !SimW5500_Connect((uint8_t)sock, benchIp, BENCH_HTTP_PORT + HTTP_REQUESTS) )
+    {
+        printf("%-14s no connection\n", "keep-alive");
+
+        return;
+    }
+
+    readSink(&sinkBefore);
+    SimW5500_GetCounters(&spiBefore);
+
+    startNs = Sim_GetNanos();
+
+    for ( served = 0; served < HTTP_REQUESTS; served++ )
+    {
+        readSink(&sink);
+
+        SimW5500_Push((uint8_t)sock, (const uint8_t*)request, (uint16_t)len);
+
+        waitNs = Sim_GetNanos();
+
+        do
+        {
+            sched_yield();
+
+            readSink(&sinkAfter);
+        } while ( sinkAfter.tcpBytes == sink.tcpBytes && !timedOut(waitNs, RESPONSE_TIMEOUT_MS) );
+
+        if ( sinkAfter.tcpBytes == sink.tcpBytes || SimW5500_GetStatus((uint8_t)sock) != SR_ESTABLISHED )
+        {
+            break;
+        }
+    }
+
+    endNs = Sim_GetNanos();
+
+    readSink(&sinkAfter);
+    SimW5500_GetCounters(&spiAfter);
+
+    if ( served == 0 )
+    {
+        printf("%-14s no response\n", "keep-alive");
+    }
+    else
+    {
+        printf("%-14s %8.0f %8.0f %8.0f %8.1f %6u\n",
+               "keep-alive",
+               served * 1e9 / ( endNs - startNs ),
+               (double)( sinkAfter.tcpBytes - sinkBefore.tcpBytes ) / served,
+               (double)( spiAfter.bytes - spiBefore.bytes ) / served,
+               (double)( spiAfter.cycles - spiBefore.cycles ) / served * 1e3 / SIM_CPU_HZ,
+               HTTP_REQUESTS - served);
+    }
+
+    openRate = ( SimW5500_GetStatus((uint8_t)sock) == SR_ESTABLISHED ) ? idleSpiRate() : -1;
+
+    SimW5500_PeerClose((uint8_t)sock);
+
+    waitNs = Sim_GetNanos();
+
+    while ( SimW5500_GetStatus((uint8_t)sock) == SR_CLOSE_WAIT && !timedOut(waitNs, RESPONSE_TIMEOUT_MS) )
+    {
+        sched_yield();
+    }
+
+    printf("\nHTTP idle      SPI fr/s\n");
+
+    if ( openRate < 0 )
+    {
+        printf("%-14s closed early\n", "keep-alive");
+    }
+    else
+    {
+        printf("%-14s %8.0f\n", "keep-alive", openRate);
+    }
+
+    printf("%-14s %8.0f\n", "no connection", idleSpiRate());
+
+    return;
+}
+
+static void oledFull(uint32_t n)
+{
+    SSD1306_InvalidateScreen();
+
+    SSD1306_UpdateScreen();
+
+    return;
+}
+
+static void oledChannel(uint32_t n)
+{
+    GUI_ChangeChannel((uint8_t)( 11 + n % 16 ));
+
+    return;
+}
+
+static void oledRx(uint32_t n)
+{
+    GUI_ChangeRx(( n & 1 ) == 0);
+
+    return;
+}
+
+static void oledProto(uint32_t n)
+{
+    GUI_ChangeProto((uint8_t)( ( n + 1 ) & 1 ));
+
+    return;
+}
+
+static void oledTargetIp(uint32_t n)
+{
+    GUI_ChangeTargetIp(( n & 1 ) ? "192.168.5.1" : "10.10.200.201");
+
+    return;
+}
+
+static void oledDeviceIp(uint32_t n)
+{
+    GUI_ChangeDeviceIp(( n & 1 ) ? "192.168.5.11" : "DHCP pending...");
+
+    return;
+}
+
+static void oledMonitor(uint32_t n)
+{
+    GUI_ChangeMonitor((uint8_t)( 5 + n % 90 ), false);
+
+    return;
+}
+
+static void oledUnchanged(uint32_t n)
+{
+    SSD1306_UpdateScreen();
+
+    return;
+}
+
+static void oledBurst(uint32_t n)
+{
+    oledChannel(n);
+    oledRx(n);
+    oledProto(n);
+    oledTargetIp(n);
+    oledDeviceIp(n);
+    oledMonitor(n);
+
+    return;
+}
+
+static void oledRepeat(uint32_t n)
+{
+    uint32_t i;
+
+    for ( i = 0; i < OLED_BURST; i++ )
+    {
+        oledChannel(n * OLED_BURST + i);
+    }
+
+    return;
+}
+
+static const Bench_Oled_t oledUpdates[] =
+{
+    { "full screen",    oledFull,       true },
+    { "channel",        oledChannel,    false },
+    { "RX on/off",      oledRx,         false },
+    { "protocol",       oledProto,      false },
+    { "target IP",      oledTargetIp,   false },
+    { "device IP",      oledDeviceIp,   false },
+    { "monitor",        oledMonitor,    false },
+    { "all fields",     oledBurst,      false },
+    { "channel x10",    oledRepeat,     false },
+    { "unchanged",      oledUnchanged,  true }
+};
+
+/*
+ * === waitGuiIdle
+ * Waits until the GUI task has shown all posted changes, compares
+ * display RAM with the LCD buffer then. The CPU is held while
+ * checking, the GUI task cannot be in the middle of an update.
+ */
+static bool waitGuiIdle(bool* pSame)
+{
+    uint64_t startNs = Sim_GetNanos();
+    bool     bIdle;
+
+    for (;;)
+    {
+        Sim_Enter();
+
+        bIdle = GUI_IsIdle();
+
+        if ( bIdle )
+        {
+            *pSame = ( memcmp(SimSsd1306_GetRam(), SSD1306_Lcd, OLED_RAM_SIZE) == 0 );
+        }
+
+        Sim_Leave();
+
+        if ( bIdle || timedOut(startNs, OLED_TIMEOUT_MS) )
+        {
+            return bIdle;
+        }
+
+        sleepMs(1);
+    }
+}
+
+/*
+ * === runOled
+ * Posts changes to the GUI task the way the tasks do (the CPU held,
+ * a task cannot be preempted) and waits until they are shown. Full
+ * screen and unchanged updates call SSD1306 directly, the GUI task
+ * idle. The monitor task may post its own change meanwhile.
+ */
+static void runOled(const Bench_Oled_t* pOled)
+{
+    SimSsd1306_Counters_t before;
+    SimSsd1306_Counters_t after;
+    uint32_t              mismatches = 0;
+    uint64_t              waitNs = 0;
+    uint64_t              startNs;
+    bool                  bSame = false;
+    uint32_t              i;
+
+    if ( !waitGuiIdle(&bSame) )
+    {
+        printf("%-14s GUI task busy\n", pOled->pName);
+
+        return;
+    }
+
+    SimSsd1306_GetCounters(&before);
+
+    for ( i = 0; i < OLED_UPDATES; i++ )
+    {
+        startNs = Sim_GetNanos();
+
+        Sim_Enter();
+
+        pOled->fxn(i);
+
+        Sim_Leave();
+
+        if ( !waitGuiIdle(&bSame) || !bSame )
+        {
+            mismatches++;
+        }
+
+        waitNs += Sim_GetNanos() - startNs;
+    }
+
+    SimSsd1306_GetCounters(&after);
+
+    printf("%-14s %8.1f %7.1f %8.2f %8.0f  %s\n",
+           pOled->pName,
+           (double)( after.bytes - before.bytes ) / OLED_UPDATES,
+           (double)( after.transfers - before.transfers ) / OLED_UPDATES,
+           (double)( after.ns - before.ns ) / OLED_UPDATES / 1e6,
+           pOled->bSync ? 0.0 : (double)waitNs / OLED_UPDATES / NS_PER_MS,
+           ( mismatches == 0 ) ? "ok" : "differs");
+
+    return;
+}
+
+static void* benchMain(void* pArg)
+{
+    size_t i;
+
+    (void)pArg;
+
+    if ( !waitForBoot() )
+    {
+        fprintf(stderr, "bench: firmware did not open its sockets\n");
+
+        exit(1);
+    }
+
+    printf("capture         frames/s  SPI B/f  SPI fr/f  dgram/f  SPI us/f  target f/s  lost\n");
+
+    for ( i = 0; i < sizeof(captures) / sizeof(captures[0]); i++ )
+    {
+        runCapture(&captures[i]);
+    }
+
+    printf("\nHTTP             req/s  resp B/r  SPI B/r  SPI ms/r  fail\n");
+
+    for ( i = 0; i < sizeof(httpPaths) / sizeof(httpPaths[0]); i++ )
+    {
+        runHttp(httpPaths[i]);
+    }
+
+    runHttpKeepAlive(keepAlivePath);
+
+    printf("\nOLED update    I2C B/u  xfer/u  I2C ms/u  shown ms  RAM\n");
+
+    for ( i = 0; i < sizeof(oledUpdates) / sizeof(oledUpdates[0]); i++ )
+    {
+        runOled(&oledUpdates[i]);
+    }
+
+    fflush(stdout);
+
+    exit(0);
+}
+
+// ==============================================================================================================
+
+
+// === MAIN =====================================================================================================
+
+int main(int argc, char* argv[])
+{
+    const char* pFlashbins = FLASHBINS_DEFAULT;
+    char        path[512];
+    pthread_t   thread;
+    int         bridgePort = 0;
+    int         i;
+
+    for ( i = 1; i < argc; i++ )
+    {
+        if ( strcmp(argv[i], "--bridge") == 0 )
+        {
+            bridgePort = BRIDGE_HTTP_PORT;
+        }
+        else if ( strncmp(argv[i], "--bridge=", 9) == 0 )
+        {
+            bridgePort = atoi(&argv[i][9]);
+        }
+        else
+        {
+            pFlashbins = argv[i];
+        }
+    }
+
+    Sim_Init();
+
+    snprintf(path, sizeof(path), "%s/status_vectors.bin", pFlashbins);
+
+    if ( !Sim_LoadFlash(path, FACTORY_PAGE_ADDR) )
+    {
+        fprintf(stderr, "bench: cannot load %s\n", path);
+
+        return 1;
+    }
+
+    snprintf(path, sizeof(path), "%s/index.bin", pFlashbins);
+
+    if ( !Sim_LoadFlash(path, HTML_TEMPLATE_ADDR) )
+    {
+        fprintf(stderr, "bench: cannot load %s\n", path);
+
+        return 1;
+    }
+
+    if ( bridgePort > 0 )
+    {
+        SimBridge_Start((uint16_t)bridgePort);
+    }
+    else
+    {
+        SimW5500_SetSink(onSend);
+
+        pthread_create(&thread, NULL, benchMain, NULL);
+    }
+
+    return Firmware_main();
+}
+
+// ==============================================================================================================
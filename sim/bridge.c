@@ -0,0 +1,397 @@
+/*
+ * bridge.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: bridge of the W5500 model to host sockets on
+// 127.0.0.1, so host tools talk to the simulated firmware the way
+// they talk to the target:
+//      UDP  - datagrams to the control and replay ports of the host
+//             are pushed to the firmware sockets of the same port,
+//             every datagram the firmware sends goes to 127.0.0.1 on
+//             its destination port (whatever target IP it was sent to)
+//      TCP  - connections to the HTTP port of the host are handed to
+//             the listening HTTP socket of the firmware
+//
+// Firmware socket.c defines socket(), close(), listen(), sendto()...
+// so host sockets are used through syscall() where those names are
+// needed.
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+
+#include <poll.h>
+
+#include <pthread.h>
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include <unistd.h>
+
+#include <netinet/in.h>
+
+#include <sys/socket.h>
+
+#include <sys/syscall.h>
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define SOCKETS                 (8)
+
+#define HTTP_PORT               (80)
+
+#define SR_LISTEN               (0x14)
+#define SR_ESTABLISHED          (0x17)
+#define SR_CLOSE_WAIT           (0x1C)
+
+#define POLL_MS                 (1)
+
+#define MAX_DATAGRAM            (2048)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === SimBridge_Connection_t
+ * Host TCP connection handed to a firmware socket. Data the model
+ * did not take yet waits in pending, the host socket is not read
+ * meanwhile.
+ */
+typedef struct SimBridge_Connection
+{
+    int      fd;                    // -1 when the firmware socket is not bridged
+    uint8_t  pending[MAX_DATAGRAM];
+    uint16_t pendingLen;
+    uint16_t pendingPos;
+} SimBridge_Connection_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static const uint16_t       udpPorts[] = { 2015, 2017 };   // control.h, replay.h
+
+static const uint8_t        loopbackIp[4] = { 127, 0, 0, 1 };
+
+static int                  udpFds[sizeof(udpPorts) / sizeof(udpPorts[0])];
+
+static int                  outFd;
+
+static int                  listenFd;
+
+//
+// Indexed by firmware socket, written by the bridge thread,
+// read by the sink (model locked, fd only)
+//
+static SimBridge_Connection_t connections[SOCKETS];
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static int hostSocket(int type)
+{
+    return (int)syscall(SYS_socket, AF_INET, type | SOCK_CLOEXEC, 0);
+}
+
+static void hostClose(int fd)
+{
+    syscall(SYS_close, fd);
+
+    return;
+}
+
+static struct sockaddr_in loopback(uint16_t port)
+{
+    struct sockaddr_in addr;
+
+    memset(&addr, 0, sizeof(addr));
+
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    return addr;
+}
+
+static int bindLoopback(int type, uint16_t port)
+{
+    struct sockaddr_in addr = loopback(port);
+    int                fd   = hostSocket(type);
+    int                one  = 1;
+
+    if ( fd < 0 )
+    {
+        return -1;
+    }
+
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if ( bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 )
+    {
+        fprintf(stderr, "bridge: cannot bind 127.0.0.1:%u, %s\n", port, strerror(errno));
+
+        exit(1);
+    }
+
+    return fd;
+}
+
+/*
+ * === onSend
+ * Sink of the W5500 model, called with the model locked: sends
+ * on host sockets only.
+ */
+static void onSend(uint8_t sock, bool bUdp, const uint8_t* pDstIp, uint16_t dstPort, const uint8_t* pData, uint16_t len)
+{
+    struct sockaddr_in addr;
+    int                fd;
+
+    (void)pDstIp;
+
+    if ( bUdp )
+    {
+        addr = loopback(dstPort);
+
+        syscall(SYS_sendto, outFd, pData, (size_t)len, 0, &addr, sizeof(addr));
+    }
+    else if ( sock < SOCKETS && ( fd = __atomic_load_n(&connections[sock].fd, __ATOMIC_ACQUIRE) ) >= 0 )
+    {
+        syscall(SYS_sendto, fd, pData, (size_t)len, MSG_NOSIGNAL, NULL, 0);
+    }
+
+    return;
+}
+
+static void dropConnection(uint8_t sock)
+{
+    int fd = connections[sock].fd;
+
+    __atomic_store_n(&connections[sock].fd, -1, __ATOMIC_RELEASE);
+
+    hostClose(fd);
+
+    return;
+}
+
+/*
+ * === acceptConnection
+ * Hands a new host connection to the listening HTTP socket of the
+ * firmware, refused while the firmware has none listening.
+ */
+static void acceptConnection(void)
+{
+    struct sockaddr_in peer;
+    socklen_t          peerLen = sizeof(peer);
+    int                fd      = accept4(listenFd, (struct sockaddr*)&peer, &peerLen, SOCK_CLOEXEC | SOCK_NONBLOCK);
+    int                sock;
+
+    if ( fd < 0 )
+    {
+        return;
+    }
+
+    sock = SimW5500_FindSocket(SR_LISTEN, HTTP_PORT);
+
+    if ( sock < 0 || !SimW5500_Connect((uint8_t)sock, loopbackIp, ntohs(peer.sin_port)) )
+    {
+        hostClose(fd);
+
+        return;
+    }
+
+    connections[sock].pendingLen = 0;
+    connections[sock].pendingPos = 0;
+
+    __atomic_store_n(&connections[sock].fd, fd, __ATOMIC_RELEASE);
+
+    return;
+}
+
+/*
+ * === serviceConnection
+ * Moves host data into the firmware socket, closes either side
+ * when the other one has closed.
+ */
+static void serviceConnection(uint8_t sock, short revents)
+{
+    SimBridge_Connection_t* pConn = &connections[sock];
+    uint8_t                 status = SimW5500_GetStatus(sock);
+    long                    len;
+
+    if ( status != SR_ESTABLISHED && status != SR_CLOSE_WAIT )
+    {
+        dropConnection(sock);
+
+        return;
+    }
+
+    if ( pConn->pendingPos == pConn->pendingLen && ( revents & ( POLLIN | POLLHUP ) ) && status == SR_ESTABLISHED )
+    {
+        len = syscall(SYS_recvfrom, pConn->fd, pConn->pending, sizeof(pConn->pending), MSG_DONTWAIT, NULL, NULL);
+
+        if ( len == 0 || ( len < 0 && errno != EAGAIN ) )
+        {
+            SimW5500_PeerClose(sock);
+
+            return;
+        }
+
+        if ( len > 0 )
+        {
+            pConn->pendingLen = (uint16_t)len;
+            pConn->pendingPos = 0;
+        }
+    }
+
+    if ( pConn->pendingPos < pConn->pendingLen )
+    {
+        pConn->pendingPos += SimW5500_Push(sock, &pConn->pending[pConn->pendingPos], pConn->pendingLen - pConn->pendingPos);
+    }
+
+    return;
+}
+
+static void forwardDatagram(int fd, uint16_t port)
+{
+    static uint8_t     datagram[MAX_DATAGRAM];
+    struct sockaddr_in peer;
+    socklen_t          peerLen = sizeof(peer);
+    long               len;
+
+    len = syscall(SYS_recvfrom, fd, datagram, sizeof(datagram), MSG_DONTWAIT, &peer, &peerLen);
+
+    if ( len > 0 )
+    {
+        SimW5500_PushUdp(port, loopbackIp, ntohs(peer.sin_port), datagram, (uint16_t)len);
+    }
+
+    return;
+}
+
+static void* bridgeMain(void* pArg)
+{
+    struct pollfd fds[sizeof(udpPorts) / sizeof(udpPorts[0]) + 1 + SOCKETS];
+    uint8_t       sockOf[SOCKETS];
+    size_t        nUdp = sizeof(udpPorts) / sizeof(udpPorts[0]);
+    size_t        n;
+    size_t        i;
+    uint8_t       s;
+
+    (void)pArg;
+
+    for (;;)
+    {
+        n = 0;
+
+        for ( i = 0; i < nUdp; i++ )
+        {
+            fds[n++] = (struct pollfd){ .fd = udpFds[i], .events = POLLIN };
+        }
+
+        fds[n++] = (struct pollfd){ .fd = listenFd, .events = POLLIN };
+
+        for ( s = 0; s < SOCKETS; s++ )
+        {
+            if ( connections[s].fd >= 0 )
+            {
+                sockOf[n - nUdp - 1] = s;
+
+                fds[n++] = (struct pollfd){ .fd = connections[s].fd, .events = ( connections[s].pendingPos == connections[s].pendingLen ) ? POLLIN : 0 };
+            }
+        }
+
+        //
+        // Short timeout: firmware closing a connection
+        // and taking pending data are polled
+        //
+        poll(fds, n, POLL_MS);
+
+        for ( i = 0; i < nUdp; i++ )
+        {
+            if ( fds[i].revents & POLLIN )
+            {
+                forwardDatagram(fds[i].fd, udpPorts[i]);
+            }
+        }
+
+        for ( i = nUdp + 1; i < n; i++ )
+        {
+            serviceConnection(sockOf[i - nUdp - 1], fds[i].revents);
+        }
+
+        if ( fds[nUdp].revents & POLLIN )
+        {
+            acceptConnection();
+        }
+    }
+
+    return NULL;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === SimBridge_Start
+ * Binds the host sockets and starts the bridge thread, the W5500
+ * model sink goes to the bridge.
+ *
+ * Parameters:
+ *      httpPort[in]    - host TCP port bridged to HTTP port 80
+ *                        (80 itself needs privileges on the host)
+ * Returns:
+ *      N/A, exits when a host port is taken
+ */
+void SimBridge_Start(uint16_t httpPort)
+{
+    pthread_t thread;
+    size_t    i;
+
+    for ( i = 0; i < SOCKETS; i++ )
+    {
+        connections[i].fd = -1;
+    }
+
+    for ( i = 0; i < sizeof(udpPorts) / sizeof(udpPorts[0]); i++ )
+    {
+        udpFds[i] = bindLoopback(SOCK_DGRAM, udpPorts[i]);
+    }
+
+    outFd    = hostSocket(SOCK_DGRAM);
+    listenFd = bindLoopback(SOCK_STREAM, httpPort);
+
+    syscall(SYS_listen, listenFd, SOCKETS);
+
+    SimW5500_SetSink(onSend);
+
+    pthread_create(&thread, NULL, bridgeMain, NULL);
+
+    fprintf(stderr, "bridge: UDP 127.0.0.1:%u,%u, HTTP 127.0.0.1:%u, output to 127.0.0.1\n", udpPorts[0], udpPorts[1], httpPort);
+
+    return;
+}
+
+// ==============================================================================================================
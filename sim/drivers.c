@@ -0,0 +1,582 @@
+/*
+ * drivers.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: TI drivers of multiSniff.syscfg. SPI and the W5500
+// GPIOs (CS, RESET, INT) go to the W5500 model, I2C to the SSD1306
+// model, NVS is kept in RAM, UART2 accepts everything. Also maps the
+// fixed target addresses the firmware dereferences.
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <stdarg.h>
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include <sys/mman.h>
+
+#include <xdc/runtime/System.h>
+
+#include <ti/drivers/Board.h>
+
+#include <ti/drivers/GPIO.h>
+
+#include <ti/drivers/SPI.h>
+
+#include <ti/drivers/I2C.h>
+
+#include <ti/drivers/NVS.h>
+
+#include <ti/drivers/UART2.h>
+
+#include "ti_drivers_config.h"
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// CONFIG_NVS_SETTINGS: two 8 kB sectors at 0x4A000
+//
+#define NVS_REGION_BASE         (0x4A000)
+#define NVS_REGION_SIZE         (0x4000)
+#define NVS_SECTOR_SIZE         (0x2000)
+
+#define FLASH_ERASED            (0xFF)
+
+#define SSD1306_I2C_ADDR        (0x3C)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+const uint_least8_t CONFIG_GPIO_W5500_RESET_CONST = CONFIG_GPIO_W5500_RESET;
+
+const uint_least8_t CONFIG_GPIO_W5500_CS_CONST    = CONFIG_GPIO_W5500_CS;
+
+const uint_least8_t CONFIG_GPIO_W5500_INT_CONST   = CONFIG_GPIO_W5500_INT;
+
+const uint_least8_t CONFIG_I2C_0_CONST            = CONFIG_I2C_0;
+
+const uint_least8_t CONFIG_SPI_0_CONST            = CONFIG_SPI_0;
+
+const uint_least8_t CONFIG_NVS_SETTINGS_CONST     = CONFIG_NVS_SETTINGS;
+
+//
+// GPIO8.callbackFunction of multiSniff.syscfg
+//
+extern void HandleInterrupt(void);
+
+static volatile bool bIntEnabled;
+
+static uint8_t       nvsMemory[NVS_REGION_SIZE];
+
+static bool          bNvsErased;
+
+//
+// Bytes programmed until power is lost (SimNvs_CutPower),
+// erases done so far
+//
+static bool          bNvsPowerCut;
+
+static uint32_t      nvsPowerBytes;
+
+static uint32_t      nvsErases;
+
+static bool          bVerbose;
+
+//
+// Handles only need to be distinct from NULL
+//
+static int           spiObject;
+
+static int           i2cObject;
+
+static I2C_Params    i2cParams;
+
+static int           nvsObject;
+
+static int           uartObject;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static void mapWindow(uintptr_t base, size_t size, uint8_t fill)
+{
+    void* p = mmap((void*)base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if ( p != (void*)base )
+    {
+        fprintf(stderr, "sim: cannot map 0x%08lx (target address), %s\n", (unsigned long)base, ( p == MAP_FAILED ) ? "in use" : "moved");
+
+        exit(1);
+    }
+
+    memset(p, fill, size);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Sim_MapTarget
+ * Maps flash (erased), SRAM and the system control space
+ * windows at their target addresses, see sim.h.
+ */
+void Sim_MapTarget(void)
+{
+    mapWindow(SIM_FLASH_BASE, SIM_FLASH_SIZE, FLASH_ERASED);
+
+    mapWindow(SIM_SRAM_BASE, SIM_SRAM_SIZE, 0);
+
+    mapWindow(SIM_DWT_BASE, 0x1000, 0);
+
+    mapWindow(SIM_SCS_BASE, SIM_SCS_SIZE, 0);
+
+    bVerbose = ( getenv("SIM_VERBOSE") != NULL );
+
+    return;
+}
+
+/*
+ * === Sim_LoadFlash
+ * Loads an image of flashbins/ the way load_bins.js does.
+ *
+ * Parameters:
+ *      pPath[in]       - binary image
+ *      address[in]     - target flash address
+ * Returns:
+ *      false when the image cannot be read or does not fit
+ */
+bool Sim_LoadFlash(const char* pPath, uint32_t address)
+{
+    FILE*  pFile = fopen(pPath, "rb");
+    size_t room  = SIM_FLASH_BASE + SIM_FLASH_SIZE - address;
+    size_t len;
+    bool   bFits;
+
+    if ( pFile == NULL || address < SIM_FLASH_BASE || address >= SIM_FLASH_BASE + SIM_FLASH_SIZE )
+    {
+        if ( pFile != NULL )
+        {
+            fclose(pFile);
+        }
+
+        return false;
+    }
+
+    len = fread((void*)(uintptr_t)address, 1, room, pFile);
+
+    //
+    // Image must not be cut
+    //
+    bFits = ( len < room ) || ( fgetc(pFile) == EOF );
+
+    fclose(pFile);
+
+    return ( len > 0 ) && bFits;
+}
+
+int System_printf(const char* pFormat, ...)
+{
+    va_list args;
+    int     len = 0;
+
+    if ( bVerbose )
+    {
+        va_start(args, pFormat);
+
+        len = vfprintf(stderr, pFormat, args);
+
+        va_end(args);
+    }
+
+    return len;
+}
+
+void RestartMCU(void)
+{
+    fprintf(stderr, "sim: RestartMCU(), the simulation ends\n");
+
+    exit(2);
+}
+
+void Board_init(void)
+{
+    return;
+}
+
+///////////////////////////
+// GPIO
+//
+
+void GPIO_init(void)
+{
+    return;
+}
+
+void GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig)
+{
+    if ( index == CONFIG_GPIO_W5500_CS && ( pinConfig & GPIO_CFG_OUT_HIGH ) )
+    {
+        SimW5500_Select(false);
+    }
+
+    return;
+}
+
+void GPIO_write(uint_least8_t index, unsigned int value)
+{
+    if ( index == CONFIG_GPIO_W5500_CS )
+    {
+        SimW5500_Select(value == 0);
+    }
+    else if ( index == CONFIG_GPIO_W5500_RESET && value != 0 )
+    {
+        SimW5500_Reset();
+    }
+
+    return;
+}
+
+void GPIO_enableInt(uint_least8_t index)
+{
+    if ( index == CONFIG_GPIO_W5500_INT )
+    {
+        bIntEnabled = true;
+    }
+
+    return;
+}
+
+void GPIO_disableInt(uint_least8_t index)
+{
+    if ( index == CONFIG_GPIO_W5500_INT )
+    {
+        bIntEnabled = false;
+    }
+
+    return;
+}
+
+/*
+ * === SimGpio_SetInt
+ * Called by the W5500 model when INT falls (asserted, active low).
+ * Like the pin interrupt of the target, an edge while the interrupt
+ * is disabled is lost.
+ */
+void SimGpio_SetInt(bool bAsserted)
+{
+    if ( bAsserted && bIntEnabled )
+    {
+        Sim_RunHwi(HandleInterrupt);
+    }
+
+    return;
+}
+
+///////////////////////////
+// SPI
+//
+
+void SPI_init(void)
+{
+    return;
+}
+
+void SPI_Params_init(SPI_Params* pParams)
+{
+    memset(pParams, 0, sizeof(*pParams));
+
+    pParams->bitRate  = 1000000;
+    pParams->dataSize = 8;
+
+    return;
+}
+
+SPI_Handle SPI_open(uint_least8_t index, SPI_Params* pParams)
+{
+    (void)pParams;
+
+    return ( index == CONFIG_SPI_0 ) ? (SPI_Handle)&spiObject : NULL;
+}
+
+bool SPI_transfer(SPI_Handle handle, SPI_Transaction* pTransaction)
+{
+    (void)handle;
+
+    SimW5500_Transfer((const uint8_t*)pTransaction->txBuf, (uint8_t*)pTransaction->rxBuf, pTransaction->count);
+
+    return true;
+}
+
+///////////////////////////
+// I2C: SSD1306 at its address, nothing else attached.
+// In callback mode the callback runs as Swi on the
+// calling thread, before I2C_transfer() returns.
+//
+
+void I2C_init(void)
+{
+    return;
+}
+
+void I2C_Params_init(I2C_Params* pParams)
+{
+    memset(pParams, 0, sizeof(*pParams));
+
+    return;
+}
+
+I2C_Handle I2C_open(uint_least8_t index, I2C_Params* pParams)
+{
+    i2cParams = *pParams;
+
+    return ( index == CONFIG_I2C_0 ) ? (I2C_Handle)&i2cObject : NULL;
+}
+
+static void i2cCallbackSwi(void* pArg)
+{
+    I2C_Transaction* pTransaction = pArg;
+
+    i2cParams.transferCallbackFxn((I2C_Handle)&i2cObject, pTransaction,
+                                  pTransaction->slaveAddress == SSD1306_I2C_ADDR);
+
+    return;
+}
+
+bool I2C_transfer(I2C_Handle handle, I2C_Transaction* pTransaction)
+{
+    bool bAcked = ( pTransaction->slaveAddress == SSD1306_I2C_ADDR );
+
+    (void)handle;
+
+    if ( bAcked && pTransaction->writeCount != 0 )
+    {
+        SimSsd1306_Write((const uint8_t*)pTransaction->writeBuf, pTransaction->writeCount);
+    }
+
+    if ( bAcked && pTransaction->readCount != 0 )
+    {
+        memset(pTransaction->readBuf, 0, pTransaction->readCount);
+    }
+
+    //
+    // A NACK completes the transfer with an error
+    // in callback mode, as the driver does
+    //
+    if ( i2cParams.transferMode == I2C_MODE_CALLBACK )
+    {
+        Sim_RunSwi(i2cCallbackSwi, pTransaction);
+
+        return true;
+    }
+
+    return bAcked;
+}
+
+///////////////////////////
+// NVS: flash semantics, a write only clears bits
+//
+
+void NVS_init(void)
+{
+    if ( !bNvsErased )
+    {
+        memset(nvsMemory, FLASH_ERASED, sizeof(nvsMemory));
+
+        bNvsErased = true;
+    }
+
+    return;
+}
+
+NVS_Handle NVS_open(uint_least8_t index, NVS_Params* pParams)
+{
+    (void)pParams;
+
+    return ( index == CONFIG_NVS_SETTINGS ) ? (NVS_Handle)&nvsObject : NULL;
+}
+
+void NVS_getAttrs(NVS_Handle handle, NVS_Attrs* pAttrs)
+{
+    (void)handle;
+
+    pAttrs->regionBase = NVS_REGION_BASE;
+    pAttrs->regionSize = NVS_REGION_SIZE;
+    pAttrs->sectorSize = NVS_SECTOR_SIZE;
+
+    return;
+}
+
+int_fast16_t NVS_read(NVS_Handle handle, size_t offset, void* pBuffer, size_t bufferSize)
+{
+    (void)handle;
+
+    if ( offset + bufferSize > NVS_REGION_SIZE )
+    {
+        return NVS_STATUS_INV_OFFSET;
+    }
+
+    memcpy(pBuffer, &nvsMemory[offset], bufferSize);
+
+    return NVS_STATUS_SUCCESS;
+}
+
+int_fast16_t NVS_write(NVS_Handle handle, size_t offset, void* pBuffer, size_t bufferSize, uint_fast16_t flags)
+{
+    const uint8_t* pSrc = (const uint8_t*)pBuffer;
+    size_t         i;
+
+    (void)handle;
+
+    if ( offset + bufferSize > NVS_REGION_SIZE )
+    {
+        return NVS_STATUS_INV_OFFSET;
+    }
+
+    for ( i = 0; i < bufferSize; i++ )
+    {
+        if ( bNvsPowerCut )
+        {
+            if ( nvsPowerBytes == 0 )
+            {
+                return NVS_STATUS_ERROR;
+            }
+
+            nvsPowerBytes--;
+        }
+
+        nvsMemory[offset + i] &= pSrc[i];
+    }
+
+    if ( ( flags & NVS_WRITE_POST_VERIFY ) && memcmp(&nvsMemory[offset], pSrc, bufferSize) != 0 )
+    {
+        return NVS_STATUS_ERROR;
+    }
+
+    return NVS_STATUS_SUCCESS;
+}
+
+int_fast16_t NVS_erase(NVS_Handle handle, size_t offset, size_t size)
+{
+    (void)handle;
+
+    if ( offset % NVS_SECTOR_SIZE || size % NVS_SECTOR_SIZE || offset + size > NVS_REGION_SIZE )
+    {
+        return NVS_STATUS_INV_OFFSET;
+    }
+
+    //
+    // Power lost before the erase, the sector keeps its contents
+    //
+    if ( bNvsPowerCut && nvsPowerBytes == 0 )
+    {
+        return NVS_STATUS_ERROR;
+    }
+
+    memset(&nvsMemory[offset], FLASH_ERASED, size);
+
+    nvsErases++;
+
+    return NVS_STATUS_SUCCESS;
+}
+
+/*
+ * === SimNvs_GetMemory
+ * Returns:
+ *      uint8_t*                - CONFIG_NVS_SETTINGS region (NVS offset 0),
+ *                                NVS_REGION_SIZE bytes, for tests to
+ *                                inspect, corrupt or save and restore
+ */
+uint8_t* SimNvs_GetMemory(void)
+{
+    NVS_init();
+
+    return nvsMemory;
+}
+
+/*
+ * === SimNvs_CutPower
+ * Flash stops being programmed after 'bytes' more bytes, the write
+ * in progress and every later write or erase fail.
+ * SimNvs_RestorePower() brings it back.
+ */
+void SimNvs_CutPower(uint32_t bytes)
+{
+    bNvsPowerCut  = true;
+    nvsPowerBytes = bytes;
+
+    return;
+}
+
+void SimNvs_RestorePower(void)
+{
+    bNvsPowerCut = false;
+
+    return;
+}
+
+uint32_t SimNvs_GetErases(void)
+{
+    return nvsErases;
+}
+
+///////////////////////////
+// UART2
+//
+
+void UART2_Params_init(UART2_Params* pParams)
+{
+    pParams->baudRate = 115200;
+
+    return;
+}
+
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params* pParams)
+{
+    (void)index;
+    (void)pParams;
+
+    return (UART2_Handle)&uartObject;
+}
+
+int_fast16_t UART2_write(UART2_Handle handle, const void* pBuffer, size_t size, size_t* pBytesWritten)
+{
+    (void)handle;
+
+    if ( bVerbose )
+    {
+        fwrite(pBuffer, 1, size, stderr);
+    }
+
+    if ( pBytesWritten != NULL )
+    {
+        *pBytesWritten = size;
+    }
+
+    return 0;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,45 @@
+/*
+ * rf_data_entry.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_DRIVERLIB_RF_DATA_ENTRY_H_
+#define SIM_DRIVERLIB_RF_DATA_ENTRY_H_
+
+#include <stdint.h>
+
+#define DATA_ENTRY_PENDING      (0)
+#define DATA_ENTRY_ACTIVE       (1)
+#define DATA_ENTRY_BUSY         (2)
+#define DATA_ENTRY_FINISHED     (3)
+#define DATA_ENTRY_UNFINISHED   (4)
+
+#define DATA_ENTRY_TYPE_GEN     (0)
+
+typedef struct rfc_dataEntryConfig_s
+{
+    uint8_t type:2;
+    uint8_t lenSz:2;
+    uint8_t irqIntv:4;
+} rfc_dataEntryConfig_t;
+
+typedef struct rfc_dataEntry_s
+{
+    uint8_t*              pNextEntry;
+    uint8_t               status;
+    rfc_dataEntryConfig_t config;
+    uint16_t              length;
+} rfc_dataEntry_t;
+
+typedef struct rfc_dataEntryGeneral_s
+{
+    uint8_t*              pNextEntry;
+    uint8_t               status;
+    rfc_dataEntryConfig_t config;
+    uint16_t              length;
+    uint8_t               data;
+} rfc_dataEntryGeneral_t;
+
+#endif /* SIM_DRIVERLIB_RF_DATA_ENTRY_H_ */
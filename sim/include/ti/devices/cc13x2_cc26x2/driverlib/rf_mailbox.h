@@ -0,0 +1,41 @@
+/*
+ * rf_mailbox.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_DRIVERLIB_RF_MAILBOX_H_
+#define SIM_DRIVERLIB_RF_MAILBOX_H_
+
+#include <stdint.h>
+
+typedef uint32_t rfc_command_t;
+
+typedef uint32_t ratmr_t;
+
+typedef struct rfc_radioOp_s
+{
+    uint16_t commandNo;
+    uint16_t status;
+} rfc_radioOp_t;
+
+typedef struct dataQueue_s
+{
+    uint8_t* pCurrEntry;
+    uint8_t* pLastEntry;
+} dataQueue_t;
+
+//
+// Radio operation status
+//
+#define IDLE                    (0x0000)
+#define PENDING                 (0x0001)
+#define ACTIVE                  (0x0002)
+#define DONE_OK                 (0x0400)
+#define DONE_RXERR              (0x0401)
+#define DONE_STOPPED            (0x0404)
+#define DONE_ABORT              (0x0405)
+#define ERROR_RXBUF             (0x0807)
+
+#endif /* SIM_DRIVERLIB_RF_MAILBOX_H_ */
@@ -0,0 +1,13 @@
+/*
+ * Board.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_DRIVERS_BOARD_H_
+#define SIM_TI_DRIVERS_BOARD_H_
+
+void Board_init(void);
+
+#endif /* SIM_TI_DRIVERS_BOARD_H_ */
@@ -0,0 +1,30 @@
+/*
+ * GPIO.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_DRIVERS_GPIO_H_
+#define SIM_TI_DRIVERS_GPIO_H_
+
+#include <stdint.h>
+
+typedef uint32_t GPIO_PinConfig;
+
+#define GPIO_CFG_OUT_STD    (0x00000000)
+#define GPIO_CFG_OUT_HIGH   (0x00000001)
+#define GPIO_CFG_OUT_LOW    (0x00000000)
+#define GPIO_CFG_INPUT      (0x00000002)
+
+void GPIO_init(void);
+
+void GPIO_setConfig(uint_least8_t index, GPIO_PinConfig pinConfig);
+
+void GPIO_write(uint_least8_t index, unsigned int value);
+
+void GPIO_enableInt(uint_least8_t index);
+
+void GPIO_disableInt(uint_least8_t index);
+
+#endif /* SIM_TI_DRIVERS_GPIO_H_ */
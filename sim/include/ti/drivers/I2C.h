@@ -0,0 +1,58 @@
+/*
+ * I2C.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_DRIVERS_I2C_H_
+#define SIM_TI_DRIVERS_I2C_H_
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <stddef.h>
+
+typedef struct I2C_Config* I2C_Handle;
+
+typedef enum I2C_BitRate
+{
+    I2C_100kHz = 0,
+    I2C_400kHz
+} I2C_BitRate;
+
+typedef enum I2C_TransferMode
+{
+    I2C_MODE_BLOCKING = 0,
+    I2C_MODE_CALLBACK
+} I2C_TransferMode;
+
+typedef struct I2C_Transaction
+{
+    const void*   writeBuf;
+    size_t        writeCount;
+    void*         readBuf;
+    size_t        readCount;
+    uint_least8_t slaveAddress;
+    void*         arg;
+} I2C_Transaction;
+
+typedef void (*I2C_CallbackFxn)(I2C_Handle handle, I2C_Transaction* pTransaction, bool bTransferStatus);
+
+typedef struct I2C_Params
+{
+    I2C_TransferMode transferMode;
+    I2C_CallbackFxn  transferCallbackFxn;
+    I2C_BitRate      bitRate;
+} I2C_Params;
+
+void       I2C_init(void);
+
+void       I2C_Params_init(I2C_Params* pParams);
+
+I2C_Handle I2C_open(uint_least8_t index, I2C_Params* pParams);
+
+bool       I2C_transfer(I2C_Handle handle, I2C_Transaction* pTransaction);
+
+#endif /* SIM_TI_DRIVERS_I2C_H_ */
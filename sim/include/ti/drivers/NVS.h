@@ -0,0 +1,49 @@
+/*
+ * NVS.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_DRIVERS_NVS_H_
+#define SIM_TI_DRIVERS_NVS_H_
+
+#include <stdint.h>
+
+#include <stddef.h>
+
+typedef struct NVS_Config* NVS_Handle;
+
+typedef struct NVS_Params
+{
+    void*   custom;
+} NVS_Params;
+
+typedef struct NVS_Attrs
+{
+    size_t  regionBase;
+    size_t  regionSize;
+    size_t  sectorSize;
+} NVS_Attrs;
+
+#define NVS_STATUS_SUCCESS      (0)
+#define NVS_STATUS_ERROR        (-1)
+#define NVS_STATUS_INV_OFFSET   (-3)
+
+#define NVS_WRITE_ERASE         (0x1)
+#define NVS_WRITE_PRE_VERIFY    (0x2)
+#define NVS_WRITE_POST_VERIFY   (0x4)
+
+void         NVS_init(void);
+
+NVS_Handle   NVS_open(uint_least8_t index, NVS_Params* pParams);
+
+void         NVS_getAttrs(NVS_Handle handle, NVS_Attrs* pAttrs);
+
+int_fast16_t NVS_read(NVS_Handle handle, size_t offset, void* pBuffer, size_t bufferSize);
+
+int_fast16_t NVS_write(NVS_Handle handle, size_t offset, void* pBuffer, size_t bufferSize, uint_fast16_t flags);
+
+int_fast16_t NVS_erase(NVS_Handle handle, size_t offset, size_t size);
+
+#endif /* SIM_TI_DRIVERS_NVS_H_ */
@@ -0,0 +1,57 @@
+/*
+ * SPI.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_DRIVERS_SPI_H_
+#define SIM_TI_DRIVERS_SPI_H_
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <stddef.h>
+
+typedef struct SPI_Config* SPI_Handle;
+
+typedef enum SPI_Mode
+{
+    SPI_MASTER = 0,
+    SPI_SLAVE
+} SPI_Mode;
+
+typedef enum SPI_TransferMode
+{
+    SPI_MODE_BLOCKING = 0,
+    SPI_MODE_CALLBACK
+} SPI_TransferMode;
+
+typedef struct SPI_Transaction
+{
+    size_t  count;
+    void*   txBuf;
+    void*   rxBuf;
+    void*   arg;
+} SPI_Transaction;
+
+typedef struct SPI_Params
+{
+    SPI_TransferMode transferMode;
+    uint32_t         transferTimeout;
+    SPI_Mode         mode;
+    uint32_t         bitRate;
+    uint32_t         dataSize;
+    uint32_t         frameFormat;
+} SPI_Params;
+
+void       SPI_init(void);
+
+void       SPI_Params_init(SPI_Params* pParams);
+
+SPI_Handle SPI_open(uint_least8_t index, SPI_Params* pParams);
+
+bool       SPI_transfer(SPI_Handle handle, SPI_Transaction* pTransaction);
+
+#endif /* SIM_TI_DRIVERS_SPI_H_ */
@@ -0,0 +1,28 @@
+/*
+ * UART2.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_DRIVERS_UART2_H_
+#define SIM_TI_DRIVERS_UART2_H_
+
+#include <stdint.h>
+
+#include <stddef.h>
+
+typedef struct UART2_Config* UART2_Handle;
+
+typedef struct UART2_Params
+{
+    uint32_t baudRate;
+} UART2_Params;
+
+void         UART2_Params_init(UART2_Params* pParams);
+
+UART2_Handle UART2_open(uint_least8_t index, UART2_Params* pParams);
+
+int_fast16_t UART2_write(UART2_Handle handle, const void* pBuffer, size_t size, size_t* pBytesWritten);
+
+#endif /* SIM_TI_DRIVERS_UART2_H_ */
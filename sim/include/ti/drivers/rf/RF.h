@@ -0,0 +1,102 @@
+/*
+ * RF.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: the part of the TI RF driver multiSniff uses,
+// implemented by sim/rf.c. Frames are injected with SimRf_Inject().
+//
+
+#ifndef SIM_TI_DRIVERS_RF_RF_H_
+#define SIM_TI_DRIVERS_RF_RF_H_
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <string.h>
+
+#define DeviceFamily_constructPath(x)   <ti/devices/cc13x2_cc26x2/x>
+
+#include DeviceFamily_constructPath(driverlib/rf_mailbox.h)
+
+typedef uint64_t RF_EventMask;
+
+typedef int16_t  RF_CmdHandle;
+
+typedef rfc_radioOp_t RF_Op;
+
+typedef struct RF_Object* RF_Handle;
+
+typedef struct RF_Mode
+{
+    uint8_t  rfMode;
+} RF_Mode;
+
+typedef union RF_RadioSetup
+{
+    rfc_command_t commandId;
+} RF_RadioSetup;
+
+typedef struct RF_Object
+{
+    RF_Mode* pMode;
+    bool     bOpen;
+} RF_Object;
+
+typedef struct RF_Params
+{
+    uint32_t nInactivityTimeout;
+} RF_Params;
+
+typedef enum RF_Priority
+{
+    RF_PriorityHighest = 2,
+    RF_PriorityHigh    = 1,
+    RF_PriorityNormal  = 0
+} RF_Priority;
+
+typedef enum RF_Stat
+{
+    RF_StatBusyError,
+    RF_StatRadioInactiveError,
+    RF_StatCmdDoneError,
+    RF_StatInvalidParamsError,
+    RF_StatCmdEnded,
+    RF_StatError       = 0x80,
+    RF_StatCmdDoneSuccess,
+    RF_StatCmdSch,
+    RF_StatSuccess
+} RF_Stat;
+
+typedef void (*RF_Callback)(RF_Handle h, RF_CmdHandle ch, RF_EventMask e);
+
+#define RF_EventCmdDone             ((RF_EventMask)1 << 0)
+#define RF_EventLastCmdDone         ((RF_EventMask)1 << 1)
+#define RF_EventRxOk                ((RF_EventMask)1 << 16)
+#define RF_EventRxNOk               ((RF_EventMask)1 << 17)
+#define RF_EventRxEntryDone         ((RF_EventMask)1 << 23)
+#define RF_EventRxBufFull           ((RF_EventMask)1 << 27)
+#define RF_EventCmdAborted          ((RF_EventMask)1 << 56)
+#define RF_EventCmdStopped          ((RF_EventMask)1 << 57)
+#define RF_EventCmdCancelled        ((RF_EventMask)1 << 58)
+
+#define RF_CMDHANDLE_FLUSH_ALL      ((RF_CmdHandle)-1)
+#define RF_ALLOC_ERROR              ((RF_CmdHandle)-2)
+
+void         RF_Params_init(RF_Params* pParams);
+
+RF_Handle    RF_open(RF_Object* pObj, RF_Mode* pRfMode, RF_RadioSetup* pOpSetup, RF_Params* pParams);
+
+void         RF_close(RF_Handle h);
+
+RF_CmdHandle RF_postCmd(RF_Handle h, RF_Op* pOp, RF_Priority ePri, RF_Callback pCb, RF_EventMask bmEvent);
+
+RF_Stat      RF_flushCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode);
+
+uint32_t     RF_getCurrentTime(void);
+
+#endif /* SIM_TI_DRIVERS_RF_RF_H_ */
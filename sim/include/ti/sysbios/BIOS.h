@@ -0,0 +1,31 @@
+/*
+ * BIOS.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_BIOS_H_
+#define SIM_TI_SYSBIOS_BIOS_H_
+
+#include <xdc/std.h>
+
+#define BIOS_WAIT_FOREVER   (~(UInt32)0)
+#define BIOS_NO_WAIT        ((UInt32)0)
+
+typedef enum BIOS_ThreadType
+{
+    BIOS_ThreadType_Hwi = 0,
+    BIOS_ThreadType_Swi,
+    BIOS_ThreadType_Task,
+    BIOS_ThreadType_Main
+} BIOS_ThreadType;
+
+BIOS_ThreadType BIOS_getThreadType(void);
+
+//
+// Hands the CPU to the created tasks, never returns
+//
+void            BIOS_start(void);
+
+#endif /* SIM_TI_SYSBIOS_BIOS_H_ */
@@ -0,0 +1,22 @@
+/*
+ * Hwi.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_FAMILY_ARM_M3_HWI_H_
+#define SIM_TI_SYSBIOS_FAMILY_ARM_M3_HWI_H_
+
+#include <xdc/std.h>
+
+typedef struct Hwi_StackInfo
+{
+    SizeT   hwiStackPeak;
+    SizeT   hwiStackSize;
+    Ptr     hwiStackBase;
+} Hwi_StackInfo;
+
+Bool Hwi_getStackInfo(Hwi_StackInfo* pStackInfo, Bool computeStackDepth);
+
+#endif /* SIM_TI_SYSBIOS_FAMILY_ARM_M3_HWI_H_ */
@@ -0,0 +1,22 @@
+/*
+ * Seconds.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_HAL_SECONDS_H_
+#define SIM_TI_SYSBIOS_HAL_SECONDS_H_
+
+#include <xdc/std.h>
+
+typedef struct Seconds_Time
+{
+    UInt32  secsHi;
+    UInt32  secs;
+    UInt32  nsecs;
+} Seconds_Time;
+
+void Seconds_getTime(Seconds_Time* pTime);
+
+#endif /* SIM_TI_SYSBIOS_HAL_SECONDS_H_ */
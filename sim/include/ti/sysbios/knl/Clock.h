@@ -0,0 +1,20 @@
+/*
+ * Clock.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_KNL_CLOCK_H_
+#define SIM_TI_SYSBIOS_KNL_CLOCK_H_
+
+#include <xdc/std.h>
+
+//
+// Clock.tickPeriod of multiSniff.syscfg
+//
+#define Clock_tickPeriod    (10)
+
+UInt32 Clock_getTicks(void);
+
+#endif /* SIM_TI_SYSBIOS_KNL_CLOCK_H_ */
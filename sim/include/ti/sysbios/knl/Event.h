@@ -0,0 +1,38 @@
+/*
+ * Event.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_KNL_EVENT_H_
+#define SIM_TI_SYSBIOS_KNL_EVENT_H_
+
+#include <xdc/std.h>
+
+#include <xdc/runtime/Error.h>
+
+typedef struct Event_Struct* Event_Handle;
+
+typedef struct Event_Params
+{
+    UInt    reserved;
+} Event_Params;
+
+#define Event_Id_NONE   (0)
+#define Event_Id_00     (0x1)
+#define Event_Id_01     (0x2)
+#define Event_Id_02     (0x4)
+#define Event_Id_03     (0x8)
+#define Event_Id_04     (0x10)
+#define Event_Id_05     (0x20)
+#define Event_Id_06     (0x40)
+#define Event_Id_07     (0x80)
+
+Event_Handle Event_create(const Event_Params* pParams, Error_Block* pEb);
+
+void         Event_post(Event_Handle handle, UInt eventId);
+
+UInt         Event_pend(Event_Handle handle, UInt andMask, UInt orMask, UInt32 timeout);
+
+#endif /* SIM_TI_SYSBIOS_KNL_EVENT_H_ */
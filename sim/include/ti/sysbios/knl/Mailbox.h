@@ -0,0 +1,30 @@
+/*
+ * Mailbox.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_KNL_MAILBOX_H_
+#define SIM_TI_SYSBIOS_KNL_MAILBOX_H_
+
+#include <xdc/std.h>
+
+#include <xdc/runtime/Error.h>
+
+typedef struct Mailbox_Struct* Mailbox_Handle;
+
+typedef struct Mailbox_Params
+{
+    UInt    reserved;
+} Mailbox_Params;
+
+Mailbox_Handle Mailbox_create(SizeT msgSize, UInt numMsgs, const Mailbox_Params* pParams, Error_Block* pEb);
+
+Bool           Mailbox_post(Mailbox_Handle handle, Ptr msg, UInt32 timeout);
+
+Bool           Mailbox_pend(Mailbox_Handle handle, Ptr msg, UInt32 timeout);
+
+Int            Mailbox_getNumPendingMsgs(Mailbox_Handle handle);
+
+#endif /* SIM_TI_SYSBIOS_KNL_MAILBOX_H_ */
@@ -0,0 +1,36 @@
+/*
+ * Semaphore.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_KNL_SEMAPHORE_H_
+#define SIM_TI_SYSBIOS_KNL_SEMAPHORE_H_
+
+#include <xdc/std.h>
+
+#include <xdc/runtime/Error.h>
+
+typedef struct Semaphore_Struct* Semaphore_Handle;
+
+typedef enum Semaphore_Mode
+{
+    Semaphore_Mode_COUNTING = 0,
+    Semaphore_Mode_BINARY
+} Semaphore_Mode;
+
+typedef struct Semaphore_Params
+{
+    Semaphore_Mode mode;
+} Semaphore_Params;
+
+void             Semaphore_Params_init(Semaphore_Params* pParams);
+
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params* pParams, Error_Block* pEb);
+
+Bool             Semaphore_pend(Semaphore_Handle handle, UInt32 timeout);
+
+void             Semaphore_post(Semaphore_Handle handle);
+
+#endif /* SIM_TI_SYSBIOS_KNL_SEMAPHORE_H_ */
@@ -0,0 +1,56 @@
+/*
+ * Task.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_KNL_TASK_H_
+#define SIM_TI_SYSBIOS_KNL_TASK_H_
+
+#include <xdc/std.h>
+
+#include <xdc/runtime/Error.h>
+
+typedef struct Task_Struct* Task_Handle;
+
+typedef void (*Task_FuncPtr)(UArg, UArg);
+
+typedef struct Task_Params
+{
+    UArg    arg0;
+    UArg    arg1;
+    Int     priority;
+    Ptr     stack;
+    SizeT   stackSize;
+} Task_Params;
+
+typedef struct Task_Stat
+{
+    Int     priority;
+    Ptr     stack;
+    SizeT   stackSize;
+    Ptr     stackHeap;
+    Ptr     env;
+    Int     mode;
+    Ptr     sp;
+    SizeT   used;
+} Task_Stat;
+
+void        Task_Params_init(Task_Params* pParams);
+
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params* pParams, Error_Block* pEb);
+
+Task_Handle Task_self(void);
+
+void        Task_yield(void);
+
+UInt        Task_disable(void);
+
+void        Task_restore(UInt key);
+
+void        Task_sleep(UInt32 ticks);
+
+void        Task_stat(Task_Handle handle, Task_Stat* pStat);
+
+#endif /* SIM_TI_SYSBIOS_KNL_TASK_H_ */
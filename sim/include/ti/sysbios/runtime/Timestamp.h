@@ -0,0 +1,23 @@
+/*
+ * Timestamp.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_RUNTIME_TIMESTAMP_H_
+#define SIM_TI_SYSBIOS_RUNTIME_TIMESTAMP_H_
+
+#include <xdc/std.h>
+
+typedef struct Types_FreqHz
+{
+    Bits32  hi;
+    Bits32  lo;
+} Types_FreqHz;
+
+UInt32 Timestamp_get32(void);
+
+void   Timestamp_getFreq(Types_FreqHz* pFreq);
+
+#endif /* SIM_TI_SYSBIOS_RUNTIME_TIMESTAMP_H_ */
@@ -0,0 +1,33 @@
+/*
+ * Load.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_TI_SYSBIOS_UTILS_LOAD_H_
+#define SIM_TI_SYSBIOS_UTILS_LOAD_H_
+
+#include <xdc/std.h>
+
+#include <ti/sysbios/knl/Task.h>
+
+typedef struct Load_Stat
+{
+    UInt32  threadTime;
+    UInt32  totalTime;
+} Load_Stat;
+
+void   Load_update(void);
+
+UInt32 Load_getCPULoad(void);
+
+Bool   Load_getTaskLoad(Task_Handle handle, Load_Stat* pStat);
+
+Bool   Load_getGlobalHwiLoad(Load_Stat* pStat);
+
+Bool   Load_getGlobalSwiLoad(Load_Stat* pStat);
+
+UInt32 Load_calculateLoad(Load_Stat* pStat);
+
+#endif /* SIM_TI_SYSBIOS_UTILS_LOAD_H_ */
@@ -0,0 +1,38 @@
+/*
+ * ti_drivers_config.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: indexes of the generated ti_drivers_config.h
+// (multiSniff.syscfg), defined in sim/drivers.c
+//
+
+#ifndef SIM_TI_DRIVERS_CONFIG_H_
+#define SIM_TI_DRIVERS_CONFIG_H_
+
+#include <stdint.h>
+
+extern const uint_least8_t CONFIG_GPIO_W5500_RESET_CONST;
+#define CONFIG_GPIO_W5500_RESET 25
+
+extern const uint_least8_t CONFIG_GPIO_W5500_CS_CONST;
+#define CONFIG_GPIO_W5500_CS    26
+
+extern const uint_least8_t CONFIG_GPIO_W5500_INT_CONST;
+#define CONFIG_GPIO_W5500_INT   5
+
+extern const uint_least8_t CONFIG_I2C_0_CONST;
+#define CONFIG_I2C_0            0
+
+extern const uint_least8_t CONFIG_SPI_0_CONST;
+#define CONFIG_SPI_0            0
+
+extern const uint_least8_t CONFIG_NVS_SETTINGS_CONST;
+#define CONFIG_NVS_SETTINGS     0
+
+extern void Board_init(void);
+
+#endif /* SIM_TI_DRIVERS_CONFIG_H_ */
@@ -0,0 +1,125 @@
+/*
+ * ti_radio_config.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: radio commands of the generated ti_radio_config.h,
+// only the members multiSniff touches. Defined in sim/rf.c.
+//
+
+#ifndef SIM_TI_RADIO_CONFIG_H_
+#define SIM_TI_RADIO_CONFIG_H_
+
+#include <ti/drivers/rf/RF.h>
+
+#include DeviceFamily_constructPath(driverlib/rf_mailbox.h)
+
+#include DeviceFamily_constructPath(driverlib/rf_data_entry.h)
+
+typedef struct rfc_bleGenericRxOutput_s
+{
+    uint16_t nRxOk;
+    uint16_t nRxNok;
+    uint16_t nRxIgnored;
+    uint16_t nRxBufFull;
+    int8_t   lastRssi;
+    uint32_t timeStamp;
+} rfc_bleGenericRxOutput_t;
+
+typedef struct rfc_ieeeRxOutput_s
+{
+    uint8_t  nTxAck;
+    uint8_t  nRxBeacon;
+    uint8_t  nRxData;
+    uint8_t  nRxAck;
+    uint8_t  nRxMacCmd;
+    uint8_t  nRxReserved;
+    uint8_t  nRxNok;
+    uint8_t  nRxIgnored;
+    uint8_t  nRxBufFull;
+    int8_t   lastRssi;
+    int8_t   maxRssi;
+    ratmr_t  beaconTimeStamp;
+} rfc_ieeeRxOutput_t;
+
+typedef struct rfc_bleGenericRxPar_s
+{
+    dataQueue_t* pRxQ;
+    struct
+    {
+        uint8_t bAutoFlushIgnored:1;
+        uint8_t bAutoFlushCrcErr:1;
+        uint8_t :1;
+        uint8_t bIncludeLenByte:1;
+        uint8_t bIncludeCrc:1;
+        uint8_t bAppendRssi:1;
+        uint8_t bAppendStatus:1;
+        uint8_t bAppendTimestamp:1;
+    } rxConfig;
+    uint8_t      bRepeat;
+    uint16_t     __dummy0;
+    uint32_t     accessAddress;
+} rfc_bleGenericRxPar_t;
+
+typedef struct rfc_CMD_BLE5_GENERIC_RX_s
+{
+    uint16_t                  commandNo;
+    uint16_t                  status;
+    uint8_t                   channel;
+    struct
+    {
+        uint8_t init:7;
+        uint8_t bOverride:1;
+    } whitening;
+    rfc_bleGenericRxPar_t*    pParams;
+    rfc_bleGenericRxOutput_t* pOutput;
+} rfc_CMD_BLE5_GENERIC_RX_t;
+
+typedef struct rfc_CMD_IEEE_RX_s
+{
+    uint16_t            commandNo;
+    uint16_t            status;
+    uint8_t             channel;
+    struct
+    {
+        uint8_t bAutoFlushCrc:1;
+        uint8_t bAutoFlushIgn:1;
+        uint8_t bIncludePhyHdr:1;
+        uint8_t bIncludeCrc:1;
+        uint8_t bAppendRssi:1;
+        uint8_t bAppendCorrCrc:1;
+        uint8_t bAppendSrcInd:1;
+        uint8_t bAppendTimestamp:1;
+    } rxConfig;
+    dataQueue_t*        pRxQ;
+    rfc_ieeeRxOutput_t* pOutput;
+} rfc_CMD_IEEE_RX_t;
+
+typedef struct rfc_CMD_FS_s
+{
+    uint16_t commandNo;
+    uint16_t status;
+    uint16_t frequency;
+    uint16_t fractFreq;
+} rfc_CMD_FS_t;
+
+typedef struct rfc_CMD_RADIO_SETUP_s
+{
+    uint16_t commandNo;
+    uint16_t status;
+} rfc_CMD_RADIO_SETUP_t;
+
+extern RF_Mode                   RFCMD_bleModeObject;
+extern RF_RadioSetup             RFCMD_bleRadioSetup;
+extern rfc_CMD_FS_t              RFCMD_bleFrequencySynthesizer;
+extern rfc_CMD_BLE5_GENERIC_RX_t RFCMD_bleGenericRX;
+
+extern RF_Mode                   RFCMD_ieeeModeObject;
+extern RF_RadioSetup             RFCMD_ieeeRadioSetup;
+extern rfc_CMD_FS_t              RFCMD_ieeeFrequencySynthesizer;
+extern rfc_CMD_IEEE_RX_t         RFCMD_ieeeRX;
+
+#endif /* SIM_TI_RADIO_CONFIG_H_ */
@@ -0,0 +1,20 @@
+/*
+ * Error.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_XDC_RUNTIME_ERROR_H_
+#define SIM_XDC_RUNTIME_ERROR_H_
+
+#include <xdc/std.h>
+
+typedef struct Error_Block
+{
+    UInt16 id;
+} Error_Block;
+
+#define Error_IGNORE    ((Error_Block*)NULL)
+
+#endif /* SIM_XDC_RUNTIME_ERROR_H_ */
@@ -0,0 +1,13 @@
+/*
+ * Memory.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_XDC_RUNTIME_MEMORY_H_
+#define SIM_XDC_RUNTIME_MEMORY_H_
+
+#include <xdc/std.h>
+
+#endif /* SIM_XDC_RUNTIME_MEMORY_H_ */
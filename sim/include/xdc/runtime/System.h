@@ -0,0 +1,18 @@
+/*
+ * System.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_XDC_RUNTIME_SYSTEM_H_
+#define SIM_XDC_RUNTIME_SYSTEM_H_
+
+#include <xdc/std.h>
+
+//
+// Printed to stderr when SIM_VERBOSE is set in the environment
+//
+int System_printf(const char* pFormat, ...);
+
+#endif /* SIM_XDC_RUNTIME_SYSTEM_H_ */
@@ -0,0 +1,37 @@
+/*
+ * std.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: XDC base types of the TI-RTOS7 kernel headers
+//
+
+#ifndef SIM_XDC_STD_H_
+#define SIM_XDC_STD_H_
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <stddef.h>
+
+typedef uintptr_t   UArg;
+typedef int         Int;
+typedef unsigned    UInt;
+typedef int32_t     Int32;
+typedef uint32_t    UInt32;
+typedef uint16_t    UInt16;
+typedef uint8_t     UInt8;
+typedef uint32_t    Bits32;
+typedef size_t      SizeT;
+typedef bool        Bool;
+typedef char        Char;
+typedef void*       Ptr;
+
+#define TRUE        (1)
+#define FALSE       (0)
+
+#endif /* SIM_XDC_STD_H_ */
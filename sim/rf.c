@@ -0,0 +1,445 @@
+/*
+ * rf.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: TI RF driver and the RF Core behind it. Posted RX
+// command stays active until flushed, frames handed to SimRf_Inject()
+// are written into the data queue of the command the way RF Core
+// writes them (length prefix, frame, appended RSSI and RAT timestamp).
+// Every stored frame runs the callback of the command as Swi with
+// RF_EventRxEntryDone. When the next entry is not free, RX ends with
+// RF_EventRxBufFull and the callback runs as well.
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+
+#include <string.h>
+
+#include "ti_radio_config.h"
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define RAT_TICKS_PER_US        (4)
+
+#define CMD_BLE5_GENERIC_RX     (0x1829)
+#define CMD_IEEE_RX             (0x2801)
+#define CMD_FS                  (0x0803)
+
+//
+// IEEE 802.15.4 frame types (frame control, bits 0..2)
+//
+#define IEEE_FRAME_BEACON       (0)
+#define IEEE_FRAME_DATA         (1)
+#define IEEE_FRAME_MAC_CMD      (3)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct SimRf_Rx
+{
+    RF_Handle    handle;
+    RF_Op*       pOp;
+    RF_CmdHandle cmdHandle;
+    RF_Callback  callback;
+    RF_EventMask events;
+} SimRf_Rx_t;
+
+typedef struct SimRf_Overflow
+{
+    SimRf_Rx_t   rx;
+} SimRf_Overflow_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+RF_Mode                   RFCMD_bleModeObject  = { .rfMode = 0x01 };
+
+RF_RadioSetup             RFCMD_bleRadioSetup;
+
+rfc_CMD_FS_t              RFCMD_bleFrequencySynthesizer = { .commandNo = CMD_FS, .frequency = 2402 };
+
+static rfc_bleGenericRxPar_t bleGenericRxPar;
+
+rfc_CMD_BLE5_GENERIC_RX_t RFCMD_bleGenericRX = { .commandNo = CMD_BLE5_GENERIC_RX, .pParams = &bleGenericRxPar };
+
+RF_Mode                   RFCMD_ieeeModeObject = { .rfMode = 0x02 };
+
+RF_RadioSetup             RFCMD_ieeeRadioSetup;
+
+rfc_CMD_FS_t              RFCMD_ieeeFrequencySynthesizer = { .commandNo = CMD_FS, .frequency = 2405 };
+
+rfc_CMD_IEEE_RX_t         RFCMD_ieeeRX = { .commandNo = CMD_IEEE_RX };
+
+static pthread_mutex_t    rfLock = PTHREAD_MUTEX_INITIALIZER;
+
+static SimRf_Rx_t         rx;
+
+static RF_CmdHandle       nextCmdHandle;
+
+static uint32_t           dropped;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint32_t ratNow(void)
+{
+    return (uint32_t)( Sim_GetNanos() * RAT_TICKS_PER_US / 1000 );
+}
+
+static void runOverflow(void* pArg)
+{
+    SimRf_Overflow_t* pOverflow = (SimRf_Overflow_t*)pArg;
+
+    pOverflow->rx.callback(pOverflow->rx.handle, pOverflow->rx.cmdHandle, RF_EventRxBufFull);
+
+    return;
+}
+
+static void runEntryDone(void* pArg)
+{
+    SimRf_Rx_t* pRx = (SimRf_Rx_t*)pArg;
+
+    pRx->callback(pRx->handle, pRx->cmdHandle, RF_EventRxEntryDone);
+
+    return;
+}
+
+/*
+ * === currentEntry
+ * Entry RF Core writes next, NULL when no RX is active. Called
+ * with rfLock held.
+ */
+static rfc_dataEntryGeneral_t* currentEntry(dataQueue_t** ppQueue)
+{
+    dataQueue_t* pQueue;
+
+    if ( rx.pOp == NULL )
+    {
+        return NULL;
+    }
+
+    pQueue = ( rx.pOp->commandNo == CMD_IEEE_RX ) ? RFCMD_ieeeRX.pRxQ : RFCMD_bleGenericRX.pParams->pRxQ;
+
+    if ( ppQueue != NULL )
+    {
+        *ppQueue = pQueue;
+    }
+
+    return (rfc_dataEntryGeneral_t*)pQueue->pCurrEntry;
+}
+
+static void countIeee(const uint8_t* pFrame, uint16_t len, int8_t rssi)
+{
+    rfc_ieeeRxOutput_t* pOutput = RFCMD_ieeeRX.pOutput;
+
+    if ( pOutput == NULL )
+    {
+        return;
+    }
+
+    switch ( ( len > 0 ) ? ( pFrame[0] & 0x07 ) : 0xFF )
+    {
+    case IEEE_FRAME_BEACON:
+        pOutput->nRxBeacon++;
+        break;
+
+    case IEEE_FRAME_DATA:
+        pOutput->nRxData++;
+        break;
+
+    case IEEE_FRAME_MAC_CMD:
+        pOutput->nRxMacCmd++;
+        break;
+
+    default:
+        pOutput->nRxReserved++;
+        break;
+    }
+
+    pOutput->lastRssi = rssi;
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void RF_Params_init(RF_Params* pParams)
+{
+    pParams->nInactivityTimeout = 0;
+
+    return;
+}
+
+RF_Handle RF_open(RF_Object* pObj, RF_Mode* pRfMode, RF_RadioSetup* pOpSetup, RF_Params* pParams)
+{
+    (void)pOpSetup;
+    (void)pParams;
+
+    pObj->pMode = pRfMode;
+    pObj->bOpen = true;
+
+    return pObj;
+}
+
+void RF_close(RF_Handle h)
+{
+    pthread_mutex_lock(&rfLock);
+
+    if ( rx.handle == h )
+    {
+        rx.pOp = NULL;
+    }
+
+    h->bOpen = false;
+
+    pthread_mutex_unlock(&rfLock);
+
+    return;
+}
+
+/*
+ * === RF_postCmd
+ * Frequency synthesizer completes right away, RX stays active
+ * (one RX command at a time, as multiSniff posts them).
+ */
+RF_CmdHandle RF_postCmd(RF_Handle h, RF_Op* pOp, RF_Priority ePri, RF_Callback pCb, RF_EventMask bmEvent)
+{
+    RF_CmdHandle cmdHandle;
+
+    (void)ePri;
+
+    pthread_mutex_lock(&rfLock);
+
+    cmdHandle = nextCmdHandle++;
+
+    if ( pOp->commandNo == CMD_FS )
+    {
+        pOp->status = DONE_OK;
+    }
+    else
+    {
+        pOp->status   = ACTIVE;
+
+        rx.handle     = h;
+        rx.pOp        = pOp;
+        rx.cmdHandle  = cmdHandle;
+        rx.callback   = pCb;
+        rx.events     = bmEvent;
+    }
+
+    pthread_mutex_unlock(&rfLock);
+
+    return cmdHandle;
+}
+
+RF_Stat RF_flushCmd(RF_Handle h, RF_CmdHandle ch, uint8_t mode)
+{
+    (void)ch;
+    (void)mode;
+
+    pthread_mutex_lock(&rfLock);
+
+    if ( rx.pOp != NULL && rx.handle == h )
+    {
+        rx.pOp->status = DONE_STOPPED;
+        rx.pOp         = NULL;
+    }
+
+    pthread_mutex_unlock(&rfLock);
+
+    return RF_StatSuccess;
+}
+
+uint32_t RF_getCurrentTime(void)
+{
+    return ratNow();
+}
+
+/*
+ * === SimRf_CanReceive
+ * True when RX is active and the entry RF Core writes next is
+ * free: SimRf_Inject() will not overflow the queue.
+ */
+bool SimRf_CanReceive(void)
+{
+    rfc_dataEntryGeneral_t* pEntry;
+    bool                    bFree;
+
+    pthread_mutex_lock(&rfLock);
+
+    pEntry = currentEntry(NULL);
+
+    bFree = ( pEntry != NULL ) && ( __atomic_load_n(&pEntry->status, __ATOMIC_ACQUIRE) == DATA_ENTRY_PENDING );
+
+    pthread_mutex_unlock(&rfLock);
+
+    return bFree;
+}
+
+/*
+ * === SimRf_Inject
+ * Receives one frame: BLE as the PDU with length byte and CRC,
+ * IEEE as the MPDU with FCS. RAT timestamp is the start of the
+ * frame, airtime before now.
+ *
+ * Parameters:
+ *      pFrame[in]      - the frame
+ *      len[in]         - length of the frame
+ *      rssi[in]        - appended when the command asks for it
+ * Returns:
+ *      false when the frame was lost: RX not active, entry too
+ *      short, or queue full (RX ends, overflow callback runs)
+ */
+bool SimRf_Inject(const uint8_t* pFrame, uint16_t len, int8_t rssi)
+{
+    static SimRf_Overflow_t overflow;
+    SimRf_Rx_t              done;
+    rfc_dataEntryGeneral_t* pEntry;
+    dataQueue_t*            pQueue;
+    uint8_t*                pData;
+    bool                    bBle;
+    bool                    bRssi;
+    bool                    bTimestamp;
+    uint16_t                total;
+    uint32_t                airtimeUs;
+    uint32_t                ratStart;
+
+    pthread_mutex_lock(&rfLock);
+
+    pEntry = currentEntry(&pQueue);
+
+    if ( pEntry == NULL )
+    {
+        dropped++;
+
+        pthread_mutex_unlock(&rfLock);
+
+        return false;
+    }
+
+    bBle       = ( rx.pOp->commandNo == CMD_BLE5_GENERIC_RX );
+    bRssi      = bBle ? RFCMD_bleGenericRX.pParams->rxConfig.bAppendRssi      : RFCMD_ieeeRX.rxConfig.bAppendRssi;
+    bTimestamp = bBle ? RFCMD_bleGenericRX.pParams->rxConfig.bAppendTimestamp : RFCMD_ieeeRX.rxConfig.bAppendTimestamp;
+    total      = len + ( bRssi ? 1 : 0 ) + ( bTimestamp ? 4 : 0 );
+
+    ///////////////////////////
+    // Queue full:
+    // RX ends, the driver calls back
+    //
+    if ( __atomic_load_n(&pEntry->status, __ATOMIC_ACQUIRE) != DATA_ENTRY_PENDING )
+    {
+        dropped++;
+
+        if ( bBle && RFCMD_bleGenericRX.pOutput != NULL )
+        {
+            RFCMD_bleGenericRX.pOutput->nRxBufFull++;
+        }
+        else if ( !bBle && RFCMD_ieeeRX.pOutput != NULL )
+        {
+            RFCMD_ieeeRX.pOutput->nRxBufFull++;
+        }
+
+        rx.pOp->status = ERROR_RXBUF;
+        rx.pOp         = NULL;
+        overflow.rx    = rx;
+
+        pthread_mutex_unlock(&rfLock);
+
+        if ( overflow.rx.callback != NULL && ( overflow.rx.events & RF_EventRxBufFull ) )
+        {
+            Sim_RunSwi(runOverflow, &overflow);
+        }
+
+        return false;
+    }
+
+    if ( total + pEntry->config.lenSz > pEntry->length )
+    {
+        dropped++;
+
+        pthread_mutex_unlock(&rfLock);
+
+        return false;
+    }
+
+    ///////////////////////////
+    // Entry:
+    // [length, lenSz bytes][frame][RSSI][RAT timestamp]
+    //
+    airtimeUs = bBle ? ( 4 + len ) * 8 : ( 1 + len ) * 32;
+    ratStart  = ratNow() - airtimeUs * RAT_TICKS_PER_US;
+
+    pData = (uint8_t*)pEntry + offsetof(rfc_dataEntryGeneral_t, data);
+
+    pData[0] = (uint8_t)total;
+    pData[1] = (uint8_t)( total >> 8 );
+    pData   += pEntry->config.lenSz;
+
+    memcpy(pData, pFrame, len);
+    pData += len;
+
+    if ( bRssi )
+    {
+        *pData++ = (uint8_t)rssi;
+    }
+
+    if ( bTimestamp )
+    {
+        memcpy(pData, &ratStart, sizeof(ratStart));
+    }
+
+    if ( bBle && RFCMD_bleGenericRX.pOutput != NULL )
+    {
+        RFCMD_bleGenericRX.pOutput->nRxOk++;
+        RFCMD_bleGenericRX.pOutput->lastRssi  = rssi;
+        RFCMD_bleGenericRX.pOutput->timeStamp = ratStart;
+    }
+    else if ( !bBle )
+    {
+        countIeee(pFrame, len, rssi);
+    }
+
+    __atomic_store_n(&pEntry->status, DATA_ENTRY_FINISHED, __ATOMIC_RELEASE);
+
+    pQueue->pCurrEntry = pEntry->pNextEntry;
+
+    done = rx;
+
+    pthread_mutex_unlock(&rfLock);
+
+    if ( done.callback != NULL && ( done.events & RF_EventRxEntryDone ) )
+    {
+        Sim_RunSwi(runEntryDone, &done);
+    }
+
+    return true;
+}
+
+uint32_t SimRf_GetDropped(void)
+{
+    return dropped;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,188 @@
+/*
+ * sim.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SIM_SIM_H_
+#define SIM_SIM_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <stddef.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Fixed target addresses the firmware dereferences, mapped at
+// the same addresses by Sim_Init():
+//      flash   - factory page (0x50000), HTML template (0x51000)
+//      SRAM    - MTU buffer (0x20012000)
+//      SCS     - DWT and DEMCR, written by Trace_Init()
+//
+#define SIM_FLASH_BASE          (0x50000)
+#define SIM_FLASH_SIZE          (0x4000)
+#define SIM_SRAM_BASE           (0x20012000)
+#define SIM_SRAM_SIZE           (0x1000)
+#define SIM_DWT_BASE            (0xE0001000)
+#define SIM_SCS_BASE            (0xE000E000)
+#define SIM_SCS_SIZE            (0x1000)
+
+#define SIM_CPU_HZ              (48000000)
+
+/*
+ * === SIM_SPI_CYCLES_*
+ * Cost annotation of the W5500 model in CPU cycles (48 MHz) for
+ * the SPI link of the target (12 MHz, byte-wise SPI_transfer()):
+ *      BYTE     - 8 bit times on the bus
+ *      TRANSFER - SPI_transfer() of a byte: driver entry, polled
+ *                 SSI FIFO, return (estimate)
+ *      CS       - one GPIO_write() of the CS line (estimate)
+ * Estimates are meant to be replaced by GET /api/spi of a target
+ * built with SPI_PROFILE (busy time divided by bytes, frames).
+ */
+#define SIM_SPI_CYCLES_BYTE     (SIM_CPU_HZ / 12000000 * 8)
+#define SIM_SPI_CYCLES_TRANSFER (160)
+#define SIM_SPI_CYCLES_CS       (40)
+
+//
+// Check of the unit tests (test_*.c): counts, reports a failed
+// expression with its location and carries on
+//
+#define TEST_CHECK(expr)        Test_Check((expr), #expr, __FILE__, __LINE__)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct SimW5500_Counters
+{
+    uint64_t frames;            // CS assertions
+    uint64_t transfers;         // SPI_transfer() calls
+    uint64_t bytes;
+    uint64_t cycles;            // SIM_SPI_CYCLES_* annotation
+    uint64_t sends;             // Sn_CR SEND commands
+} SimW5500_Counters_t;
+
+typedef struct SimSsd1306_Counters
+{
+    uint64_t transfers;         // I2C write transfers
+    uint64_t bytes;             // on the bus, slave address included
+    uint64_t dataBytes;         // written into display RAM
+    uint64_t ns;                // bus time at 400 kHz
+} SimSsd1306_Counters_t;
+
+/*
+ * === SimW5500_Sink_t
+ * Called for every SEND the firmware issues, with the model
+ * locked: must not call back into the model.
+ */
+typedef void (*SimW5500_Sink_t)(uint8_t sock, bool bUdp, const uint8_t* pDstIp, uint16_t dstPort,
+                                const uint8_t* pData, uint16_t len);
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+//
+// sim/tirtos.c
+//
+void     Sim_Init(void);
+
+uint32_t Sim_GetCycles(void);
+
+uint64_t Sim_GetNanos(void);
+
+void     Sim_Enter(void);
+
+void     Sim_Leave(void);
+
+void     Sim_RunHwi(void (*fxn)(void));
+
+void     Sim_RunSwi(void (*fxn)(void* pArg), void* pArg);
+
+//
+// sim/drivers.c
+//
+void     Sim_MapTarget(void);
+
+bool     Sim_LoadFlash(const char* pPath, uint32_t address);
+
+void     SimGpio_SetInt(bool bAsserted);
+
+uint8_t* SimNvs_GetMemory(void);
+
+void     SimNvs_CutPower(uint32_t bytes);
+
+void     SimNvs_RestorePower(void);
+
+uint32_t SimNvs_GetErases(void);
+
+//
+// sim/rf.c
+//
+bool     SimRf_CanReceive(void);
+
+bool     SimRf_Inject(const uint8_t* pFrame, uint16_t len, int8_t rssi);
+
+uint32_t SimRf_GetDropped(void);
+
+//
+// sim/w5500_model.c
+//
+void     SimW5500_Reset(void);
+
+void     SimW5500_Select(bool bSelected);
+
+void     SimW5500_Transfer(const uint8_t* pTx, uint8_t* pRx, size_t count);
+
+void     SimW5500_SetSink(SimW5500_Sink_t sink);
+
+void     SimW5500_GetCounters(SimW5500_Counters_t* pCounters);
+
+int      SimW5500_FindSocket(uint8_t status, uint16_t port);
+
+bool     SimW5500_Connect(uint8_t sock, const uint8_t* pPeerIp, uint16_t peerPort);
+
+uint16_t SimW5500_Push(uint8_t sock, const uint8_t* pData, uint16_t len);
+
+bool     SimW5500_PushUdp(uint16_t port, const uint8_t* pSrcIp, uint16_t srcPort, const uint8_t* pData, uint16_t len);
+
+void     SimW5500_PeerClose(uint8_t sock);
+
+uint8_t  SimW5500_GetStatus(uint8_t sock);
+
+//
+// sim/ssd1306_model.c
+//
+void     SimSsd1306_Write(const uint8_t* pData, size_t count);
+
+void     SimSsd1306_GetCounters(SimSsd1306_Counters_t* pCounters);
+
+const uint8_t* SimSsd1306_GetRam(void);
+
+//
+// sim/bridge.c
+//
+void     SimBridge_Start(uint16_t httpPort);
+
+//
+// sim/test.c
+//
+void     Test_Check(bool bOk, const char* pExpr, const char* pFile, int line);
+
+int      Test_Finish(const char* pName);
+
+// ==============================================================================================================
+
+#endif /* SIM_SIM_H_ */
@@ -0,0 +1,258 @@
+/*
+ * ssd1306_model.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: SSD1306 (128x64) behind I2C. Control bytes, the
+// commands which move the RAM pointer (addressing mode, column and
+// page address) and the display RAM are modelled, other commands are
+// only skipped with their arguments. A command and its arguments may
+// come in separate transfers, as the init sequence sends them. Every
+// transfer is counted with its bus time at 400 kHz.
+//
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define PAGES                   (8)
+#define COLUMNS                 (128)
+
+//
+// Control byte: [Co][D/C][000000]
+//
+#define CONTROL_CO              (0x80)
+#define CONTROL_DC              (0x40)
+
+#define CMD_ADDR_MODE           (0x20)
+#define CMD_COLUMN_ADDR         (0x21)
+#define CMD_PAGE_ADDR           (0x22)
+
+#define MODE_HORIZONTAL         (0x00)
+#define MODE_VERTICAL           (0x01)
+#define MODE_PAGE               (0x02)
+
+//
+// Bit times of a transfer: start, address and every byte
+// with its ACK, stop
+//
+#define BITS_PER_BYTE           (9)
+#define BITS_START_STOP         (2)
+#define NS_PER_BIT              (2500)
+
+#define MAX_ARGS                (2)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static uint8_t  ram[PAGES * COLUMNS];
+
+static uint8_t  mode = MODE_PAGE;
+
+static uint8_t  colStart;
+static uint8_t  colEnd  = COLUMNS - 1;
+static uint8_t  pageStart;
+static uint8_t  pageEnd = PAGES - 1;
+
+static uint8_t  col;
+static uint8_t  page;
+
+//
+// Command waiting for its arguments
+//
+static uint8_t  command;
+static uint8_t  args[MAX_ARGS];
+static uint8_t  argsHave;
+static uint8_t  argsNeed;
+
+static SimSsd1306_Counters_t counters;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint8_t argumentCount(uint8_t cmd)
+{
+    switch ( cmd )
+    {
+    case CMD_COLUMN_ADDR:
+    case CMD_PAGE_ADDR:
+        return 2;
+
+    case CMD_ADDR_MODE:
+    case 0x81:                      // contrast
+    case 0x8D:                      // charge pump
+    case 0xA8:                      // multiplex ratio
+    case 0xD3:                      // display offset
+    case 0xD5:                      // oscillator
+    case 0xD9:                      // precharge
+    case 0xDA:                      // COM pins
+    case 0xDB:                      // VCOMH
+        return 1;
+
+    default:
+        return 0;
+    }
+}
+
+static void execute(void)
+{
+    switch ( command )
+    {
+    case CMD_ADDR_MODE:
+        mode = args[0] & 0x03;
+        break;
+
+    case CMD_COLUMN_ADDR:
+        colStart = args[0] & ( COLUMNS - 1 );
+        colEnd   = args[1] & ( COLUMNS - 1 );
+        col      = colStart;
+        break;
+
+    case CMD_PAGE_ADDR:
+        pageStart = args[0] & ( PAGES - 1 );
+        pageEnd   = args[1] & ( PAGES - 1 );
+        page      = pageStart;
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+static void writeCommand(uint8_t value)
+{
+    if ( argsHave < argsNeed )
+    {
+        args[argsHave++] = value;
+    }
+    else
+    {
+        command  = value;
+        argsHave = 0;
+        argsNeed = argumentCount(value);
+    }
+
+    if ( argsHave == argsNeed )
+    {
+        execute();
+    }
+
+    return;
+}
+
+static void writeData(uint8_t value)
+{
+    ram[page * COLUMNS + col] = value;
+
+    counters.dataBytes++;
+
+    if ( mode == MODE_PAGE )
+    {
+        col = ( col + 1 ) & ( COLUMNS - 1 );
+    }
+    else if ( mode == MODE_HORIZONTAL )
+    {
+        if ( col == colEnd )
+        {
+            col  = colStart;
+            page = ( page == pageEnd ) ? pageStart : page + 1;
+        }
+        else
+        {
+            col++;
+        }
+    }
+    else
+    {
+        if ( page == pageEnd )
+        {
+            page = pageStart;
+            col  = ( col == colEnd ) ? colStart : col + 1;
+        }
+        else
+        {
+            page++;
+        }
+    }
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === SimSsd1306_Write
+ * One I2C write transfer addressed to the display: control byte,
+ * then commands or data, control bytes again while Co is set.
+ */
+void SimSsd1306_Write(const uint8_t* pData, size_t count)
+{
+    size_t  i = 0;
+    uint8_t control;
+
+    counters.transfers++;
+    counters.bytes += count + 1;
+    counters.ns    += (uint64_t)( ( count + 1 ) * BITS_PER_BYTE + BITS_START_STOP ) * NS_PER_BIT;
+
+    while ( i < count )
+    {
+        control = pData[i++];
+
+        if ( control & CONTROL_CO )
+        {
+            if ( i < count )
+            {
+                ( control & CONTROL_DC ) ? writeData(pData[i]) : writeCommand(pData[i]);
+
+                i++;
+            }
+
+            continue;
+        }
+
+        for ( ; i < count; i++ )
+        {
+            ( control & CONTROL_DC ) ? writeData(pData[i]) : writeCommand(pData[i]);
+        }
+    }
+
+    return;
+}
+
+void SimSsd1306_GetCounters(SimSsd1306_Counters_t* pCounters)
+{
+    *pCounters = counters;
+
+    return;
+}
+
+/*
+ * === SimSsd1306_GetRam
+ * Display RAM, page by page (128 bytes each), the layout of the
+ * firmware's LCD buffer.
+ */
+const uint8_t* SimSsd1306_GetRam(void)
+{
+    return ram;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,62 @@
+/*
+ * test.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: checks shared by the unit tests (test_*.c). Every
+// test is a program of its own linked with the firmware and the models,
+// run by make test, and exits non-zero when a check failed.
+//
+
+// === INCLUDES =================================================================================================
+
+#include <stdio.h>
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static uint32_t checks;
+
+static uint32_t failures;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Test_Check
+ * Called through TEST_CHECK().
+ */
+void Test_Check(bool bOk, const char* pExpr, const char* pFile, int line)
+{
+    checks++;
+
+    if ( !bOk )
+    {
+        failures++;
+        printf("%s:%d: check failed: %s\n", pFile, line, pExpr);
+    }
+
+    return;
+}
+
+/*
+ * === Test_Finish
+ * Prints the result of the test, returned value is the exit status.
+ */
+int Test_Finish(const char* pName)
+{
+    printf("%-24s %u checks, %u failed\n", pName, checks, failures);
+
+    return ( failures == 0 ) ? 0 : 1;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,415 @@
+/*
+ * test_config_store.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: unit test of the persistent config store
+// (config_store.c) against the NVS model of drivers.c, which keeps
+// flash semantics (a write only clears bits, erase per sector). A
+// reboot is ConfigStore_Init() over the same flash. Covers commit and
+// load, wear leveling over both sectors, power loss at every byte of
+// a commit (sector change included) and corrupted records, and
+// reports boot scan and commit time on the host.
+//
+
+// === INCLUDES =================================================================================================
+
+#include <stdio.h>
+
+#include <string.h>
+
+#include "ti_drivers_config.h"
+
+#include "sim.h"
+
+#include <source/config/config_store.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// CONFIG_NVS_SETTINGS of drivers.c
+//
+#define REGION_SIZE             (0x4000)
+
+#define SECTOR_SIZE             (0x2000)
+
+//
+// Layout of config_store.c: sector header, record header
+// (ConfigStore_Record_t), its last field is the commit word
+// programmed again once the payload is written
+//
+#define SECTOR_HEADER_SIZE      (8)
+
+#define RECORD_HEADER_SIZE      (20)
+
+#define COMMIT_SIZE             (4)
+
+#define IMAGE_SIZE              (40)
+
+#define IMAGE_VERSION           (1)
+
+#define RECORD_SIZE             ( RECORD_HEADER_SIZE + IMAGE_SIZE )
+
+#define RECORDS_PER_SECTOR      ( ( SECTOR_SIZE - SECTOR_HEADER_SIZE ) / RECORD_SIZE )
+
+//
+// Bytes programmed by a commit which starts a new sector
+//
+#define COMMIT_BYTES_MAX        ( SECTOR_HEADER_SIZE + RECORD_SIZE + COMMIT_SIZE )
+
+#define WEAR_COMMITS            (10000)
+
+#define BENCH_BOOTS             (10000)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static uint8_t saved[REGION_SIZE];
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static void fillImage(uint8_t* pImage, uint32_t n)
+{
+    uint16_t i;
+
+    for ( i = 0; i < IMAGE_SIZE; i++ )
+    {
+        pImage[i] = (uint8_t)( n * 7 + i * 13 + ( n >> 8 ) );
+    }
+
+    return;
+}
+
+static void eraseFlash(void)
+{
+    memset(SimNvs_GetMemory(), 0xFF, REGION_SIZE);
+
+    return;
+}
+
+/*
+ * === loads
+ * Boots the store and checks that image n is the latest one.
+ */
+static bool loads(uint32_t n)
+{
+    uint8_t  image[IMAGE_SIZE], expected[IMAGE_SIZE];
+    uint16_t len, version;
+
+    fillImage(expected, n);
+
+    return ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_OK
+        && ConfigStore_Load(image, sizeof(image), &len, &version) == CONFIG_STORE_OK
+        && len == IMAGE_SIZE && version == IMAGE_VERSION
+        && memcmp(image, expected, IMAGE_SIZE) == 0;
+}
+
+static ConfigStore_Status_t commit(uint32_t n)
+{
+    uint8_t image[IMAGE_SIZE];
+
+    fillImage(image, n);
+
+    return ConfigStore_Commit(image, IMAGE_SIZE, IMAGE_VERSION);
+}
+
+static void testCommit(void)
+{
+    uint8_t  image[CONFIG_STORE_MAX_PAYLOAD + 1];
+    uint16_t len, version;
+
+    eraseFlash();
+
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_EMPTY);
+    TEST_CHECK(ConfigStore_Load(image, sizeof(image), &len, &version) == CONFIG_STORE_EMPTY);
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS + 1) == CONFIG_STORE_FLASH_ERROR);
+    TEST_CHECK(ConfigStore_Commit(image, IMAGE_SIZE, IMAGE_VERSION) == CONFIG_STORE_FLASH_ERROR);
+
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_EMPTY);
+    TEST_CHECK(commit(1) == CONFIG_STORE_OK);
+    TEST_CHECK(loads(1));
+    TEST_CHECK(ConfigStore_GetSequence() == 0);
+
+    TEST_CHECK(commit(2) == CONFIG_STORE_OK);
+    TEST_CHECK(loads(2));
+    TEST_CHECK(ConfigStore_GetSequence() == 1);
+
+    //
+    // Unchanged image writes nothing, another version does
+    //
+    memcpy(saved, SimNvs_GetMemory(), REGION_SIZE);
+
+    TEST_CHECK(commit(2) == CONFIG_STORE_OK);
+    TEST_CHECK(memcmp(saved, SimNvs_GetMemory(), REGION_SIZE) == 0);
+
+    fillImage(image, 2);
+    TEST_CHECK(ConfigStore_Commit(image, IMAGE_SIZE, IMAGE_VERSION + 1) == CONFIG_STORE_OK);
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_OK);
+    TEST_CHECK(ConfigStore_Load(image, sizeof(image), &len, &version) == CONFIG_STORE_OK);
+    TEST_CHECK(version == IMAGE_VERSION + 1);
+    TEST_CHECK(ConfigStore_GetSequence() == 2);
+
+    //
+    // Sizes: empty image, largest image, too large
+    // for the store and for the caller's buffer
+    //
+    TEST_CHECK(ConfigStore_Commit(image, 0, IMAGE_VERSION) == CONFIG_STORE_OK);
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_OK);
+    TEST_CHECK(ConfigStore_Load(image, sizeof(image), &len, &version) == CONFIG_STORE_OK);
+    TEST_CHECK(len == 0);
+
+    memset(image, 0x5A, sizeof(image));
+    TEST_CHECK(ConfigStore_Commit(image, CONFIG_STORE_MAX_PAYLOAD + 1, IMAGE_VERSION) == CONFIG_STORE_TOO_LARGE);
+    TEST_CHECK(ConfigStore_Commit(image, CONFIG_STORE_MAX_PAYLOAD, IMAGE_VERSION) == CONFIG_STORE_OK);
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_OK);
+    TEST_CHECK(ConfigStore_Load(image, CONFIG_STORE_MAX_PAYLOAD - 1, &len, &version) == CONFIG_STORE_TOO_LARGE);
+
+    memset(image, 0, sizeof(image));
+    TEST_CHECK(ConfigStore_Load(image, sizeof(image), &len, &version) == CONFIG_STORE_OK);
+    TEST_CHECK(len == CONFIG_STORE_MAX_PAYLOAD && image[0] == 0x5A && image[CONFIG_STORE_MAX_PAYLOAD - 1] == 0x5A);
+
+    return;
+}
+
+/*
+ * === testWear
+ * Commits go round-robin over both sectors, a sector is erased once
+ * per RECORDS_PER_SECTOR commits. Reboots in between continue the log.
+ */
+static void testWear(void)
+{
+    uint32_t n, erases, failed = 0;
+
+    eraseFlash();
+
+    ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+    erases = SimNvs_GetErases();
+
+    for ( n = 0; n < WEAR_COMMITS; n++ )
+    {
+        failed += ( commit(n) != CONFIG_STORE_OK );
+
+        if ( n % 97 == 0 && !loads(n) )
+        {
+            failed++;
+        }
+    }
+
+    TEST_CHECK(failed == 0);
+    TEST_CHECK(loads(WEAR_COMMITS - 1));
+    TEST_CHECK(ConfigStore_GetSequence() == WEAR_COMMITS - 1);
+    TEST_CHECK(SimNvs_GetErases() - erases == ( WEAR_COMMITS + RECORDS_PER_SECTOR - 1 ) / RECORDS_PER_SECTOR);
+
+    return;
+}
+
+/*
+ * === testPowerLoss
+ * For every fill level of the log up to three sectors' worth,
+ * power is lost after each byte of the next commit. After the reboot
+ * the store must hold the new image when the commit returned OK and
+ * the previous one otherwise, and take the commit after that.
+ */
+static void testPowerLoss(void)
+{
+    uint32_t             n, cut, failed = 0, completed = 0;
+    ConfigStore_Status_t status;
+
+    eraseFlash();
+
+    ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+    commit(0);
+
+    for ( n = 1; n <= 3 * RECORDS_PER_SECTOR; n++ )
+    {
+        memcpy(saved, SimNvs_GetMemory(), REGION_SIZE);
+
+        for ( cut = 0; cut <= COMMIT_BYTES_MAX; cut++ )
+        {
+            memcpy(SimNvs_GetMemory(), saved, REGION_SIZE);
+
+            ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+            SimNvs_CutPower(cut);
+
+            status = commit(n);
+
+            SimNvs_RestorePower();
+
+            completed += ( status == CONFIG_STORE_OK );
+
+            if ( !loads( ( status == CONFIG_STORE_OK ) ? n : n - 1 ) )
+            {
+                failed++;
+            }
+
+            if ( commit(n + 1000) != CONFIG_STORE_OK || !loads(n + 1000) )
+            {
+                failed++;
+            }
+        }
+
+        memcpy(SimNvs_GetMemory(), saved, REGION_SIZE);
+
+        ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+        commit(n);
+    }
+
+    TEST_CHECK(failed == 0);
+
+    //
+    // A commit completes once its record is programmed, three of
+    // them also programmed the header of the sector they started
+    //
+    TEST_CHECK(completed == 3 * RECORDS_PER_SECTOR * ( SECTOR_HEADER_SIZE + 1 ) - 3 * SECTOR_HEADER_SIZE);
+
+    return;
+}
+
+/*
+ * === testCorruption
+ * Latest record with a damaged payload or header falls back to the
+ * record before it, its sequence is not used again. A damaged
+ * record header ends the log of its sector.
+ */
+static void testCorruption(void)
+{
+    uint8_t* pFlash = SimNvs_GetMemory();
+    uint32_t last   = SECTOR_HEADER_SIZE + 4 * RECORD_SIZE;
+
+    eraseFlash();
+
+    ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+    commit(0);
+    commit(1);
+    commit(2);
+    commit(3);
+    commit(4);
+
+    //
+    // Sector the log started in (erased one has no header)
+    //
+    if ( pFlash[0] == 0xFF )
+    {
+        pFlash += SECTOR_SIZE;
+    }
+
+    pFlash[last + RECORD_HEADER_SIZE + 5] ^= 0x10;
+
+    TEST_CHECK(loads(3));
+    TEST_CHECK(ConfigStore_GetSequence() == 3);
+
+    TEST_CHECK(commit(5) == CONFIG_STORE_OK);
+    TEST_CHECK(loads(5));
+    TEST_CHECK(ConfigStore_GetSequence() == 5);
+
+    //
+    // Version (covered by crc) of the latest and the one before
+    //
+    pFlash[last + RECORD_SIZE + 4] ^= 0x01;
+    pFlash[last - RECORD_SIZE + 4] ^= 0x01;
+
+    TEST_CHECK(loads(2));
+
+    //
+    // Torn magic of the third record hides the records after it
+    //
+    pFlash[SECTOR_HEADER_SIZE + 2 * RECORD_SIZE] = 0x00;
+
+    TEST_CHECK(loads(1));
+
+    TEST_CHECK(commit(6) == CONFIG_STORE_OK);
+    TEST_CHECK(loads(6));
+
+    //
+    // Foreign contents: no valid sector header
+    //
+    memset(SimNvs_GetMemory(), 0x00, REGION_SIZE);
+
+    TEST_CHECK(ConfigStore_Init(CONFIG_NVS_SETTINGS) == CONFIG_STORE_EMPTY);
+    TEST_CHECK(commit(7) == CONFIG_STORE_OK);
+    TEST_CHECK(loads(7));
+
+    return;
+}
+
+/*
+ * === benchStore
+ * Host time of a boot (header scan of two full sectors and crc of
+ * the latest payload) and of a commit, and sector erases per commit.
+ */
+static void benchStore(void)
+{
+    uint64_t startNs, bootNs, commitNs;
+    uint32_t n, erases;
+
+    eraseFlash();
+
+    ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+    for ( n = 0; n < 2 * RECORDS_PER_SECTOR; n++ )
+    {
+        commit(n);
+    }
+
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < BENCH_BOOTS; n++ )
+    {
+        ConfigStore_Init(CONFIG_NVS_SETTINGS);
+    }
+
+    bootNs = Sim_GetNanos() - startNs;
+
+    erases  = SimNvs_GetErases();
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < WEAR_COMMITS; n++ )
+    {
+        commit(n + 1);
+    }
+
+    commitNs = Sim_GetNanos() - startNs;
+    erases   = SimNvs_GetErases() - erases;
+
+    TEST_CHECK(loads(WEAR_COMMITS));
+
+    printf("ConfigStore_Init         %.2f us (%u records in 2 sectors)\n", (double)bootNs / BENCH_BOOTS / 1000, 2 * RECORDS_PER_SECTOR);
+    printf("ConfigStore_Commit       %.2f us (%u byte image)\n", (double)commitNs / WEAR_COMMITS / 1000, IMAGE_SIZE);
+    printf("sector erases            %u per %u commits\n", erases, WEAR_COMMITS);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === MAIN =====================================================================================================
+
+int main(void)
+{
+    testCommit();
+    testWear();
+    testPowerLoss();
+    testCorruption();
+    benchStore();
+
+    return Test_Finish("test_config_store");
+}
+
+// ==============================================================================================================
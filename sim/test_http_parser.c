@@ -0,0 +1,372 @@
+/*
+ * test_http_parser.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: unit test of the HTTP request parser (http_reader.c)
+// on header blocks put straight into the request buffer. Covers
+// well-formed requests and header lookup, malformed ones (bare LF,
+// missing colon, bad method, target, version or Content-Length, a
+// header block filling the whole buffer), query parameters with bad
+// percent escapes, and every single-byte corruption of a browser
+// pRequest-> Reports the parse rate.
+//
+// The request sits right in front of an inaccessible page, with the
+// buffer past the text cleared: reading past the header block, e.g.
+// memchr() over a negative line length, faults instead of stopping
+// at leftovers of earlier requests.
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+
+#include <string.h>
+
+#include <unistd.h>
+
+#include <sys/mman.h>
+
+#include "sim.h"
+
+#include <source/http/http_reader.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define BENCH_PARSES            (1000000)
+
+//
+// Placement of the guarded request, low enough for its
+// pointers into buf not to hold ':' or other text bytes
+//
+#define GUARD_BASE              (0x10000000)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+//
+// Request of a browser (Firefox) for the dashboard with settings
+//
+static const char browserRequest[] =
+    "GET /?c=15&p=1&r=1 HTTP/1.1\r\n"
+    "Host: 192.168.5.11\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Connection: keep-alive\r\n"
+    "Referer: http://192.168.5.11/\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "\r\n";
+
+//
+// Bytes every position of a request is replaced with by testCorrupted()
+//
+static const char corruptions[] = { '\r', '\n', ':', ' ', '?', '%', '\0', 'A' };
+
+static HttpRequest_t* pRequest;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === mapRequest
+ * Places the request at the end of a page followed by an
+ * inaccessible one.
+ */
+static bool mapRequest(void)
+{
+    size_t   page = (size_t)sysconf(_SC_PAGESIZE);
+    uint8_t* pPages;
+
+    pPages = mmap((void*)GUARD_BASE, 2 * page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if ( pPages == MAP_FAILED || sizeof(HttpRequest_t) > page || mprotect(pPages + page, page, PROT_NONE) != 0 )
+    {
+        return false;
+    }
+
+    pRequest = (HttpRequest_t*)( pPages + page - sizeof(HttpRequest_t) );
+
+    return true;
+}
+
+/*
+ * === parse
+ * Puts text into the request buffer the way HttpReader_Read()
+ * leaves it, up to the first blank line.
+ */
+static HttpReader_Status_t parse(const char* pText, uint16_t len)
+{
+    const char* pBlank;
+
+    memset(pRequest, 0, sizeof(HttpRequest_t));
+    memcpy(pRequest->buf, pText, len);
+
+    pRequest->len       = len;
+    pRequest->buf[len]  = '\0';
+    pBlank            = memmem(pRequest->buf, len, "\r\n\r\n", 4);
+    pRequest->headerLen = (uint16_t)( pBlank + 4 - pRequest->buf );
+
+    return HttpReader_Parse(pRequest);
+}
+
+static HttpReader_Status_t parseText(const char* pText)
+{
+    return parse(pText, strlen(pText));
+}
+
+static void testParse(void)
+{
+    const char* pValue;
+    char        text[HTTP_REQUEST_MAXLEN + 1];
+    uint16_t    len;
+
+    TEST_CHECK(parseText("POST /api/config?x=1 HTTP/1.0\r\n"
+                         "host:192.168.5.11\r\n"
+                         "Content-Type: application/json \t\r\n"
+                         "content-length: 7\r\n"
+                         "Connection: Keep-Alive\r\n"
+                         "X-Empty:\r\n"
+                         "\r\n"
+                         "{\"c\":1}") == HTTP_READER_OK);
+    TEST_CHECK(pRequest->method == HTTP_METHOD_POST);
+    TEST_CHECK(strcmp(pRequest->pMethod, "POST") == 0);
+    TEST_CHECK(strcmp(pRequest->pPath, "/api/config") == 0);
+    TEST_CHECK(strcmp(pRequest->pQuery, "x=1") == 0);
+    TEST_CHECK(strcmp(pRequest->pVersion, "HTTP/1.0") == 0);
+    TEST_CHECK(strcmp(pRequest->pHost, "192.168.5.11") == 0);
+    TEST_CHECK(strcmp(pRequest->pContentType, "application/json") == 0);
+    TEST_CHECK(pRequest->contentLength == 7);
+    TEST_CHECK(pRequest->bKeepAlive);
+    TEST_CHECK(strcmp(pRequest->buf + pRequest->headerLen, "{\"c\":1}") == 0);
+
+    pValue = HttpReader_GetHeader(pRequest, "CONTENT-TYPE", &len);
+    TEST_CHECK(pValue != NULL && len == 16 && memcmp(pValue, "application/json", 16) == 0);
+    pValue = HttpReader_GetHeader(pRequest, "x-empty", &len);
+    TEST_CHECK(pValue != NULL && len == 0);
+    TEST_CHECK(HttpReader_GetHeader(pRequest, "Accept", &len) == NULL);
+    TEST_CHECK(HttpReader_GetHeader(pRequest, "Host:", &len) == NULL);
+
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\nConnection: close\r\n\r\n") == HTTP_READER_OK);
+    TEST_CHECK(pRequest->method == HTTP_METHOD_GET);
+    TEST_CHECK(*pRequest->pQuery == '\0');
+    TEST_CHECK(!pRequest->bKeepAlive);
+    TEST_CHECK(pRequest->pHost == NULL && pRequest->contentLength == 0);
+
+    TEST_CHECK(parseText("HEAD /metrics HTTP/1.1\r\n\r\n") == HTTP_READER_OK);
+    TEST_CHECK(pRequest->method == HTTP_METHOD_HEAD);
+    TEST_CHECK(parseText("DELETE /x HTTP/1.1\r\n\r\n") == HTTP_READER_OK);
+    TEST_CHECK(pRequest->method == HTTP_METHOD_OTHER);
+
+    TEST_CHECK(parseText("POST / HTTP/1.1\r\nContent-Length: 65535\r\n\r\n") == HTTP_READER_OK);
+    TEST_CHECK(pRequest->contentLength == 65535);
+
+    //
+    // Bare LF starting a header line, it used to make the
+    // line end precede the line (memchr() of SIZE_MAX bytes)
+    //
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\n\nX\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\nHost: a\r\n\nX: 1\r\n\r\n") == HTTP_READER_MALFORMED);
+
+    //
+    // Bare LF elsewhere
+    //
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\nHost: a\nX: 1\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET / HTTP/1.1\nHost: a\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET /\n HTTP/1.1\r\n\r\n") == HTTP_READER_MALFORMED);
+
+    //
+    // Header lines without a name or colon
+    //
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\nNoColon\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\n: value\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET / HTTP/1.1\r\n \r\n\r\n") == HTTP_READER_MALFORMED);
+
+    //
+    // Request line
+    //
+    TEST_CHECK(parseText("get / HTTP/1.1\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText(" / HTTP/1.1\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET index.html HTTP/1.1\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET  / HTTP/1.1\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET / HTTP/2.0\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET / HTTP/1.10\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("GET /\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("\r\n\r\n") == HTTP_READER_MALFORMED);
+
+    //
+    // Content-Length
+    //
+    TEST_CHECK(parseText("POST / HTTP/1.1\r\nContent-Length: 65536\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("POST / HTTP/1.1\r\nContent-Length: 100000\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("POST / HTTP/1.1\r\nContent-Length: 1 2\r\n\r\n") == HTTP_READER_MALFORMED);
+    TEST_CHECK(parseText("POST / HTTP/1.1\r\nContent-Length:\r\n\r\n") == HTTP_READER_MALFORMED);
+
+    //
+    // Header block filling the whole buffer
+    //
+    len = snprintf(text, sizeof(text), "GET / HTTP/1.1\r\nX: %0*d\r\n\r\n", HTTP_REQUEST_MAXLEN - 23, 0);
+    TEST_CHECK(len == HTTP_REQUEST_MAXLEN);
+    TEST_CHECK(parse(text, len) == HTTP_READER_OK);
+    TEST_CHECK(pRequest->headerLen == HTTP_REQUEST_MAXLEN);
+
+    return;
+}
+
+static void testParams(void)
+{
+    char  query[] = "a=1&b=%41%4a+x&&c&d=%zz&e=%4&%66=%3D=&";
+    char* pCursor = query;
+    char* pKey;
+    char* pValue;
+
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "a") == 0 && strcmp(pValue, "1") == 0);
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "b") == 0 && strcmp(pValue, "AJ x") == 0);
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "c") == 0 && strcmp(pValue, "") == 0);
+
+    //
+    // Bad escapes are kept as they are
+    //
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "d") == 0 && strcmp(pValue, "%zz") == 0);
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "e") == 0 && strcmp(pValue, "%4") == 0);
+
+    //
+    // Key is decoded too, value may hold '='
+    //
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "f") == 0 && strcmp(pValue, "==") == 0);
+    TEST_CHECK(!HttpReader_NextParam(&pCursor, &pKey, &pValue));
+
+    //
+    // Iteration stops at the end of a line
+    //
+    strcpy(query, "k=%\r\nz=1");
+    pCursor = query;
+    TEST_CHECK(HttpReader_NextParam(&pCursor, &pKey, &pValue));
+    TEST_CHECK(strcmp(pKey, "k") == 0 && strcmp(pValue, "%") == 0);
+    TEST_CHECK(!HttpReader_NextParam(&pCursor, &pKey, &pValue));
+
+    return;
+}
+
+/*
+ * === testCorrupted
+ * Every byte of a request replaced with bytes that matter to the
+ * parser. Any outcome but a crash or a status other than OK and
+ * MALFORMED is fine, the blank line is looked for again as the
+ * reader does.
+ */
+static void testCorrupted(void)
+{
+    char     text[sizeof(browserRequest)];
+    uint16_t len = sizeof(browserRequest) - 1;
+    uint16_t i;
+    uint8_t  k;
+    HttpReader_Status_t status;
+
+    for ( i = 0; i < len; i++ )
+    {
+        for ( k = 0; k < sizeof(corruptions); k++ )
+        {
+            memcpy(text, browserRequest, len);
+            text[i] = corruptions[k];
+
+            if ( memmem(text, len, "\r\n\r\n", 4) == NULL )
+            {
+                continue;
+            }
+
+            status = parse(text, len);
+
+            TEST_CHECK(status == HTTP_READER_OK || status == HTTP_READER_MALFORMED);
+        }
+    }
+
+    return;
+}
+
+/*
+ * === benchParse
+ * Parse of the browser request and its query parameters, copied
+ * in as HttpReader_Read() does, without the socket.
+ */
+static void benchParse(void)
+{
+    uint64_t startNs, ns;
+    uint32_t n, params = 0;
+    char*    pCursor;
+    char*    pKey;
+    char*    pValue;
+
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < BENCH_PARSES; n++ )
+    {
+        memcpy(pRequest->buf, browserRequest, sizeof(browserRequest) - 1);
+
+        pRequest->len       = sizeof(browserRequest) - 1;
+        pRequest->headerLen = sizeof(browserRequest) - 1;
+
+        if ( HttpReader_Parse(pRequest) == HTTP_READER_OK )
+        {
+            pCursor = pRequest->pQuery;
+
+            while ( HttpReader_NextParam(&pCursor, &pKey, &pValue) )
+            {
+                params++;
+            }
+        }
+    }
+
+    ns = Sim_GetNanos() - startNs;
+
+    TEST_CHECK(params == 3 * BENCH_PARSES);
+
+    printf("HttpReader_Parse         %.1f ns/request, %.2f M requests/s (parameters decoded)\n",
+           (double)ns / BENCH_PARSES, BENCH_PARSES * 1e3 / ns);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === MAIN =====================================================================================================
+
+int main(void)
+{
+    if ( !mapRequest() )
+    {
+        printf("test_http_parser: cannot map the request\n");
+
+        return 1;
+    }
+
+    testParse();
+    testParams();
+    testCorrupted();
+    benchParse();
+
+    return Test_Finish("test_http_parser");
+}
+
+// ==============================================================================================================
@@ -0,0 +1,304 @@
+/*
+ * test_http_reader.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: unit test of the HTTP request reader (http_reader.c)
+// on a socket of the W5500 model. Requests are read the way the
+// dashboard does, and compared with the byte-wise reading it replaced
+// (readBytesUntil() of the request line, then one recv() per byte):
+// requests/s on the host, SPI frames, bytes and modelled SPI time per
+// request. Parsing is tested on its own by test_http_parser.c.
+//
+
+// === INCLUDES =================================================================================================
+
+#include <stdio.h>
+
+#include <string.h>
+
+#include "sim.h"
+
+#include <source/ethernet/Ethernet.h>
+
+#include <source/ethernet/EthernetClient.h>
+
+#include <source/ethernet/EthernetServer.h>
+
+#include <source/ethernet/SPIfg.h>
+
+#include <source/http/http_reader.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define HTTP_PORT               (80)
+#define PEER_PORT               (50000)
+#define SR_LISTEN               (0x14)
+
+//
+// Byte-wise reading is two orders of magnitude slower
+//
+#define BENCH_REQUESTS          (20000)
+#define BENCH_REQUESTS_BYTEWISE (500)
+
+#define LINE_MAXLEN             (256)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static const uint8_t peerIp[4] = { 192, 168, 5, 1 };
+
+static const uint8_t mac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+//
+// Request of a browser (Firefox) for the dashboard with settings
+//
+static const char browserRequest[] =
+    "GET /?c=15&p=1&r=1 HTTP/1.1\r\n"
+    "Host: 192.168.5.11\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:128.0) Gecko/20100101 Firefox/128.0\r\n"
+    "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Connection: keep-alive\r\n"
+    "Referer: http://192.168.5.11/\r\n"
+    "Upgrade-Insecure-Requests: 1\r\n"
+    "\r\n";
+
+static HttpRequest_t request;
+
+static EthernetServer server;
+
+static EthernetClient client;
+
+static uint8_t sock;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === connectPeer
+ * Brings the W5500 up the way the init task does and connects
+ * the peer to the listening HTTP socket.
+ */
+static bool connectPeer(void)
+{
+    IPAddress ip = { .bytes = { 192, 168, 5, 11 } };
+    int       listening;
+
+    SPI_begin();
+    Ethernet_begin_mac_ip(( uint8_t* )mac, ip);
+    EthernetServer_begin(&server, HTTP_PORT);
+
+    listening = SimW5500_FindSocket(SR_LISTEN, HTTP_PORT);
+
+    if ( listening < 0 || !SimW5500_Connect((uint8_t)listening, peerIp, PEER_PORT) )
+    {
+        return false;
+    }
+
+    sock = (uint8_t)listening;
+
+    EthernetClient_begin(&client, sock);
+
+    return true;
+}
+
+static void push(const char* pData, uint16_t len)
+{
+    TEST_CHECK(SimW5500_Push(sock, (const uint8_t*)pData, len) == len);
+
+    return;
+}
+
+/*
+ * === readBytewise
+ * Reading of Dashboard_Main before the reader: the request line
+ * by readBytesUntil(), then the rest byte by byte up to the blank line.
+ */
+static bool readBytewise(char* pLine)
+{
+    bool bBlank = true;
+    int  c;
+
+    EthernetClient_readBytesUntil(&client, '\n', pLine, LINE_MAXLEN);
+
+    while ( EthernetClient_available(&client) )
+    {
+        c = EthernetClient_read(&client);
+
+        if ( c == '\n' && bBlank )
+        {
+            return true;
+        }
+
+        if ( c == '\n' )
+        {
+            bBlank = true;
+        }
+        else if ( c != '\r' )
+        {
+            bBlank = false;
+        }
+    }
+
+    return false;
+}
+
+static void testRead(void)
+{
+    static const char post[] = "POST /api/config HTTP/1.1\r\nContent-Length: 9\r\n\r\nc=20&p=0";
+    char     oversized[HTTP_REQUEST_MAXLEN + 100];
+    uint16_t len;
+
+    push(browserRequest, sizeof(browserRequest) - 1);
+
+    HttpReader_Begin(&request);
+
+    TEST_CHECK(HttpReader_Read(&client, &request) == HTTP_READER_OK);
+    TEST_CHECK(request.method == HTTP_METHOD_GET);
+    TEST_CHECK(strcmp(request.pPath, "/") == 0);
+    TEST_CHECK(strcmp(request.pQuery, "c=15&p=1&r=1") == 0);
+    TEST_CHECK(request.headerLen == sizeof(browserRequest) - 1);
+    TEST_CHECK(request.bKeepAlive);
+    TEST_CHECK(EthernetClient_available(&client) == 0);
+
+    //
+    // Nothing more arrived, reader does not wait for it
+    //
+    HttpReader_Begin(&request);
+
+    TEST_CHECK(HttpReader_Read(&client, &request) == HTTP_READER_PENDING);
+    TEST_CHECK(request.len == 0);
+
+    //
+    // Request in pieces, terminator split between them. Bytes
+    // read so far are kept until the rest of it arrives.
+    //
+    push(browserRequest, sizeof(browserRequest) - 3);
+
+    TEST_CHECK(HttpReader_Read(&client, &request) == HTTP_READER_PENDING);
+    TEST_CHECK(request.len == sizeof(browserRequest) - 3);
+
+    push(browserRequest + sizeof(browserRequest) - 3, 2);
+
+    TEST_CHECK(HttpReader_Read(&client, &request) == HTTP_READER_OK);
+    TEST_CHECK(strcmp(request.pQuery, "c=15&p=1&r=1") == 0);
+    TEST_CHECK(request.headerLen == sizeof(browserRequest) - 1);
+
+    //
+    // Body partly in the first read, rest read by
+    // HttpReader_ReadBody() once it arrives
+    //
+    push(post, sizeof(post) - 1);
+
+    HttpReader_Begin(&request);
+
+    TEST_CHECK(HttpReader_Read(&client, &request) == HTTP_READER_OK);
+    TEST_CHECK(request.method == HTTP_METHOD_POST);
+    TEST_CHECK(request.contentLength == 9);
+    TEST_CHECK(HttpReader_ReadBody(&client, &request) == HTTP_READER_PENDING);
+
+    push("&", 1);
+
+    TEST_CHECK(HttpReader_ReadBody(&client, &request) == HTTP_READER_OK);
+    TEST_CHECK(strcmp(request.buf + request.headerLen, "c=20&p=0&") == 0);
+
+    //
+    // Header block that does not fit the buffer
+    //
+    len = snprintf(oversized, sizeof(oversized), "GET /%0*d HTTP/1.1\r\n\r\n", HTTP_REQUEST_MAXLEN, 0);
+    push(oversized, len);
+
+    HttpReader_Begin(&request);
+
+    TEST_CHECK(HttpReader_Read(&client, &request) == HTTP_READER_TOO_LARGE);
+
+    while ( EthernetClient_available(&client) )
+    {
+        EthernetClient_read_buf(&client, (uint8_t*)oversized, sizeof(oversized));
+    }
+
+    return;
+}
+
+/*
+ * === benchRead
+ * Same request read over and over on a kept-alive connection.
+ */
+static void benchRead(bool bBulk, uint32_t requests)
+{
+    SimW5500_Counters_t before;
+    SimW5500_Counters_t after;
+    char                line[LINE_MAXLEN];
+    uint64_t            startNs, ns;
+    uint32_t            n, read = 0;
+
+    SimW5500_GetCounters(&before);
+
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < requests; n++ )
+    {
+        SimW5500_Push(sock, (const uint8_t*)browserRequest, sizeof(browserRequest) - 1);
+
+        if ( bBulk )
+        {
+            HttpReader_Begin(&request);
+
+            read += ( HttpReader_Read(&client, &request) == HTTP_READER_OK );
+        }
+        else
+        {
+            read += readBytewise(line);
+        }
+    }
+
+    ns = Sim_GetNanos() - startNs;
+
+    SimW5500_GetCounters(&after);
+
+    TEST_CHECK(read == requests);
+
+    printf("%-24s %9.0f %10.1f %10.1f %10.1f\n",
+           bBulk ? "HttpReader_Read" : "byte-wise (old)",
+           requests * 1e9 / ns,
+           (double)( after.frames - before.frames ) / requests,
+           (double)( after.bytes - before.bytes ) / requests,
+           (double)( after.cycles - before.cycles ) / requests * 1e6 / SIM_CPU_HZ);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === MAIN =====================================================================================================
+
+int main(void)
+{
+    Sim_Init();
+
+    TEST_CHECK(connectPeer());
+
+    testRead();
+
+    printf("%-24s %9s %10s %10s %10s\n", "request read", "req/s", "SPI frames", "SPI bytes", "SPI us");
+
+    benchRead(false, BENCH_REQUESTS_BYTEWISE);
+    benchRead(true, BENCH_REQUESTS);
+
+    return Test_Finish("test_http_reader");
+}
+
+// ==============================================================================================================
@@ -0,0 +1,339 @@
+/*
+ * test_ieee_parser.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: unit test of IeeeParser_Parse() over a corpus of
+// 802.15.4 frames (2003, 2006 and 2015 frame versions, every addressing
+// mode, PAN ID compression, auxiliary security header, reserved modes),
+// every truncation of each frame, and the parse rate on the host.
+//
+// Frames are kept as the radio queue stores them: no PHY header,
+// FCS (two bytes, not checked by the parser) at the end.
+//
+
+// === INCLUDES =================================================================================================
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <string.h>
+
+#include "sim.h"
+
+#include <source/frame_parser/ieee_parser.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define BENCH_ROUNDS            (200000)
+
+#define NS_PER_S                (1000000000ULL)
+
+#define FRAME(...)              (const uint8_t[]){ __VA_ARGS__ }, sizeof((const uint8_t[]){ __VA_ARGS__ })
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct Test_Frame
+{
+    const char*          pName;
+    const uint8_t*       pMpdu;
+    uint16_t             len;
+    bool                 bOk;
+    IeeeParser_Summary_t expected;
+} Test_Frame_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static const Test_Frame_t corpus[] =
+{
+    {
+        "2006 beacon, short source",
+        FRAME(0x00, 0x90, 0x11, 0x34, 0x12, 0xCD, 0xAB, 0xFF, 0xCF, 0x00, 0x00, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_BEACON, .frameVersion = 1, .seqNum = 0x11,
+          .srcAddrMode = IEEE_ADDR_MODE_SHORT, .srcPanId = 0x1234, .srcAddr = { 0xCD, 0xAB },
+          .headerLen = 7, .payloadLen = 4 }
+    },
+    {
+        "2003 data, intra-PAN short",
+        FRAME(0x61, 0x88, 0x22, 0xEF, 0xBE, 0xFF, 0xFF, 0x01, 0x00, 0x01, 0x02, 0x03, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .seqNum = 0x22,
+          .flags = IEEE_FLAG_ACK_REQUEST | IEEE_FLAG_PAN_ID_COMPRESSION,
+          .dstAddrMode = IEEE_ADDR_MODE_SHORT, .srcAddrMode = IEEE_ADDR_MODE_SHORT,
+          .dstPanId = 0xBEEF, .srcPanId = 0xBEEF, .dstAddr = { 0xFF, 0xFF }, .srcAddr = { 0x01, 0x00 },
+          .headerLen = 9, .payloadLen = 3 }
+    },
+    {
+        "2006 data, extended, two PANs",
+        FRAME(0x01, 0xDC, 0x23, 0x01, 0x01, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+              0x02, 0x02, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+              0x01, 0x02, 0x03, 0x04, 0x05, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .frameVersion = 1, .seqNum = 0x23,
+          .dstAddrMode = IEEE_ADDR_MODE_EXTENDED, .srcAddrMode = IEEE_ADDR_MODE_EXTENDED,
+          .dstPanId = 0x0101, .srcPanId = 0x0202,
+          .dstAddr = { 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18 },
+          .srcAddr = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28 },
+          .headerLen = 23, .payloadLen = 5 }
+    },
+    {
+        "2003 ack",
+        FRAME(0x02, 0x00, 0x33, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_ACK, .seqNum = 0x33, .headerLen = 3 }
+    },
+    {
+        "2006 MAC command, secured",
+        FRAME(0x6B, 0xD8, 0x44, 0x34, 0x12, 0x00, 0x00,
+              0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+              0x0D, 0x01, 0x00, 0x00, 0x00, 0x07,
+              0x04, 0xE1, 0xE2, 0xE3, 0xE4, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_MAC_CMD, .frameVersion = 1, .seqNum = 0x44,
+          .flags = IEEE_FLAG_SECURITY | IEEE_FLAG_ACK_REQUEST | IEEE_FLAG_PAN_ID_COMPRESSION,
+          .dstAddrMode = IEEE_ADDR_MODE_SHORT, .srcAddrMode = IEEE_ADDR_MODE_EXTENDED,
+          .dstPanId = 0x1234, .srcPanId = 0x1234, .dstAddr = { 0x00, 0x00 },
+          .srcAddr = { 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38 },
+          .securityLevel = 5, .keyIdMode = 1, .headerLen = 21, .payloadLen = 5 }
+    },
+    {
+        "2003 data, security bit",
+        FRAME(0x49, 0x88, 0x45, 0x34, 0x12, 0x02, 0x00, 0x01, 0x00, 0x01, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .seqNum = 0x45,
+          .flags = IEEE_FLAG_SECURITY | IEEE_FLAG_PAN_ID_COMPRESSION,
+          .dstAddrMode = IEEE_ADDR_MODE_SHORT, .srcAddrMode = IEEE_ADDR_MODE_SHORT,
+          .dstPanId = 0x1234, .srcPanId = 0x1234, .dstAddr = { 0x02, 0x00 }, .srcAddr = { 0x01, 0x00 },
+          .headerLen = 9, .payloadLen = 1 }
+    },
+    {
+        "2015 data, extended, no PAN",
+        FRAME(0x41, 0xEC, 0x55, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+              0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x01, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .frameVersion = 2, .seqNum = 0x55,
+          .flags = IEEE_FLAG_PAN_ID_COMPRESSION,
+          .dstAddrMode = IEEE_ADDR_MODE_EXTENDED, .srcAddrMode = IEEE_ADDR_MODE_EXTENDED,
+          .dstAddr = { 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18 },
+          .srcAddr = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28 },
+          .headerLen = 19, .payloadLen = 1 }
+    },
+    {
+        "2015 data, seq suppressed, IEs",
+        FRAME(0x01, 0x2B, 0xCD, 0xAB, 0xFF, 0xFF, 0x00, 0x3F, 0x01, 0x02, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .frameVersion = 2,
+          .flags = IEEE_FLAG_SEQ_SUPPRESSED | IEEE_FLAG_IE_PRESENT,
+          .dstAddrMode = IEEE_ADDR_MODE_SHORT, .dstPanId = 0xABCD, .dstAddr = { 0xFF, 0xFF },
+          .headerLen = 6, .payloadLen = 4 }
+    },
+    {
+        "2015 data, secured, no counter",
+        FRAME(0x49, 0xA8, 0x66, 0x34, 0x12, 0x02, 0x00, 0x01, 0x00, 0x26,
+              0x01, 0x02, 0x03, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .frameVersion = 2, .seqNum = 0x66,
+          .flags = IEEE_FLAG_SECURITY | IEEE_FLAG_PAN_ID_COMPRESSION,
+          .dstAddrMode = IEEE_ADDR_MODE_SHORT, .srcAddrMode = IEEE_ADDR_MODE_SHORT,
+          .dstPanId = 0x1234, .srcPanId = 0x1234, .dstAddr = { 0x02, 0x00 }, .srcAddr = { 0x01, 0x00 },
+          .securityLevel = 6, .headerLen = 10, .payloadLen = 3 }
+    },
+    {
+        "2015 data, no address, PAN",
+        FRAME(0x41, 0x20, 0x77, 0x34, 0x12, 0x01, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .frameVersion = 2, .seqNum = 0x77,
+          .flags = IEEE_FLAG_PAN_ID_COMPRESSION, .dstPanId = 0x1234,
+          .headerLen = 5, .payloadLen = 1 }
+    },
+    {
+        "2015 data, source only",
+        FRAME(0x01, 0xA0, 0x88, 0x34, 0x12, 0x01, 0x00, 0xAA, 0xBB),
+        true,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .frameVersion = 2, .seqNum = 0x88,
+          .srcAddrMode = IEEE_ADDR_MODE_SHORT, .srcPanId = 0x1234, .srcAddr = { 0x01, 0x00 },
+          .headerLen = 7 }
+    },
+    {
+        "reserved destination mode",
+        FRAME(0x01, 0x84, 0x99, 0x34, 0x12, 0x01, 0x00, 0xAA, 0xBB),
+        false,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .dstAddrMode = 1, .srcAddrMode = IEEE_ADDR_MODE_SHORT }
+    },
+    {
+        "reserved source mode",
+        FRAME(0x01, 0x48, 0x99, 0x34, 0x12, 0x01, 0x00, 0xAA, 0xBB),
+        false,
+        { .frameType = IEEE_FRAME_TYPE_DATA, .dstAddrMode = IEEE_ADDR_MODE_SHORT, .srcAddrMode = 1 }
+    },
+    {
+        "multipurpose frame",
+        FRAME(0x05, 0x00, 0x00, 0x00, 0xAA, 0xBB),
+        false,
+        { .frameType = IEEE_FRAME_TYPE_MULTIPURPOSE }
+    },
+    {
+        "shorter than FCF and FCS",
+        FRAME(0x01, 0x88, 0xAA),
+        false,
+        { 0 }
+    }
+};
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === parseExact
+ * Parses a copy of the first len bytes held in a buffer of that
+ * very size, so that reading past the frame is caught by a build
+ * with -fsanitize=address (or valgrind).
+ */
+static bool parseExact(const uint8_t* pMpdu, uint16_t len, IeeeParser_Summary_t* pSummary)
+{
+    uint8_t* pCopy = malloc(len ? len : 1);
+    bool     bOk;
+
+    memcpy(pCopy, pMpdu, len);
+    bOk = IeeeParser_Parse(pCopy, len, pSummary);
+    free(pCopy);
+
+    return bOk;
+}
+
+static void testCorpus(void)
+{
+    IeeeParser_Summary_t summary;
+    size_t i;
+
+    for ( i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++ )
+    {
+        const Test_Frame_t* pFrame = &corpus[i];
+        bool bOk   = parseExact(pFrame->pMpdu, pFrame->len, &summary);
+        bool bSame = ( memcmp(&summary, &pFrame->expected, sizeof(summary)) == 0 );
+
+        TEST_CHECK(bOk == pFrame->bOk);
+
+        if ( pFrame->bOk )
+        {
+            TEST_CHECK(bSame);
+        }
+        else
+        {
+            TEST_CHECK(summary.frameType == pFrame->expected.frameType);
+            TEST_CHECK(summary.headerLen == 0);
+        }
+
+        if ( bOk != pFrame->bOk || ( bOk && !bSame ) )
+        {
+            printf("  in frame \"%s\"\n", pFrame->pName);
+        }
+    }
+
+    return;
+}
+
+/*
+ * === testTruncated
+ * Every prefix of a well-formed frame that cuts into its header
+ * (FCS still counted as the last two bytes) must be rejected, every
+ * longer one accepted with the same header.
+ */
+static void testTruncated(void)
+{
+    IeeeParser_Summary_t summary;
+    size_t   i;
+    uint16_t len;
+
+    for ( i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++ )
+    {
+        const Test_Frame_t* pFrame = &corpus[i];
+
+        if ( !pFrame->bOk )
+        {
+            continue;
+        }
+
+        for ( len = 0; len < pFrame->len; len++ )
+        {
+            bool bOk = parseExact(pFrame->pMpdu, len, &summary);
+
+            TEST_CHECK(bOk == ( len >= pFrame->expected.headerLen + IEEE_FCS_LEN ));
+
+            if ( bOk )
+            {
+                TEST_CHECK(summary.headerLen == pFrame->expected.headerLen);
+                TEST_CHECK(summary.payloadLen == len - IEEE_FCS_LEN - pFrame->expected.headerLen);
+            }
+        }
+    }
+
+    return;
+}
+
+/*
+ * === benchParse
+ * Parse rate over the well-formed part of the corpus, taken as
+ * it comes from the radio queue (no copy).
+ */
+static void benchParse(void)
+{
+    IeeeParser_Summary_t summary;
+    uint64_t startNs, ns, frames = 0, headerBytes = 0;
+    uint32_t round;
+    size_t   i;
+
+    startNs = Sim_GetNanos();
+
+    for ( round = 0; round < BENCH_ROUNDS; round++ )
+    {
+        for ( i = 0; i < sizeof(corpus) / sizeof(corpus[0]); i++ )
+        {
+            if ( corpus[i].bOk && IeeeParser_Parse(corpus[i].pMpdu, corpus[i].len, &summary) )
+            {
+                headerBytes += summary.headerLen;
+                frames++;
+            }
+        }
+    }
+
+    ns = Sim_GetNanos() - startNs;
+
+    printf("IeeeParser_Parse         %llu frames, %.1f ns/frame, %.2f Mframes/s (header bytes %llu)\n",
+           (unsigned long long)frames, (double)ns / frames, (double)frames * NS_PER_S / ns / 1e6,
+           (unsigned long long)headerBytes);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === MAIN =====================================================================================================
+
+int main(void)
+{
+    testCorpus();
+    testTruncated();
+    benchParse();
+
+    return Test_Finish("test_ieee_parser");
+}
+
+// ==============================================================================================================
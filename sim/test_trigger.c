@@ -0,0 +1,359 @@
+/*
+ * test_trigger.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: unit test of the capture trigger (trigger.c).
+// Covers pattern parsing and matching, the state machine with its
+// post-trigger window, wraparound and eviction of the history ring
+// against a reference model, and reports the trigger latency on the
+// host: pattern match, armed frame (push and match) and history flush.
+//
+
+// === INCLUDES =================================================================================================
+
+#include <stdio.h>
+
+#include <string.h>
+
+#include "sim.h"
+
+#include <source/trigger/trigger.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define FRAME_MAXLEN            (127)
+
+#define WRAP_TRIALS             (50)
+
+#define WRAP_PUSHES             (5000)
+
+#define BENCH_FRAMES            (1000000)
+
+#define BENCH_FLUSHES           (10000)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static uint32_t randomState = 0x2014;
+
+//
+// Lengths of the frames pushed by testWraparound(),
+// frame n is filled by fillFrame(n)
+//
+static uint16_t pushedLen[WRAP_PUSHES];
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint32_t nextRandom(void)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+
+    return randomState;
+}
+
+static void fillFrame(uint8_t* pFrame, uint16_t len, uint32_t n)
+{
+    uint16_t i;
+
+    for ( i = 0; i < len; i++ )
+    {
+        pFrame[i] = (uint8_t)( n * 31 + i );
+    }
+
+    return;
+}
+
+static void testPattern(void)
+{
+    const uint8_t frame[] = { 0x41, 0x88, 0x17, 0xCD, 0xAB };
+
+    TEST_CHECK(Trigger_SetPattern("4188"));
+    TEST_CHECK(strcmp(Trigger_GetPattern(), "4188") == 0);
+
+    Trigger_SetOffset(0);
+    TEST_CHECK(Trigger_Match(frame, sizeof(frame)));
+
+    Trigger_SetOffset(1);
+    TEST_CHECK(!Trigger_Match(frame, sizeof(frame)));
+
+    //
+    // Wildcard nibbles
+    //
+    TEST_CHECK(Trigger_SetPattern("x8x7"));
+    TEST_CHECK(Trigger_Match(frame, sizeof(frame)));
+    TEST_CHECK(Trigger_SetPattern("X8X6"));
+    TEST_CHECK(!Trigger_Match(frame, sizeof(frame)));
+
+    //
+    // Pattern reaching past the frame
+    //
+    TEST_CHECK(Trigger_SetPattern("cdab"));
+    Trigger_SetOffset(3);
+    TEST_CHECK(Trigger_Match(frame, sizeof(frame)));
+    Trigger_SetOffset(4);
+    TEST_CHECK(!Trigger_Match(frame, sizeof(frame)));
+    Trigger_SetOffset(0xFFFF);
+    TEST_CHECK(!Trigger_Match(frame, sizeof(frame)));
+
+    //
+    // Malformed patterns keep the previous one
+    //
+    TEST_CHECK(!Trigger_SetPattern("418"));
+    TEST_CHECK(!Trigger_SetPattern("41g8"));
+    TEST_CHECK(!Trigger_SetPattern("00112233445566778"));
+    TEST_CHECK(!Trigger_SetPattern("001122334455667788"));
+    TEST_CHECK(!Trigger_IsValidPattern("4 88"));
+    TEST_CHECK(Trigger_IsValidPattern("0011223344556677"));
+    TEST_CHECK(strcmp(Trigger_GetPattern(), "cdab") == 0);
+
+    //
+    // Empty pattern matches every frame
+    //
+    TEST_CHECK(Trigger_SetPattern(""));
+    Trigger_SetOffset(0);
+    TEST_CHECK(Trigger_Match(frame, 0));
+
+    return;
+}
+
+/*
+ * === testStates
+ * Armed frames are kept, the matching one fires the trigger and is
+ * the last one flushed, then the post-trigger window is counted.
+ */
+static void testStates(void)
+{
+    uint8_t  frame[FRAME_MAXLEN];
+    uint16_t len;
+    uint32_t n;
+
+    Trigger_SetPattern("ff");
+    Trigger_SetOffset(0);
+    Trigger_SetPostFrames(3);
+
+    TEST_CHECK(Trigger_GetState() == TRIGGER_OFF);
+    TEST_CHECK(!Trigger_CountPostFrame());
+
+    Trigger_Arm(true);
+    TEST_CHECK(Trigger_GetState() == TRIGGER_ARMED);
+
+    for ( n = 0; n < 4; n++ )
+    {
+        fillFrame(frame, 10, n);
+        frame[0] = n;
+        TEST_CHECK(!Trigger_ProcessFrame(frame, 10));
+    }
+
+    frame[0] = 0xFF;
+    TEST_CHECK(Trigger_ProcessFrame(frame, 10));
+    TEST_CHECK(Trigger_GetState() == TRIGGER_POST);
+
+    for ( n = 0; n < 5; n++ )
+    {
+        len = Trigger_PopHistory(frame, sizeof(frame));
+        TEST_CHECK(len == 10);
+        TEST_CHECK(frame[0] == ( n < 4 ? n : 0xFF ));
+    }
+
+    TEST_CHECK(Trigger_PopHistory(frame, sizeof(frame)) == 0);
+
+    TEST_CHECK(Trigger_CountPostFrame());
+    TEST_CHECK(Trigger_CountPostFrame());
+    TEST_CHECK(Trigger_GetState() == TRIGGER_POST);
+    TEST_CHECK(Trigger_CountPostFrame());
+    TEST_CHECK(Trigger_GetState() == TRIGGER_DONE);
+    TEST_CHECK(!Trigger_CountPostFrame());
+
+    //
+    // No post-trigger window, re-arming empties the history
+    //
+    Trigger_SetPostFrames(0);
+    Trigger_Arm(true);
+    TEST_CHECK(Trigger_PopHistory(frame, sizeof(frame)) == 0);
+    TEST_CHECK(Trigger_ProcessFrame(frame, 10));
+    TEST_CHECK(Trigger_GetState() == TRIGGER_DONE);
+
+    Trigger_Arm(false);
+    TEST_CHECK(Trigger_GetState() == TRIGGER_OFF);
+    TEST_CHECK(Trigger_PopHistory(frame, sizeof(frame)) == 0);
+
+    return;
+}
+
+/*
+ * === testWraparound
+ * Pushes frames of random length, so that entries and their
+ * length headers wrap around the end of the ring at every possible
+ * position, then flushes it. The ring must give back the longest run
+ * of the newest frames that fits, oldest first and intact.
+ */
+static void testWraparound(void)
+{
+    uint8_t  frame[FRAME_MAXLEN], expected[FRAME_MAXLEN];
+    uint32_t trial, pushes, n, first, used;
+    uint16_t len;
+
+    for ( trial = 0; trial < WRAP_TRIALS; trial++ )
+    {
+        pushes = 1 + nextRandom() % WRAP_PUSHES;
+
+        Trigger_Arm(true);
+
+        for ( n = 0; n < pushes; n++ )
+        {
+            pushedLen[n] = 1 + nextRandom() % FRAME_MAXLEN;
+            fillFrame(frame, pushedLen[n], n);
+            Trigger_PushHistory(frame, pushedLen[n]);
+        }
+
+        first = pushes;
+        used  = 0;
+
+        while ( first > 0 && used + pushedLen[first - 1] + TRIGGER_ENTRY_HDR_SIZE <= TRIGGER_HISTORY_SIZE )
+        {
+            first--;
+            used += pushedLen[first] + TRIGGER_ENTRY_HDR_SIZE;
+        }
+
+        for ( n = first; n < pushes; n++ )
+        {
+            len = Trigger_PopHistory(frame, sizeof(frame));
+            fillFrame(expected, pushedLen[n], n);
+
+            TEST_CHECK(len == pushedLen[n]);
+            TEST_CHECK(memcmp(frame, expected, pushedLen[n]) == 0);
+        }
+
+        TEST_CHECK(Trigger_PopHistory(frame, sizeof(frame)) == 0);
+    }
+
+    //
+    // Frames longer than the buffer are skipped on flush,
+    // frames longer than the ring are not kept at all
+    //
+    Trigger_Arm(true);
+
+    fillFrame(frame, 100, 1);
+    Trigger_PushHistory(frame, 100);
+    fillFrame(frame, 20, 2);
+    Trigger_PushHistory(frame, 20);
+    Trigger_PushHistory(frame, TRIGGER_HISTORY_SIZE - 1);
+
+    len = Trigger_PopHistory(frame, 50);
+    fillFrame(expected, 20, 2);
+    TEST_CHECK(len == 20);
+    TEST_CHECK(memcmp(frame, expected, 20) == 0);
+    TEST_CHECK(Trigger_PopHistory(frame, sizeof(frame)) == 0);
+
+    Trigger_Arm(false);
+
+    return;
+}
+
+/*
+ * === benchLatency
+ * Host time the sniffing task spends per armed frame, and until the
+ * matching frame has been taken out again with the full history.
+ */
+static void benchLatency(void)
+{
+    uint8_t  frame[FRAME_MAXLEN];
+    uint64_t startNs, matchNs, armedNs, flushNs = 0;
+    uint32_t n, pushed, fired = 0;
+
+    fillFrame(frame, sizeof(frame), 0);
+
+    Trigger_SetPattern("x1x2x3x4x5x6x7x8");
+    Trigger_SetOffset(100);
+
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < BENCH_FRAMES; n++ )
+    {
+        frame[100] = (uint8_t)n;
+        fired += Trigger_Match(frame, sizeof(frame));
+    }
+
+    matchNs = Sim_GetNanos() - startNs;
+
+    Trigger_Arm(true);
+
+    startNs = Sim_GetNanos();
+
+    for ( n = 0; n < BENCH_FRAMES; n++ )
+    {
+        frame[100] = (uint8_t)n;
+        fired += Trigger_ProcessFrame(frame, sizeof(frame));
+    }
+
+    armedNs = Sim_GetNanos() - startNs;
+
+    TEST_CHECK(fired == 0);
+
+    //
+    // From the matching frame until the full history is taken out
+    //
+    Trigger_SetPattern("");
+
+    for ( n = 0; n < BENCH_FLUSHES; n++ )
+    {
+        Trigger_Arm(true);
+
+        for ( pushed = 0; pushed < TRIGGER_HISTORY_SIZE / ( FRAME_MAXLEN + TRIGGER_ENTRY_HDR_SIZE ); pushed++ )
+        {
+            Trigger_PushHistory(frame, sizeof(frame));
+        }
+
+        startNs = Sim_GetNanos();
+
+        fired += Trigger_ProcessFrame(frame, sizeof(frame));
+
+        while ( Trigger_PopHistory(frame, sizeof(frame)) )
+        {
+        }
+
+        flushNs += Sim_GetNanos() - startNs;
+    }
+
+    Trigger_Arm(false);
+
+    TEST_CHECK(fired == BENCH_FLUSHES);
+
+    printf("Trigger_Match            %.1f ns/frame (8 byte pattern)\n", (double)matchNs / BENCH_FRAMES);
+    printf("Trigger_ProcessFrame     %.1f ns/frame (127 bytes, armed)\n", (double)armedNs / BENCH_FRAMES);
+    printf("trigger and flush        %.1f ns (%u frames of 127 bytes)\n", (double)flushNs / BENCH_FLUSHES,
+           TRIGGER_HISTORY_SIZE / ( FRAME_MAXLEN + TRIGGER_ENTRY_HDR_SIZE ));
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === MAIN =====================================================================================================
+
+int main(void)
+{
+    testPattern();
+    testStates();
+    testWraparound();
+    benchLatency();
+
+    return Test_Finish("test_trigger");
+}
+
+// ==============================================================================================================
@@ -0,0 +1,1002 @@
+/*
+ * tirtos.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: TI-RTOS7 kernel services on pthreads. Every task
+// is a thread, but only the thread holding the CPU runs firmware code:
+// the CPU is handed out in FIFO order (ticket lock), it is given back
+// by Task_yield() and by every blocking call. This keeps the single
+// priority, cooperative scheduling of the target. Hwi and Swi run on
+// the thread that raises them (W5500 model, RF stub, benchmark),
+// concurrently with the task holding the CPU, as they would preempt it.
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+
+#include <time.h>
+
+#include <errno.h>
+
+#include <string.h>
+
+#include <stdio.h>
+
+#include <stdlib.h>
+
+#include <unistd.h>
+
+#include <ti/sysbios/BIOS.h>
+
+#include <ti/sysbios/knl/Task.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <ti/sysbios/knl/Semaphore.h>
+
+#include <ti/sysbios/knl/Event.h>
+
+#include <ti/sysbios/knl/Mailbox.h>
+
+#include <ti/sysbios/family/arm/m3/Hwi.h>
+
+#include <ti/sysbios/hal/Seconds.h>
+
+#include <ti/sysbios/runtime/Timestamp.h>
+
+#include <ti/sysbios/utils/Load.h>
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define SIM_MAX_TASKS           (8)
+
+#define NS_PER_TICK             (Clock_tickPeriod * 1000ULL)
+
+//
+// Hwi stack of multiSniff.syscfg (Program.stack)
+//
+#define HWI_STACK_SIZE          (1024)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+struct Task_Struct
+{
+    pthread_t     thread;
+    Task_FuncPtr  fxn;
+    UArg          arg0;
+    UArg          arg1;
+    Int           priority;
+    SizeT         stackSize;
+    unsigned long ticket;       // first turn on the CPU
+    uint64_t      busyNs;       // CPU held since start
+    uint64_t      markNs;       // busyNs at the last Load_update()
+    uint64_t      windowNs;     // CPU held in the last Load window
+};
+
+struct Semaphore_Struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    Int             count;
+    Semaphore_Mode  mode;
+};
+
+struct Event_Struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    UInt            posted;
+};
+
+struct Mailbox_Struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;       // a message or a free slot, broadcast
+    SizeT           msgSize;
+    UInt            numMsgs;
+    UInt            head;       // oldest message
+    UInt            count;
+    uint8_t*        pBuffer;
+};
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static struct Task_Struct tasks[SIM_MAX_TASKS];
+
+static unsigned           taskCount;
+
+//
+// CPU: tickets are taken in order, the thread whose
+// ticket is served holds the CPU. main() holds ticket 0.
+//
+static pthread_mutex_t    cpuLock = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_cond_t     cpuCond = PTHREAD_COND_INITIALIZER;
+
+static unsigned long      nextTicket = 1;
+
+static unsigned long      nowServing = 0;
+
+static Task_Handle        holder;
+
+static uint64_t           holderSince;
+
+static uint64_t           startNs;
+
+static uint64_t           loadMarkNs;
+
+static uint64_t           loadWindowNs;
+
+static uint64_t           loadBusyNs;
+
+//
+// Hwi do not nest, neither do Swi
+//
+static pthread_mutex_t    hwiLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static pthread_mutex_t    swiLock = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+static __thread Task_Handle     self;
+
+static __thread BIOS_ThreadType threadType = BIOS_ThreadType_Main;
+
+static __thread bool            bHoldsCpu;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint64_t nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void deadlineOf(UInt32 ticks, struct timespec* pDeadline)
+{
+    uint64_t ns = nowNs() + (uint64_t)ticks * NS_PER_TICK;
+
+    pDeadline->tv_sec  = (time_t)( ns / 1000000000ULL );
+    pDeadline->tv_nsec = (long)( ns % 1000000000ULL );
+
+    return;
+}
+
+static void initCond(pthread_cond_t* pCond)
+{
+    pthread_condattr_t attr;
+
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(pCond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    return;
+}
+
+/*
+ * === waitTurn
+ * Called with cpuLock held, returns once ticket is served.
+ */
+static void waitTurn(unsigned long ticket)
+{
+    while ( nowServing != ticket )
+    {
+        pthread_cond_wait(&cpuCond, &cpuLock);
+    }
+
+    holder      = self;
+    holderSince = nowNs();
+    bHoldsCpu   = true;
+
+    return;
+}
+
+static void acquireCpu(void)
+{
+    pthread_mutex_lock(&cpuLock);
+
+    waitTurn(nextTicket++);
+
+    pthread_mutex_unlock(&cpuLock);
+
+    return;
+}
+
+static void releaseCpu(void)
+{
+    pthread_mutex_lock(&cpuLock);
+
+    if ( holder != NULL )
+    {
+        holder->busyNs += nowNs() - holderSince;
+    }
+
+    holder    = NULL;
+    bHoldsCpu = false;
+
+    nowServing++;
+
+    pthread_cond_broadcast(&cpuCond);
+
+    pthread_mutex_unlock(&cpuLock);
+
+    return;
+}
+
+static void* taskEntry(void* pArg)
+{
+    Task_Handle task = (Task_Handle)pArg;
+
+    self       = task;
+    threadType = BIOS_ThreadType_Task;
+
+    pthread_mutex_lock(&cpuLock);
+
+    waitTurn(task->ticket);
+
+    pthread_mutex_unlock(&cpuLock);
+
+    task->fxn(task->arg0, task->arg1);
+
+    //
+    // Task terminated
+    //
+    releaseCpu();
+
+    return NULL;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Sim_Init
+ * Called by the benchmark on the main thread before the firmware
+ * main(), which then holds the CPU until BIOS_start().
+ */
+void Sim_Init(void)
+{
+    startNs    = nowNs();
+    loadMarkNs = startNs;
+    bHoldsCpu  = true;
+
+    Sim_MapTarget();
+
+    return;
+}
+
+uint64_t Sim_GetNanos(void)
+{
+    return nowNs() - startNs;
+}
+
+/*
+ * === Sim_GetCycles
+ * TRACE_CYCLES() of the simulation: host time counted at 48 MHz.
+ */
+uint32_t Sim_GetCycles(void)
+{
+    return (uint32_t)( ( nowNs() - startNs ) * ( SIM_CPU_HZ / 1000000 ) / 1000 );
+}
+
+/*
+ * === Sim_Enter
+ * Lets a host thread (benchmark) call firmware functions the way
+ * a task would, it waits for the CPU like a task does.
+ */
+void Sim_Enter(void)
+{
+    threadType = BIOS_ThreadType_Task;
+
+    acquireCpu();
+
+    return;
+}
+
+void Sim_Leave(void)
+{
+    releaseCpu();
+
+    threadType = BIOS_ThreadType_Main;
+
+    return;
+}
+
+void Sim_RunHwi(void (*fxn)(void))
+{
+    BIOS_ThreadType prev;
+
+    pthread_mutex_lock(&hwiLock);
+
+    prev       = threadType;
+    threadType = BIOS_ThreadType_Hwi;
+
+    fxn();
+
+    threadType = prev;
+
+    pthread_mutex_unlock(&hwiLock);
+
+    return;
+}
+
+void Sim_RunSwi(void (*fxn)(void* pArg), void* pArg)
+{
+    BIOS_ThreadType prev;
+
+    pthread_mutex_lock(&swiLock);
+
+    prev       = threadType;
+    threadType = BIOS_ThreadType_Swi;
+
+    fxn(pArg);
+
+    threadType = prev;
+
+    pthread_mutex_unlock(&swiLock);
+
+    return;
+}
+
+///////////////////////////
+// BIOS
+//
+
+BIOS_ThreadType BIOS_getThreadType(void)
+{
+    return threadType;
+}
+
+void BIOS_start(void)
+{
+    releaseCpu();
+
+    for (;;)
+    {
+        pause();
+    }
+}
+
+///////////////////////////
+// Task
+//
+
+void Task_Params_init(Task_Params* pParams)
+{
+    pParams->arg0      = 0;
+    pParams->arg1      = 0;
+    pParams->priority  = 1;
+    pParams->stack     = NULL;
+    pParams->stackSize = 1024;
+
+    return;
+}
+
+Task_Handle Task_create(Task_FuncPtr fxn, const Task_Params* pParams, Error_Block* pEb)
+{
+    Task_Handle    task;
+    pthread_attr_t attr;
+
+    (void)pEb;
+
+    pthread_mutex_lock(&cpuLock);
+
+    if ( taskCount == SIM_MAX_TASKS )
+    {
+        pthread_mutex_unlock(&cpuLock);
+
+        return NULL;
+    }
+
+    task = &tasks[taskCount++];
+
+    task->fxn       = fxn;
+    task->arg0      = pParams->arg0;
+    task->arg1      = pParams->arg1;
+    task->priority  = pParams->priority;
+    task->stackSize = pParams->stackSize;
+
+    //
+    // Ready queue order: the new task runs after
+    // the tasks that are ready now
+    //
+    task->ticket    = nextTicket++;
+
+    pthread_mutex_unlock(&cpuLock);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    pthread_create(&task->thread, &attr, taskEntry, task);
+    pthread_attr_destroy(&attr);
+
+    return task;
+}
+
+Task_Handle Task_self(void)
+{
+    return self;
+}
+
+void Task_yield(void)
+{
+    if ( !bHoldsCpu )
+    {
+        return;
+    }
+
+    releaseCpu();
+
+    acquireCpu();
+
+    return;
+}
+
+/*
+ * === Task_disable
+ * Tasks switch only where they block or yield here, a section
+ * which does neither already runs without a switch.
+ */
+UInt Task_disable(void)
+{
+    return 0;
+}
+
+void Task_restore(UInt key)
+{
+    (void)key;
+
+    return;
+}
+
+void Task_sleep(UInt32 ticks)
+{
+    struct timespec deadline;
+    bool            bReleased = bHoldsCpu;
+
+    deadlineOf(ticks, &deadline);
+
+    if ( bReleased )
+    {
+        releaseCpu();
+    }
+
+    while ( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR );
+
+    if ( bReleased )
+    {
+        acquireCpu();
+    }
+
+    return;
+}
+
+/*
+ * === Task_stat
+ * Stack use of a host thread says nothing about the target,
+ * high-water marks are reported as 0.
+ */
+void Task_stat(Task_Handle handle, Task_Stat* pStat)
+{
+    pStat->priority  = handle->priority;
+    pStat->stack     = NULL;
+    pStat->stackSize = handle->stackSize;
+    pStat->stackHeap = NULL;
+    pStat->env       = NULL;
+    pStat->mode      = ( handle == holder ) ? 0 : 1;
+    pStat->sp        = NULL;
+    pStat->used      = 0;
+
+    return;
+}
+
+///////////////////////////
+// Semaphore
+//
+
+void Semaphore_Params_init(Semaphore_Params* pParams)
+{
+    pParams->mode = Semaphore_Mode_COUNTING;
+
+    return;
+}
+
+Semaphore_Handle Semaphore_create(Int count, const Semaphore_Params* pParams, Error_Block* pEb)
+{
+    Semaphore_Handle sem = calloc(1, sizeof(*sem));
+
+    (void)pEb;
+
+    pthread_mutex_init(&sem->lock, NULL);
+
+    initCond(&sem->cond);
+
+    sem->mode  = ( pParams != NULL ) ? pParams->mode : Semaphore_Mode_COUNTING;
+    sem->count = count;
+
+    return sem;
+}
+
+/*
+ * === Semaphore_pend
+ * A task gives the CPU away only when it has to wait.
+ */
+Bool Semaphore_pend(Semaphore_Handle handle, UInt32 timeout)
+{
+    struct timespec deadline;
+    bool            bReleased = false;
+    Bool            bTaken;
+
+    pthread_mutex_lock(&handle->lock);
+
+    if ( handle->count == 0 && timeout != BIOS_NO_WAIT )
+    {
+        if ( bHoldsCpu )
+        {
+            releaseCpu();
+
+            bReleased = true;
+        }
+
+        deadlineOf(timeout, &deadline);
+
+        while ( handle->count == 0 )
+        {
+            if ( timeout == BIOS_WAIT_FOREVER )
+            {
+                pthread_cond_wait(&handle->cond, &handle->lock);
+            }
+            else if ( pthread_cond_timedwait(&handle->cond, &handle->lock, &deadline) == ETIMEDOUT )
+            {
+                break;
+            }
+        }
+    }
+
+    bTaken = ( handle->count > 0 );
+
+    if ( bTaken )
+    {
+        handle->count--;
+    }
+
+    pthread_mutex_unlock(&handle->lock);
+
+    if ( bReleased )
+    {
+        acquireCpu();
+    }
+
+    return bTaken;
+}
+
+void Semaphore_post(Semaphore_Handle handle)
+{
+    pthread_mutex_lock(&handle->lock);
+
+    if ( handle->mode == Semaphore_Mode_BINARY )
+    {
+        handle->count = 1;
+    }
+    else
+    {
+        handle->count++;
+    }
+
+    pthread_cond_signal(&handle->cond);
+
+    pthread_mutex_unlock(&handle->lock);
+
+    return;
+}
+
+///////////////////////////
+// Event
+//
+
+Event_Handle Event_create(const Event_Params* pParams, Error_Block* pEb)
+{
+    Event_Handle event = calloc(1, sizeof(*event));
+
+    (void)pParams;
+    (void)pEb;
+
+    pthread_mutex_init(&event->lock, NULL);
+
+    initCond(&event->cond);
+
+    return event;
+}
+
+void Event_post(Event_Handle handle, UInt eventId)
+{
+    pthread_mutex_lock(&handle->lock);
+
+    handle->posted |= eventId;
+
+    pthread_cond_broadcast(&handle->cond);
+
+    pthread_mutex_unlock(&handle->lock);
+
+    return;
+}
+
+static UInt matchEvents(Event_Handle handle, UInt andMask, UInt orMask)
+{
+    UInt matched = handle->posted & orMask;
+
+    if ( andMask != 0 && ( handle->posted & andMask ) == andMask )
+    {
+        matched |= andMask;
+    }
+
+    return matched;
+}
+
+/*
+ * === Event_pend
+ * Consumes and returns the events that satisfied the masks,
+ * 0 on timeout.
+ */
+UInt Event_pend(Event_Handle handle, UInt andMask, UInt orMask, UInt32 timeout)
+{
+    struct timespec deadline;
+    bool            bReleased = false;
+    UInt            matched;
+
+    pthread_mutex_lock(&handle->lock);
+
+    matched = matchEvents(handle, andMask, orMask);
+
+    if ( matched == 0 && timeout != BIOS_NO_WAIT )
+    {
+        if ( bHoldsCpu )
+        {
+            releaseCpu();
+
+            bReleased = true;
+        }
+
+        deadlineOf(timeout, &deadline);
+
+        while ( ( matched = matchEvents(handle, andMask, orMask) ) == 0 )
+        {
+            if ( timeout == BIOS_WAIT_FOREVER )
+            {
+                pthread_cond_wait(&handle->cond, &handle->lock);
+            }
+            else if ( pthread_cond_timedwait(&handle->cond, &handle->lock, &deadline) == ETIMEDOUT )
+            {
+                break;
+            }
+        }
+    }
+
+    handle->posted &= ~matched;
+
+    pthread_mutex_unlock(&handle->lock);
+
+    if ( bReleased )
+    {
+        acquireCpu();
+    }
+
+    return matched;
+}
+
+///////////////////////////
+// Mailbox
+//
+
+Mailbox_Handle Mailbox_create(SizeT msgSize, UInt numMsgs, const Mailbox_Params* pParams, Error_Block* pEb)
+{
+    Mailbox_Handle mbx = calloc(1, sizeof(*mbx));
+
+    (void)pParams;
+    (void)pEb;
+
+    pthread_mutex_init(&mbx->lock, NULL);
+
+    initCond(&mbx->cond);
+
+    mbx->msgSize = msgSize;
+    mbx->numMsgs = numMsgs;
+    mbx->pBuffer = calloc(numMsgs, msgSize);
+
+    return mbx;
+}
+
+static bool mailboxReady(Mailbox_Handle handle, bool bPost)
+{
+    return bPost ? ( handle->count < handle->numMsgs ) : ( handle->count > 0 );
+}
+
+/*
+ * === waitMailbox
+ * Called with the mailbox locked, waits until a slot is free (post)
+ * or a message came (pend). Like Semaphore_pend() a task gives the
+ * CPU away only when it has to wait, it takes it back once the
+ * mailbox is unlocked. Returns false on timeout.
+ */
+static bool waitMailbox(Mailbox_Handle handle, bool bPost, UInt32 timeout, bool* pReleased)
+{
+    struct timespec deadline;
+
+    if ( !mailboxReady(handle, bPost) && timeout != BIOS_NO_WAIT )
+    {
+        if ( bHoldsCpu )
+        {
+            releaseCpu();
+
+            *pReleased = true;
+        }
+
+        deadlineOf(timeout, &deadline);
+
+        while ( !mailboxReady(handle, bPost) )
+        {
+            if ( timeout == BIOS_WAIT_FOREVER )
+            {
+                pthread_cond_wait(&handle->cond, &handle->lock);
+            }
+            else if ( pthread_cond_timedwait(&handle->cond, &handle->lock, &deadline) == ETIMEDOUT )
+            {
+                break;
+            }
+        }
+    }
+
+    return mailboxReady(handle, bPost);
+}
+
+/*
+ * === Mailbox_post
+ * Copies the message in, Swi and Hwi have to use BIOS_NO_WAIT.
+ */
+Bool Mailbox_post(Mailbox_Handle handle, Ptr msg, UInt32 timeout)
+{
+    bool bReleased = false;
+    Bool bPosted;
+
+    pthread_mutex_lock(&handle->lock);
+
+    bPosted = waitMailbox(handle, true, timeout, &bReleased);
+
+    if ( bPosted )
+    {
+        memcpy(handle->pBuffer + ( ( handle->head + handle->count ) % handle->numMsgs ) * handle->msgSize,
+               msg, handle->msgSize);
+
+        handle->count++;
+
+        pthread_cond_broadcast(&handle->cond);
+    }
+
+    pthread_mutex_unlock(&handle->lock);
+
+    if ( bReleased )
+    {
+        acquireCpu();
+    }
+
+    return bPosted;
+}
+
+Bool Mailbox_pend(Mailbox_Handle handle, Ptr msg, UInt32 timeout)
+{
+    bool bReleased = false;
+    Bool bTaken;
+
+    pthread_mutex_lock(&handle->lock);
+
+    bTaken = waitMailbox(handle, false, timeout, &bReleased);
+
+    if ( bTaken )
+    {
+        memcpy(msg, handle->pBuffer + handle->head * handle->msgSize, handle->msgSize);
+
+        handle->head = ( handle->head + 1 ) % handle->numMsgs;
+
+        handle->count--;
+
+        pthread_cond_broadcast(&handle->cond);
+    }
+
+    pthread_mutex_unlock(&handle->lock);
+
+    if ( bReleased )
+    {
+        acquireCpu();
+    }
+
+    return bTaken;
+}
+
+Int Mailbox_getNumPendingMsgs(Mailbox_Handle handle)
+{
+    Int count;
+
+    pthread_mutex_lock(&handle->lock);
+
+    count = (Int)handle->count;
+
+    pthread_mutex_unlock(&handle->lock);
+
+    return count;
+}
+
+///////////////////////////
+// Time
+//
+
+UInt32 Clock_getTicks(void)
+{
+    return (UInt32)( ( nowNs() - startNs ) / NS_PER_TICK );
+}
+
+UInt32 Timestamp_get32(void)
+{
+    return Sim_GetCycles();
+}
+
+void Timestamp_getFreq(Types_FreqHz* pFreq)
+{
+    pFreq->hi = 0;
+    pFreq->lo = SIM_CPU_HZ;
+
+    return;
+}
+
+void Seconds_getTime(Seconds_Time* pTime)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    pTime->secsHi = 0;
+    pTime->secs   = (UInt32)ts.tv_sec;
+    pTime->nsecs  = (UInt32)ts.tv_nsec;
+
+    return;
+}
+
+/*
+ * === usleep
+ * TI POSIX usleep() sleeps the calling task, so does this one
+ * (replaces the C library's for the whole simulation).
+ */
+int usleep(useconds_t us)
+{
+    struct timespec ts;
+    bool            bReleased = bHoldsCpu;
+
+    ts.tv_sec  = us / 1000000;
+    ts.tv_nsec = ( us % 1000000 ) * 1000L;
+
+    if ( bReleased )
+    {
+        releaseCpu();
+    }
+
+    while ( nanosleep(&ts, &ts) != 0 && errno == EINTR );
+
+    if ( bReleased )
+    {
+        acquireCpu();
+    }
+
+    return 0;
+}
+
+///////////////////////////
+// Load, Hwi
+//
+
+/*
+ * === Load_update
+ * Closes the Load window: CPU time every task held the CPU since
+ * the previous update. Time nobody held it is Idle.
+ */
+void Load_update(void)
+{
+    uint64_t now;
+    unsigned i;
+
+    pthread_mutex_lock(&cpuLock);
+
+    now = nowNs();
+
+    if ( holder != NULL )
+    {
+        holder->busyNs += now - holderSince;
+        holderSince     = now;
+    }
+
+    loadWindowNs = now - loadMarkNs;
+    loadMarkNs   = now;
+    loadBusyNs   = 0;
+
+    for ( i = 0; i < taskCount; i++ )
+    {
+        tasks[i].windowNs = tasks[i].busyNs - tasks[i].markNs;
+        tasks[i].markNs   = tasks[i].busyNs;
+
+        loadBusyNs += tasks[i].windowNs;
+    }
+
+    pthread_mutex_unlock(&cpuLock);
+
+    return;
+}
+
+UInt32 Load_getCPULoad(void)
+{
+    return ( loadWindowNs != 0 ) ? (UInt32)( loadBusyNs * 100 / loadWindowNs ) : 0;
+}
+
+Bool Load_getTaskLoad(Task_Handle handle, Load_Stat* pStat)
+{
+    pStat->threadTime = (UInt32)( handle->windowNs / 1000 );
+    pStat->totalTime  = (UInt32)( loadWindowNs / 1000 );
+
+    return ( loadWindowNs != 0 );
+}
+
+//
+// Interrupts are not timed by the simulation
+//
+Bool Load_getGlobalHwiLoad(Load_Stat* pStat)
+{
+    (void)pStat;
+
+    return false;
+}
+
+Bool Load_getGlobalSwiLoad(Load_Stat* pStat)
+{
+    (void)pStat;
+
+    return false;
+}
+
+UInt32 Load_calculateLoad(Load_Stat* pStat)
+{
+    return ( pStat->totalTime != 0 ) ? (UInt32)( (uint64_t)pStat->threadTime * 100 / pStat->totalTime ) : 0;
+}
+
+Bool Hwi_getStackInfo(Hwi_StackInfo* pStackInfo, Bool computeStackDepth)
+{
+    (void)computeStackDepth;
+
+    pStackInfo->hwiStackPeak = 0;
+    pStackInfo->hwiStackSize = HWI_STACK_SIZE;
+    pStackInfo->hwiStackBase = NULL;
+
+    return false;
+}
+
+// ==============================================================================================================
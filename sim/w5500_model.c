@@ -0,0 +1,835 @@
+/*
+ * w5500_model.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+//
+// Host simulation: W5500 behind SPI. Register map, socket buffers
+// and the socket commands multiSniff uses, the network side is the
+// host API at the end (benchmark acts as the peer). TCP is reduced
+// to its states, UDP datagrams keep the 8 byte RX header. Every SPI
+// frame is counted and annotated with SIM_SPI_CYCLES_*.
+//
+
+// === INCLUDES =================================================================================================
+
+#define _GNU_SOURCE
+
+#include <pthread.h>
+
+#include <string.h>
+
+#include "sim.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define SOCKETS                 (8)
+#define SOCKET_BUFFER_MAX       (0x4000)
+#define SOCKET_REGS             (0x30)
+#define COMMON_REGS             (0x40)
+
+//
+// Control byte: [block select, 5 bits][RWB][OM, 2 bits]
+//
+#define CB_WRITE                (0x04)
+#define CB_BLOCK(cb)            ( (cb) >> 3 )
+#define BLOCK_COMMON            (0x00)
+#define BLOCK_SOCKET(b)         ( (b) >> 2 )
+#define BLOCK_KIND(b)           ( (b) & 0x03 )
+#define KIND_REGS               (1)
+#define KIND_TX                 (2)
+#define KIND_RX                 (3)
+
+//
+// Common registers
+//
+#define MR                      (0x00)
+#define MR_RST                  (0x80)
+#define IR                      (0x15)
+#define IMR                     (0x16)
+#define SIR                     (0x17)
+#define SIMR                    (0x18)
+#define PHYCFGR                 (0x2E)
+#define VERSIONR                (0x39)
+
+#define PHYCFGR_LINK_100_FULL   (0xBF)
+#define VERSION                 (0x04)
+
+//
+// Socket registers
+//
+#define Sn_MR                   (0x00)
+#define Sn_CR                   (0x01)
+#define Sn_IR                   (0x02)
+#define Sn_SR                   (0x03)
+#define Sn_PORT                 (0x04)
+#define Sn_DIPR                 (0x0C)
+#define Sn_DPORT                (0x10)
+#define Sn_RXBUF_SIZE           (0x1E)
+#define Sn_TXBUF_SIZE           (0x1F)
+#define Sn_TX_FSR               (0x20)
+#define Sn_TX_RD                (0x22)
+#define Sn_TX_WR                (0x24)
+#define Sn_RX_RSR               (0x26)
+#define Sn_RX_RD                (0x28)
+#define Sn_RX_WR                (0x2A)
+#define Sn_IMR                  (0x2C)
+
+#define MODE_TCP                (0x01)
+#define MODE_UDP                (0x02)
+
+#define CMD_OPEN                (0x01)
+#define CMD_LISTEN              (0x02)
+#define CMD_CONNECT             (0x04)
+#define CMD_DISCON              (0x08)
+#define CMD_CLOSE               (0x10)
+#define CMD_SEND                (0x20)
+#define CMD_SEND_MAC            (0x21)
+#define CMD_RECV                (0x40)
+
+#define IR_SEND_OK              (0x10)
+#define IR_RECV                 (0x04)
+#define IR_DISCON               (0x02)
+#define IR_CON                  (0x01)
+
+#define SR_CLOSED               (0x00)
+#define SR_INIT                 (0x13)
+#define SR_LISTEN               (0x14)
+#define SR_ESTABLISHED          (0x17)
+#define SR_CLOSE_WAIT           (0x1C)
+#define SR_UDP                  (0x22)
+
+#define UDP_HEADER_SIZE         (8)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef enum
+{
+    PHASE_ADDR_HI,
+    PHASE_ADDR_LO,
+    PHASE_CONTROL,
+    PHASE_DATA
+} Phase_t;
+
+typedef struct Socket
+{
+    uint8_t regs[SOCKET_REGS];
+    uint8_t tx[SOCKET_BUFFER_MAX];
+    uint8_t rx[SOCKET_BUFFER_MAX];
+} Socket_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static pthread_mutex_t     modelLock = PTHREAD_MUTEX_INITIALIZER;
+
+static uint8_t             common[COMMON_REGS];
+
+static Socket_t            sockets[SOCKETS];
+
+static bool                bIntAsserted;
+
+static bool                bSelected;
+
+static Phase_t             phase;
+
+static uint16_t            address;
+
+static uint8_t             controlByte;
+
+static SimW5500_Sink_t     sink;
+
+static SimW5500_Counters_t counters;
+
+//
+// One datagram or TCP segment, contiguous for the sink
+//
+static uint8_t             sendBuffer[SOCKET_BUFFER_MAX];
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint16_t get16(const uint8_t* pRegs, uint8_t addr)
+{
+    return (uint16_t)( ( pRegs[addr] << 8 ) | pRegs[addr + 1] );
+}
+
+static void set16(uint8_t* pRegs, uint8_t addr, uint16_t value)
+{
+    pRegs[addr]     = (uint8_t)( value >> 8 );
+    pRegs[addr + 1] = (uint8_t)value;
+
+    return;
+}
+
+static uint16_t txSize(const Socket_t* pSocket)
+{
+    return (uint16_t)( pSocket->regs[Sn_TXBUF_SIZE] * 1024 );
+}
+
+static uint16_t rxSize(const Socket_t* pSocket)
+{
+    return (uint16_t)( pSocket->regs[Sn_RXBUF_SIZE] * 1024 );
+}
+
+static uint16_t rxReceived(const Socket_t* pSocket)
+{
+    return (uint16_t)( get16(pSocket->regs, Sn_RX_WR) - get16(pSocket->regs, Sn_RX_RD) );
+}
+
+static void resetLocked(void)
+{
+    uint8_t s;
+
+    memset(common, 0, sizeof(common));
+    memset(sockets, 0, sizeof(sockets));
+
+    for ( s = 0; s < SOCKETS; s++ )
+    {
+        sockets[s].regs[Sn_RXBUF_SIZE] = 2;
+        sockets[s].regs[Sn_TXBUF_SIZE] = 2;
+        sockets[s].regs[Sn_IMR]        = 0xFF;
+    }
+
+    phase        = PHASE_ADDR_HI;
+    bIntAsserted = false;
+
+    return;
+}
+
+static uint8_t socketInterrupts(void)
+{
+    uint8_t sir = 0;
+    uint8_t s;
+
+    for ( s = 0; s < SOCKETS; s++ )
+    {
+        if ( sockets[s].regs[Sn_IR] & sockets[s].regs[Sn_IMR] )
+        {
+            sir |= (uint8_t)( 1 << s );
+        }
+    }
+
+    return sir;
+}
+
+/*
+ * === updateInt
+ * INT is low while an unmasked interrupt is pending.
+ *
+ * Returns:
+ *      true on the falling edge, the caller signals it
+ *      with SimGpio_SetInt() once the model is unlocked
+ */
+static bool updateInt(void)
+{
+    bool bAsserted = ( common[IR] & common[IMR] ) || ( socketInterrupts() & common[SIMR] );
+    bool bEdge     = bAsserted && !bIntAsserted;
+
+    bIntAsserted = bAsserted;
+
+    return bEdge;
+}
+
+static void commandSend(uint8_t s)
+{
+    Socket_t* pSocket = &sockets[s];
+    uint16_t  size    = txSize(pSocket);
+    uint16_t  rd      = get16(pSocket->regs, Sn_TX_RD);
+    uint16_t  wr      = get16(pSocket->regs, Sn_TX_WR);
+    uint16_t  len     = (uint16_t)( wr - rd );
+    uint16_t  i;
+
+    if ( len > size )
+    {
+        len = size;
+    }
+
+    for ( i = 0; i < len; i++ )
+    {
+        sendBuffer[i] = pSocket->tx[(uint16_t)( rd + i ) & ( size - 1 )];
+    }
+
+    set16(pSocket->regs, Sn_TX_RD, wr);
+
+    pSocket->regs[Sn_IR] |= IR_SEND_OK;
+
+    counters.sends++;
+
+    if ( sink != NULL )
+    {
+        sink(s, pSocket->regs[Sn_SR] == SR_UDP, &pSocket->regs[Sn_DIPR], get16(pSocket->regs, Sn_DPORT), sendBuffer, len);
+    }
+
+    return;
+}
+
+static void command(uint8_t s, uint8_t cmd)
+{
+    Socket_t* pSocket = &sockets[s];
+    uint8_t*  pRegs   = pSocket->regs;
+
+    switch ( cmd )
+    {
+    case CMD_OPEN:
+        switch ( pRegs[Sn_MR] & 0x0F )
+        {
+        case MODE_TCP:
+            pRegs[Sn_SR] = SR_INIT;
+            break;
+
+        case MODE_UDP:
+            pRegs[Sn_SR] = SR_UDP;
+            break;
+
+        default:
+            pRegs[Sn_SR] = SR_CLOSED;
+            break;
+        }
+
+        set16(pRegs, Sn_TX_RD, 0);
+        set16(pRegs, Sn_TX_WR, 0);
+        set16(pRegs, Sn_RX_RD, 0);
+        set16(pRegs, Sn_RX_WR, 0);
+        break;
+
+    case CMD_LISTEN:
+        if ( pRegs[Sn_SR] == SR_INIT )
+        {
+            pRegs[Sn_SR] = SR_LISTEN;
+        }
+        break;
+
+    case CMD_CONNECT:
+        if ( pRegs[Sn_SR] == SR_INIT )
+        {
+            pRegs[Sn_SR]  = SR_ESTABLISHED;
+            pRegs[Sn_IR] |= IR_CON;
+        }
+        break;
+
+    case CMD_DISCON:
+        pRegs[Sn_SR]  = SR_CLOSED;
+        pRegs[Sn_IR] |= IR_DISCON;
+        break;
+
+    case CMD_CLOSE:
+        pRegs[Sn_SR]  = SR_CLOSED;
+        break;
+
+    case CMD_SEND:
+    case CMD_SEND_MAC:
+        commandSend(s);
+        break;
+
+    case CMD_RECV:
+        if ( rxReceived(pSocket) != 0 )
+        {
+            pRegs[Sn_IR] |= IR_RECV;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+static uint8_t readByte(uint8_t block, uint16_t addr)
+{
+    Socket_t* pSocket;
+
+    if ( block == BLOCK_COMMON )
+    {
+        switch ( addr )
+        {
+        case SIR:
+            return socketInterrupts();
+
+        case PHYCFGR:
+            return PHYCFGR_LINK_100_FULL;
+
+        case VERSIONR:
+            return VERSION;
+
+        default:
+            return ( addr < COMMON_REGS ) ? common[addr] : 0;
+        }
+    }
+
+    pSocket = &sockets[BLOCK_SOCKET(block) % SOCKETS];
+
+    switch ( BLOCK_KIND(block) )
+    {
+    case KIND_REGS:
+        switch ( addr )
+        {
+        case Sn_CR:
+            return 0;
+
+        case Sn_TX_FSR:
+        case Sn_TX_FSR + 1:
+        {
+            uint16_t room = txSize(pSocket) - (uint16_t)( get16(pSocket->regs, Sn_TX_WR) - get16(pSocket->regs, Sn_TX_RD) );
+
+            return ( addr == Sn_TX_FSR ) ? (uint8_t)( room >> 8 ) : (uint8_t)room;
+        }
+
+        case Sn_RX_RSR:
+        case Sn_RX_RSR + 1:
+        {
+            uint16_t received = rxReceived(pSocket);
+
+            return ( addr == Sn_RX_RSR ) ? (uint8_t)( received >> 8 ) : (uint8_t)received;
+        }
+
+        default:
+            return ( addr < SOCKET_REGS ) ? pSocket->regs[addr] : 0;
+        }
+
+    case KIND_TX:
+        return pSocket->tx[addr & ( txSize(pSocket) - 1 )];
+
+    case KIND_RX:
+        return pSocket->rx[addr & ( rxSize(pSocket) - 1 )];
+
+    default:
+        return 0;
+    }
+}
+
+static void writeByte(uint8_t block, uint16_t addr, uint8_t value)
+{
+    Socket_t* pSocket;
+
+    if ( block == BLOCK_COMMON )
+    {
+        if ( addr == MR && ( value & MR_RST ) )
+        {
+            resetLocked();
+        }
+        else if ( addr == IR )
+        {
+            common[IR] &= (uint8_t)~value;
+        }
+        else if ( addr < COMMON_REGS && addr != SIR && addr != PHYCFGR && addr != VERSIONR )
+        {
+            common[addr] = value;
+        }
+
+        return;
+    }
+
+    pSocket = &sockets[BLOCK_SOCKET(block) % SOCKETS];
+
+    switch ( BLOCK_KIND(block) )
+    {
+    case KIND_REGS:
+        if ( addr == Sn_CR )
+        {
+            command(BLOCK_SOCKET(block) % SOCKETS, value);
+        }
+        else if ( addr == Sn_IR )
+        {
+            pSocket->regs[Sn_IR] &= (uint8_t)~value;
+        }
+        else if ( addr == Sn_RXBUF_SIZE || addr == Sn_TXBUF_SIZE )
+        {
+            //
+            // 0, 1, 2, 4, 8 or 16 kB
+            //
+            pSocket->regs[addr] = ( value <= 16 && ( value & ( value - 1 ) ) == 0 ) ? value : pSocket->regs[addr];
+        }
+        else if ( addr < SOCKET_REGS && addr != Sn_SR && ( addr & ~1 ) != Sn_TX_FSR
+               && ( addr & ~1 ) != Sn_TX_RD && ( addr & ~1 ) != Sn_RX_RSR && ( addr & ~1 ) != Sn_RX_WR )
+        {
+            pSocket->regs[addr] = value;
+        }
+        break;
+
+    case KIND_TX:
+        pSocket->tx[addr & ( txSize(pSocket) - 1 )] = value;
+        break;
+
+    default:
+        break;
+    }
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === SimW5500_Reset
+ * RESET pin released: registers to their reset values.
+ */
+void SimW5500_Reset(void)
+{
+    pthread_mutex_lock(&modelLock);
+
+    resetLocked();
+
+    pthread_mutex_unlock(&modelLock);
+
+    return;
+}
+
+void SimW5500_Select(bool bSelect)
+{
+    pthread_mutex_lock(&modelLock);
+
+    if ( bSelect && !bSelected )
+    {
+        counters.frames++;
+    }
+
+    if ( bSelect != bSelected )
+    {
+        counters.cycles += SIM_SPI_CYCLES_CS;
+    }
+
+    bSelected = bSelect;
+    phase     = PHASE_ADDR_HI;
+
+    pthread_mutex_unlock(&modelLock);
+
+    return;
+}
+
+/*
+ * === SimW5500_Transfer
+ * One SPI_transfer() of the firmware: shifts count bytes
+ * through the frame state machine, addresses auto-increment.
+ *
+ * Parameters:
+ *      pTx[in]         - MOSI bytes, NULL for zeros
+ *      pRx[out]        - MISO bytes, may be NULL
+ *      count[in]       - number of bytes
+ * Returns:
+ *      N/A
+ */
+void SimW5500_Transfer(const uint8_t* pTx, uint8_t* pRx, size_t count)
+{
+    uint8_t mosi;
+    uint8_t miso;
+    size_t  i;
+    bool    bEdge;
+
+    pthread_mutex_lock(&modelLock);
+
+    counters.transfers++;
+    counters.bytes  += count;
+    counters.cycles += SIM_SPI_CYCLES_TRANSFER + SIM_SPI_CYCLES_BYTE * count;
+
+    for ( i = 0; i < count; i++ )
+    {
+        mosi = ( pTx != NULL ) ? pTx[i] : 0;
+        miso = 0;
+
+        if ( !bSelected )
+        {
+            // Bus not addressed, MISO floats
+        }
+        else if ( phase == PHASE_ADDR_HI )
+        {
+            address = (uint16_t)( mosi << 8 );
+            phase   = PHASE_ADDR_LO;
+        }
+        else if ( phase == PHASE_ADDR_LO )
+        {
+            address |= mosi;
+            phase    = PHASE_CONTROL;
+        }
+        else if ( phase == PHASE_CONTROL )
+        {
+            controlByte = mosi;
+            phase       = PHASE_DATA;
+        }
+        else if ( controlByte & CB_WRITE )
+        {
+            writeByte(CB_BLOCK(controlByte), address++, mosi);
+        }
+        else
+        {
+            miso = readByte(CB_BLOCK(controlByte), address++);
+        }
+
+        if ( pRx != NULL )
+        {
+            pRx[i] = miso;
+        }
+    }
+
+    bEdge = updateInt();
+
+    pthread_mutex_unlock(&modelLock);
+
+    if ( bEdge )
+    {
+        SimGpio_SetInt(true);
+    }
+
+    return;
+}
+
+void SimW5500_SetSink(SimW5500_Sink_t newSink)
+{
+    pthread_mutex_lock(&modelLock);
+
+    sink = newSink;
+
+    pthread_mutex_unlock(&modelLock);
+
+    return;
+}
+
+void SimW5500_GetCounters(SimW5500_Counters_t* pCounters)
+{
+    pthread_mutex_lock(&modelLock);
+
+    *pCounters = counters;
+
+    pthread_mutex_unlock(&modelLock);
+
+    return;
+}
+
+/*
+ * === SimW5500_FindSocket
+ * Returns:
+ *      first socket in the status bound to the local
+ *      port, -1 if none
+ */
+int SimW5500_FindSocket(uint8_t status, uint16_t port)
+{
+    int found = -1;
+    int s;
+
+    pthread_mutex_lock(&modelLock);
+
+    for ( s = 0; s < SOCKETS && found < 0; s++ )
+    {
+        if ( sockets[s].regs[Sn_SR] == status && get16(sockets[s].regs, Sn_PORT) == port )
+        {
+            found = s;
+        }
+    }
+
+    pthread_mutex_unlock(&modelLock);
+
+    return found;
+}
+
+/*
+ * === SimW5500_Connect
+ * Peer connects to a listening socket.
+ */
+bool SimW5500_Connect(uint8_t sock, const uint8_t* pPeerIp, uint16_t peerPort)
+{
+    uint8_t* pRegs = sockets[sock % SOCKETS].regs;
+    bool     bConnected;
+    bool     bEdge;
+
+    pthread_mutex_lock(&modelLock);
+
+    bConnected = ( pRegs[Sn_SR] == SR_LISTEN );
+
+    if ( bConnected )
+    {
+        pRegs[Sn_SR]  = SR_ESTABLISHED;
+        pRegs[Sn_IR] |= IR_CON;
+
+        memcpy(&pRegs[Sn_DIPR], pPeerIp, 4);
+        set16(pRegs, Sn_DPORT, peerPort);
+    }
+
+    bEdge = updateInt();
+
+    pthread_mutex_unlock(&modelLock);
+
+    if ( bEdge )
+    {
+        SimGpio_SetInt(true);
+    }
+
+    return bConnected;
+}
+
+/*
+ * === SimW5500_Push
+ * Peer sends TCP data.
+ *
+ * Returns:
+ *      number of bytes the RX buffer took
+ */
+uint16_t SimW5500_Push(uint8_t sock, const uint8_t* pData, uint16_t len)
+{
+    Socket_t* pSocket = &sockets[sock % SOCKETS];
+    uint16_t  wr;
+    uint16_t  room;
+    uint16_t  i;
+    bool      bEdge;
+
+    pthread_mutex_lock(&modelLock);
+
+    room = ( pSocket->regs[Sn_SR] == SR_ESTABLISHED ) ? rxSize(pSocket) - rxReceived(pSocket) : 0;
+
+    if ( len > room )
+    {
+        len = room;
+    }
+
+    wr = get16(pSocket->regs, Sn_RX_WR);
+
+    for ( i = 0; i < len; i++ )
+    {
+        pSocket->rx[(uint16_t)( wr + i ) & ( rxSize(pSocket) - 1 )] = pData[i];
+    }
+
+    set16(pSocket->regs, Sn_RX_WR, wr + len);
+
+    if ( len != 0 )
+    {
+        pSocket->regs[Sn_IR] |= IR_RECV;
+    }
+
+    bEdge = updateInt();
+
+    pthread_mutex_unlock(&modelLock);
+
+    if ( bEdge )
+    {
+        SimGpio_SetInt(true);
+    }
+
+    return len;
+}
+
+/*
+ * === SimW5500_PushUdp
+ * Peer sends a datagram to a local UDP port, stored
+ * behind the header the W5500 prepends (IP, port, length).
+ *
+ * Returns:
+ *      false when no socket is bound or the datagram
+ *      does not fit (dropped, as the chip does)
+ */
+bool SimW5500_PushUdp(uint16_t port, const uint8_t* pSrcIp, uint16_t srcPort, const uint8_t* pData, uint16_t len)
+{
+    Socket_t* pSocket = NULL;
+    uint8_t   header[UDP_HEADER_SIZE];
+    uint16_t  wr;
+    uint16_t  mask;
+    uint16_t  i;
+    uint8_t   s;
+    bool      bStored = false;
+    bool      bEdge;
+
+    pthread_mutex_lock(&modelLock);
+
+    for ( s = 0; s < SOCKETS && pSocket == NULL; s++ )
+    {
+        if ( sockets[s].regs[Sn_SR] == SR_UDP && get16(sockets[s].regs, Sn_PORT) == port )
+        {
+            pSocket = &sockets[s];
+        }
+    }
+
+    if ( pSocket != NULL && UDP_HEADER_SIZE + len <= rxSize(pSocket) - rxReceived(pSocket) )
+    {
+        memcpy(header, pSrcIp, 4);
+        set16(header, 4, srcPort);
+        set16(header, 6, len);
+
+        wr   = get16(pSocket->regs, Sn_RX_WR);
+        mask = rxSize(pSocket) - 1;
+
+        for ( i = 0; i < UDP_HEADER_SIZE; i++ )
+        {
+            pSocket->rx[wr++ & mask] = header[i];
+        }
+
+        for ( i = 0; i < len; i++ )
+        {
+            pSocket->rx[wr++ & mask] = pData[i];
+        }
+
+        set16(pSocket->regs, Sn_RX_WR, wr);
+
+        pSocket->regs[Sn_IR] |= IR_RECV;
+
+        bStored = true;
+    }
+
+    bEdge = updateInt();
+
+    pthread_mutex_unlock(&modelLock);
+
+    if ( bEdge )
+    {
+        SimGpio_SetInt(true);
+    }
+
+    return bStored;
+}
+
+/*
+ * === SimW5500_PeerClose
+ * Peer closes its side of the connection (FIN).
+ */
+void SimW5500_PeerClose(uint8_t sock)
+{
+    uint8_t* pRegs = sockets[sock % SOCKETS].regs;
+    bool     bEdge;
+
+    pthread_mutex_lock(&modelLock);
+
+    if ( pRegs[Sn_SR] == SR_ESTABLISHED )
+    {
+        pRegs[Sn_SR]  = SR_CLOSE_WAIT;
+        pRegs[Sn_IR] |= IR_DISCON;
+    }
+
+    bEdge = updateInt();
+
+    pthread_mutex_unlock(&modelLock);
+
+    if ( bEdge )
+    {
+        SimGpio_SetInt(true);
+    }
+
+    return;
+}
+
+uint8_t SimW5500_GetStatus(uint8_t sock)
+{
+    uint8_t status;
+
+    pthread_mutex_lock(&modelLock);
+
+    status = sockets[sock % SOCKETS].regs[Sn_SR];
+
+    pthread_mutex_unlock(&modelLock);
+
+    return status;
+}
+
+// ==============================================================================================================
@@ -19,11 +19,15 @@
 
 #include <ti/sysbios/knl/Semaphore.h>
 
+#include <ti/sysbios/knl/Clock.h>
+
 #include <stdint.h>
 
+#include <string.h>
+
 #include <source/queue/radio_queue.h>
 
-#include <source/utils/stv.h>
+#include <source/config/config.h>
 
 #include <source/ethernet/Ethernet.h>
 
@@ -31,113 +35,819 @@
 
 #include <source/radio_api/radio_api.h>
 
+#include <source/frame_parser/ieee_parser.h>
+
+#include <source/frame_parser/ble_parser.h>
+
+#include <source/trigger/trigger.h>
+
 #include <source/utils/restart.h>
 
+#include <source/utils/stats.h>
+
+#include <source/utils/boot_profile.h>
+
+#include <source/utils/trace.h>
+
+#include <source/ethernet/EthernetIrq.h>
+
+#include <source/control/control.h>
+
+#include <source/replay/replay.h>
+
 #include <sniffing_task.h>
 
 //===============================================================================================================
 
 extern Semaphore_Handle Dashboard_SemaphoreHandle;
 
+extern Semaphore_Handle Init_SemaphoreHandle;
+
+extern Event_Handle     Sniffing_EventHandle;
+
 void HandleIncomingRfPacket(uint8_t*, IPAddress, RF_Protocol_t, const uint8_t[]);
 
+void ForwardRfPacket(uint8_t*, uint16_t, IPAddress, RF_Protocol_t, const uint8_t[]);
+
+void HandleTrigger(uint8_t*, uint16_t, IPAddress, RF_Protocol_t, const uint8_t[]);
+
+void FlushBleRecords(IPAddress, bool);
+
+void SendStats(IPAddress);
+
+static uint8_t BeginDatagram(IPAddress, uint8_t, uint8_t*);
+
+static void WriteDatagram(const void*, uint16_t);
+
+static bool EndDatagram(void);
+
+static void OnCaptureSocketEvent(uint8_t, uint8_t);
+
+Control_Status_t ApplyControlBatch(const Control_Batch_t*, RF_Params*, RF_Object*, RF_Handle*, RF_Protocol_t*);
+
 EthernetUDP   ethernetUdp;
 
 rfc_bleGenericRxOutput_t bleStats;
 
 rfc_ieeeRxOutput_t ieeeStats;
 
+//
+// Consistent copy of the config used by this task, refreshed
+// when its generation is behind Config_GetGeneration()
+//
+static Config_Values_t settings;
+
+static uint32_t        settingsGeneration;
+
+//
+// Frame taken from the radio queue, kept off
+// the task stack (1028 bytes)
+//
+static uint8_t         packetBuffer[2047];
+
+//
+// RF driver client of this task, off the task stack as well
+//
+static RF_Object       rfObj;
+
+static RF_Params       rfParams;
+
+//
+// Latency of the frame being forwarded: its age at dequeue and
+// cycle counter (TRACE_CYCLES) at dequeue, SPI write done, SEND
+//
+static uint32_t        frameAgeUs = SNIFF_LATENCY_UNKNOWN;
+
+static uint32_t        dequeueCycles;
+
+static uint32_t        writtenCycles;
+
+static uint32_t        sentCycles;
+
+#define CYCLES_PER_US  ( TRACE_CPU_HZ / 1000000 )
+
+//
+// Sequence of the next datagram to the target, its lower 16 bits
+// go into every datagram. Write came back short in the datagram
+// being built (no room in W5500 TX buffer).
+//
+static uint32_t        datagramSequence;
+
+static bool            bShortWrite;
+
+//
+// Clock ticks (10 us) of the last SNIFF_TYPE_STATS datagram
+//
+static uint32_t        lastStatsTicks;
+
+#define STATS_PERIOD_TICKS  ( SNIFF_STATS_PERIOD_MS * 100 )
+
+//
+// Type byte and sequence, then age, IEEE summary or access address
+//
+#define SEQUENCE_HEADER_SIZE    (3)
+
+#define MAX_HEADER_SIZE         ( SEQUENCE_HEADER_SIZE + 4 + sizeof(IeeeParser_Summary_t) + 4 )
+
 // === MAIN TASK FUNCTION =======================================================================================
 
 void Sniffing_Main(UArg a0, UArg a1)
 {
-    RF_Object     rfObj;
-    RF_Params     rfParams;
-    RF_CmdHandle  rfCmdHnd;
     RF_Protocol_t currProto;
     RF_Handle     rfHnd;
-    uint8_t       packetBuffer[2047];
     const uint8_t accessAddress[] = {0xD6, 0xBE, 0x89, 0x8E};
-    IPAddress*    targetIp = (IPAddress*)STVW_TARGET_IP_ADDRESS;
-    uint8_t*      bSniffing = (uint8_t*)STVW_RUNNING_STATUS;
-    uint8_t*      bChange = (uint8_t*)STVW_SIGNAL_RF_CHANGE;
+    static Control_Batch_t batch;
 
 
+    Config_Snapshot(&settings, &settingsGeneration);
+
     RadioQueue_init();
 
     RadioQueue_reset();
 
-    EthernetUDP_begin_init(&ethernetUdp);
-
-    EthernetUDP_begin(&ethernetUdp, 2014, 3);
-
-    //Semaphore_post(Dashboard_SemaphoreHandle);
-
     currProto = Radio_GetCurrentProtocol();
 
     Radio_initRXCmd(&bleStats, &ieeeStats);
 
+    Radio_SetRxNotify(Sniffing_EventHandle, SNIFF_EVENT_FRAME);
+
+    Config_SetChangeNotify(Sniffing_EventHandle, SNIFF_EVENT_CONFIG);
+
     Radio_openRadioCore(&rfParams, &rfObj, currProto, &rfHnd);
 
     Radio_setFrequencySynthesizer(&rfHnd, currProto);
 
-    Radio_beginRX(rfHnd, currProto, &Radio_HandleQueueOverflow, RF_EventRxBufFull);
+    Radio_beginRX(rfHnd, currProto, &Radio_HandleRxEvent, RADIO_RX_EVENTS);
+
+    BootProfile_Mark(BOOT_PHASE_RADIO_RX);
+
+    //
+    // Frames are buffered in the radio queue until
+    // the init task has brought the network up
+    //
+    Semaphore_pend(Init_SemaphoreHandle, BIOS_WAIT_FOREVER);
+
+    EthernetUDP_begin_init(&ethernetUdp);
+
+    EthernetUDP_begin(&ethernetUdp, 2014, 3);
+
+    EthernetIrq_Register(ethernetUdp._sock, ETHIRQ_TIMEOUT, OnCaptureSocketEvent);
+
+    Control_Init();
+
+    Replay_Init();
+
+    BootProfile_Mark(BOOT_PHASE_CAPTURE);
 
     for (;;)
     {
+        //
+        // Control requests are applied between frames,
+        // both calls return without SPI access when idle
+        //
+        EthernetIrq_Service();
 
-        if (*bSniffing)
+        while ( Control_Receive(&batch) )
         {
-            HandleIncomingRfPacket(packetBuffer, *targetIp, currProto, accessAddress);
+            Control_Ack(&batch, ApplyControlBatch(&batch, &rfParams, &rfObj, &rfHnd, &currProto));
+
+            //
+            // After the ack, flash write must not delay it.
+            // Channel-only batches leave the config as it
+            // is and write nothing.
+            //
+            Config_Commit();
         }
 
-        if (*bChange)
+        //
+        // Settings changed (by either task), take a new copy.
+        // An update still in progress is picked up later.
+        //
+        if ( settingsGeneration != Config_GetGeneration() && Config_Snapshot(&settings, &settingsGeneration) )
         {
-            *bChange = 0x0;
+            if ( Event_pend(Config_EventHandle, Event_Id_NONE, CONFIG_EVENT_RF_CHANGE | CONFIG_EVENT_CHANGED, BIOS_NO_WAIT) & CONFIG_EVENT_RF_CHANGE )
+            {
+                Radio_stopRX(rfHnd);
+
+                RestartMCU();
+            }
+        }
+
+        //
+        // Trace records of all contexts, rate limited
+        //
+        Trace_Drain(&ethernetUdp, settings.targetIp);
+
+        //
+        // Test build (REPLAY_INJECT): recorded frames are
+        // written into the radio queue, no-op otherwise
+        //
+        Replay_Service(rfHnd, currProto);
 
-            Radio_stopRX(rfHnd);
+        //
+        // RF Core counters are narrow, extended every pass
+        //
+        Stats_SampleRadio(currProto);
 
-            RestartMCU();
+        if ( settings.running )
+        {
+            HandleIncomingRfPacket(packetBuffer, settings.targetIp, currProto, accessAddress);
+
+            SendStats(settings.targetIp);
+        }
+
+        //
+        // Sleep until a frame or W5500 INT comes, lower priority
+        // tasks (monitor, GUI) run meanwhile. With frames queued
+        // only tasks of the same priority get their turn.
+        //
+        if ( settings.running && RadioQueue_hasPacket() )
+        {
+            Task_yield();
+        }
+        else
+        {
+            Event_pend(Sniffing_EventHandle, Event_Id_NONE, SNIFF_EVENTS_ALL, SNIFF_IDLE_TICKS);
         }
-        Task_yield();
     }
 }
 
 
 /*
- * === TODO
- * Stops listening to RF frames.
- * Main purpose is to shadow TI's API for better readability
+ * === HandleIncomingRfPacket
+ * Takes one frame from the radio queue (if there is any) and forwards
+ * it to the target. BLE advertising PDUs are always decoded into
+ * BleParser_Record_t and pushed into the record ring. While trigger is
+ * in use, frames are handed over to HandleTrigger() instead. In
+ * records-only mode (settings.outputMode) raw BLE frames are not
+ * forwarded, records are sent in batches instead.
  *
  * Parameters:
- *      pHandle[in]             - handle to Radio Core
+ *      buffer[in]              - scratch buffer for the frame
+ *      targetIp[in]            - IP address of the target
+ *      proto[in]               - protocol the radio listens to
+ *      accessAddr[in]          - BLE access address to prepend
  * Returns:
- *      RF_Stat                 - Enum signaling successful completition
+ *      N/A
  */
 void HandleIncomingRfPacket(uint8_t* buffer, IPAddress targetIp, RF_Protocol_t proto, const uint8_t accessAddr[])
 {
-    //uint8_t buf[2047];
+    BleParser_Record_t record;
 
-    uint8_t ret = 0;
+    bool bRecordsOnly = settings.outputMode;
 
     uint16_t packetLen = RadioQueue_takePacket(buffer, 2047);
 
-    if (packetLen)
+    uint32_t ratStart;
+
+    uint32_t ageUs;
+
+    if ( packetLen <= RADIO_TIMESTAMP_LEN )
+    {
+        return;
+    }
+
+    dequeueCycles = TRACE_CYCLES();
+
+    Stats_Increment(STATS_RX_FRAMES);
+
+    BootProfile_Mark(BOOT_PHASE_FIRST_FRAME);
+
+    //
+    // RAT timestamp appended by RF Core (bAppendTimestamp = 1)
+    // follows all other appended bytes
+    //
+    packetLen -= RADIO_TIMESTAMP_LEN;
+
+    ratStart = (uint32_t)buffer[packetLen] | ( (uint32_t)buffer[packetLen + 1] << 8 ) | ( (uint32_t)buffer[packetLen + 2] << 16 ) | ( (uint32_t)buffer[packetLen + 3] << 24 );
+
+    if ( proto == BluetoothLowEnergy )
+    {
+        //
+        // RSSI appended by RF Core (bAppendRssi = 1) is not part
+        // of the frame, strip it so raw output stays unchanged.
+        //
+        packetLen--;
+
+        if ( BleParser_Parse(buffer, packetLen, (int8_t)buffer[packetLen], RFCMD_bleGenericRX.channel, &record) )
+        {
+            BleParser_PushRecord(&record);
+        }
+    }
+
+    ageUs = Radio_GetMicrosSinceRxEnd(proto, ratStart, packetLen);
+
+    Stats_Observe(STATS_HIST_FRAME_BYTES, packetLen);
+
+    Stats_Observe(STATS_HIST_LATENCY_QUEUE, ageUs);
+
+    if ( Trigger_GetState() != TRIGGER_OFF )
+    {
+        HandleTrigger(buffer, packetLen, targetIp, proto, accessAddr);
+
+        return;
+    }
+
+    if ( proto == BluetoothLowEnergy && bRecordsOnly )
+    {
+        Stats_Increment(STATS_RX_FILTERED);
+
+        FlushBleRecords(targetIp, !RadioQueue_hasPacket());
+
+        return;
+    }
+
+    frameAgeUs = ageUs;
+
+    ForwardRfPacket(buffer, packetLen, targetIp, proto, accessAddr);
+
+    frameAgeUs = SNIFF_LATENCY_UNKNOWN;
+
+    ///////////////////////////
+    // Per-stage latency, frames
+    // forwarded right away only
+    //
+    Stats_Observe(STATS_HIST_LATENCY_SPI,   ( writtenCycles - dequeueCycles ) / CYCLES_PER_US);
+    Stats_Observe(STATS_HIST_LATENCY_SEND,  ( sentCycles - writtenCycles ) / CYCLES_PER_US);
+    Stats_Observe(STATS_HIST_LATENCY_TOTAL, ageUs + ( sentCycles - dequeueCycles ) / CYCLES_PER_US);
+
+    return;
+}
+
+
+/*
+ * === ForwardRfPacket
+ * Forwards one frame to the target in a single UDP datagram. When IEEE
+ * header decoding is enabled (settings.ieeeDecode), 802.15.4 frames are
+ * prefixed with IeeeParser_Summary_t and the MPDU is cut to
+ * settings.ieeeSnaplen bytes. Built with SNIFF_LATENCY_HEADER, the
+ * sequence is followed by the age of the frame in microseconds (LE32)
+ * from the end of reception, SNIFF_LATENCY_UNKNOWN for trigger history.
+ *
+ * Parameters:
+ *      buffer[in]              - the frame
+ *      packetLen[in]           - length of the frame
+ *      targetIp[in]            - IP address of the target
+ *      proto[in]               - protocol the radio listens to
+ *      accessAddr[in]          - BLE access address to prepend
+ * Returns:
+ *      N/A
+ */
+void ForwardRfPacket(uint8_t* buffer, uint16_t packetLen, IPAddress targetIp, RF_Protocol_t proto, const uint8_t accessAddr[])
+{
+    bool    ret;
+
+    uint8_t snaplen;
+
+    uint8_t type = (uint8_t)proto;
+
+    uint8_t header[MAX_HEADER_SIZE];
+
+    uint8_t headerLen;
+
+    bool    bSummary = ( proto == IEEE_802_15_4 && settings.ieeeDecode );
+
+    IeeeParser_Summary_t summary;
+
+#ifdef SNIFF_LATENCY_HEADER
+    uint32_t age = frameAgeUs;
+#endif
+
+    if ( bSummary )
+    {
+        IeeeParser_Parse(buffer, packetLen, &summary);
+
+        snaplen = settings.ieeeSnaplen;
+
+        if ( snaplen && packetLen > snaplen )
+        {
+            packetLen = snaplen;
+        }
+
+        type = SNIFF_TYPE_IEEE | SNIFF_FLAG_SUMMARY;
+    }
+
+    //
+    // Everything in front of the frame is written
+    // in one go, each write costs several SPI frames
+    //
+#ifdef SNIFF_LATENCY_HEADER
+
+    headerLen = BeginDatagram(targetIp, type | SNIFF_FLAG_LATENCY, header);
+
+    if ( age != SNIFF_LATENCY_UNKNOWN )
+    {
+        age += ( TRACE_CYCLES() - dequeueCycles ) / CYCLES_PER_US;
+    }
+
+    memcpy(&header[headerLen], &age, sizeof(age));
+    headerLen += sizeof(age);
+
+#else
+
+    headerLen = BeginDatagram(targetIp, type, header);
+
+#endif
+
+    if ( bSummary )
+    {
+        memcpy(&header[headerLen], &summary, sizeof(summary));
+        headerLen += sizeof(summary);
+    }
+
+    if ( proto == BluetoothLowEnergy )
+    {
+        memcpy(&header[headerLen], accessAddr, 4);
+        headerLen += 4;
+    }
+
+    WriteDatagram(header, headerLen);
+
+    WriteDatagram(buffer, packetLen);
+
+    Stats_Increment(STATS_TX_FRAMES);
+
+    writtenCycles = TRACE_CYCLES();
+
+    ret = EndDatagram();
+
+    sentCycles = TRACE_CYCLES();
+
+    Stats_Increment(ret ? STATS_TX_DATAGRAMS : STATS_TX_ERRORS);
+
+    return;
+}
+
+
+/*
+ * === HandleTrigger
+ * Oscilloscope-like capture. While armed, frames are only kept in
+ * the pre-trigger history ring. When a frame matches the pattern,
+ * whole history (ending with the matching frame) is forwarded,
+ * followed by the post-trigger window. After that, frames are
+ * dropped until the trigger is re-armed over REST.
+ *
+ * Parameters:
+ *      buffer[in]              - the frame, reused as scratch buffer
+ *                                while history is flushed
+ *      packetLen[in]           - length of the frame
+ *      targetIp[in]            - IP address of the target
+ *      proto[in]               - protocol the radio listens to
+ *      accessAddr[in]          - BLE access address to prepend
+ * Returns:
+ *      N/A
+ */
+void HandleTrigger(uint8_t* buffer, uint16_t packetLen, IPAddress targetIp, RF_Protocol_t proto, const uint8_t accessAddr[])
+{
+    switch (Trigger_GetState())
     {
-        EthernetUDP_beginPacket_ip(&ethernetUdp, targetIp, 2014);
+    case TRIGGER_ARMED:
+        if ( Trigger_ProcessFrame(buffer, packetLen) )
+        {
+            Stats_Increment(STATS_TRIGGER_FIRES);
 
-        EthernetUDP_write_byte(&ethernetUdp, (uint8_t)proto);
+            while (( packetLen = Trigger_PopHistory(buffer, 2047) ))
+            {
+                ForwardRfPacket(buffer, packetLen, targetIp, proto, accessAddr);
+            }
+        }
+        break;
 
-        if ( proto == BluetoothLowEnergy )
+    case TRIGGER_POST:
+        if ( Trigger_CountPostFrame() )
         {
-            EthernetUDP_write(&ethernetUdp, (uint8_t*)accessAddr, 4);
+            ForwardRfPacket(buffer, packetLen, targetIp, proto, accessAddr);
         }
+        break;
+
+    default:
+        Stats_Increment(STATS_TRIGGER_DROPS);
+        Stats_Increment(STATS_RX_FILTERED);
+        break;
+    }
+
+    return;
+}
+
+
+/*
+ * === FlushBleRecords
+ * Sends pending BLE records to the target. Records are batched,
+ * a datagram is sent once SNIFF_RECORDS_PER_DATAGRAM records are
+ * pending or when forced (radio queue drained), so that a lone
+ * advertiser is not delayed until the batch fills up.
+ * Datagram: [SNIFF_TYPE_BLE_RECORDS][sequence][count][count * BleParser_Record_t]
+ *
+ * Parameters:
+ *      targetIp[in]            - IP address of the target
+ *      bForce[in]              - send even if batch is not full
+ * Returns:
+ *      N/A
+ */
+void FlushBleRecords(IPAddress targetIp, bool bForce)
+{
+    //
+    // 512 bytes, kept off the task stack
+    // (this task is the only caller)
+    //
+    static BleParser_Record_t records[SNIFF_RECORDS_PER_DATAGRAM];
 
-        EthernetUDP_write(&ethernetUdp, (uint8_t*)buffer, packetLen);
+    uint8_t header[SEQUENCE_HEADER_SIZE + 1];
 
-        ret = EthernetUDP_endPacket(&ethernetUdp);
+    uint8_t count;
+
+    if ( BleParser_GetPendingRecords() == 0 )
+    {
+        return;
+    }
+
+    if ( !bForce && BleParser_GetPendingRecords() < SNIFF_RECORDS_PER_DATAGRAM )
+    {
+        return;
     }
 
+    count = BleParser_PopRecords(records, SNIFF_RECORDS_PER_DATAGRAM);
+
+    header[BeginDatagram(targetIp, SNIFF_TYPE_BLE_RECORDS, header)] = count;
+
+    WriteDatagram(header, sizeof(header));
+
+    WriteDatagram(records, count * sizeof(BleParser_Record_t));
+
+    Stats_Increment(EndDatagram() ? STATS_RECORD_DATAGRAMS : STATS_TX_ERRORS);
+
     return;
 }
 
+
+/*
+ * === SendStats
+ * Sends cumulative loss accounting counters to the target every
+ * SNIFF_STATS_PERIOD_MS, in the capture stream so that the receiver
+ * can put them against the sequence numbers it has seen.
+ * Datagram: [SNIFF_TYPE_STATS][sequence][count][count * LE32]
+ *
+ * Parameters:
+ *      targetIp[in]            - IP address of the target
+ * Returns:
+ *      N/A
+ */
+void SendStats(IPAddress targetIp)
+{
+    uint32_t fields[SNIFF_STATS_COUNT];
+
+    uint8_t  header[SEQUENCE_HEADER_SIZE + 1];
+
+    uint32_t now = Clock_getTicks();
+
+    if ( now - lastStatsTicks < STATS_PERIOD_TICKS )
+    {
+        return;
+    }
+
+    lastStatsTicks = now;
+
+    fields[SNIFF_STATS_UPTIME_MS]       = now / 100;
+    fields[SNIFF_STATS_RF_RX_OK]        = Stats_Get(STATS_RF_RX_OK);
+    fields[SNIFF_STATS_RX_OVERFLOWS]    = Stats_Get(STATS_RX_OVERFLOWS);
+    fields[SNIFF_STATS_QUEUE_DISCARDS]  = Stats_Get(STATS_QUEUE_DISCARDS);
+    fields[SNIFF_STATS_REPLAY_FRAMES]   = Stats_Get(STATS_REPLAY_FRAMES);
+    fields[SNIFF_STATS_RX_FRAMES]       = Stats_Get(STATS_RX_FRAMES);
+    fields[SNIFF_STATS_RX_FILTERED]     = Stats_Get(STATS_RX_FILTERED);
+    fields[SNIFF_STATS_TX_FRAMES]       = Stats_Get(STATS_TX_FRAMES);
+    fields[SNIFF_STATS_TX_SHORT_WRITES] = Stats_Get(STATS_TX_SHORT_WRITES);
+    fields[SNIFF_STATS_TX_TIMEOUTS]     = Stats_Get(STATS_TX_TIMEOUTS);
+    fields[SNIFF_STATS_SEQUENCE]        = datagramSequence;
+
+    header[BeginDatagram(targetIp, SNIFF_TYPE_STATS, header)] = SNIFF_STATS_COUNT;
+
+    WriteDatagram(header, sizeof(header));
+
+    WriteDatagram(fields, sizeof(fields));
+
+    if ( !EndDatagram() )
+    {
+        Stats_Increment(STATS_TX_ERRORS);
+    }
+
+    return;
+}
+
+
+/*
+ * === BeginDatagram
+ * Starts a datagram to the target and puts its type byte with
+ * SNIFF_FLAG_SEQUENCE and the next sequence number (LE16) into the
+ * caller's header, which is written with the rest of the header.
+ * All datagrams of the capture port go through here, so a gap in the
+ * sequence is a datagram lost after the firmware sent it.
+ *
+ * Parameters:
+ *      targetIp[in]            - IP address of the target
+ *      type[in]                - SNIFF_TYPE_* and flags
+ *      pHeader[out]            - SEQUENCE_HEADER_SIZE bytes at least
+ * Returns:
+ *      uint8_t                 - bytes put into pHeader
+ */
+static uint8_t BeginDatagram(IPAddress targetIp, uint8_t type, uint8_t* pHeader)
+{
+    EthernetUDP_beginPacket_ip(&ethernetUdp, targetIp, 2014);
+
+    bShortWrite = false;
+
+    pHeader[0] = type | SNIFF_FLAG_SEQUENCE;
+    pHeader[1] = (uint8_t)datagramSequence;
+    pHeader[2] = (uint8_t)( datagramSequence >> 8 );
+
+    datagramSequence++;
+
+    return SEQUENCE_HEADER_SIZE;
+}
+
+
+static void WriteDatagram(const void* pData, uint16_t len)
+{
+    if ( EthernetUDP_write(&ethernetUdp, (const uint8_t*)pData, len) < len )
+    {
+        bShortWrite = true;
+    }
+
+    return;
+}
+
+
+/*
+ * === EndDatagram
+ * Sends the datagram, one that did not fit into W5500 TX buffer
+ * goes out cut short and is counted as STATS_TX_SHORT_WRITES.
+ *
+ * Returns:
+ *      bool                    - false when W5500 refused SEND
+ */
+static bool EndDatagram(void)
+{
+    if ( bShortWrite )
+    {
+        Stats_Increment(STATS_TX_SHORT_WRITES);
+    }
+
+    return ( EthernetUDP_endPacket(&ethernetUdp) != 0 );
+}
+
+
+/*
+ * === OnCaptureSocketEvent
+ * TIMEOUT of the capture socket: W5500 could not resolve the target
+ * (ARP) and dropped the datagram, SEND itself reported success.
+ */
+static void OnCaptureSocketEvent(uint8_t sock, uint8_t events)
+{
+    if ( events & ETHIRQ_TIMEOUT )
+    {
+        Stats_Increment(STATS_TX_TIMEOUTS);
+    }
+
+    return;
+}
+
+
+/*
+ * === ApplyControlBatch
+ * Applies SET request of the control protocol. Values were checked
+ * by Control_Receive(), so only the radio may refuse. The radio goes
+ * first and config and trigger are changed only when it succeeded,
+ * a refused batch leaves the sniffer as it was. Protocol change
+ * reopens Radio Core in place (no restart) and drops queued frames of
+ * the previous protocol, channel change only retunes RX. OLED is not
+ * refreshed on this path, redrawing it takes tens of milliseconds.
+ *
+ * Parameters:
+ *      pBatch[in]              - request to apply
+ *      pParams[in]             - RF parameters of the task
+ *      pObj[in]                - RF object of the task
+ *      pRfHnd[in/out]          - handle to Radio Core
+ *      pProto[in/out]          - protocol the radio listens to
+ * Returns:
+ *      Control_Status_t        - CONTROL_OK or CONTROL_RADIO_ERROR
+ */
+Control_Status_t ApplyControlBatch(const Control_Batch_t* pBatch, RF_Params* pParams, RF_Object* pObj, RF_Handle* pRfHnd, RF_Protocol_t* pProto)
+{
+    RF_Protocol_t proto = *pProto;
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_PROTOCOL) )
+    {
+        proto = (RF_Protocol_t)pBatch->protocol;
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_CHANNEL) && !Radio_isValidChannel(proto, pBatch->channel) )
+    {
+        return CONTROL_RADIO_ERROR;
+    }
+
+    ///////////////////////////
+    // Radio:
+    // New protocol needs another RF mode, Radio Core is
+    // closed (Radio_stopRX) and opened again. When it does
+    // not open, the previous protocol is opened back and RX
+    // continues there. RX is posted by the channel change
+    // below when the batch carries a channel.
+    //
+    if ( proto != *pProto )
+    {
+        Radio_stopRX(*pRfHnd);
+
+        Radio_openRadioCore(pParams, pObj, proto, pRfHnd);
+
+        if ( *pRfHnd == NULL )
+        {
+            Radio_openRadioCore(pParams, pObj, *pProto, pRfHnd);
+
+            if ( *pRfHnd != NULL )
+            {
+                Radio_setFrequencySynthesizer(pRfHnd, *pProto);
+
+                Radio_beginRX(*pRfHnd, *pProto, &Radio_HandleRxEvent, RADIO_RX_EVENTS);
+            }
+
+            return CONTROL_RADIO_ERROR;
+        }
+
+        *pProto = proto;
+
+        Stats_Add(STATS_QUEUE_DISCARDS, RadioQueue_reset());
+
+        Radio_setFrequencySynthesizer(pRfHnd, proto);
+
+        if ( !CONTROL_HAS(pBatch, CONTROL_KEY_CHANNEL) )
+        {
+            Radio_beginRX(*pRfHnd, proto, &Radio_HandleRxEvent, RADIO_RX_EVENTS);
+        }
+    }
+
+    //
+    // Channel was checked above, retuning cannot fail
+    //
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_CHANNEL) )
+    {
+        Radio_setChannel(*pRfHnd, proto, pBatch->channel);
+    }
+
+    Config_BeginUpdate();
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_PROTOCOL) )
+    {
+        Config_SetProtocol(proto);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_TARGET_IP) )
+    {
+        Config_SetTargetIp(pBatch->targetIp);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_RUNNING) )
+    {
+        Config_SetRunning(pBatch->running);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_IEEE_DECODE) )
+    {
+        Config_SetIeeeDecode(pBatch->ieeeDecode);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_IEEE_SNAPLEN) )
+    {
+        Config_SetIeeeSnaplen(pBatch->ieeeSnaplen);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_OUTPUT_MODE) )
+    {
+        Config_SetOutputMode(pBatch->outputMode);
+    }
+
+    Config_EndUpdate();
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_TRIGGER_PATTERN) )
+    {
+        Trigger_SetPattern(pBatch->triggerPattern);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_TRIGGER_OFFSET) )
+    {
+        Trigger_SetOffset(pBatch->triggerOffset);
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_TRIGGER_POST) )
+    {
+        Trigger_SetPostFrames(pBatch->triggerPostFrames);
+    }
+
+    //
+    // Arm after pattern, offset and window are set
+    //
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_TRIGGER_STATE) )
+    {
+        Trigger_Arm(pBatch->triggerState);
+    }
+
+    return CONTROL_OK;
+}
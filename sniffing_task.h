@@ -8,6 +8,81 @@
 #ifndef SNIFFING_TASK_H_
 #define SNIFFING_TASK_H_
 
+#include <ti/sysbios/knl/Event.h>
+
+// === DEFINES ==================================================================================================
+
+//
+// First byte of every datagram sent to the target carries type of
+// the capture record in lower nibble and flags in upper nibble.
+//
+#define SNIFF_TYPE_BLE           (0x00)
+
+#define SNIFF_TYPE_IEEE          (0x01)
+
+#define SNIFF_TYPE_BLE_RECORDS   (0x02) // batch of BleParser_Record_t, preceded by record count
+
+#define SNIFF_TYPE_STATS         (0x03) // loss accounting, count then count * LE32, see Sniff_StatsField_t
+
+#define SNIFF_TYPE_MASK          (0x0F)
+
+#define SNIFF_FLAG_SUMMARY       (0x80) // IeeeParser_Summary_t precedes the (truncated) MPDU
+
+#define SNIFF_FLAG_LATENCY       (0x40) // LE32 frame age (us) follows the sequence, SNIFF_LATENCY_HEADER builds
+
+#define SNIFF_FLAG_SEQUENCE      (0x20) // LE16 datagram sequence follows the type byte, set in every datagram
+
+#define SNIFF_LATENCY_UNKNOWN    (0xFFFFFFFF)
+
+#define SNIFF_RECORDS_PER_DATAGRAM (16)
+
+#define SNIFF_STATS_PERIOD_MS    (1000)
+
+//
+// Events of Sniffing_EventHandle, the task sleeps on them
+// while the radio queue is empty
+//
+#define SNIFF_EVENT_FRAME        (Event_Id_00)  // RF Core stored a frame (Radio_SetRxNotify)
+#define SNIFF_EVENT_ETHERNET     (Event_Id_01)  // W5500 INT (HandleInterrupt)
+#define SNIFF_EVENT_CONFIG       (Event_Id_02)  // settings updated (Config_SetChangeNotify)
+
+#define SNIFF_EVENTS_ALL         ( SNIFF_EVENT_FRAME | SNIFF_EVENT_ETHERNET | SNIFF_EVENT_CONFIG )
+
+//
+// Longest sleep (10 ms): trace and stats
+// are served at least this often
+//
+#define SNIFF_IDLE_TICKS         (1000)
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+/*
+ * === Sniff_StatsField_t
+ * Cumulative counters in SNIFF_TYPE_STATS datagram, in the order
+ * the frames pass the stages. New fields are only appended, the
+ * receiver takes as many as the count byte says.
+ */
+typedef enum Sniff_StatsField
+{
+    SNIFF_STATS_UPTIME_MS = 0,      // when the counters were taken
+    SNIFF_STATS_RF_RX_OK,           // frames RF Core stored in the radio queue
+    SNIFF_STATS_RX_OVERFLOWS,       // frames RF Core could not store, radio queue full
+    SNIFF_STATS_QUEUE_DISCARDS,     // stored frames dropped by radio queue reset
+    SNIFF_STATS_REPLAY_FRAMES,      // frames written into the radio queue by replay
+    SNIFF_STATS_RX_FRAMES,          // frames taken from the radio queue
+    SNIFF_STATS_RX_FILTERED,        // frames taken and not forwarded on purpose
+    SNIFF_STATS_TX_FRAMES,          // frames written into a datagram
+    SNIFF_STATS_TX_SHORT_WRITES,    // datagrams cut short, W5500 TX buffer full
+    SNIFF_STATS_TX_TIMEOUTS,        // datagrams dropped by W5500, ARP timeout
+    SNIFF_STATS_SEQUENCE,           // sequence of this datagram, not wrapped at 16 bits
+    SNIFF_STATS_COUNT
+} Sniff_StatsField_t;
+
+// ==============================================================================================================
+
 
 void Sniffing_Main(UArg a0, UArg a1);
 
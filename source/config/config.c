@@ -0,0 +1,800 @@
+/*
+ * config.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <stddef.h>
+
+#include <string.h>
+
+#include <ti/sysbios/BIOS.h>
+
+#include <ti/sysbios/knl/Task.h>
+
+#include <source/config/config.h>
+
+#include <source/config/config_store.h>
+
+#include <source/html/html.h>
+
+#include "ti_drivers_config.h"
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define CONFIG_MAGIC            ( 0x43464700UL | CONFIG_LAYOUT_VERSION )   // "CFG" + layout
+
+#define FACTORY_MAGIC           (0x4446534DUL)                              // "MSFD"
+
+//
+// Retained RAM of the linker command file (STV_W)
+//
+#define RETAINED_SIZE           (0x20)
+
+#define TOKEN_COUNT             (26)
+
+//
+// Orders accesses of the seqlock, single core so
+// the compiler is the only one to reorder them
+//
+#define BARRIER()               __asm volatile ("" ::: "memory")
+
+//
+// Version 1 (STV) layout: offsets within the image, the factory
+// image of that version starts at 0x50006 and ends after RUNNING
+//
+#define V1_DHCP                 (0)
+#define V1_DEVICE_IP            (1)
+#define V1_GATEWAY_IP           (5)
+#define V1_NETMASK              (9)
+#define V1_TARGET_IP            (13)
+#define V1_PROTOCOL             (17)
+#define V1_RUNNING              (18)
+#define V1_IEEE_DECODE          (20)
+#define V1_IEEE_SNAPLEN         (21)
+#define V1_OUTPUT_MODE          (22)
+#define V1_FACTORY_BASE         (0x50006)
+#define V1_FACTORY_SIZE         (19)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct Config_Field
+{
+    const char* pName;
+    uint32_t    min;
+    uint32_t    max;
+    uint32_t    def;
+    uint8_t     offset;
+    uint8_t     size;
+    uint8_t     kind;
+    char        token;
+} Config_Field_t;
+
+
+typedef struct Config_Factory
+{
+    uint32_t        magic;
+    uint16_t        version;
+    uint16_t        length;
+    Config_Values_t values;
+} Config_Factory_t;
+
+// ==============================================================================================================
+
+
+// === COMPILE TIME CHECKS ======================================================================================
+
+#define CONFIG_X_SIZE(ID, Name, member, type, kind, token, pName, min, max, def)    + sizeof(type)
+
+#define CONFIG_X_CHECK(ID, Name, member, type, kind, token, pName, min, max, def) \
+    _Static_assert(offsetof(Config_Values_t, member) % sizeof(type) == 0, #member " is not aligned"); \
+    _Static_assert(sizeof(type) == 1 || sizeof(type) == 2 || sizeof(type) == 4, #member " has unsupported size"); \
+    _Static_assert((token) >= 'a' && (token) <= 'z', #member " token is not 'a'..'z'"); \
+    _Static_assert((kind) == CONFIG_KIND_IP || ( (def) >= (min) && (def) <= (max) ), #member " default out of range");
+
+CONFIG_FIELDS(CONFIG_X_CHECK)
+
+//
+// Only tail padding is expected, a gap between members
+// means CONFIG_FIELDS are not ordered by size
+//
+_Static_assert(sizeof(Config_Values_t) - ( 0 CONFIG_FIELDS(CONFIG_X_SIZE) ) < sizeof(uint32_t), "Config_Values_t has padding, reorder CONFIG_FIELDS");
+
+_Static_assert(sizeof(Config_Values_t) <= CONFIG_STORE_MAX_PAYLOAD, "Config_Values_t does not fit a config store record");
+
+_Static_assert(sizeof(Config_t) <= RETAINED_SIZE, "Config_t does not fit retained RAM");
+
+#undef CONFIG_X_SIZE
+#undef CONFIG_X_CHECK
+
+// ==============================================================================================================
+
+
+// === GLOBAL VARIABLES =========================================================================================
+
+//
+// Not initialized by startup code (NOLOAD section)
+//
+Config_t config __attribute__((section("startup_vectors_w")));
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+#define CONFIG_X_FIELD(ID, Name, member, type, kind, token, pName, min, max, def) \
+    [CONFIG_ID_##ID] = { pName, min, max, def, offsetof(Config_Values_t, member), sizeof(type), kind, token },
+
+static const Config_Field_t fields[CONFIG_FIELD_COUNT] =
+{
+    CONFIG_FIELDS(CONFIG_X_FIELD)
+};
+
+#undef CONFIG_X_FIELD
+
+
+//
+// Dashboard token to field, CONFIG_ID + 1 (0 = no field)
+//
+#define CONFIG_X_TOKEN(ID, Name, member, type, kind, token, pName, min, max, def)   [(token) - 'a'] = CONFIG_ID_##ID + 1,
+
+static const uint8_t tokenIds[TOKEN_COUNT] =
+{
+    CONFIG_FIELDS(CONFIG_X_TOKEN)
+};
+
+#undef CONFIG_X_TOKEN
+
+
+//
+// Nesting of Config_BeginUpdate(), events to post
+// when the outermost update ends
+//
+static uint8_t     updateDepth   = 0;
+
+static UInt        pendingEvents = 0;
+
+//
+// Task holding Config_WriterSemaphoreHandle and nesting of
+// lockWriters() in it, updates of one task may nest
+//
+static Task_Handle writer        = NULL;
+
+static uint8_t     writerDepth   = 0;
+
+//
+// Posted along with Config_EventHandle, see Config_SetChangeNotify()
+//
+static Event_Handle changeNotifyEvent = NULL;
+
+static UInt         changeNotifyId;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === lockWriters
+ * Waits until no other task writes values or commits them.
+ * The writer may block while holding it (OLED, SPI, flash).
+ */
+static void lockWriters(void)
+{
+    if ( writerDepth == 0 || writer != Task_self() )
+    {
+        Semaphore_pend(Config_WriterSemaphoreHandle, BIOS_WAIT_FOREVER);
+
+        writer = Task_self();
+    }
+
+    writerDepth++;
+
+    return;
+}
+
+
+static void unlockWriters(void)
+{
+    if ( --writerDepth == 0 )
+    {
+        writer = NULL;
+
+        Semaphore_post(Config_WriterSemaphoreHandle);
+    }
+
+    return;
+}
+
+
+static void postEvents(UInt events)
+{
+    Event_post(Config_EventHandle, events);
+
+    if ( changeNotifyEvent != NULL )
+    {
+        Event_post(changeNotifyEvent, changeNotifyId);
+    }
+
+    return;
+}
+
+
+static void* fieldPtr(Config_Id_t id)
+{
+    return (uint8_t*)&config.values + fields[id].offset;
+}
+
+
+static void setDefaults(void)
+{
+    Config_Id_t id;
+
+    for ( id = (Config_Id_t)0; id < CONFIG_FIELD_COUNT; id++ )
+    {
+        Config_Set(id, fields[id].def);
+    }
+
+    return;
+}
+
+
+/*
+ * === sanitize
+ * Loaded image may come from another firmware, every
+ * value out of range is replaced by its default.
+ */
+static void sanitize(void)
+{
+    Config_Id_t id;
+
+    for ( id = (Config_Id_t)0; id < CONFIG_FIELD_COUNT; id++ )
+    {
+        if ( !Config_IsValid(id, Config_Get(id)) )
+        {
+            Config_Set(id, fields[id].def);
+        }
+    }
+
+    return;
+}
+
+
+/*
+ * === migrateV1
+ * Converts image of the STV layout (magic byte values),
+ * fields beyond len keep their defaults.
+ */
+static void migrateV1(const uint8_t* pImage, uint16_t len)
+{
+    setDefaults();
+
+    if ( len > V1_RUNNING )
+    {
+        config.values.dhcp     = ( pImage[V1_DHCP] == 0x59 );
+        config.values.protocol = ( pImage[V1_PROTOCOL] == 0x15 );
+        config.values.running  = ( pImage[V1_RUNNING] != 0x00 );
+
+        memcpy(config.values.deviceIp.bytes,  &pImage[V1_DEVICE_IP],  4);
+        memcpy(config.values.gatewayIp.bytes, &pImage[V1_GATEWAY_IP], 4);
+        memcpy(config.values.netmask.bytes,   &pImage[V1_NETMASK],    4);
+        memcpy(config.values.targetIp.bytes,  &pImage[V1_TARGET_IP],  4);
+    }
+
+    if ( len > V1_OUTPUT_MODE )
+    {
+        config.values.ieeeDecode  = ( pImage[V1_IEEE_DECODE] == 0x44 );
+        config.values.ieeeSnaplen = pImage[V1_IEEE_SNAPLEN];
+        config.values.outputMode  = ( pImage[V1_OUTPUT_MODE] == 0x52 );
+    }
+
+    return;
+}
+
+
+static bool loadStored(void)
+{
+    uint8_t  image[CONFIG_STORE_MAX_PAYLOAD];
+    uint16_t len;
+    uint16_t version;
+
+    if ( ConfigStore_Load(image, sizeof(image), &len, &version) != CONFIG_STORE_OK )
+    {
+        return false;
+    }
+
+    if ( version == CONFIG_LAYOUT_VERSION && len == sizeof(Config_Values_t) )
+    {
+        memcpy(&config.values, image, len);
+
+        return true;
+    }
+
+    if ( version == 1 )
+    {
+        migrateV1(image, len);
+
+        return true;
+    }
+
+    return false;
+}
+
+
+static bool loadFactory(void)
+{
+    const Config_Factory_t* pFactory = (const Config_Factory_t*)CONFIG_FACTORY_BASE;
+    const uint8_t*          pV1      = (const uint8_t*)V1_FACTORY_BASE;
+
+    if ( pFactory->magic == FACTORY_MAGIC && pFactory->version == CONFIG_LAYOUT_VERSION && pFactory->length == sizeof(Config_Values_t) )
+    {
+        config.values = pFactory->values;
+
+        return true;
+    }
+
+    //
+    // status_vectors.bin of the STV layout
+    //
+    if ( pV1[V1_DHCP] == 0x59 || pV1[V1_DHCP] == 0x4E )
+    {
+        migrateV1(pV1, V1_FACTORY_SIZE);
+
+        return true;
+    }
+
+    return false;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Config_LoadIfNotYet
+ * On cold boot loads settings from the config store, from the
+ * factory image when nothing is stored yet, or compiled-in
+ * defaults (CONFIG_FIELDS) when flash holds neither. Warm
+ * restart (RestartMCU) keeps values in retained RAM.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void Config_LoadIfNotYet(void)
+{
+    ConfigStore_Init(CONFIG_NVS_SETTINGS);
+
+    if ( config.magic != CONFIG_MAGIC )
+    {
+        memset(&config, 0, sizeof(config));
+
+        if ( !loadStored() && !loadFactory() )
+        {
+            setDefaults();
+        }
+
+        sanitize();
+
+        config.magic = CONFIG_MAGIC;
+    }
+
+    config.generation = 0;
+
+    return;
+}
+
+
+/*
+ * === Config_Commit
+ * Stores current values in the config store, nothing
+ * is written when they did not change.
+ */
+void Config_Commit(void)
+{
+    lockWriters();
+
+    ConfigStore_Commit(&config.values, sizeof(Config_Values_t), CONFIG_LAYOUT_VERSION);
+
+    unlockWriters();
+
+    return;
+}
+
+
+/*
+ * === Config_FindToken
+ * Returns:
+ *      Config_Id_t     - field of the dashboard key,
+ *                        CONFIG_NO_FIELD when none
+ */
+Config_Id_t Config_FindToken(char token)
+{
+    if ( token < 'a' || token > 'z' || tokenIds[token - 'a'] == 0 )
+    {
+        return (Config_Id_t)CONFIG_NO_FIELD;
+    }
+
+    return (Config_Id_t)( tokenIds[token - 'a'] - 1 );
+}
+
+
+/*
+ * === Config_FindName
+ * Returns:
+ *      Config_Id_t     - field of the JSON name (not '\0'
+ *                        terminated), CONFIG_NO_FIELD when none
+ */
+Config_Id_t Config_FindName(const char* pName, uint16_t len)
+{
+    Config_Id_t id;
+
+    for ( id = (Config_Id_t)0; id < CONFIG_FIELD_COUNT; id++ )
+    {
+        if ( strlen(fields[id].pName) == len && strncmp(fields[id].pName, pName, len) == 0 )
+        {
+            return id;
+        }
+    }
+
+    return (Config_Id_t)CONFIG_NO_FIELD;
+}
+
+
+char Config_GetToken(Config_Id_t id)
+{
+    return fields[id].token;
+}
+
+
+const char* Config_GetName(Config_Id_t id)
+{
+    return fields[id].pName;
+}
+
+
+Config_Kind_t Config_GetKind(Config_Id_t id)
+{
+    return (Config_Kind_t)fields[id].kind;
+}
+
+
+/*
+ * === Config_IsValid
+ * Checks value against range of the field (CONFIG_FIELDS),
+ * any IP address is valid.
+ */
+bool Config_IsValid(Config_Id_t id, uint32_t value)
+{
+    if ( id >= CONFIG_FIELD_COUNT )
+    {
+        return false;
+    }
+
+    return ( fields[id].kind == CONFIG_KIND_IP ) || ( value >= fields[id].min && value <= fields[id].max );
+}
+
+
+/*
+ * === Config_Get
+ * Value of a field by id, IP addresses as IPAddress.dword.
+ */
+uint32_t Config_Get(Config_Id_t id)
+{
+    void* p = fieldPtr(id);
+
+    switch ( fields[id].size )
+    {
+    case 4:
+        return *(uint32_t*)p;
+
+    case 2:
+        return *(uint16_t*)p;
+
+    default:
+        return *(uint8_t*)p;
+    }
+}
+
+
+/*
+ * === Config_Set
+ * Parameters:
+ *      id[in]          - field
+ *      value[in]       - new value, IP addresses as IPAddress.dword
+ * Returns:
+ *      bool            - false when value is out of range
+ *                        (field is left as it was)
+ */
+bool Config_Set(Config_Id_t id, uint32_t value)
+{
+    void* p;
+
+    if ( !Config_IsValid(id, value) )
+    {
+        return false;
+    }
+
+    p = fieldPtr(id);
+
+    switch ( fields[id].size )
+    {
+    case 4:
+        *(uint32_t*)p = value;
+        break;
+
+    case 2:
+        *(uint16_t*)p = (uint16_t)value;
+        break;
+
+    default:
+        *(uint8_t*)p = (uint8_t)value;
+        break;
+    }
+
+    return true;
+}
+
+
+/*
+ * === Config_Parse
+ * Parses text of a field (dashboard form, REST API): dotted
+ * IP address or decimal number, and checks its range.
+ *
+ * Parameters:
+ *      id[in]          - field
+ *      pText[in]       - text of the value
+ *      pValue[out]     - value, IP addresses as IPAddress.dword
+ * Returns:
+ *      bool            - false when text is malformed or
+ *                        value out of range
+ */
+bool Config_Parse(Config_Id_t id, const char* pText, uint32_t* pValue)
+{
+    IPAddress ip;
+    uint32_t  value = 0;
+
+    if ( id >= CONFIG_FIELD_COUNT )
+    {
+        return false;
+    }
+
+    if ( fields[id].kind == CONFIG_KIND_IP )
+    {
+        if ( !IPAddress_fromString(&ip, pText) )
+        {
+            return false;
+        }
+
+        *pValue = ip.dword;
+
+        return true;
+    }
+
+    if ( *pText == '\0' )
+    {
+        return false;
+    }
+
+    while ( *pText )
+    {
+        if ( *pText < '0' || *pText > '9' || value > 0xFFFFFFF )
+        {
+            return false;
+        }
+
+        value = value * 10 + ( *pText++ - '0' );
+    }
+
+    *pValue = value;
+
+    return Config_IsValid(id, value);
+}
+
+
+/*
+ * === Config_SetFromString
+ * Config_Parse() and Config_Set() in one go.
+ */
+bool Config_SetFromString(Config_Id_t id, const char* pText)
+{
+    uint32_t value;
+
+    return Config_Parse(id, pText, &value) && Config_Set(id, value);
+}
+
+
+/*
+ * === Config_Format
+ * Writes text of the field (as taken by Config_SetFromString).
+ *
+ * Parameters:
+ *      pBuf[out]       - at least CONFIG_TEXT_MAXLEN + 1 bytes
+ * Returns:
+ *      uint8_t         - number of characters (without '\0')
+ */
+uint8_t Config_Format(Config_Id_t id, char* pBuf)
+{
+    IPAddress ip;
+
+    if ( fields[id].kind == CONFIG_KIND_IP )
+    {
+        ip.dword = Config_Get(id);
+
+        IPAddress_toString(ip, pBuf);
+
+        return strlen(pBuf);
+    }
+
+    return Html_FormatUint(pBuf, Config_Get(id));
+}
+
+
+/*
+ * === Config_BeginUpdate
+ * Starts an update of values, readers using Config_Snapshot() keep
+ * their previous copy until Config_EndUpdate(). Updates may nest,
+ * only the outermost one counts. Writer may block in between
+ * (OLED, SPI), readers never wait for it, writers of other tasks
+ * wait until the update ends.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void Config_BeginUpdate(void)
+{
+    lockWriters();
+
+    if ( updateDepth++ == 0 )
+    {
+        config.generation++;
+
+        BARRIER();
+    }
+
+    return;
+}
+
+
+/*
+ * === Config_EndUpdate
+ * Publishes values written since Config_BeginUpdate() and posts
+ * CONFIG_EVENT_CHANGED (with CONFIG_EVENT_RF_CHANGE if signalled),
+ * and the event given to Config_SetChangeNotify().
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void Config_EndUpdate(void)
+{
+    UInt events = 0;
+
+    if ( --updateDepth == 0 )
+    {
+        BARRIER();
+
+        config.generation++;
+
+        events        = CONFIG_EVENT_CHANGED | pendingEvents;
+        pendingEvents = 0;
+    }
+
+    unlockWriters();
+
+    if ( events )
+    {
+        postEvents(events);
+    }
+
+    return;
+}
+
+
+/*
+ * === Config_Snapshot
+ * Copies values, consistent with respect to updates of other
+ * tasks. Costs a load of generation and a copy, when the copy
+ * is older than Config_GetGeneration() only.
+ *
+ * Parameters:
+ *      pValues[out]    - copy of values
+ *      pGeneration[out]- generation of the copy
+ * Returns:
+ *      bool            - false when an update is in progress,
+ *                        pValues and pGeneration are left as
+ *                        they were (use the previous copy)
+ */
+bool Config_Snapshot(Config_Values_t* pValues, uint32_t* pGeneration)
+{
+    Config_Values_t copy;
+    uint32_t        generation = config.generation;
+
+    if ( generation & 1 )
+    {
+        return false;
+    }
+
+    BARRIER();
+
+    copy = config.values;
+
+    BARRIER();
+
+    if ( config.generation != generation )
+    {
+        return false;
+    }
+
+    *pValues     = copy;
+    *pGeneration = generation;
+
+    return true;
+}
+
+
+/*
+ * === Config_SignalRfChange
+ * Requests restart of the sniffing task with the new protocol,
+ * CONFIG_EVENT_RF_CHANGE is posted when the update ends.
+ */
+void Config_SignalRfChange(void)
+{
+    UInt events = 0;
+
+    lockWriters();
+
+    pendingEvents |= CONFIG_EVENT_RF_CHANGE;
+
+    if ( updateDepth == 0 )
+    {
+        events        = pendingEvents;
+        pendingEvents = 0;
+    }
+
+    unlockWriters();
+
+    if ( events )
+    {
+        postEvents(events);
+    }
+
+    return;
+}
+
+
+/*
+ * === Config_SetChangeNotify
+ * Event posted whenever Config_EventHandle is, so that a task
+ * which sleeps on an event of its own learns about updates
+ * without polling Config_GetGeneration().
+ *
+ * Parameters:
+ *      event[in]       - event object, NULL for none
+ *      eventId[in]     - Event_Id_xx to post
+ * Returns:
+ *      N/A
+ */
+void Config_SetChangeNotify(Event_Handle event, UInt eventId)
+{
+    changeNotifyId    = eventId;
+    changeNotifyEvent = event;
+
+    return;
+}
+
+// ==============================================================================================================
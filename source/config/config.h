@@ -0,0 +1,187 @@
+/*
+ * config.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_CONFIG_CONFIG_H_
+#define SOURCE_CONFIG_CONFIG_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <ti/sysbios/knl/Event.h>
+
+#include <ti/sysbios/knl/Semaphore.h>
+
+#include <source/ethernet/IPAddress.h>
+
+#include <source/config/config_schema.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Layout of Config_Values_t, stored with every record of the
+// config store. Version 1 was the STV byte layout (0x20013500).
+//
+#define CONFIG_LAYOUT_VERSION   (2)
+
+#define CONFIG_NO_FIELD         (0xFF)
+
+//
+// Factory image (flashbins/status_vectors.bin), MAC address
+// followed by Config_Values_t defaults of the device
+//
+#define CONFIG_FACTORY_MAC      (0x50000)
+
+#define CONFIG_FACTORY_BASE     (0x50008)
+
+//
+// Longest text of a value (IP address)
+//
+#define CONFIG_TEXT_MAXLEN      (15)
+
+//
+// Events of Config_EventHandle, posted by Config_EndUpdate()
+//
+#define CONFIG_EVENT_CHANGED    (Event_Id_00)   // values were updated
+#define CONFIG_EVENT_RF_CHANGE  (Event_Id_01)   // protocol changed, sniffing task restarts
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef enum Config_Kind
+{
+    CONFIG_KIND_IP = 0,
+    CONFIG_KIND_FLAG,
+    CONFIG_KIND_UINT
+} Config_Kind_t;
+
+
+#define CONFIG_X_ID(ID, Name, member, type, kind, token, pName, min, max, def)      CONFIG_ID_##ID,
+
+typedef enum Config_Id
+{
+    CONFIG_FIELDS(CONFIG_X_ID)
+    CONFIG_FIELD_COUNT
+} Config_Id_t;
+
+#undef CONFIG_X_ID
+
+
+/*
+ * === Config_Values_t
+ * Persistent settings, image of a config store record.
+ */
+#define CONFIG_X_MEMBER(ID, Name, member, type, kind, token, pName, min, max, def)  type member;
+
+typedef struct Config_Values
+{
+    CONFIG_FIELDS(CONFIG_X_MEMBER)
+} Config_Values_t;
+
+#undef CONFIG_X_MEMBER
+
+
+/*
+ * === Config_t
+ * Lives in retained RAM (startup_vectors_w), so it survives
+ * RestartMCU(). magic tells a warm restart from a cold boot.
+ * generation is odd while an update is in progress (seqlock),
+ * see Config_BeginUpdate() and Config_Snapshot().
+ */
+typedef struct Config
+{
+    uint32_t          magic;
+    Config_Values_t   values;
+    volatile uint32_t generation;
+} Config_t;
+
+// ==============================================================================================================
+
+
+// === GLOBAL VARIABLES =========================================================================================
+
+extern Config_t config;
+
+extern Event_Handle Config_EventHandle;
+
+//
+// Binary, created with count 1: writers (init, dashboard and
+// sniffing task) hold it from Config_BeginUpdate() to
+// Config_EndUpdate() and during Config_Commit()
+//
+extern Semaphore_Handle Config_WriterSemaphoreHandle;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void          Config_LoadIfNotYet(void);
+
+void          Config_Commit(void);
+
+Config_Id_t   Config_FindToken(char token);
+
+Config_Id_t   Config_FindName(const char* pName, uint16_t len);
+
+char          Config_GetToken(Config_Id_t id);
+
+const char*   Config_GetName(Config_Id_t id);
+
+Config_Kind_t Config_GetKind(Config_Id_t id);
+
+bool          Config_IsValid(Config_Id_t id, uint32_t value);
+
+uint32_t      Config_Get(Config_Id_t id);
+
+bool          Config_Set(Config_Id_t id, uint32_t value);
+
+bool          Config_Parse(Config_Id_t id, const char* pText, uint32_t* pValue);
+
+bool          Config_SetFromString(Config_Id_t id, const char* pText);
+
+uint8_t       Config_Format(Config_Id_t id, char* pBuf);
+
+void          Config_BeginUpdate(void);
+
+void          Config_EndUpdate(void);
+
+bool          Config_Snapshot(Config_Values_t* pValues, uint32_t* pGeneration);
+
+void          Config_SignalRfChange(void);
+
+void          Config_SetChangeNotify(Event_Handle event, UInt eventId);
+
+static inline uint32_t Config_GetGeneration(void)
+{
+    return config.generation;
+}
+
+//
+// Typed accessors, Config_GetTargetIp() etc., a single aligned load or store.
+// Setters do not check the value, use Config_Set() for unchecked input. Writes
+// go between Config_BeginUpdate() and Config_EndUpdate(), so that tasks using
+// Config_Snapshot() see them all at once.
+//
+#define CONFIG_X_ACCESSORS(ID, Name, member, type, kind, token, pName, min, max, def) \
+    static inline type Config_Get##Name(void)       { return config.values.member; } \
+    static inline void Config_Set##Name(type value) { config.values.member = value; }
+
+CONFIG_FIELDS(CONFIG_X_ACCESSORS)
+
+#undef CONFIG_X_ACCESSORS
+
+// ==============================================================================================================
+
+#endif /* SOURCE_CONFIG_CONFIG_H_ */
@@ -0,0 +1,61 @@
+/*
+ * config_schema.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_CONFIG_CONFIG_SCHEMA_H_
+#define SOURCE_CONFIG_CONFIG_SCHEMA_H_
+
+// === INCLUDES =================================================================================================
+
+#include <source/frame_parser/ieee_parser.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// IPv4 address as stored in IPAddress.dword (first octet in the lowest byte)
+//
+#define CONFIG_IP(a, b, c, d)   ( (uint32_t)(a) | ( (uint32_t)(b) << 8 ) | ( (uint32_t)(c) << 16 ) | ( (uint32_t)(d) << 24 ) )
+
+/*
+ * === CONFIG_FIELDS
+ * The one list of persistent settings. Storage layout (Config_Values_t),
+ * typed accessors, dashboard tokens, JSON names, range checks and factory
+ * defaults are all generated from it (config.h, config.c), as is the factory
+ * image (flashbins/create_status_vectors.py parses this table).
+ *
+ *   X(ID, Name, member, type, kind, token, "json name", min, max, default)
+ *
+ *   ID        - CONFIG_ID_<ID>
+ *   Name      - accessors Config_Get<Name>() / Config_Set<Name>()
+ *   member    - member of Config_Values_t
+ *   type      - IPAddress, uint8_t, uint16_t or uint32_t
+ *   kind      - CONFIG_KIND_IP / _FLAG (0/1) / _UINT (min..max)
+ *   token     - dashboard key ('a'..'z'), '$' token in the template
+ *   json name - field of GET/POST /api/config
+ *
+ * Fields are kept in order of decreasing size, so that every member
+ * is naturally aligned without padding (checked at compile time).
+ * Append new fields of a size at the end of its group and bump
+ * CONFIG_LAYOUT_VERSION (config.h).
+ */
+#define CONFIG_FIELDS(X) \
+    X(DEVICE_IP,    DeviceIp,    deviceIp,    IPAddress, CONFIG_KIND_IP,   'd', "deviceIp",       0, 0,                 CONFIG_IP(192, 168, 5, 11)) \
+    X(GATEWAY_IP,   GatewayIp,   gatewayIp,   IPAddress, CONFIG_KIND_IP,   'g', "gatewayIp",      0, 0,                 CONFIG_IP(192, 168, 5, 1))  \
+    X(NETMASK,      Netmask,     netmask,     IPAddress, CONFIG_KIND_IP,   's', "netmask",        0, 0,                 CONFIG_IP(255, 255, 255, 0)) \
+    X(TARGET_IP,    TargetIp,    targetIp,    IPAddress, CONFIG_KIND_IP,   't', "targetIp",       0, 0,                 CONFIG_IP(192, 168, 5, 2))  \
+    X(DHCP,         Dhcp,        dhcp,        uint8_t,   CONFIG_KIND_FLAG, 'h', "dhcp",           0, 1,                 0) \
+    X(PROTOCOL,     Protocol,    protocol,    uint8_t,   CONFIG_KIND_UINT, 'p', "protocol",       0, 1,                 0) \
+    X(RUNNING,      Running,     running,     uint8_t,   CONFIG_KIND_FLAG, 'r', "running",        0, 1,                 0) \
+    X(IEEE_DECODE,  IeeeDecode,  ieeeDecode,  uint8_t,   CONFIG_KIND_FLAG, 'e', "ieeeDecode",     0, 1,                 0) \
+    X(IEEE_SNAPLEN, IeeeSnaplen, ieeeSnaplen, uint8_t,   CONFIG_KIND_UINT, 'n', "ieeeSnaplen",    0, IEEE_MAX_MPDU_LEN, 0) \
+    X(OUTPUT_MODE,  OutputMode,  outputMode,  uint8_t,   CONFIG_KIND_FLAG, 'o', "bleRecordsOnly", 0, 1,                 0)
+
+// ==============================================================================================================
+
+#endif /* SOURCE_CONFIG_CONFIG_SCHEMA_H_ */
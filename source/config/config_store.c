@@ -0,0 +1,490 @@
+/*
+ * config_store.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <stddef.h>
+
+#include <string.h>
+
+#include <ti/drivers/NVS.h>
+
+#include <source/config/config_store.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Log of configuration images in an NVS region of two or more
+// sectors. Every sector starts with a header, records follow:
+//
+//   sector: [magic][generation][record][record]...[erased]
+//   record: [magic][length][version][reserved][sequence][crc][commit][payload, padded to 4]
+//
+// A commit appends a new record, so flash is written round-robin
+// over all sectors and each sector is erased once per
+// (sector size / record size) commits. When the active sector is
+// full, the next one is erased and the record starts it. Older
+// sector stays intact until then, so the latest committed image
+// survives power loss at any point. Commit word is programmed
+// last, a torn record never has it.
+//
+#define SECTOR_MAGIC            (0x4643534DUL)  // "MSCF"
+#define RECORD_MAGIC            (0xC0F1)
+#define RECORD_COMMITTED        (0x00000000UL)
+#define ERASED_16               (0xFFFF)
+#define ERASED_32               (0xFFFFFFFFUL)
+
+#define RECORD_ALIGN            (4)
+
+#define RECORD_SIZE(len)        ( sizeof(ConfigStore_Record_t) + ( ( (len) + RECORD_ALIGN - 1 ) & ~( RECORD_ALIGN - 1 ) ) )
+
+//
+// Bytes of the record header covered by crc (magic .. sequence)
+//
+#define RECORD_CRC_SPAN         ( offsetof(ConfigStore_Record_t, crc) )
+
+#define MAX_SECTORS             (8)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct ConfigStore_Sector
+{
+    uint32_t magic;
+    uint32_t generation;
+} ConfigStore_Sector_t;
+
+
+typedef struct ConfigStore_Record
+{
+    uint16_t magic;
+    uint16_t length;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t sequence;
+    uint32_t crc;
+    uint32_t commit;
+} ConfigStore_Record_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static NVS_Handle           nvsHandle = NULL;
+
+static uint32_t             sectorSize;
+
+static uint8_t              sectorCount;
+
+//
+// Where the next record goes, activeSector is
+// sectorCount until the first commit formats one
+//
+static uint8_t              activeSector;
+
+static uint32_t             writeOffset;
+
+static uint32_t             lastGeneration;
+
+//
+// Above every committed sequence found, even in records
+// which failed crc, so that sequences are never reused
+//
+static uint32_t             nextSequence;
+
+//
+// Latest valid record
+//
+static bool                 bValid = false;
+
+static uint32_t             lastOffset;
+
+static ConfigStore_Record_t lastRecord;
+
+static uint8_t              scratch[CONFIG_STORE_MAX_PAYLOAD];
+
+//
+// CRC-32 (IEEE 802.3, reflected), half-byte table
+//
+static const uint32_t       crcTable[16] =
+{
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint32_t crc32(uint32_t crc, const uint8_t* pData, uint16_t len)
+{
+    crc = ~crc;
+
+    while ( len-- )
+    {
+        crc ^= *pData++;
+        crc  = ( crc >> 4 ) ^ crcTable[crc & 0x0F];
+        crc  = ( crc >> 4 ) ^ crcTable[crc & 0x0F];
+    }
+
+    return ~crc;
+}
+
+
+static uint32_t recordCrc(const ConfigStore_Record_t* pRecord, const uint8_t* pPayload)
+{
+    uint32_t crc = crc32(0, (const uint8_t*)pRecord, RECORD_CRC_SPAN);
+
+    return crc32(crc, pPayload, pRecord->length);
+}
+
+
+/*
+ * === verify
+ * Reads payload of a committed record into scratch and checks crc.
+ */
+static bool verify(uint32_t offset, const ConfigStore_Record_t* pRecord)
+{
+    if ( NVS_read(nvsHandle, offset + sizeof(ConfigStore_Record_t), scratch, pRecord->length) != NVS_STATUS_SUCCESS )
+    {
+        return false;
+    }
+
+    return ( recordCrc(pRecord, scratch) == pRecord->crc );
+}
+
+
+/*
+ * === findLatest
+ * Walks record headers of all sectors and picks the committed record
+ * with the highest sequence below 'below'. Only headers are read, so
+ * this takes microseconds; payload is checked by the caller. Also
+ * finds where the log of each sector ends.
+ *
+ * Parameters:
+ *      below[in]           - sequence bound (exclusive)
+ *      pOffset[out]        - offset of the record found
+ *      pRecord[out]        - its header
+ *      pEnds[out]          - end of written area of each sector,
+ *                            sectorSize when it cannot take more
+ * Returns:
+ *      bool                - false when no record was found
+ */
+static bool findLatest(uint32_t below, uint32_t* pOffset, ConfigStore_Record_t* pRecord, uint32_t* pEnds)
+{
+    ConfigStore_Sector_t header;
+    ConfigStore_Record_t record;
+    uint32_t             base, pos;
+    uint8_t              sector;
+    bool                 bFound = false;
+
+    for ( sector = 0; sector < sectorCount; sector++ )
+    {
+        base = (uint32_t)sector * sectorSize;
+
+        pEnds[sector] = sectorSize;
+
+        NVS_read(nvsHandle, base, &header, sizeof(header));
+
+        if ( header.magic != SECTOR_MAGIC )
+        {
+            continue;
+        }
+
+        if ( header.generation > lastGeneration )
+        {
+            lastGeneration = header.generation;
+        }
+
+        for ( pos = sizeof(header); pos + sizeof(record) <= sectorSize; pos += RECORD_SIZE(record.length) )
+        {
+            NVS_read(nvsHandle, base + pos, &record, sizeof(record));
+
+            if ( record.magic == ERASED_16 )
+            {
+                break;
+            }
+
+            //
+            // Garbage (torn header), nothing after it can be trusted
+            //
+            if ( record.magic != RECORD_MAGIC || record.length > CONFIG_STORE_MAX_PAYLOAD || pos + RECORD_SIZE(record.length) > sectorSize )
+            {
+                pos = sectorSize;
+
+                break;
+            }
+
+            if ( record.commit == RECORD_COMMITTED && record.sequence >= nextSequence )
+            {
+                nextSequence = record.sequence + 1;
+            }
+
+            if ( record.commit == RECORD_COMMITTED && record.sequence < below && ( !bFound || record.sequence > pRecord->sequence ) )
+            {
+                *pRecord = record;
+                *pOffset = base + pos;
+
+                bFound = true;
+            }
+        }
+
+        pEnds[sector] = ( pos > sectorSize ) ? sectorSize : pos;
+    }
+
+    return bFound;
+}
+
+
+/*
+ * === startSector
+ * Erases next sector and writes its header, the record
+ * which did not fit into the active sector goes there.
+ */
+static bool startSector(void)
+{
+    ConfigStore_Sector_t header;
+    uint8_t              sector = ( activeSector + 1 ) % sectorCount;
+
+    if ( NVS_erase(nvsHandle, (size_t)sector * sectorSize, sectorSize) != NVS_STATUS_SUCCESS )
+    {
+        return false;
+    }
+
+    header.magic      = SECTOR_MAGIC;
+    header.generation = ++lastGeneration;
+
+    if ( NVS_write(nvsHandle, (size_t)sector * sectorSize, &header, sizeof(header), NVS_WRITE_POST_VERIFY) != NVS_STATUS_SUCCESS )
+    {
+        return false;
+    }
+
+    activeSector = sector;
+    writeOffset  = sizeof(header);
+
+    return true;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === ConfigStore_Init
+ * Opens the NVS region and locates the latest valid record.
+ * Record headers are scanned, only the payload of the latest
+ * record is read and checked (a bad one falls back to the
+ * record before it).
+ *
+ * Parameters:
+ *      nvsIndex[in]        - NVS instance (ti_drivers_config.h),
+ *                            region of at least two sectors
+ * Returns:
+ *      ConfigStore_Status_t - CONFIG_STORE_EMPTY when nothing
+ *                             valid is stored yet
+ */
+ConfigStore_Status_t ConfigStore_Init(uint_least8_t nvsIndex)
+{
+    NVS_Attrs            attrs;
+    uint32_t             ends[MAX_SECTORS];
+    uint32_t             below = ERASED_32;
+
+    NVS_init();
+
+    nvsHandle = NVS_open(nvsIndex, NULL);
+
+    if ( nvsHandle == NULL )
+    {
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    NVS_getAttrs(nvsHandle, &attrs);
+
+    sectorSize  = attrs.sectorSize;
+    sectorCount = attrs.regionSize / attrs.sectorSize;
+
+    if ( sectorCount < 2 || sectorCount > MAX_SECTORS )
+    {
+        nvsHandle = NULL;
+
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    bValid         = false;
+    lastGeneration = 0;
+    nextSequence   = 0;
+    activeSector   = sectorCount;
+
+    while ( findLatest(below, &lastOffset, &lastRecord, ends) )
+    {
+        if ( verify(lastOffset, &lastRecord) )
+        {
+            bValid = true;
+
+            break;
+        }
+
+        below = lastRecord.sequence;
+    }
+
+    if ( !bValid )
+    {
+        return CONFIG_STORE_EMPTY;
+    }
+
+    //
+    // Log continues in the sector of the latest record
+    //
+    activeSector = lastOffset / sectorSize;
+    writeOffset  = ends[activeSector];
+
+    return CONFIG_STORE_OK;
+}
+
+
+/*
+ * === ConfigStore_Load
+ * Copies payload of the latest record.
+ *
+ * Parameters:
+ *      pData[out]          - payload
+ *      maxLen[in]          - size of pData
+ *      pLen[out]           - payload length
+ *      pVersion[out]       - layout version it was committed with
+ * Returns:
+ *      ConfigStore_Status_t
+ */
+ConfigStore_Status_t ConfigStore_Load(void* pData, uint16_t maxLen, uint16_t* pLen, uint16_t* pVersion)
+{
+    if ( !bValid )
+    {
+        return CONFIG_STORE_EMPTY;
+    }
+
+    if ( lastRecord.length > maxLen )
+    {
+        return CONFIG_STORE_TOO_LARGE;
+    }
+
+    if ( NVS_read(nvsHandle, lastOffset + sizeof(ConfigStore_Record_t), pData, lastRecord.length) != NVS_STATUS_SUCCESS )
+    {
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    *pLen     = lastRecord.length;
+    *pVersion = lastRecord.version;
+
+    return CONFIG_STORE_OK;
+}
+
+
+/*
+ * === ConfigStore_Commit
+ * Appends the image as a new record, unless it equals the latest one
+ * (no flash wear for settings which did not change). Latest record
+ * is replaced only once the new one is complete.
+ *
+ * Parameters:
+ *      pData[in]           - configuration image
+ *      len[in]             - its length
+ *      version[in]         - layout version of the image
+ * Returns:
+ *      ConfigStore_Status_t
+ */
+ConfigStore_Status_t ConfigStore_Commit(const void* pData, uint16_t len, uint16_t version)
+{
+    ConfigStore_Record_t record;
+    uint32_t             commit = RECORD_COMMITTED;
+    uint32_t             offset;
+
+    if ( nvsHandle == NULL )
+    {
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    if ( len > CONFIG_STORE_MAX_PAYLOAD )
+    {
+        return CONFIG_STORE_TOO_LARGE;
+    }
+
+    if ( bValid && lastRecord.length == len && lastRecord.version == version )
+    {
+        if ( NVS_read(nvsHandle, lastOffset + sizeof(record), scratch, len) == NVS_STATUS_SUCCESS && memcmp(scratch, pData, len) == 0 )
+        {
+            return CONFIG_STORE_OK;
+        }
+    }
+
+    if ( activeSector >= sectorCount || writeOffset + RECORD_SIZE(len) > sectorSize )
+    {
+        if ( !startSector() )
+        {
+            return CONFIG_STORE_FLASH_ERROR;
+        }
+    }
+
+    record.magic    = RECORD_MAGIC;
+    record.length   = len;
+    record.version  = version;
+    record.reserved = ERASED_16;
+    record.sequence = nextSequence++;
+    record.crc      = recordCrc(&record, (const uint8_t*)pData);
+    record.commit   = ERASED_32;
+
+    offset = (uint32_t)activeSector * sectorSize + writeOffset;
+
+    //
+    // Space is taken even if a write fails, the
+    // torn record is skipped on the next boot
+    //
+    writeOffset += RECORD_SIZE(len);
+
+    if ( NVS_write(nvsHandle, offset, &record, sizeof(record), NVS_WRITE_POST_VERIFY) != NVS_STATUS_SUCCESS )
+    {
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    if ( len && NVS_write(nvsHandle, offset + sizeof(record), (void*)pData, len, NVS_WRITE_POST_VERIFY) != NVS_STATUS_SUCCESS )
+    {
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    if ( NVS_write(nvsHandle, offset + offsetof(ConfigStore_Record_t, commit), &commit, sizeof(commit), NVS_WRITE_POST_VERIFY) != NVS_STATUS_SUCCESS )
+    {
+        return CONFIG_STORE_FLASH_ERROR;
+    }
+
+    record.commit = commit;
+
+    lastRecord = record;
+    lastOffset = offset;
+    bValid     = true;
+
+    return CONFIG_STORE_OK;
+}
+
+
+/*
+ * === ConfigStore_GetSequence
+ * Returns:
+ *      uint32_t            - sequence number of the latest record,
+ *                            i.e. number of commits minus one
+ */
+uint32_t ConfigStore_GetSequence(void)
+{
+    return bValid ? lastRecord.sequence : 0;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,63 @@
+/*
+ * config_store.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_CONFIG_CONFIG_STORE_H_
+#define SOURCE_CONFIG_CONFIG_STORE_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Largest configuration image one record can carry
+//
+#define CONFIG_STORE_MAX_PAYLOAD    (128)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === ConfigStore_Status_t
+ * CONFIG_STORE_OK          - done
+ * CONFIG_STORE_EMPTY       - no valid record (blank or foreign flash)
+ * CONFIG_STORE_TOO_LARGE   - payload does not fit the caller's buffer
+ *                            or CONFIG_STORE_MAX_PAYLOAD
+ * CONFIG_STORE_FLASH_ERROR - NVS region missing or refused the operation
+ */
+typedef enum ConfigStore_Status
+{
+    CONFIG_STORE_OK = 0,
+    CONFIG_STORE_EMPTY,
+    CONFIG_STORE_TOO_LARGE,
+    CONFIG_STORE_FLASH_ERROR
+} ConfigStore_Status_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+ConfigStore_Status_t ConfigStore_Init(uint_least8_t nvsIndex);
+
+ConfigStore_Status_t ConfigStore_Load(void* pData, uint16_t maxLen, uint16_t* pLen, uint16_t* pVersion);
+
+ConfigStore_Status_t ConfigStore_Commit(const void* pData, uint16_t len, uint16_t version);
+
+uint32_t             ConfigStore_GetSequence(void);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_CONFIG_CONFIG_STORE_H_ */
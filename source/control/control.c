@@ -0,0 +1,459 @@
+/*
+ * control.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <source/control/control.h>
+
+#include <source/ethernet/EthernetUdp.h>
+
+#include <source/ethernet/EthernetIrq.h>
+
+#include <source/radio_api/radio_api.h>
+
+#include <source/config/config.h>
+
+#include <source/utils/boot_profile.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// First socket tried for the control port, data
+// socket of the sniffing task starts at 3
+//
+#define CONTROL_SOCKET_PREF     (4)
+
+#define FIELD_VARIABLE          (0xFF)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static EthernetUDP controlUdp;
+
+//
+// RECV interrupt came, datagrams may be waiting
+//
+static bool        bPending = false;
+
+static uint8_t     request[CONTROL_MAX_DATAGRAM];
+
+static uint8_t     response[CONTROL_MAX_DATAGRAM];
+
+//
+// Sender of the request being handled, response goes there
+//
+static IPAddress   remoteIp;
+
+static uint16_t    remotePort;
+
+static const uint8_t fieldSize[CONTROL_KEY_COUNT] =
+{
+    [CONTROL_KEY_CHANNEL]         = 1,
+    [CONTROL_KEY_PROTOCOL]        = 1,
+    [CONTROL_KEY_TARGET_IP]       = 4,
+    [CONTROL_KEY_RUNNING]         = 1,
+    [CONTROL_KEY_IEEE_DECODE]     = 1,
+    [CONTROL_KEY_IEEE_SNAPLEN]    = 1,
+    [CONTROL_KEY_OUTPUT_MODE]     = 1,
+    [CONTROL_KEY_TRIGGER_STATE]   = 1,
+    [CONTROL_KEY_TRIGGER_PATTERN] = FIELD_VARIABLE,
+    [CONTROL_KEY_TRIGGER_OFFSET]  = 2,
+    [CONTROL_KEY_TRIGGER_POST]    = 1
+};
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static void onSocketEvent(uint8_t sock, uint8_t events)
+{
+    bPending = true;
+
+    return;
+}
+
+
+static uint16_t writeHeader(uint8_t opcode, uint16_t requestId, Control_Status_t status, uint8_t index)
+{
+    response[0] = CONTROL_VERSION;
+    response[1] = opcode | CONTROL_OP_ACK;
+    response[2] = (uint8_t)requestId;
+    response[3] = (uint8_t)( requestId >> 8 );
+    response[4] = (uint8_t)status;
+    response[5] = index;
+
+    return CONTROL_ACK_HEADER_SIZE;
+}
+
+
+static uint16_t appendField(uint16_t pos, uint8_t key, const void* pValue, uint8_t len)
+{
+    response[pos++] = key;
+    response[pos++] = len;
+
+    memcpy(&response[pos], pValue, len);
+
+    return pos + len;
+}
+
+
+static void sendResponse(uint16_t len)
+{
+    EthernetUDP_beginPacket_ip(&controlUdp, remoteIp, remotePort);
+
+    EthernetUDP_write(&controlUdp, response, len);
+
+    EthernetUDP_endPacket(&controlUdp);
+
+    return;
+}
+
+
+/*
+ * === decode
+ * Decodes fields of a SET request into pBatch and checks every
+ * value, including channel against the protocol the batch leaves
+ * the radio in. Nothing is applied here, so a batch is either
+ * applied as a whole or rejected.
+ *
+ * Parameters:
+ *      len[in]         - length of the request
+ *      pBatch[out]     - decoded fields
+ *      pIndex[out]     - index of the offending field
+ * Returns:
+ *      Control_Status_t
+ */
+static Control_Status_t decode(uint16_t len, Control_Batch_t* pBatch, uint8_t* pIndex)
+{
+    const uint8_t* pValue;
+    uint16_t       pos = CONTROL_HEADER_SIZE;
+    uint8_t        key, fieldLen, index;
+    uint8_t        channelIndex = CONTROL_NO_INDEX;
+    RF_Protocol_t  proto;
+
+    pBatch->fields = 0;
+
+    for ( index = 0; pos < len; index++ )
+    {
+        *pIndex = index;
+
+        if ( pos + 2 > len )
+        {
+            return CONTROL_BAD_FIELD;
+        }
+
+        key      = request[pos];
+        fieldLen = request[pos + 1];
+        pValue   = &request[pos + 2];
+
+        pos += 2 + fieldLen;
+
+        if ( pos > len || key == 0 || key >= CONTROL_KEY_COUNT )
+        {
+            return CONTROL_BAD_FIELD;
+        }
+
+        if ( fieldSize[key] == FIELD_VARIABLE ? fieldLen > 2 * TRIGGER_PATTERN_MAXLEN : fieldLen != fieldSize[key] )
+        {
+            return CONTROL_BAD_FIELD;
+        }
+
+        switch (key)
+        {
+        case CONTROL_KEY_CHANNEL:
+            pBatch->channel = *pValue;
+            channelIndex = index;
+            break;
+
+        case CONTROL_KEY_PROTOCOL:
+            if ( !Config_IsValid(CONFIG_ID_PROTOCOL, *pValue) )
+            {
+                return CONTROL_BAD_VALUE;
+            }
+            pBatch->protocol = *pValue;
+            break;
+
+        case CONTROL_KEY_TARGET_IP:
+            memcpy(pBatch->targetIp.bytes, pValue, 4);
+            break;
+
+        case CONTROL_KEY_IEEE_SNAPLEN:
+            if ( !Config_IsValid(CONFIG_ID_IEEE_SNAPLEN, *pValue) )
+            {
+                return CONTROL_BAD_VALUE;
+            }
+            pBatch->ieeeSnaplen = *pValue;
+            break;
+
+        case CONTROL_KEY_TRIGGER_PATTERN:
+            memcpy(pBatch->triggerPattern, pValue, fieldLen);
+            pBatch->triggerPattern[fieldLen] = '\0';
+            if ( !Trigger_IsValidPattern(pBatch->triggerPattern) )
+            {
+                return CONTROL_BAD_VALUE;
+            }
+            break;
+
+        case CONTROL_KEY_TRIGGER_OFFSET:
+            pBatch->triggerOffset = pValue[0] | ( (uint16_t)pValue[1] << 8 );
+            break;
+
+        case CONTROL_KEY_TRIGGER_POST:
+            pBatch->triggerPostFrames = *pValue;
+            break;
+
+        default:
+            //
+            // Remaining fields are flags
+            //
+            if ( *pValue > 1 )
+            {
+                return CONTROL_BAD_VALUE;
+            }
+
+            if ( key == CONTROL_KEY_RUNNING )            pBatch->running      = *pValue;
+            else if ( key == CONTROL_KEY_IEEE_DECODE )   pBatch->ieeeDecode   = *pValue;
+            else if ( key == CONTROL_KEY_OUTPUT_MODE )   pBatch->outputMode   = *pValue;
+            else                                         pBatch->triggerState = *pValue;
+            break;
+        }
+
+        pBatch->fields |= ( 1 << key );
+    }
+
+    if ( CONTROL_HAS(pBatch, CONTROL_KEY_CHANNEL) )
+    {
+        proto = CONTROL_HAS(pBatch, CONTROL_KEY_PROTOCOL) ? (RF_Protocol_t)pBatch->protocol : Radio_GetCurrentProtocol();
+
+        if ( !Radio_isValidChannel(proto, pBatch->channel) )
+        {
+            *pIndex = channelIndex;
+
+            return CONTROL_BAD_VALUE;
+        }
+    }
+
+    *pIndex = CONTROL_NO_INDEX;
+
+    return CONTROL_OK;
+}
+
+
+/*
+ * === respondGet
+ * Sends current settings, same fields as SET takes.
+ */
+static void respondGet(uint16_t requestId)
+{
+    RF_Protocol_t proto = Radio_GetCurrentProtocol();
+    const char*   pPattern = Trigger_GetPattern();
+    uint16_t      offset = Trigger_GetOffset();
+    IPAddress     targetIp;
+    uint8_t       value;
+    uint16_t      pos;
+
+    pos = writeHeader(CONTROL_OP_GET, requestId, CONTROL_OK, CONTROL_NO_INDEX);
+
+    value = Radio_GetChannel(proto);
+    pos = appendField(pos, CONTROL_KEY_CHANNEL, &value, 1);
+
+    value = (uint8_t)proto;
+    pos = appendField(pos, CONTROL_KEY_PROTOCOL, &value, 1);
+
+    targetIp = Config_GetTargetIp();
+    pos = appendField(pos, CONTROL_KEY_TARGET_IP, targetIp.bytes, 4);
+
+    value = Config_GetRunning();
+    pos = appendField(pos, CONTROL_KEY_RUNNING, &value, 1);
+
+    value = Config_GetIeeeDecode();
+    pos = appendField(pos, CONTROL_KEY_IEEE_DECODE, &value, 1);
+
+    value = Config_GetIeeeSnaplen();
+    pos = appendField(pos, CONTROL_KEY_IEEE_SNAPLEN, &value, 1);
+
+    value = Config_GetOutputMode();
+    pos = appendField(pos, CONTROL_KEY_OUTPUT_MODE, &value, 1);
+
+    value = ( Trigger_GetState() != TRIGGER_OFF );
+    pos = appendField(pos, CONTROL_KEY_TRIGGER_STATE, &value, 1);
+
+    pos = appendField(pos, CONTROL_KEY_TRIGGER_PATTERN, pPattern, strlen(pPattern));
+
+    pos = appendField(pos, CONTROL_KEY_TRIGGER_OFFSET, &offset, 2);    // LE on CC26x2
+
+    value = Trigger_GetPostFrames();
+    pos = appendField(pos, CONTROL_KEY_TRIGGER_POST, &value, 1);
+
+    sendResponse(pos);
+
+    return;
+}
+
+
+_Static_assert(CONTROL_ACK_HEADER_SIZE + BOOT_PHASE_COUNT * ( 2 + 4 ) <= CONTROL_MAX_DATAGRAM, "BOOT response does not fit a datagram");
+
+/*
+ * === respondBoot
+ * Sends boot phase timestamps, one u32 field per phase reached.
+ */
+static void respondBoot(uint16_t requestId)
+{
+    BootProfile_Phase_t phase;
+    uint32_t            micros;
+    uint16_t            pos;
+
+    pos = writeHeader(CONTROL_OP_BOOT, requestId, CONTROL_OK, CONTROL_NO_INDEX);
+
+    for ( phase = (BootProfile_Phase_t)0; phase < BOOT_PHASE_COUNT; phase++ )
+    {
+        if ( BootProfile_Get(phase, &micros) )
+        {
+            pos = appendField(pos, (uint8_t)phase, &micros, 4);    // LE on CC26x2
+        }
+    }
+
+    sendResponse(pos);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Control_Init
+ * Opens the control port and enables its RECV interrupt,
+ * requests are then read only after the interrupt came.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      bool            - false when no socket is free
+ */
+bool Control_Init(void)
+{
+    EthernetUDP_begin_init(&controlUdp);
+
+    if ( !EthernetUDP_begin(&controlUdp, CONTROL_PORT, CONTROL_SOCKET_PREF) )
+    {
+        return false;
+    }
+
+    EthernetIrq_Register(controlUdp._sock, ETHIRQ_RECV, onSocketEvent);
+
+    return true;
+}
+
+
+/*
+ * === Control_Receive
+ * Reads pending requests. GET, BOOT and malformed requests are answered
+ * right away, the first valid SET request is returned to be applied
+ * by the caller, who answers it with Control_Ack(). Datagrams shorter
+ * than the header are dropped. No SPI access unless RECV came.
+ *
+ * Parameters:
+ *      pBatch[out]     - decoded SET request
+ * Returns:
+ *      bool            - true when pBatch holds a request to apply
+ */
+bool Control_Receive(Control_Batch_t* pBatch)
+{
+    Control_Status_t status;
+    uint16_t         requestId;
+    uint8_t          index = CONTROL_NO_INDEX;
+    int              len;
+
+    while ( bPending )
+    {
+        len = EthernetUDP_parsePacket(&controlUdp);
+
+        if ( len <= 0 )
+        {
+            bPending = false;
+
+            break;
+        }
+
+        remoteIp   = EthernetUDP_remoteIP(&controlUdp);
+        remotePort = EthernetUDP_remotePort(&controlUdp);
+
+        if ( len < CONTROL_HEADER_SIZE )
+        {
+            continue;
+        }
+
+        EthernetUDP_read_buf(&controlUdp, request, len > CONTROL_MAX_DATAGRAM ? CONTROL_MAX_DATAGRAM : len);
+
+        requestId = request[2] | ( (uint16_t)request[3] << 8 );
+
+        if ( request[0] != CONTROL_VERSION )
+        {
+            status = CONTROL_BAD_VERSION;
+        }
+        else if ( len > CONTROL_MAX_DATAGRAM )
+        {
+            status = CONTROL_BAD_FIELD;
+        }
+        else if ( request[1] == CONTROL_OP_GET )
+        {
+            respondGet(requestId);
+
+            continue;
+        }
+        else if ( request[1] == CONTROL_OP_BOOT )
+        {
+            respondBoot(requestId);
+
+            continue;
+        }
+        else if ( request[1] == CONTROL_OP_SET )
+        {
+            status = decode(len, pBatch, &index);
+
+            if ( status == CONTROL_OK )
+            {
+                pBatch->requestId = requestId;
+
+                return true;
+            }
+        }
+        else
+        {
+            status = CONTROL_BAD_OPCODE;
+        }
+
+        sendResponse(writeHeader(request[1] & ~CONTROL_OP_ACK, requestId, status, index));
+    }
+
+    return false;
+}
+
+
+/*
+ * === Control_Ack
+ * Answers SET request returned by Control_Receive().
+ */
+void Control_Ack(const Control_Batch_t* pBatch, Control_Status_t status)
+{
+    sendResponse(writeHeader(CONTROL_OP_SET, pBatch->requestId, status, CONTROL_NO_INDEX));
+
+    return;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,132 @@
+/*
+ * control.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_CONTROL_CONTROL_H_
+#define SOURCE_CONTROL_CONTROL_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <source/trigger/trigger.h>
+
+#include <source/ethernet/IPAddress.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Binary control protocol, one request per datagram.
+// Request:  [version][opcode][request id, LE16][fields...]
+// Response: [version][opcode | CONTROL_OP_ACK][request id, LE16][status][index][fields...]
+// Field:    [key][len][value, len bytes, multi-byte values LE]
+//
+// Index is position of the offending field (0-based), 0xFF
+// when the status does not relate to a field. Fields are
+// carried by GET and BOOT responses only. BOOT response
+// fields are keyed by BootProfile_Phase_t, u32 microseconds
+// from the start of the init task (phases not reached are
+// left out).
+//
+#define CONTROL_PORT                (2015)
+
+#define CONTROL_VERSION             (1)
+
+#define CONTROL_HEADER_SIZE         (4)
+
+#define CONTROL_ACK_HEADER_SIZE     (6)
+
+#define CONTROL_MAX_DATAGRAM        (64)
+
+#define CONTROL_NO_INDEX            (0xFF)
+
+#define CONTROL_OP_SET              (0x01)  // apply all fields, or none of them
+#define CONTROL_OP_GET              (0x02)  // report current settings
+#define CONTROL_OP_BOOT             (0x03)  // report boot phase timestamps
+#define CONTROL_OP_ACK              (0x80)
+
+#define CONTROL_KEY_CHANNEL         (0x01)  // u8, BLE 0..39, IEEE 11..26
+#define CONTROL_KEY_PROTOCOL        (0x02)  // u8, RF_Protocol_t
+#define CONTROL_KEY_TARGET_IP       (0x03)  // 4 bytes
+#define CONTROL_KEY_RUNNING         (0x04)  // u8, 0/1
+#define CONTROL_KEY_IEEE_DECODE     (0x05)  // u8, 0/1
+#define CONTROL_KEY_IEEE_SNAPLEN    (0x06)  // u8, 0 = whole MPDU
+#define CONTROL_KEY_OUTPUT_MODE     (0x07)  // u8, 0 raw / 1 BLE records
+#define CONTROL_KEY_TRIGGER_STATE   (0x08)  // u8, 0 off / 1 armed
+#define CONTROL_KEY_TRIGGER_PATTERN (0x09)  // text as in Trigger_SetPattern, no terminator
+#define CONTROL_KEY_TRIGGER_OFFSET  (0x0A)  // u16
+#define CONTROL_KEY_TRIGGER_POST    (0x0B)  // u8
+#define CONTROL_KEY_COUNT           (0x0C)
+
+#define CONTROL_HAS(pBatch, key)    ( (pBatch)->fields & ( 1 << (key) ) )
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === Control_Status_t
+ * CONTROL_OK           - batch was applied
+ * CONTROL_BAD_VERSION  - version byte is not CONTROL_VERSION
+ * CONTROL_BAD_OPCODE   - unknown opcode
+ * CONTROL_BAD_FIELD    - unknown key, wrong length or truncated field
+ * CONTROL_BAD_VALUE    - value out of range, nothing was applied
+ * CONTROL_RADIO_ERROR  - other fields were applied, radio refused
+ *                        the protocol or channel
+ */
+typedef enum Control_Status
+{
+    CONTROL_OK = 0,
+    CONTROL_BAD_VERSION,
+    CONTROL_BAD_OPCODE,
+    CONTROL_BAD_FIELD,
+    CONTROL_BAD_VALUE,
+    CONTROL_RADIO_ERROR
+} Control_Status_t;
+
+
+/*
+ * === Control_Batch_t
+ * Decoded and validated SET request. Only fields
+ * with their bit in fields (CONTROL_HAS) are valid.
+ */
+typedef struct Control_Batch
+{
+    uint16_t  requestId;
+    uint16_t  fields;
+    uint8_t   channel;
+    uint8_t   protocol;
+    IPAddress targetIp;
+    uint8_t   running;
+    uint8_t   ieeeDecode;
+    uint8_t   ieeeSnaplen;
+    uint8_t   outputMode;
+    uint8_t   triggerState;
+    char      triggerPattern[2 * TRIGGER_PATTERN_MAXLEN + 1];
+    uint16_t  triggerOffset;
+    uint8_t   triggerPostFrames;
+} Control_Batch_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+bool Control_Init(void);
+
+bool Control_Receive(Control_Batch_t* pBatch);
+
+void Control_Ack(const Control_Batch_t* pBatch, Control_Status_t status);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_CONTROL_CONTROL_H_ */
@@ -21,6 +21,10 @@
 
 #include <ti/drivers/I2C.h>
 
+#include <ti/sysbios/BIOS.h>
+
+#include <ti/sysbios/knl/Semaphore.h>
+
 #include "ti_drivers_config.h"
 
 #include <source/driverlib/ssd1306/font.h>
@@ -29,6 +33,32 @@
 
 // ==============================================================================================================
 
+// === DEFINES ==================================================================================================
+
+//
+// Page of the update in flight while the command
+// of its window has not been sent yet
+//
+#define WINDOW_COMMAND            0xFF
+
+// ==============================================================================================================
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === SSD1306_Window_t
+ * Column and page address window of an update.
+ */
+typedef struct SSD1306_Window
+{
+    uint8_t firstPage;
+    uint8_t lastPage;
+    uint8_t firstCol;
+    uint8_t lastCol;
+} SSD1306_Window_t;
+
+// ==============================================================================================================
+
 // === GLOBAL VARIABLES =========================================================================================
 
 /*
@@ -85,6 +115,39 @@ char *const SSD1306_Lcd = &SSD1306_LcdBufferInclStreamByte[1];
 static I2C_Params _i2cParams;
 static I2C_Handle _i2c;
 
+//
+// Columns of each page changed since the last update, a clean
+// page has END_COLUMN_ADDR as first and 0 as last column
+//
+static uint8_t _dirtyFirst[RAM_Y_END];
+static uint8_t _dirtyLast[RAM_Y_END];
+
+//
+// One page of a window with the data stream byte in front
+//
+static uint8_t _pageBuffer[RAM_X_END + 1];
+
+//
+// I2C runs in callback mode. Single transfers and
+// SSD1306_UpdateScreen() wait for the callback here.
+//
+static Semaphore_Handle _transferDone;
+static volatile bool _transferStatus;
+
+//
+// Update in flight: windows planned by SSD1306_BeginUpdate() and
+// the window and page being sent, each transfer is queued by the
+// callback of the previous one
+//
+static SSD1306_Window_t _windows[RAM_Y_END];
+static uint8_t _windowCount;
+static uint8_t _window;
+static uint8_t _page;
+static uint8_t _windowCmd[7];
+static I2C_Transaction _updateTxn;
+static SSD1306_DoneFxn _updateDone;
+static volatile bool _updating;
+
 // ==============================================================================================================
 
 // === INTERNAL FUNCTIONS =======================================================================================
@@ -92,7 +155,7 @@ static I2C_Handle _i2c;
 /*
  * === sendData
  * Non-published function handling I2C transfer of data. Can be called after
- * I2C Initialization. Uses global handle `_i2c`.
+ * I2C Initialization. Uses global handle `_i2c`, waits for the callback.
  *
  * Parameters:
  *      address[in]  - address of I2C device
@@ -111,7 +174,217 @@ uint8_t sendData(uint8_t address, void *data, uint16_t count)
     txn.readBuf = NULL;
     txn.slaveAddress = address;
 
-    return I2C_transfer(_i2c, &txn);
+    if (!I2C_transfer(_i2c, &txn))
+    {
+        return 0;
+    }
+
+    Semaphore_pend(_transferDone, BIOS_WAIT_FOREVER);
+
+    return _transferStatus ? 1 : 0;
+}
+
+/*
+ * === markDirty
+ * Marks bytes of LCD buffer from `first` to `last` as changed,
+ * both have to be in the same page.
+ *
+ * Parameters:
+ *      first[in]    - index of the first changed byte
+ *      last[in]     - index of the last changed byte
+ * Returns:
+ *      N/A
+ */
+static void markDirty(uint16_t first, uint16_t last)
+{
+    uint8_t page = first >> 7;
+
+    if (page > END_PAGE_ADDR)
+    {
+        return;
+    }
+
+    if ((first & END_COLUMN_ADDR) < _dirtyFirst[page])
+    {
+        _dirtyFirst[page] = first & END_COLUMN_ADDR;
+    }
+
+    if ((last & END_COLUMN_ADDR) > _dirtyLast[page])
+    {
+        _dirtyLast[page] = last & END_COLUMN_ADDR;
+    }
+
+    return;
+}
+
+/*
+ * === finishUpdate
+ * Completes the update in flight. When it failed, the window being
+ * sent and those after it are marked again for the next update.
+ *
+ * Parameters:
+ *      status[in]   - all transfers of the update were successful
+ * Returns:
+ *      N/A
+ */
+static void finishUpdate(bool status)
+{
+    SSD1306_DoneFxn doneFxn = _updateDone;
+
+    uint8_t page;
+
+    for (; !status && _window < _windowCount; _window++)
+    {
+        for (page = _windows[_window].firstPage; page <= _windows[_window].lastPage; page++)
+        {
+            markDirty((page << 7) + _windows[_window].firstCol, (page << 7) + _windows[_window].lastCol);
+        }
+    }
+
+    _updating = false;
+
+    doneFxn(status ? SSD1306_SUCCESS : SSD1306_ERROR);
+
+    return;
+}
+
+/*
+ * === sendNext
+ * Queues the next transfer of the update in flight: the column and page
+ * address command of a window, then its pages. In horizontal addressing
+ * mode the display moves to the next page at the end of the window, so
+ * pages follow each other in separate transfers. Full-width windows from
+ * page 0 go in one transfer straight from LCD buffer. Completes the
+ * update after the last transfer.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+static void sendNext(void)
+{
+    SSD1306_Window_t *window;
+
+    uint8_t width;
+
+    while (_window < _windowCount)
+    {
+        window = &_windows[_window];
+
+        width = window->lastCol - window->firstCol + 1;
+
+        if (_page == WINDOW_COMMAND)
+        {
+            _windowCmd[0] = SSD1306_COMMAND_STREAM;
+            _windowCmd[1] = SSD1306_SET_COLUMN_ADDR;
+            _windowCmd[2] = window->firstCol;
+            _windowCmd[3] = window->lastCol;
+            _windowCmd[4] = SSD1306_SET_PAGE_ADDR;
+            _windowCmd[5] = window->firstPage;
+            _windowCmd[6] = window->lastPage;
+
+            _updateTxn.writeBuf = _windowCmd;
+            _updateTxn.writeCount = sizeof(_windowCmd);
+
+            _page = window->firstPage;
+
+            break;
+        }
+
+        if (_page <= window->lastPage)
+        {
+            if (window->firstPage == START_PAGE_ADDR && width == RAM_X_END)
+            {
+                _updateTxn.writeBuf = SSD1306_LcdBufferInclStreamByte;
+                _updateTxn.writeCount = ((window->lastPage + 1) * RAM_X_END) + 1;
+
+                _page = window->lastPage + 1;
+            }
+            else
+            {
+                memcpy(&_pageBuffer[1], &SSD1306_Lcd[(_page << 7) + window->firstCol], width);
+
+                _updateTxn.writeBuf = _pageBuffer;
+                _updateTxn.writeCount = width + 1;
+
+                _page++;
+            }
+
+            break;
+        }
+
+        _window++;
+
+        _page = WINDOW_COMMAND;
+    }
+
+    if (_window == _windowCount)
+    {
+        finishUpdate(true);
+
+        return;
+    }
+
+    _updateTxn.readBuf = NULL;
+    _updateTxn.readCount = 0;
+    _updateTxn.slaveAddress = SSD1306_ADDR;
+
+    //
+    // The callback may run before this returns,
+    // nothing may be touched after it
+    //
+    if (!I2C_transfer(_i2c, &_updateTxn))
+    {
+        finishUpdate(false);
+    }
+
+    return;
+}
+
+/*
+ * === onTransfer
+ * I2C callback (Swi context). Carries the update in flight on or
+ * wakes up the task waiting for a single transfer.
+ *
+ * Parameters:
+ *      handle[in]   - I2C handle
+ *      txn[in]      - transaction which completed
+ *      status[in]   - true if the transfer was successful
+ * Returns:
+ *      N/A
+ */
+static void onTransfer(I2C_Handle handle, I2C_Transaction *txn, bool status)
+{
+    if (txn != &_updateTxn)
+    {
+        _transferStatus = status;
+
+        Semaphore_post(_transferDone);
+    }
+    else if (status)
+    {
+        sendNext();
+    }
+    else
+    {
+        finishUpdate(false);
+    }
+
+    return;
+}
+
+/*
+ * === onUpdateScreenDone
+ * Completion of the update started by SSD1306_UpdateScreen().
+ */
+static void onUpdateScreenDone(uint8_t status)
+{
+    _transferStatus = (status == SSD1306_SUCCESS);
+
+    Semaphore_post(_transferDone);
+
+    return;
 }
 
 // ==============================================================================================================
@@ -132,9 +405,19 @@ uint8_t SSD1306_Init()
 {
     SSD1306_LcdBufferInclStreamByte[0] = 0x40;
 
+    _pageBuffer[0] = SSD1306_DATA_STREAM;
+
     uint8_t i;
 
-    uint8_t status = INIT_STATUS;
+    uint8_t status = SSD1306_SUCCESS;
+
+    Semaphore_Params semParams;
+
+    Semaphore_Params_init(&semParams);
+
+    semParams.mode = Semaphore_Mode_BINARY;
+
+    _transferDone = Semaphore_create(0, &semParams, NULL);
 
     //
     // I2C Initialization
@@ -147,7 +430,9 @@ uint8_t SSD1306_Init()
 
     _i2cParams.bitRate = I2C_400kHz;
 
-    _i2cParams.transferMode = I2C_MODE_BLOCKING;
+    _i2cParams.transferMode = I2C_MODE_CALLBACK;
+
+    _i2cParams.transferCallbackFxn = onTransfer;
 
     _i2c = I2C_open(CONFIG_I2C_0, &_i2cParams);
 
@@ -156,17 +441,24 @@ uint8_t SSD1306_Init()
         return I2C_ERROR;
     }
 
+    //
+    // Display RAM holds whatever was there before
+    //
+    SSD1306_InvalidateScreen();
+
+    //
+    // Whole sequence is sent even if a command is not acked,
+    // the result tells whether the display took all of it
+    //
     for (i = 0; i < sizeof(SSD1306_InitSequence); i++)
     {
-        status = SSD1306_SendCommand(SSD1306_InitSequence[i]);
-
-        //        if ( status != SSD1306_SUCCESS )
-        //        {
-        //            return status;
-        //        }
+        if ( SSD1306_SendCommand(SSD1306_InitSequence[i]) != SSD1306_SUCCESS )
+        {
+            status = SSD1306_ERROR;
+        }
     }
 
-    return SSD1306_SUCCESS;
+    return status;
 }
 
 /*
@@ -224,9 +516,129 @@ uint8_t SSD1306_InverseScreen()
     return SSD1306_SendCommand(SSD1306_DIS_INVERSE);
 }
 
+/*
+ * === SSD1306_BeginUpdate
+ * Starts sending changed parts of LCD buffer to SSD1306 and returns,
+ * the I2C callback queues one transfer after the other. Neighbouring
+ * changed pages share one address window (spanning columns of both)
+ * when the columns sent in addition cost less than another window,
+ * SSD1306_WINDOW_COST. Nothing is sent when nothing changed. Pages
+ * not sent because a transfer failed are marked again. LCD buffer
+ * must not be drawn into until `doneFxn` is called.
+ *
+ * Parameters:
+ *      doneFxn[in]  - called once with SSD1306_SUCCESS or SSD1306_ERROR
+ *                     when the update completes (Swi context), may be
+ *                     called before this returns
+ * Returns:
+ *      SSD1306_SUCCESS, or SSD1306_ERROR if an update is in flight
+ *      (`doneFxn` is not called then)
+ */
+uint8_t SSD1306_BeginUpdate(SSD1306_DoneFxn doneFxn)
+{
+    uint8_t page;
+
+    uint8_t firstPage = RAM_Y_END;
+
+    uint8_t firstCol = 0;
+
+    uint8_t lastCol = 0;
+
+    uint8_t mergedFirst;
+
+    uint8_t mergedLast;
+
+    uint16_t separate;
+
+    uint16_t merged;
+
+    if (_updating)
+    {
+        return SSD1306_ERROR;
+    }
+
+    _windowCount = 0;
+
+    //
+    // One pass past the last page sends the window still open
+    //
+    for (page = START_PAGE_ADDR; page <= RAM_Y_END; page++)
+    {
+        bool dirty = (page < RAM_Y_END) && (_dirtyFirst[page] <= _dirtyLast[page]);
+
+        if (firstPage < RAM_Y_END)
+        {
+            //
+            // Extend the window over this page or send it
+            //
+            if (dirty)
+            {
+                mergedFirst = (_dirtyFirst[page] < firstCol) ? _dirtyFirst[page] : firstCol;
+                mergedLast  = (_dirtyLast[page] > lastCol) ? _dirtyLast[page] : lastCol;
+
+                separate = (page - firstPage) * (lastCol - firstCol + 1) + (_dirtyLast[page] - _dirtyFirst[page] + 1) + SSD1306_WINDOW_COST;
+                merged   = (page - firstPage + 1) * (mergedLast - mergedFirst + 1);
+
+                if (merged <= separate)
+                {
+                    firstCol = mergedFirst;
+                    lastCol  = mergedLast;
+
+                    continue;
+                }
+            }
+
+            _windows[_windowCount].firstPage = firstPage;
+            _windows[_windowCount].lastPage  = page - 1;
+            _windows[_windowCount].firstCol  = firstCol;
+            _windows[_windowCount].lastCol   = lastCol;
+
+            _windowCount++;
+
+            for (; firstPage < page; firstPage++)
+            {
+                _dirtyFirst[firstPage] = END_COLUMN_ADDR;
+                _dirtyLast[firstPage]  = 0;
+            }
+
+            firstPage = RAM_Y_END;
+        }
+
+        if (dirty)
+        {
+            firstPage = page;
+            firstCol  = _dirtyFirst[page];
+            lastCol   = _dirtyLast[page];
+        }
+    }
+
+    _updateDone = doneFxn;
+
+    _window = 0;
+
+    _page = WINDOW_COMMAND;
+
+    _updating = true;
+
+    sendNext();
+
+    return SSD1306_SUCCESS;
+}
+
+/*
+ * === SSD1306_IsUpdating
+ * Returns:
+ *      true while an update started by SSD1306_BeginUpdate() is in flight
+ */
+bool SSD1306_IsUpdating()
+{
+    return _updating;
+}
+
 /*
  * === SSD1306_UpdateScreen
- * Sends contents of LCD buffer to SSD1306 thus updating the screen itself.
+ * Sends changed parts of LCD buffer to SSD1306 thus updating the screen
+ * itself, waits until the update completes (SSD1306_BeginUpdate()).
  *
  * Parameters:
  *      N/A
@@ -235,16 +647,32 @@ uint8_t SSD1306_InverseScreen()
  */
 uint8_t SSD1306_UpdateScreen()
 {
-    uint8_t status = INIT_STATUS;
-
-    status = sendData(SSD1306_ADDR, (void *)SSD1306_LcdBufferInclStreamByte, (CACHE_SIZE_MEM + 1));
-
-    if (status == 1)
+    if (SSD1306_BeginUpdate(onUpdateScreenDone) != SSD1306_SUCCESS)
     {
-        return SSD1306_SUCCESS;
+        return SSD1306_ERROR;
     }
 
-    return SSD1306_ERROR;
+    Semaphore_pend(_transferDone, BIOS_WAIT_FOREVER);
+
+    return _transferStatus ? SSD1306_SUCCESS : SSD1306_ERROR;
+}
+
+/*
+ * === SSD1306_InvalidateScreen
+ * Marks the whole LCD buffer as changed, the next update sends
+ * all of it.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void SSD1306_InvalidateScreen()
+{
+    memset(_dirtyFirst, START_COLUMN_ADDR, sizeof(_dirtyFirst));
+    memset(_dirtyLast, END_COLUMN_ADDR, sizeof(_dirtyLast));
+
+    return;
 }
 
 /*
@@ -260,6 +688,8 @@ void SSD1306_ClearScreenBuffer()
 {
     memset((void *)SSD1306_Lcd, 0x0, CACHE_SIZE_MEM);
 
+    SSD1306_InvalidateScreen();
+
     return;
 }
 
@@ -336,6 +766,8 @@ uint8_t SSD1306_DrawChar(const char character, bool inverted)
         return SSD1306_ERROR;
     }
 
+    markDirty(_counter, _counter + CHARS_COLS_LENGTH - (inverted ? 0 : 1));
+
     while (i < CHARS_COLS_LENGTH)
     {
         if (!inverted)
@@ -410,6 +842,8 @@ uint8_t SSD1306_DrawPixel(uint8_t x, uint8_t y)
 
     _counter = x + (page << 7);
 
+    markDirty(_counter, _counter);
+
     SSD1306_Lcd[_counter++] |= pixel;
 
     return SSD1306_SUCCESS;
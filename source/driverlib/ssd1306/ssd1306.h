@@ -62,11 +62,6 @@
 //
 #define CLEAR_COLOR               0x00
 
-//
-// Init Status
-//
-#define INIT_STATUS               0xFF
-
 //
 // AREA definition
 //
@@ -82,6 +77,24 @@
 #define MAX_X                     (END_COLUMN_ADDR)
 #define MAX_Y                     ((END_PAGE_ADDR + 1) * 8)
 
+//
+// Bus cost of an address window in bytes (slave address, control
+// byte, column and page commands), weighed by SSD1306_UpdateScreen()
+// against sending unchanged columns of neighbouring pages
+//
+#define SSD1306_WINDOW_COST       8
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+//
+// Completion of SSD1306_BeginUpdate(), called from
+// the I2C callback (Swi context)
+//
+typedef void (*SSD1306_DoneFxn)(uint8_t status);
+
 // ==============================================================================================================
 
 
@@ -108,6 +121,12 @@ uint8_t SSD1306_InverseScreen(void);
 
 uint8_t SSD1306_UpdateScreen(void);
 
+uint8_t SSD1306_BeginUpdate(SSD1306_DoneFxn);
+
+bool    SSD1306_IsUpdating(void);
+
+void    SSD1306_InvalidateScreen(void);
+
 uint8_t SSD1306_UpdatePosition(void);
 
 void    SSD1306_SetPosition(uint8_t, uint8_t);
@@ -15,6 +15,13 @@
 
 #include <source/ethernet/ArduinoCompatibility.h>
 
+#include <source/utils/stats.h>
+
+#include <source/utils/spi_profile.h>
+
+// address (2) + control byte
+#define SPI_FRAME_HEADER 3
+
 #define SPI_CS 10
 
 void W5500_init(void)
@@ -92,17 +99,21 @@ void W5500_read_data(SOCKET s, volatile uint16_t src, volatile uint8_t *dst, uin
 
 uint8_t W5500_write(uint16_t _addr, uint8_t _cb, uint8_t _data)
 {
+    SPI_PROFILE_FRAME(_addr, _cb);
     setSS();  
     SPI_transf(_addr >> 8);
     SPI_transf(_addr & 0xFF);
     SPI_transf(_cb);
     SPI_transf(_data);
     resetSS();
+    Stats_Increment(STATS_SPI_TRANSACTIONS);
+    Stats_Add(STATS_SPI_BYTES, SPI_FRAME_HEADER + 1);
     return 1;
 }
 
 uint16_t W5500_write_buf(uint16_t _addr, uint8_t _cb, const uint8_t *_buf, uint16_t _len)
 {
+    SPI_PROFILE_FRAME(_addr, _cb);
     setSS();
     SPI_transf(_addr >> 8);
     SPI_transf(_addr & 0xFF);
@@ -111,22 +122,28 @@ uint16_t W5500_write_buf(uint16_t _addr, uint8_t _cb, const uint8_t *_buf, uint1
         SPI_transf(_buf[i]);
     }
     resetSS();
+    Stats_Increment(STATS_SPI_TRANSACTIONS);
+    Stats_Add(STATS_SPI_BYTES, SPI_FRAME_HEADER + _len);
     return _len;
 }
 
 uint8_t W5500_read(uint16_t _addr, uint8_t _cb)
 {
+    SPI_PROFILE_FRAME(_addr, _cb);
     setSS();
     SPI_transf(_addr >> 8);
     SPI_transf(_addr & 0xFF);
     SPI_transf(_cb);
     uint8_t _data = SPI_transf(0);
     resetSS();
+    Stats_Increment(STATS_SPI_TRANSACTIONS);
+    Stats_Add(STATS_SPI_BYTES, SPI_FRAME_HEADER + 1);
     return _data;
 }
 
 uint16_t W5500_read_buf(uint16_t _addr, uint8_t _cb, uint8_t *_buf, uint16_t _len)
 { 
+    SPI_PROFILE_FRAME(_addr, _cb);
     setSS(); 
     SPI_transf(_addr >> 8);
     SPI_transf(_addr & 0xFF);
@@ -135,6 +152,8 @@ uint16_t W5500_read_buf(uint16_t _addr, uint8_t _cb, uint8_t *_buf, uint16_t _le
         _buf[i] = SPI_transf(0);
     }
     resetSS();
+    Stats_Increment(STATS_SPI_TRANSACTIONS);
+    Stats_Add(STATS_SPI_BYTES, SPI_FRAME_HEADER + _len);
     return _len;
 }
 
@@ -4,6 +4,7 @@
 */
 #include "Ethernet.h"
 #include "Dhcp.h"
+#include <source/utils/spi_profile.h>
 
 EthernetConfiguration Ethernet;
 
@@ -11,13 +12,15 @@ EthernetConfiguration Ethernet;
 //uint8_t Ethernet_state[MAX_SOCK_NUM] = { 0, };
 uint16_t Ethernet_server_port[MAX_SOCK_NUM] = { 0, };
 
+// DHCP client state, used by Ethernet_maintain() for lease renewal
+// after Ethernet_begin_mac() returns (must not live on its stack)
+static DHCP _dhcp_state;
+
 
 
 int Ethernet_begin_mac(uint8_t *mac_address)
 {
-  DHCP dhcp;
-
-  Ethernet._dhcp = &dhcp;
+  Ethernet._dhcp = &_dhcp_state;
 
   // Initialise the basic info
   W5500_init();
@@ -31,7 +34,9 @@ int Ethernet_begin_mac(uint8_t *mac_address)
   W5500_setIPAddress(ip.bytes);
 
   // Now try to get our config info from a DHCP server
+  SPI_PROFILE_ENTER(SPI_PROFILE_DHCP_DNS);
   int ret =  DHCP_beginWithDHCP(Ethernet._dhcp,mac_address);
+  SPI_PROFILE_LEAVE();
   if(ret == 1)
   {
     // We've successfully found a DHCP server and got our configuration info, so set things
@@ -41,6 +46,11 @@ int Ethernet_begin_mac(uint8_t *mac_address)
     W5500_setSubnetMask(DHCP_getSubnetMask(Ethernet._dhcp).bytes);
 	Ethernet._dnsServerAddress.dword = DHCP_getDnsServerIp(Ethernet._dhcp).dword;
   }
+  else
+  {
+    // No lease, nothing for Ethernet_maintain() to renew
+    Ethernet._dhcp = NULL;
+  }
 
   return ret;
 }
@@ -84,11 +94,29 @@ void Ethernet_begin_mac_ip_dns_gateway_subnet(uint8_t *mac, IPAddress local_ip,
   Ethernet._dnsServerAddress = dns_server;
 }
 
+// Takes over W5500 configured before a soft restart (no chip reset).
+// lease is NULL for a static address, otherwise it continues to be
+// renewed by Ethernet_maintain().
+void Ethernet_resume(IPAddress dns_server, const DHCP *lease)
+{
+  Ethernet._dnsServerAddress = dns_server;
+
+  if (lease != NULL) {
+    _dhcp_state = *lease;
+    // millis() started again, restart the one second countdown
+    _dhcp_state._lastCheck = 0;
+    EthernetUDP_begin_init(&_dhcp_state._dhcpUdpSocket);
+    Ethernet._dhcp = &_dhcp_state;
+  }
+}
+
 int Ethernet_maintain(){
   int rc = DHCP_CHECK_NONE;
   if(Ethernet._dhcp != NULL){
     //we have a pointer to dhcp, use it
+    SPI_PROFILE_ENTER(SPI_PROFILE_DHCP_DNS);
     rc = DHCP_checkLease(Ethernet._dhcp);
+    SPI_PROFILE_LEAVE();
     switch ( rc ){
       case DHCP_CHECK_NONE:
         //nothing done
@@ -134,32 +162,3 @@ IPAddress Ethernet_dnsServerIP()
 {
   return Ethernet._dnsServerAddress;
 }
-
-void Ethernet_SetConnectInterruptForAllSockets()
-{
-    uint8_t reg = 0xFF;
-    uint8_t act = 1;      // <= what action it reacts to. 1 = CON
-    uint8_t i;
-
-    // Enable Interrupt in SIMR register for all sockets(page  37)
-    W5500_writeSIMR(reg);
-
-    // Enable Interrupt in Sn_IMR register (page 56)
-    for ( i = 0; i < 8; i++ )
-    {
-        W5500_writeSnIMR(i, act);
-    }
-}
-
-void Ethernet_ClearConnectInterruptForAllSockets()
-{
-    uint8_t i, tmp;
-    for ( i = 0; i < 8; i++ )
-    {
-        while(W5500_readSnIR(i))
-            W5500_writeSnIR(i, 0);
-    }
-
-    while(W5500_readSIR())
-        W5500_writeSIR(0);
-}
@@ -43,14 +43,15 @@ extern "C" {
 	void Ethernet_begin_mac_ip_dns_gateway_subnet(uint8_t *mac_address, IPAddress local_ip, IPAddress dns_server, IPAddress gateway, IPAddress subnet);
 
 
+	// Take over W5500 left configured by a soft restart (see warm_start.c)
+	void Ethernet_resume(IPAddress dns_server, const DHCP *lease);
+
 	int Ethernet_maintain();
 
 	IPAddress Ethernet_localIP();
 	IPAddress Ethernet_subnetMask();
 	IPAddress Ethernet_gatewayIP();
 	IPAddress Ethernet_dnsServerIP();
-	void Ethernet_SetConnectInterruptForAllSockets();
-	void Ethernet_ClearConnectInterruptForAllSockets();
 
 #ifdef __cplusplus
 }
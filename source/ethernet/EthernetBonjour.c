@@ -156,7 +156,7 @@ int EthernetBonjour_begin(const char* bonjourName)
 	IPAddress ip = {{ mdnsMulticastIPAddr[0],mdnsMulticastIPAddr[1],mdnsMulticastIPAddr[2],mdnsMulticastIPAddr[3]}};
 
 	Serial_print("Name:");
-	Serial_println(EthernetBonjour._bonjourName);
+	Serial_println((const char*)EthernetBonjour._bonjourName);
 
 	if (statusCode)
 		statusCode = EthernetUDP_beginMulticast(&EthernetBonjour.udp, &ip, MDNS_SERVER_PORT);
@@ -518,7 +518,7 @@ MDNSError_t EthernetBonjour_processMDNSQuery()
 #endif
 	uint16_t i, j;
 	uint8_t* buf;
-	uint32_t xid;
+	uint32_t xid = 0;
 	uint16_t udp_len, qCnt, aCnt, aaCnt, addCnt;
 	uint8_t recordsAskedFor[NumMDNSServiceRecords + 2];
 	uint8_t recordsFound[2];
@@ -15,6 +15,7 @@
 #include "EthernetClient.h"
 #include "EthernetServer.h"
 #include "Dns.h"
+#include <source/utils/spi_profile.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,7 +40,9 @@ extern "C" {
 		IPAddress remote_addr;
 
 		DNSClient_begin(&dns, Ethernet_dnsServerIP());
+		SPI_PROFILE_ENTER(SPI_PROFILE_DHCP_DNS);
 		ret = DNSClient_getHostByName(&dns, host, &remote_addr);
+		SPI_PROFILE_LEAVE();
 		if (ret == 1) {
 			return EthernetClient_connect_ip(eth, remote_addr, port);
 		}
@@ -0,0 +1,268 @@
+/*
+ * EthernetIrq.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <stddef.h>
+
+#include <stdbool.h>
+
+#include <source/ethernet/EthernetIrq.h>
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === EthernetIrq_Owner_t
+ * Who gets the events of a socket: handler is called,
+ * or eventId is posted to event when handler is NULL.
+ */
+typedef struct EthernetIrq_Owner
+{
+    uint8_t               mask;
+    EthernetIrq_Handler_t handler;
+    Event_Handle          event;
+    UInt                  eventId;
+} EthernetIrq_Owner_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static EthernetIrq_Owner_t owners[MAX_SOCK_NUM];
+
+//
+// Copy of SIMR, one bit per socket with an owner
+//
+static uint8_t             socketMask = 0;
+
+//
+// INT line fell since the last EthernetIrq_Service()
+//
+static volatile bool       bSignalled = false;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === setMask
+ * Writes Sn_IMR of the socket and its bit in SIMR. Events which
+ * are already pending in Sn_IR and newly enabled pull INT low
+ * right away, so nothing that came before the registration is lost.
+ */
+static void setMask(uint8_t sock, uint8_t mask)
+{
+    owners[sock].mask = mask;
+
+    if ( mask != 0 )
+    {
+        socketMask |= (uint8_t)( 1 << sock );
+    }
+    else
+    {
+        socketMask &= (uint8_t)~( 1 << sock );
+    }
+
+    W5500_writeSnIMR(sock, mask);
+    W5500_writeSIMR(socketMask);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === EthernetIrq_Init
+ * Masks interrupts of all sockets, owners enable
+ * only the events they need by registering.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void EthernetIrq_Init(void)
+{
+    uint8_t sock;
+
+    for ( sock = 0; sock < MAX_SOCK_NUM; sock++ )
+    {
+        owners[sock].handler = NULL;
+        owners[sock].event   = NULL;
+
+        setMask(sock, 0);
+    }
+
+    return;
+}
+
+
+/*
+ * === EthernetIrq_Register
+ * Makes handler the owner of socket's events in mask (ETHIRQ_*).
+ * Previous owner of the socket is replaced.
+ *
+ * SEND_OK is consumed by send()/sendUDP() themselves while waiting
+ * for the transmission, ask for it only on sockets which do not wait.
+ *
+ * Parameters:
+ *      sock[in]        - socket number
+ *      mask[in]        - events to enable
+ *      handler[in]     - called from EthernetIrq_Service()
+ * Returns:
+ *      N/A
+ */
+void EthernetIrq_Register(uint8_t sock, uint8_t mask, EthernetIrq_Handler_t handler)
+{
+    if ( sock >= MAX_SOCK_NUM )
+    {
+        return;
+    }
+
+    owners[sock].handler = handler;
+    owners[sock].event   = NULL;
+
+    setMask(sock, mask);
+
+    return;
+}
+
+
+/*
+ * === EthernetIrq_RegisterEvent
+ * Same as EthernetIrq_Register, but eventId is posted to event,
+ * so the events wake up a task which pends on it.
+ */
+void EthernetIrq_RegisterEvent(uint8_t sock, uint8_t mask, Event_Handle event, UInt eventId)
+{
+    if ( sock >= MAX_SOCK_NUM )
+    {
+        return;
+    }
+
+    owners[sock].handler = NULL;
+    owners[sock].event   = event;
+    owners[sock].eventId = eventId;
+
+    setMask(sock, mask);
+
+    return;
+}
+
+
+void EthernetIrq_Unregister(uint8_t sock)
+{
+    if ( sock >= MAX_SOCK_NUM )
+    {
+        return;
+    }
+
+    owners[sock].handler = NULL;
+    owners[sock].event   = NULL;
+
+    setMask(sock, 0);
+
+    return;
+}
+
+
+uint8_t EthernetIrq_GetMask(uint8_t sock)
+{
+    return ( sock < MAX_SOCK_NUM ) ? owners[sock].mask : 0;
+}
+
+
+/*
+ * === EthernetIrq_Signal
+ * Top half, called from the INT line callback (hwi). Only marks
+ * the interrupt, SPI must not be touched here as a task may be
+ * in the middle of a transaction.
+ */
+void EthernetIrq_Signal(void)
+{
+    bSignalled = true;
+
+    return;
+}
+
+
+/*
+ * === EthernetIrq_Service
+ * Bottom half of the W5500 INT line, has to run in task context.
+ * Returns right away unless EthernetIrq_Signal() was called, so
+ * tasks may call it in their loops without touching SPI when idle.
+ * SIR tells which sockets have pending events, only those Sn_IR are
+ * read. Events of the owner are cleared (write 1 to clear) and
+ * dispatched, other bits are left for whoever polls them.
+ * SIR is read again until no owned event is pending, as INT
+ * does not give another edge while it is held low.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void EthernetIrq_Service(void)
+{
+    uint8_t pending;
+    uint8_t handled;
+    uint8_t events;
+    uint8_t sock;
+
+    if ( !bSignalled )
+    {
+        return;
+    }
+
+    bSignalled = false;
+
+    do
+    {
+        pending = W5500_readSIR() & socketMask;
+        handled = 0;
+
+        for ( sock = 0; pending != 0; sock++, pending >>= 1 )
+        {
+            if ( ( pending & 1 ) == 0 )
+            {
+                continue;
+            }
+
+            events = W5500_readSnIR(sock) & owners[sock].mask;
+
+            if ( events == 0 )
+            {
+                continue;
+            }
+
+            W5500_writeSnIR(sock, events);
+
+            handled |= (uint8_t)( 1 << sock );
+
+            if ( owners[sock].handler != NULL )
+            {
+                owners[sock].handler(sock, events);
+            }
+            else if ( owners[sock].event != NULL )
+            {
+                Event_post(owners[sock].event, owners[sock].eventId);
+            }
+        }
+    } while ( handled != 0 );
+
+    return;
+}
+
+// ==============================================================================================================
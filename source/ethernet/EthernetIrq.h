@@ -0,0 +1,66 @@
+/*
+ * EthernetIrq.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_ETHERNET_ETHERNETIRQ_H_
+#define SOURCE_ETHERNET_ETHERNETIRQ_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <ti/sysbios/knl/Event.h>
+
+#include <source/driverlib/w5500/w5500.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Events of one socket, same bits as in Sn_IR / Sn_IMR
+//
+#define ETHIRQ_SEND_OK          (SnIR_SEND_OK)
+#define ETHIRQ_TIMEOUT          (SnIR_TIMEOUT)
+#define ETHIRQ_RECV             (SnIR_RECV)
+#define ETHIRQ_DISCON           (SnIR_DISCON)
+#define ETHIRQ_CON              (SnIR_CON)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === EthernetIrq_Handler_t
+ * Called from EthernetIrq_Service() (task context, SPI may be used)
+ * with the socket number and its events, already cleared in Sn_IR.
+ */
+typedef void (*EthernetIrq_Handler_t)(uint8_t sock, uint8_t events);
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void    EthernetIrq_Init(void);
+
+void    EthernetIrq_Register(uint8_t sock, uint8_t mask, EthernetIrq_Handler_t handler);
+
+void    EthernetIrq_RegisterEvent(uint8_t sock, uint8_t mask, Event_Handle event, UInt eventId);
+
+void    EthernetIrq_Unregister(uint8_t sock);
+
+uint8_t EthernetIrq_GetMask(uint8_t sock);
+
+void    EthernetIrq_Signal(void);
+
+void    EthernetIrq_Service(void);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_ETHERNET_ETHERNETIRQ_H_ */
@@ -30,6 +30,7 @@
 #include "socket.h"
 #include "Ethernet.h"
 #include "Dns.h"
+#include <source/utils/spi_profile.h>
 
 void EthernetUDP_begin_init(EthernetUDP* eth) {
 	eth->_sock = MAX_SOCK_NUM;
@@ -84,7 +85,9 @@ int EthernetUDP_beginPacket_host(EthernetUDP* eth, const char *host, uint16_t po
   IPAddress remote_addr;
 
   DNSClient_begin(&dns,Ethernet_dnsServerIP());
+  SPI_PROFILE_ENTER(SPI_PROFILE_DHCP_DNS);
   ret = DNSClient_getHostByName(&dns, host, &remote_addr);
+  SPI_PROFILE_LEAVE();
   if (ret == 1) {
     return EthernetUDP_beginPacket_ip(eth,remote_addr, port);
   } else {
@@ -105,7 +108,9 @@ int EthernetUDP_endPacket(EthernetUDP* eth)
 
 size_t EthernetUDP_write(void* eth, const uint8_t *buffer, size_t size)
 {
-  uint16_t bytes_written = bufferData(((EthernetUDP*)eth)->_sock, ((EthernetUDP*)eth)->_offset, buffer, size);
+  // Sn_TX_WR is moved past the data by every bufferData(), so the next
+  // chunk goes right there: passing _offset left holes in the datagram
+  uint16_t bytes_written = bufferData(((EthernetUDP*)eth)->_sock, 0, buffer, size);
   ((EthernetUDP*)eth)->_offset += bytes_written;
   return bytes_written;
 }
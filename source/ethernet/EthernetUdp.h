@@ -39,6 +39,7 @@
 
 #include "Printfg.h"
 #include "IPAddress.h"
+#include <source/driverlib/w5500/w5500.h>
 
 #ifdef __cplusplus
 extern "C" {
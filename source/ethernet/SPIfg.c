@@ -4,6 +4,7 @@
 #include <ti/drivers/GPIO.h>
 #include "ti_drivers_config.h"
 #include <ti/drivers/Board.h>
+#include <source/utils/spi_profile.h>
 
  SPI_Handle  spi;
 
@@ -16,6 +17,7 @@
         trans.count = sizeof(tx);
         trans.rxBuf = &rx;
         bool tsOK = SPI_transfer(spi, &trans);
+        SPI_PROFILE_XFER(trans.count);
 
         if(tsOK)
         {
@@ -66,10 +68,12 @@
     inline void setSS()
     {
         GPIO_write(CONFIG_GPIO_W5500_CS, 0);
+        SPI_PROFILE_CS_LOW();
     }
 
 
     inline void resetSS()
     {
+        SPI_PROFILE_CS_HIGH();
         GPIO_write(CONFIG_GPIO_W5500_CS, 1);
     }
@@ -28,10 +28,10 @@ void Serial_begin(void){
 
 
 
-void Serial_print(char* txt){
+void Serial_print(const char* txt){
     UART2_write(uart, txt, strlen(txt), NULL);
 }
-void Serial_println(char* txt){
+void Serial_println(const char* txt){
     Serial_print(txt);
     Serial_print("\n\r");
 }
@@ -9,8 +9,8 @@ extern "C" {
 
 void Serial_begin();
 
-void Serial_print(char* txt);
-void Serial_println(char* txt);
+void Serial_print(const char* txt);
+void Serial_println(const char* txt);
 void Serial_write(char c);
 
 #ifdef __cplusplus
@@ -0,0 +1,413 @@
+/*
+ * ble_parser.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <source/frame_parser/ble_parser.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define BLE_HEADER_LEN           (2)    // PDU header + length byte (bIncludeLenByte = 1)
+
+#define BLE_CRC_LEN              (3)    // bIncludeCrc = 1
+
+#define BLE_ADDR_LEN             (6)
+
+#define HDR_PDU_TYPE(h)          ((h) & 0xF)
+
+#define HDR_TX_ADD(h)            (((h) >> 6) & 0x1)
+
+//
+// Extended header flags of Common Extended Advertising Payload
+//
+#define EXT_HDR_LEN(b)           ((b) & 0x3F)
+
+#define EXT_FLAG_ADV_A           (0x01)
+
+#define EXT_FLAG_TARGET_A        (0x02)
+
+#define EXT_FLAG_CTE_INFO        (0x04)
+
+#define EXT_FLAG_ADI             (0x08)
+
+#define EXT_FLAG_AUX_PTR         (0x10)
+
+#define EXT_FLAG_SYNC_INFO       (0x20)
+
+#define EXT_FLAG_TX_POWER        (0x40)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+/*
+ * === recordRing
+ * Ring of decoded records. Written by the sniffing task, read either by
+ * the sniffing task itself (records-only UDP mode) or left to be
+ * overwritten when nobody consumes it. The oldest record is dropped
+ * when the ring is full.
+ */
+static BleParser_Record_t recordRing[BLE_REC_RING_SIZE];
+
+static uint8_t            ringHead;
+
+static uint8_t            ringTail;
+
+static uint8_t            ringPending;
+
+static BleParser_Record_t lastRecord;
+
+static uint32_t           recordCount;
+
+static uint32_t           overwrittenCount;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static inline uint16_t get16bitValue(const uint8_t* buffer)
+{
+    return (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+}
+
+/*
+ * === parseAdStructures
+ * Walks AD structures ([len][type][data]) of advertising data and fills
+ * in fields of the record. Only the first occurrence of UUID and
+ * manufacturer data is kept. Walking stops at the first malformed
+ * structure or at zero padding.
+ */
+static void parseAdStructures(const uint8_t* p, const uint8_t* pEnd, BleParser_Record_t* pRecord)
+{
+    uint8_t adLen, adType, dataLen, copyLen;
+    const uint8_t* pData;
+
+    while ( p + 2 <= pEnd )
+    {
+        adLen = p[0];
+
+        if ( adLen == 0 || p + 1 + adLen > pEnd )
+        {
+            return;
+        }
+
+        adType  = p[1];
+        pData   = p + 2;
+        dataLen = adLen - 1;
+
+        switch (adType)
+        {
+        case BLE_AD_FLAGS:
+            if ( dataLen >= 1 )
+            {
+                pRecord->adFlags  = pData[0];
+                pRecord->present |= BLE_REC_FLAGS;
+            }
+            break;
+
+        case BLE_AD_UUID16_INCOMPLETE:
+        case BLE_AD_UUID16_COMPLETE:
+            if ( dataLen >= 2 && !(pRecord->present & BLE_REC_UUID16) )
+            {
+                pRecord->uuid16   = get16bitValue(pData);
+                pRecord->present |= BLE_REC_UUID16;
+            }
+            break;
+
+        case BLE_AD_UUID128_INCOMPLETE:
+        case BLE_AD_UUID128_COMPLETE:
+            pRecord->present |= BLE_REC_UUID128;
+            break;
+
+        case BLE_AD_NAME_COMPLETE:
+            pRecord->present |= BLE_REC_NAME_COMPLETE;
+            // no break
+
+        case BLE_AD_NAME_SHORT:
+            copyLen = dataLen > BLE_REC_NAME_MAXLEN ? BLE_REC_NAME_MAXLEN : dataLen;
+            memcpy(pRecord->name, pData, copyLen);
+            pRecord->nameLen  = copyLen;
+            pRecord->present |= BLE_REC_NAME;
+            break;
+
+        case BLE_AD_TX_POWER:
+            if ( dataLen >= 1 )
+            {
+                pRecord->txPower  = (int8_t)pData[0];
+                pRecord->present |= BLE_REC_TX_POWER;
+            }
+            break;
+
+        case BLE_AD_MANUFACTURER:
+            if ( dataLen >= 2 && !(pRecord->present & BLE_REC_MANUFACTURER) )
+            {
+                pRecord->companyId = get16bitValue(pData);
+                pRecord->present  |= BLE_REC_MANUFACTURER;
+            }
+            break;
+
+        default:
+            break;
+        }
+
+        p += 1 + adLen;
+    }
+
+    return;
+}
+
+/*
+ * === parseExtendedHeader
+ * Parses Common Extended Advertising Payload of ADV_EXT_IND. Only AdvA
+ * and TxPower are kept, the rest of extended header is skipped.
+ *
+ * Returns:
+ *      pointer to AdvData or NULL when extended header is malformed
+ */
+static const uint8_t* parseExtendedHeader(const uint8_t* p, const uint8_t* pEnd, BleParser_Record_t* pRecord)
+{
+    const uint8_t* pHdrEnd;
+    uint8_t flags;
+
+    if ( p + 1 > pEnd )
+    {
+        return NULL;
+    }
+
+    pHdrEnd = p + 1 + EXT_HDR_LEN(p[0]);
+
+    if ( pHdrEnd > pEnd )
+    {
+        return NULL;
+    }
+
+    if ( EXT_HDR_LEN(p[0]) == 0 )
+    {
+        return pHdrEnd;
+    }
+
+    flags = p[1];
+    p += 2;
+
+    if ( flags & EXT_FLAG_ADV_A )
+    {
+        if ( p + BLE_ADDR_LEN > pHdrEnd )
+        {
+            return NULL;
+        }
+
+        memcpy(pRecord->advA, p, BLE_ADDR_LEN);
+        pRecord->present |= BLE_REC_ADV_A;
+        p += BLE_ADDR_LEN;
+    }
+
+    p += (flags & EXT_FLAG_TARGET_A)  ? BLE_ADDR_LEN : 0;
+    p += (flags & EXT_FLAG_CTE_INFO)  ? 1  : 0;
+    p += (flags & EXT_FLAG_ADI)       ? 2  : 0;
+    p += (flags & EXT_FLAG_AUX_PTR)   ? 3  : 0;
+    p += (flags & EXT_FLAG_SYNC_INFO) ? 18 : 0;
+
+    if ( flags & EXT_FLAG_TX_POWER )
+    {
+        if ( p + 1 > pHdrEnd )
+        {
+            return NULL;
+        }
+
+        pRecord->txPower  = (int8_t)*p;
+        pRecord->present |= BLE_REC_TX_POWER;
+    }
+
+    return pHdrEnd;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === BleParser_Parse
+ * Decodes BLE advertising channel PDU as it is stored in the radio queue
+ * (header, length byte, payload, CRC) into a compact record. advA holds
+ * address of the transmitting device, i.e. ScanA for SCAN_REQ and InitA
+ * for CONNECT_IND.
+ *
+ * Parameters:
+ *      pPdu[in]        - pointer to the PDU
+ *      len[in]         - length of the PDU including CRC
+ *      rssi[in]        - RSSI of the frame
+ *      channel[in]     - channel the frame was received on
+ *      pRecord[out]    - decoded record
+ * Returns:
+ *      bool            - true when the PDU was decoded
+ */
+bool BleParser_Parse(const uint8_t* pPdu, uint16_t len, int8_t rssi, uint8_t channel, BleParser_Record_t* pRecord)
+{
+    const uint8_t* p;
+    const uint8_t* pEnd;
+
+    memset(pRecord, 0, sizeof(BleParser_Record_t));
+
+    if ( len < BLE_HEADER_LEN + BLE_CRC_LEN || BLE_HEADER_LEN + pPdu[1] + BLE_CRC_LEN > len )
+    {
+        return false;
+    }
+
+    pRecord->pduType  = HDR_PDU_TYPE(pPdu[0]);
+    pRecord->addrType = HDR_TX_ADD(pPdu[0]);
+    pRecord->rssi     = rssi;
+    pRecord->channel  = channel;
+
+    p    = pPdu + BLE_HEADER_LEN;
+    pEnd = p + pPdu[1];
+
+    if ( pRecord->pduType == BLE_PDU_ADV_EXT_IND )
+    {
+        p = parseExtendedHeader(p, pEnd, pRecord);
+
+        if ( p == NULL )
+        {
+            return false;
+        }
+
+        parseAdStructures(p, pEnd, pRecord);
+
+        return true;
+    }
+
+    if ( p + BLE_ADDR_LEN > pEnd )
+    {
+        return false;
+    }
+
+    memcpy(pRecord->advA, p, BLE_ADDR_LEN);
+    pRecord->present |= BLE_REC_ADV_A;
+    p += BLE_ADDR_LEN;
+
+    switch (pRecord->pduType)
+    {
+    case BLE_PDU_ADV_IND:
+    case BLE_PDU_ADV_NONCONN_IND:
+    case BLE_PDU_ADV_SCAN_IND:
+    case BLE_PDU_SCAN_RSP:
+        parseAdStructures(p, pEnd, pRecord);
+        break;
+
+    default:
+        break;
+    }
+
+    return true;
+}
+
+
+/*
+ * === BleParser_PushRecord
+ * Stores record into the ring, overwriting the oldest one
+ * when the ring is full.
+ *
+ * Parameters:
+ *      pRecord[in]     - record to be stored
+ * Returns:
+ *      N/A
+ */
+void BleParser_PushRecord(const BleParser_Record_t* pRecord)
+{
+    recordRing[ringHead] = *pRecord;
+
+    ringHead = (ringHead + 1) % BLE_REC_RING_SIZE;
+
+    if ( ringPending == BLE_REC_RING_SIZE )
+    {
+        ringTail = ringHead;
+        overwrittenCount++;
+    }
+    else
+    {
+        ringPending++;
+    }
+
+    lastRecord = *pRecord;
+
+    recordCount++;
+
+    return;
+}
+
+
+/*
+ * === BleParser_PopRecords
+ * Moves up to `maxRecords` oldest records from the ring
+ * to the caller's buffer.
+ *
+ * Parameters:
+ *      pRecords[out]   - buffer for records
+ *      maxRecords[in]  - capacity of the buffer
+ * Returns:
+ *      uint8_t         - number of records copied
+ */
+uint8_t BleParser_PopRecords(BleParser_Record_t* pRecords, uint8_t maxRecords)
+{
+    uint8_t n = 0;
+
+    while ( ringPending && n < maxRecords )
+    {
+        pRecords[n++] = recordRing[ringTail];
+
+        ringTail = (ringTail + 1) % BLE_REC_RING_SIZE;
+
+        ringPending--;
+    }
+
+    return n;
+}
+
+
+uint8_t BleParser_GetPendingRecords(void)
+{
+    return ringPending;
+}
+
+
+/*
+ * === BleParser_GetLastRecord
+ * Copies the most recently decoded record (regardless of whether it was
+ * already popped from the ring).
+ *
+ * Parameters:
+ *      pRecord[out]    - copy of the last record
+ * Returns:
+ *      bool            - false when no record was decoded yet
+ */
+bool BleParser_GetLastRecord(BleParser_Record_t* pRecord)
+{
+    *pRecord = lastRecord;
+
+    return ( recordCount != 0 );
+}
+
+
+uint32_t BleParser_GetRecordCount(void)
+{
+    return recordCount;
+}
+
+
+uint32_t BleParser_GetOverwrittenCount(void)
+{
+    return overwrittenCount;
+}
+
+// ==============================================================================================================
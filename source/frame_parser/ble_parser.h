@@ -0,0 +1,138 @@
+/*
+ * ble_parser.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_FRAME_PARSER_BLE_PARSER_H_
+#define SOURCE_FRAME_PARSER_BLE_PARSER_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Advertising physical channel PDU types (header bits 0..3)
+//
+#define BLE_PDU_ADV_IND           (0x0)
+
+#define BLE_PDU_ADV_DIRECT_IND    (0x1)
+
+#define BLE_PDU_ADV_NONCONN_IND   (0x2)
+
+#define BLE_PDU_SCAN_REQ          (0x3)
+
+#define BLE_PDU_SCAN_RSP          (0x4)
+
+#define BLE_PDU_CONNECT_IND       (0x5)
+
+#define BLE_PDU_ADV_SCAN_IND      (0x6)
+
+#define BLE_PDU_ADV_EXT_IND       (0x7)
+
+//
+// AD types decoded into the record
+//
+#define BLE_AD_FLAGS              (0x01)
+
+#define BLE_AD_UUID16_INCOMPLETE  (0x02)
+
+#define BLE_AD_UUID16_COMPLETE    (0x03)
+
+#define BLE_AD_UUID128_INCOMPLETE (0x06)
+
+#define BLE_AD_UUID128_COMPLETE   (0x07)
+
+#define BLE_AD_NAME_SHORT         (0x08)
+
+#define BLE_AD_NAME_COMPLETE      (0x09)
+
+#define BLE_AD_TX_POWER           (0x0A)
+
+#define BLE_AD_MANUFACTURER       (0xFF)
+
+//
+// Bits of BleParser_Record_t.present
+//
+#define BLE_REC_ADV_A             (0x01)
+
+#define BLE_REC_FLAGS             (0x02)
+
+#define BLE_REC_NAME              (0x04)
+
+#define BLE_REC_TX_POWER          (0x08)
+
+#define BLE_REC_MANUFACTURER      (0x10)
+
+#define BLE_REC_UUID16            (0x20)
+
+#define BLE_REC_UUID128           (0x40)
+
+#define BLE_REC_NAME_COMPLETE     (0x80)
+
+#define BLE_REC_NAME_MAXLEN       (14)
+
+//
+// Number of records the ring can hold
+//
+#define BLE_REC_RING_SIZE         (32)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === BleParser_Record_t
+ * Compact record of one advertising PDU. Layout is naturally aligned
+ * (no padding, 32 bytes) so that records can be forwarded to the host
+ * as-is in little-endian byte order. AdvA is kept in over-the-air
+ * (little-endian) byte order. Fields not flagged in `present` are zero.
+ *
+ */
+typedef struct BleParser_Record
+{
+    uint8_t  pduType;
+    uint8_t  addrType;
+    uint8_t  advA[6];
+    int8_t   rssi;
+    uint8_t  adFlags;
+    int8_t   txPower;
+    uint8_t  nameLen;
+    uint16_t companyId;
+    uint16_t uuid16;
+    uint8_t  channel;
+    uint8_t  present;
+    char     name[BLE_REC_NAME_MAXLEN];
+} BleParser_Record_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+bool     BleParser_Parse(const uint8_t* pPdu, uint16_t len, int8_t rssi, uint8_t channel, BleParser_Record_t* pRecord);
+
+void     BleParser_PushRecord(const BleParser_Record_t* pRecord);
+
+uint8_t  BleParser_PopRecords(BleParser_Record_t* pRecords, uint8_t maxRecords);
+
+uint8_t  BleParser_GetPendingRecords(void);
+
+bool     BleParser_GetLastRecord(BleParser_Record_t* pRecord);
+
+uint32_t BleParser_GetRecordCount(void);
+
+uint32_t BleParser_GetOverwrittenCount(void);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_FRAME_PARSER_BLE_PARSER_H_ */
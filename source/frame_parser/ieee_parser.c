@@ -0,0 +1,279 @@
+/*
+ * ieee_parser.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <source/frame_parser/ieee_parser.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define FC_FRAME_TYPE(fc)       ((fc) & 0x7)
+
+#define FC_SECURITY(fc)         (((fc) >> 3) & 0x1)
+
+#define FC_FRAME_PENDING(fc)    (((fc) >> 4) & 0x1)
+
+#define FC_ACK_REQUEST(fc)      (((fc) >> 5) & 0x1)
+
+#define FC_PAN_ID_COMP(fc)      (((fc) >> 6) & 0x1)
+
+#define FC_SEQ_SUPPRESS(fc)     (((fc) >> 8) & 0x1)
+
+#define FC_IE_PRESENT(fc)       (((fc) >> 9) & 0x1)
+
+#define FC_DST_ADDR_MODE(fc)    (((fc) >> 10) & 0x3)
+
+#define FC_FRAME_VERSION(fc)    (((fc) >> 12) & 0x3)
+
+#define FC_SRC_ADDR_MODE(fc)    (((fc) >> 14) & 0x3)
+
+#define FRAME_VERSION_2015      (0x2)
+
+#define SEC_LEVEL(sc)           ((sc) & 0x7)
+
+#define SEC_KEY_ID_MODE(sc)     (((sc) >> 3) & 0x3)
+
+#define SEC_FC_SUPPRESS(sc)     (((sc) >> 5) & 0x1)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+/*
+ * === addrLenByMode
+ * Length of address field in bytes indexed by addressing mode.
+ * Mode 1 is reserved, it is caught before lookup.
+ */
+static const uint8_t addrLenByMode[4] = { 0, 0, 2, 8 };
+
+/*
+ * === keyIdLenByMode
+ * Length of Key Identifier field of Auxiliary Security Header
+ * indexed by Key Identifier Mode.
+ */
+static const uint8_t keyIdLenByMode[4] = { 0, 1, 5, 9 };
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static inline uint16_t get16bitValue(const uint8_t* buffer)
+{
+    return (uint16_t)buffer[0] | ((uint16_t)buffer[1] << 8);
+}
+
+/*
+ * === resolvePanIds
+ * Decides which of PAN ID fields are present in MHR. Frame versions 0 and 1
+ * (2003, 2006) use the simple rule, 2015 frames use Table 7-2 of
+ * IEEE 802.15.4-2015 which also depends on combination of addressing modes.
+ */
+static void resolvePanIds(uint16_t fc, bool* pDstPan, bool* pSrcPan)
+{
+    uint8_t dstMode = FC_DST_ADDR_MODE(fc);
+    uint8_t srcMode = FC_SRC_ADDR_MODE(fc);
+    bool    comp    = FC_PAN_ID_COMP(fc);
+
+    if ( FC_FRAME_VERSION(fc) < FRAME_VERSION_2015 )
+    {
+        *pDstPan = ( dstMode != IEEE_ADDR_MODE_NONE );
+        *pSrcPan = ( srcMode != IEEE_ADDR_MODE_NONE ) && !comp;
+        return;
+    }
+
+    *pSrcPan = false;
+
+    if ( dstMode == IEEE_ADDR_MODE_NONE && srcMode == IEEE_ADDR_MODE_NONE )
+    {
+        *pDstPan = comp;
+    }
+    else if ( srcMode == IEEE_ADDR_MODE_NONE )
+    {
+        *pDstPan = !comp;
+    }
+    else if ( dstMode == IEEE_ADDR_MODE_NONE )
+    {
+        *pDstPan = false;
+        *pSrcPan = !comp;
+    }
+    else if ( dstMode == IEEE_ADDR_MODE_EXTENDED && srcMode == IEEE_ADDR_MODE_EXTENDED )
+    {
+        *pDstPan = !comp;
+    }
+    else
+    {
+        *pDstPan = true;
+        *pSrcPan = !comp;
+    }
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === IeeeParser_Parse
+ * Decodes MAC header (MHR) of an IEEE 802.15.4 MPDU as it is stored in the
+ * radio queue (no PHY header, FCS included). Works in place over the
+ * caller's buffer, nothing is allocated or copied apart from the addresses.
+ * Header IEs (2015 frames) are not walked, they are left as part of the
+ * payload and only signaled by IEEE_FLAG_IE_PRESENT.
+ *
+ * Parameters:
+ *      pMpdu[in]       - pointer to the MPDU
+ *      len[in]         - length of the MPDU including FCS
+ *      pSummary[out]   - decoded header
+ * Returns:
+ *      bool            - true when header is well-formed, false when it is
+ *                        truncated, uses reserved addressing mode or it is
+ *                        a multipurpose/fragment/extended frame. frameType
+ *                        and flags are filled in even then.
+ */
+bool IeeeParser_Parse(const uint8_t* pMpdu, uint16_t len, IeeeParser_Summary_t* pSummary)
+{
+    const uint8_t* p = pMpdu;
+    const uint8_t* pEnd;
+    uint16_t fc;
+    uint8_t  secCtrl;
+    bool     hasDstPan, hasSrcPan;
+
+    memset(pSummary, 0, sizeof(IeeeParser_Summary_t));
+
+    if ( len < 2 + IEEE_FCS_LEN )
+    {
+        return false;
+    }
+
+    pEnd = pMpdu + len - IEEE_FCS_LEN;
+
+    fc = get16bitValue(p);
+    p += 2;
+
+    pSummary->frameType    = FC_FRAME_TYPE(fc);
+    pSummary->frameVersion = FC_FRAME_VERSION(fc);
+    pSummary->dstAddrMode  = FC_DST_ADDR_MODE(fc);
+    pSummary->srcAddrMode  = FC_SRC_ADDR_MODE(fc);
+    pSummary->flags        = (FC_SECURITY(fc)      ? IEEE_FLAG_SECURITY           : 0)
+                           | (FC_FRAME_PENDING(fc) ? IEEE_FLAG_FRAME_PENDING      : 0)
+                           | (FC_ACK_REQUEST(fc)   ? IEEE_FLAG_ACK_REQUEST        : 0)
+                           | (FC_PAN_ID_COMP(fc)   ? IEEE_FLAG_PAN_ID_COMPRESSION : 0);
+
+    //
+    // Reserved, multipurpose, fragment and extended frames use different
+    // Frame Control layout, nothing more can be told about them.
+    //
+    if ( pSummary->frameType > IEEE_FRAME_TYPE_MAC_CMD )
+    {
+        return false;
+    }
+
+    if ( pSummary->frameVersion == FRAME_VERSION_2015 )
+    {
+        pSummary->flags |= (FC_SEQ_SUPPRESS(fc) ? IEEE_FLAG_SEQ_SUPPRESSED : 0)
+                        |  (FC_IE_PRESENT(fc)   ? IEEE_FLAG_IE_PRESENT     : 0);
+    }
+
+    if ( pSummary->dstAddrMode == 0x1 || pSummary->srcAddrMode == 0x1 )
+    {
+        return false;
+    }
+
+    ///////////////////////////
+    // Sequence number
+    //
+    if ( !(pSummary->flags & IEEE_FLAG_SEQ_SUPPRESSED) )
+    {
+        if ( p + 1 > pEnd )
+        {
+            return false;
+        }
+
+        pSummary->seqNum = *p++;
+    }
+
+    ///////////////////////////
+    // Addressing fields
+    //
+    resolvePanIds(fc, &hasDstPan, &hasSrcPan);
+
+    if ( p + (hasDstPan ? 2 : 0) + addrLenByMode[pSummary->dstAddrMode]
+           + (hasSrcPan ? 2 : 0) + addrLenByMode[pSummary->srcAddrMode] > pEnd )
+    {
+        return false;
+    }
+
+    if ( hasDstPan )
+    {
+        pSummary->dstPanId = get16bitValue(p);
+        p += 2;
+    }
+
+    memcpy(pSummary->dstAddr, p, addrLenByMode[pSummary->dstAddrMode]);
+    p += addrLenByMode[pSummary->dstAddrMode];
+
+    if ( hasSrcPan )
+    {
+        pSummary->srcPanId = get16bitValue(p);
+        p += 2;
+    }
+    else if ( pSummary->srcAddrMode != IEEE_ADDR_MODE_NONE )
+    {
+        //
+        // Source PAN ID elided, it equals destination PAN ID
+        //
+        pSummary->srcPanId = pSummary->dstPanId;
+    }
+
+    memcpy(pSummary->srcAddr, p, addrLenByMode[pSummary->srcAddrMode]);
+    p += addrLenByMode[pSummary->srcAddrMode];
+
+    ///////////////////////////
+    // Auxiliary Security Header
+    // (not present in 2003 frames)
+    //
+    if ( (pSummary->flags & IEEE_FLAG_SECURITY) && pSummary->frameVersion != 0 )
+    {
+        if ( p + 1 > pEnd )
+        {
+            return false;
+        }
+
+        secCtrl = *p++;
+
+        pSummary->securityLevel = SEC_LEVEL(secCtrl);
+        pSummary->keyIdMode     = SEC_KEY_ID_MODE(secCtrl);
+
+        if ( !(pSummary->frameVersion == FRAME_VERSION_2015 && SEC_FC_SUPPRESS(secCtrl)) )
+        {
+            p += 4;
+        }
+
+        p += keyIdLenByMode[pSummary->keyIdMode];
+
+        if ( p > pEnd )
+        {
+            return false;
+        }
+    }
+
+    pSummary->headerLen  = (uint16_t)(p - pMpdu);
+    pSummary->payloadLen = (uint16_t)(pEnd - p);
+
+    return true;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,108 @@
+/*
+ * ieee_parser.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_FRAME_PARSER_IEEE_PARSER_H_
+#define SOURCE_FRAME_PARSER_IEEE_PARSER_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Frame types (Frame Control bits 0..2)
+//
+#define IEEE_FRAME_TYPE_BEACON        (0x0)
+
+#define IEEE_FRAME_TYPE_DATA          (0x1)
+
+#define IEEE_FRAME_TYPE_ACK           (0x2)
+
+#define IEEE_FRAME_TYPE_MAC_CMD       (0x3)
+
+#define IEEE_FRAME_TYPE_MULTIPURPOSE  (0x5)
+
+//
+// Addressing modes (Frame Control bits 10..11 and 14..15)
+//
+#define IEEE_ADDR_MODE_NONE           (0x0)
+
+#define IEEE_ADDR_MODE_SHORT          (0x2)
+
+#define IEEE_ADDR_MODE_EXTENDED       (0x3)
+
+//
+// Bits of IeeeParser_Summary_t.flags
+//
+#define IEEE_FLAG_SECURITY            (0x01)
+
+#define IEEE_FLAG_FRAME_PENDING       (0x02)
+
+#define IEEE_FLAG_ACK_REQUEST         (0x04)
+
+#define IEEE_FLAG_PAN_ID_COMPRESSION  (0x08)
+
+#define IEEE_FLAG_SEQ_SUPPRESSED      (0x10)
+
+#define IEEE_FLAG_IE_PRESENT          (0x20)
+
+//
+// Length of Frame Check Sequence appended by RF Core
+// (RFCMD_ieeeRX.rxConfig.bIncludeCrc = 1)
+//
+#define IEEE_FCS_LEN                  (2)
+
+#define IEEE_MAX_MPDU_LEN             (127)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === IeeeParser_Summary_t
+ * Compact decoded MAC header. Layout is naturally aligned
+ * (no padding, 32 bytes) so that it can be forwarded to the host
+ * as-is in little-endian byte order. Addresses are kept in
+ * over-the-air (little-endian) byte order, unused bytes are zero.
+ * headerLen of zero marks a frame whose header could not be decoded.
+ *
+ */
+typedef struct IeeeParser_Summary
+{
+    uint8_t  frameType;
+    uint8_t  flags;
+    uint8_t  frameVersion;
+    uint8_t  seqNum;
+    uint8_t  dstAddrMode;
+    uint8_t  srcAddrMode;
+    uint16_t dstPanId;
+    uint16_t srcPanId;
+    uint8_t  dstAddr[8];
+    uint8_t  srcAddr[8];
+    uint8_t  securityLevel;
+    uint8_t  keyIdMode;
+    uint16_t headerLen;
+    uint16_t payloadLen;
+} IeeeParser_Summary_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+bool IeeeParser_Parse(const uint8_t* pMpdu, uint16_t len, IeeeParser_Summary_t* pSummary);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_FRAME_PARSER_IEEE_PARSER_H_ */
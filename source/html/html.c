@@ -14,6 +14,8 @@
 
 #include <unistd.h>
 
+#include <string.h>
+
 #include <source/html/html.h>
 
 // ==============================================================================================================
@@ -99,71 +101,170 @@ void Html_SetKeyValueInBuffer(char key, char* value)
 {
     Html_strset(valueBuffer[CHAR_KEY(key)].buf, 0, MAXLEN);
 
-    Html_strcpy(valueBuffer[CHAR_KEY(key)].buf, value, MAXLEN);
+    valueBuffer[CHAR_KEY(key)].len = Html_strcpy(valueBuffer[CHAR_KEY(key)].buf, value, MAXLEN);
 
     return;
 }
 
 
+/*
+ * === Html_GetKeyValue
+ * Returns value stored under given key in valueBuffer
+ * dictionary, so that other outputs than the dashboard
+ * (JSON API) can reuse values prepared for it.
+ *
+ * Parameters:
+ *      key[in]      - key ('a'..'z')
+ *      pLen[out]    - length of the value
+ * Returns:
+ *      const char*  - value (not '\0' terminated)
+ */
+const char* Html_GetKeyValue(char key, uint8_t* pLen)
+{
+    *pLen = valueBuffer[CHAR_KEY(key)].len;
+
+    return valueBuffer[CHAR_KEY(key)].buf;
+}
+
+
 /*
  * === Html_CopyHtmlToMtuBuffer
- * Copies HTML code from its source on the flash to the MTU
- * buffer. While copying, if it comes across SUBSTITUE_TOKEN,
- * it injects the value from valueBuffer dictionary.
+ * Fills the MTU buffer with the next part of the dashboard. Template
+ * in flash is precompiled into a table of static spans and key slots
+ * (flashbins/compile_template.py), so static spans are copied in bulk
+ * and only key slots are taken from valueBuffer dictionary. A slot
+ * value is never split between two MTU buffers.
  *
  * Parameters:
- *      offset[in]   - used to offset to start of HTML code. Usable
- *                     when splitting HTML code to more messages.
+ *      pCursor[in/out] - position within the template, zeroed
+ *                        before the first call
  * Returns:
- *      uint16_t     - number of copied characters (MTU_SIZE
- *                     when there are more data available; n < MTU_SIZE
- *                     when no additional data to be copied are available.)
+ *      uint16_t        - number of bytes in MTU buffer, 0 when whole
+ *                        template was sent (or flash does not hold
+ *                        a compiled template)
  *
  */
-int32_t Html_CopyHtmlToMtuBuffer(uint16_t offset)
+uint16_t Html_CopyHtmlToMtuBuffer(Html_Cursor_t* pCursor)
 {
-    char *pHtml = (char*)(HTML_MEM_START + offset);
-    char *pMtu  = (char*)MTU_BUF_MEM_START;
-    uint16_t i, tmp;
+    const Html_TemplateHeader_t* pHeader   = (const Html_TemplateHeader_t*)HTML_MEM_START;
+    const Html_Segment_t*        pSegments = (const Html_Segment_t*)(HTML_MEM_START + sizeof(Html_TemplateHeader_t));
+    const Html_Segment_t*        pSeg;
+    const ValueBuffer_t*         pValue;
+    char*    pMtu = (char*)MTU_BUF_MEM_START;
+    uint16_t used = 0;
+    uint16_t chunk;
+
+    if ( memcmp(pHeader->magic, HTML_MAGIC, sizeof(pHeader->magic)) != 0 )
+    {
+        return 0;
+    }
 
-    while ( (uint32_t)pMtu < (MTU_BUF_MEM_START + MTU_SIZE - 1) )
+    while ( pCursor->segment < pHeader->segmentCount )
     {
-        //
-        // Source HTML ended, remove all remaining characters from MTU buffer
-        // and cease copying.
-        //
-        if ( *pHtml == 255 )
-        {
-            *pMtu = 0;
-            return -1;
-        }
+        pSeg = &pSegments[pCursor->segment];
 
-        if ( *pHtml == SUBSTITUTE_TOKEN )
+        if ( pSeg->length == HTML_SEG_SLOT )
         {
-            tmp = Html_strcpy(pMtu, valueBuffer[CHAR_KEY(*(pHtml + 1))].buf, MAXLEN);
-            pHtml += 2;
-            pMtu += tmp;
+            pValue = &valueBuffer[CHAR_KEY(pSeg->offset)];
+
+            if ( used + pValue->len > MTU_SIZE )
+            {
+                break;
+            }
+
+            memcpy(pMtu + used, pValue->buf, pValue->len);
+
+            used += pValue->len;
+
+            pCursor->segment++;
         }
         else
         {
-            *pMtu = *pHtml;
-            pMtu++;
-            pHtml++;
+            chunk = pSeg->length - pCursor->offset;
+
+            if ( chunk > MTU_SIZE - used )
+            {
+                chunk = MTU_SIZE - used;
+            }
+
+            memcpy(pMtu + used, (const char*)(uintptr_t)(HTML_MEM_START + pSeg->offset + pCursor->offset), chunk);
+
+            used += chunk;
+
+            pCursor->offset += chunk;
+
+            if ( pCursor->offset == pSeg->length )
+            {
+                pCursor->segment++;
+                pCursor->offset = 0;
+            }
+        }
+
+        if ( used == MTU_SIZE )
+        {
+            break;
         }
     }
 
-    //
-    // Make sure that the last character from MTU buffer is '\0'
-    // so that other functions can print the buffer successfully.
-    //
-    *pMtu = 0;
+    return used;
+}
+
+
+/*
+ * === Html_FormatUint
+ * Lightweight replacement of sprintf("%u") for dashboard values.
+ *
+ * Parameters:
+ *      pBuf[out]    - destination, at least 11 bytes
+ *      value[in]    - value to be formatted
+ * Returns:
+ *      uint8_t      - number of characters written (without '\0')
+ */
+uint8_t Html_FormatUint(char* pBuf, uint32_t value)
+{
+    char    tmp[10];
+    uint8_t n = 0, i;
+
+    do
+    {
+        tmp[n++] = '0' + (value % 10);
+        value /= 10;
+    }
+    while ( value );
+
+    for ( i = 0; i < n; i++ )
+    {
+        pBuf[i] = tmp[n - 1 - i];
+    }
+
+    pBuf[n] = '\0';
 
-    return ((uint32_t)pHtml - HTML_MEM_START);
+    return n;
 }
 
 
+uint8_t Html_FormatInt(char* pBuf, int32_t value)
+{
+    if ( value < 0 )
+    {
+        *pBuf = '-';
 
+        return 1 + Html_FormatUint(pBuf + 1, (uint32_t)0 - (uint32_t)value);
+    }
 
+    return Html_FormatUint(pBuf, (uint32_t)value);
+}
+
+
+uint8_t Html_FormatHexByte(char* pBuf, uint8_t value)
+{
+    static const char hex[] = "0123456789ABCDEF";
 
+    pBuf[0] = hex[value >> 4];
+    pBuf[1] = hex[value & 0xF];
+    pBuf[2] = '\0';
 
+    return 2;
+}
 
+// ==============================================================================================================
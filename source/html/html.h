@@ -9,6 +9,8 @@
 #ifndef SOURCE_HTML_HTML_H_
 #define SOURCE_HTML_HTML_H_
 
+#include <stdint.h>
+
 // === DEFINES ==================================================================================================
 
 #define HTML_MEM_START    (0x51000)
@@ -23,19 +25,66 @@
 
 #define CHAR_KEY(key)     ((key) - 'a')
 
+//
+// Layout of the compiled template image,
+// see flashbins/compile_template.py
+//
+#define HTML_MAGIC        ("MSTP")
+
+#define HTML_SEG_SLOT     (0x8000)
+
 // ==============================================================================================================
 
 typedef struct ValueBuffer
 {
-    char buf[MAXLEN];
+    char    buf[MAXLEN];
+    uint8_t len;
 } ValueBuffer_t;
 
+typedef struct Html_TemplateHeader
+{
+    char     magic[4];
+    uint16_t segmentCount;
+    uint16_t dataLength;
+} Html_TemplateHeader_t;
+
+/*
+ * === Html_Segment_t
+ * Static span: offset from HTML_MEM_START and length.
+ * Key slot: offset holds the key, length is HTML_SEG_SLOT.
+ */
+typedef struct Html_Segment
+{
+    uint16_t offset;
+    uint16_t length;
+} Html_Segment_t;
+
+/*
+ * === Html_Cursor_t
+ * Position within the template between two calls
+ * of Html_CopyHtmlToMtuBuffer(). Zero it before
+ * the first call.
+ */
+typedef struct Html_Cursor
+{
+    uint16_t segment;
+    uint16_t offset;
+} Html_Cursor_t;
+
 
 // === FUNCTION DECLARATIONS ====================================================================================
 
 void Html_SetKeyValueInBuffer(char, char*);
 
-int32_t Html_CopyHtmlToMtuBuffer(uint16_t);
+const char* Html_GetKeyValue(char, uint8_t*);
+
+uint16_t Html_CopyHtmlToMtuBuffer(Html_Cursor_t*);
+
+uint8_t Html_FormatInt(char*, int32_t);
+
+uint8_t Html_FormatUint(char*, uint32_t);
+
+uint8_t Html_FormatHexByte(char*, uint8_t);
 
 // ==============================================================================================================
 
@@ -0,0 +1,608 @@
+/*
+ * http_reader.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <stdlib.h>
+
+#include <ctype.h>
+
+#include <source/ethernet/Ethernet.h>
+
+#include <source/http/http_reader.h>
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === findHeaderEnd
+ * Looks for the blank line ("\r\n\r\n") terminating the header block.
+ *
+ * Returns:
+ *      length of the header block including the blank line,
+ *      0 when it is not complete yet
+ */
+static uint16_t findHeaderEnd(const char* buf, uint16_t from, uint16_t len)
+{
+    uint16_t i;
+
+    for ( i = from; i + 3 < len; i++ )
+    {
+        if ( buf[i] == '\r' && buf[i + 1] == '\n' && buf[i + 2] == '\r' && buf[i + 3] == '\n' )
+        {
+            return i + 4;
+        }
+    }
+
+    return 0;
+}
+
+static bool isMethodChar(char c)
+{
+    return ( c >= 'A' && c <= 'Z' );
+}
+
+static bool isTargetChar(char c)
+{
+    return ( c > ' ' && c < 0x7F );
+}
+
+static bool isParamEnd(char c)
+{
+    return ( c == '\0' || c == '\r' || c == '\n' );
+}
+
+static int8_t hexValue(char c)
+{
+    if ( c >= '0' && c <= '9' ) return c - '0';
+    if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+    if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+
+    return -1;
+}
+
+static HttpMethod_t parseMethod(const char* pMethod, uint16_t len)
+{
+    if ( len == 3 && memcmp(pMethod, "GET", 3) == 0 )
+    {
+        return HTTP_METHOD_GET;
+    }
+
+    if ( len == 4 && memcmp(pMethod, "POST", 4) == 0 )
+    {
+        return HTTP_METHOD_POST;
+    }
+
+    if ( len == 4 && memcmp(pMethod, "HEAD", 4) == 0 )
+    {
+        return HTTP_METHOD_HEAD;
+    }
+
+    return HTTP_METHOD_OTHER;
+}
+
+/*
+ * === percentDecode
+ * Decodes "%XX" and '+' in place, malformed escapes are kept as they are.
+ */
+static void percentDecode(char* p)
+{
+    char* pOut;
+
+    //
+    // Most values have nothing to decode
+    //
+    while ( *p && *p != '%' && *p != '+' ) p++;
+
+    pOut = p;
+
+    while ( *p )
+    {
+        if ( *p == '%' && hexValue(p[1]) >= 0 && hexValue(p[2]) >= 0 )
+        {
+            *pOut++ = (char)(( hexValue(p[1]) << 4 ) | hexValue(p[2]));
+
+            p += 3;
+        }
+        else
+        {
+            *pOut++ = ( *p == '+' ) ? ' ' : *p;
+
+            p++;
+        }
+    }
+
+    *pOut = '\0';
+
+    return;
+}
+
+static bool equalsIgnoreCase(const char* pA, const char* pB, uint16_t len)
+{
+    uint16_t i;
+
+    for ( i = 0; i < len; i++ )
+    {
+        if ( tolower((unsigned char)pA[i]) != tolower((unsigned char)pB[i]) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool nameEquals(const char* pLine, const char* pName, uint16_t nameLen)
+{
+    return equalsIgnoreCase(pLine, pName, nameLen) && ( pLine[nameLen] == ':' );
+}
+
+/*
+ * === selectHeader
+ * Picks up headers the server acts upon. Content-Length
+ * has to be a plain decimal number fitting uint16_t.
+ */
+static HttpReader_Status_t selectHeader(HttpRequest_t* pRequest, const char* pName, uint16_t nameLen, const char* pValue, uint16_t valueLen)
+{
+    uint32_t length = 0;
+    uint16_t i;
+
+    if ( nameLen == 14 && equalsIgnoreCase(pName, "Content-Length", 14) )
+    {
+        if ( valueLen == 0 || valueLen > 5 )
+        {
+            return HTTP_READER_MALFORMED;
+        }
+
+        for ( i = 0; i < valueLen; i++ )
+        {
+            if ( pValue[i] < '0' || pValue[i] > '9' )
+            {
+                return HTTP_READER_MALFORMED;
+            }
+
+            length = 10 * length + ( pValue[i] - '0' );
+        }
+
+        if ( length > 0xFFFF )
+        {
+            return HTTP_READER_MALFORMED;
+        }
+
+        pRequest->contentLength = (uint16_t)length;
+    }
+    else if ( nameLen == 10 && equalsIgnoreCase(pName, "Connection", 10) )
+    {
+        if ( valueLen == 5 && equalsIgnoreCase(pValue, "close", 5) )
+        {
+            pRequest->bKeepAlive = false;
+        }
+        else if ( valueLen == 10 && equalsIgnoreCase(pValue, "keep-alive", 10) )
+        {
+            pRequest->bKeepAlive = true;
+        }
+    }
+    else if ( nameLen == 12 && equalsIgnoreCase(pName, "Content-Type", 12) )
+    {
+        pRequest->pContentType = pValue;
+    }
+    else if ( nameLen == 4 && equalsIgnoreCase(pName, "Host", 4) )
+    {
+        pRequest->pHost = pValue;
+    }
+
+    return HTTP_READER_OK;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === HttpReader_Begin
+ * Starts reading of a new request into pRequest.
+ */
+void HttpReader_Begin(HttpRequest_t* pRequest)
+{
+    pRequest->len       = 0;
+    pRequest->headerLen = 0;
+
+    return;
+}
+
+
+/*
+ * === HttpReader_Read
+ * Reads HTTP request header block from the client. Instead of
+ * pulling the request byte by byte (every byte being a separate recv()
+ * with its own RX size reads, RX_RD update and RECV command on SPI),
+ * whatever the socket holds is moved to RAM in one bulk read, which is
+ * usually the whole request. Then the header block is parsed in RAM.
+ * Reader never waits for the rest of the request: when the socket runs
+ * dry first, bytes read so far are kept in pRequest and reading goes
+ * on by another call, once the socket signals RECV again.
+ *
+ * Parameters:
+ *      pClient[in]         - connected client
+ *      pRequest[in/out]    - request started by HttpReader_Begin()
+ * Returns:
+ *      HttpReader_Status_t - HTTP_READER_OK when a complete header block
+ *                            was read and parsed, HTTP_READER_PENDING
+ *                            when it is not complete yet
+ */
+HttpReader_Status_t HttpReader_Read(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    int      ret;
+    uint16_t scanFrom;
+
+    for (;;)
+    {
+        if ( pRequest->len == HTTP_REQUEST_MAXLEN )
+        {
+            return HTTP_READER_TOO_LARGE;
+        }
+
+        ret = EthernetClient_read_buf(pClient, (uint8_t*)pRequest->buf + pRequest->len, HTTP_REQUEST_MAXLEN - pRequest->len);
+
+        if ( ret > 0 )
+        {
+            //
+            // Terminator may be split between two reads
+            //
+            scanFrom = pRequest->len > 3 ? pRequest->len - 3 : 0;
+
+            pRequest->len += ret;
+
+            pRequest->headerLen = findHeaderEnd(pRequest->buf, scanFrom, pRequest->len);
+
+            if ( pRequest->headerLen )
+            {
+                return HttpReader_Parse(pRequest);
+            }
+        }
+        else if ( ret == 0 )
+        {
+            return HTTP_READER_CLOSED;
+        }
+        else
+        {
+            return HTTP_READER_PENDING;
+        }
+    }
+}
+
+
+/*
+ * === HttpReader_Parse
+ * Parses header block already stored in pRequest->buf
+ * (pRequest->len and pRequest->headerLen have to be set) in a single
+ * pass, never looking past the header block. Request line is split in
+ * place into method, path, query and version, header lines are checked
+ * for "name: value" form and the selected ones are remembered.
+ *
+ * Parameters:
+ *      pRequest[in/out]    - request
+ * Returns:
+ *      HttpReader_Status_t - HTTP_READER_OK or HTTP_READER_MALFORMED
+ */
+HttpReader_Status_t HttpReader_Parse(HttpRequest_t* pRequest)
+{
+    char*               p    = pRequest->buf;
+    char*               pEnd = pRequest->buf + pRequest->headerLen;
+    char*               pName;
+    char*               pColon;
+    char*               pValue;
+    char*               pValueEnd;
+    HttpReader_Status_t status;
+
+    pRequest->buf[pRequest->len] = '\0';
+
+    pRequest->contentLength = 0;
+    pRequest->pHost         = NULL;
+    pRequest->pContentType  = NULL;
+
+    ///////////////////////////
+    // Method
+    //
+    pRequest->pMethod = p;
+
+    while ( p < pEnd && isMethodChar(*p) ) p++;
+
+    if ( p == pRequest->pMethod || p == pEnd || *p != ' ' )
+    {
+        return HTTP_READER_MALFORMED;
+    }
+
+    pRequest->method = parseMethod(pRequest->pMethod, p - pRequest->pMethod);
+
+    *p++ = '\0';
+
+    ///////////////////////////
+    // Target, split into
+    // path and query
+    //
+    pRequest->pPath = p;
+
+    if ( *p != '/' )
+    {
+        return HTTP_READER_MALFORMED;
+    }
+
+    while ( p < pEnd && isTargetChar(*p) && *p != '?' ) p++;
+
+    //
+    // Without '?' pQuery ends up pointing to
+    // the terminator of the path, i.e. ""
+    //
+    pRequest->pQuery = p;
+
+    if ( p < pEnd && *p == '?' )
+    {
+        *p++ = '\0';
+
+        pRequest->pQuery = p;
+
+        while ( p < pEnd && isTargetChar(*p) ) p++;
+    }
+
+    if ( p == pEnd || *p != ' ' )
+    {
+        return HTTP_READER_MALFORMED;
+    }
+
+    *p++ = '\0';
+
+    ///////////////////////////
+    // Version
+    //
+    pRequest->pVersion = p;
+
+    while ( p < pEnd && *p != '\r' ) p++;
+
+    if ( p + 1 >= pEnd || p[1] != '\n' || p - pRequest->pVersion != 8 || strncmp(pRequest->pVersion, "HTTP/1.", 7) != 0 )
+    {
+        return HTTP_READER_MALFORMED;
+    }
+
+    *p = '\0';
+
+    p += 2;
+
+    pRequest->bKeepAlive = ( pRequest->pVersion[7] == '1' );
+
+    ///////////////////////////
+    // Header lines. Header block
+    // ends with "\r\n\r\n", so every
+    // line ends before pEnd
+    //
+    pRequest->pHeaders = p;
+
+    while ( *p != '\r' )
+    {
+        pName = p;
+
+        p = (char*)memchr(p, '\n', pEnd - p);
+
+        //
+        // Line has to end with "\r\n", a bare '\n' at its
+        // very start would leave the line end before pName
+        //
+        if ( p == pName || p[-1] != '\r' )
+        {
+            return HTTP_READER_MALFORMED;
+        }
+
+        p--;
+
+        pColon = memchr(pName, ':', p - pName);
+
+        if ( pColon == NULL || pColon == pName )
+        {
+            return HTTP_READER_MALFORMED;
+        }
+
+        pValue = pColon + 1;
+
+        while ( *pValue == ' ' || *pValue == '\t' ) pValue++;
+
+        pValueEnd = p;
+
+        while ( pValueEnd > pValue && ( pValueEnd[-1] == ' ' || pValueEnd[-1] == '\t' ) ) pValueEnd--;
+
+        *pValueEnd = '\0';
+
+        status = selectHeader(pRequest, pName, pColon - pName, pValue, pValueEnd - pValue);
+
+        if ( status != HTTP_READER_OK )
+        {
+            return status;
+        }
+
+        p += 2;
+    }
+
+    if ( p + 2 != pEnd || p[1] != '\n' )
+    {
+        return HTTP_READER_MALFORMED;
+    }
+
+    return HTTP_READER_OK;
+}
+
+
+/*
+ * === HttpReader_ReadBody
+ * Makes sure that whole body (Content-Length bytes) of the request
+ * is in pRequest->buf right after the header block, reading the rest
+ * of it from the client in bulk when needed. Same as the header block,
+ * body which has not arrived yet is not waited for.
+ *
+ * Parameters:
+ *      pClient[in]         - connected client
+ *      pRequest[in/out]    - request parsed by HttpReader_Read()
+ * Returns:
+ *      HttpReader_Status_t - HTTP_READER_OK when body is complete and
+ *                            '\0' terminated, HTTP_READER_PENDING when
+ *                            the socket has no more of it yet
+ */
+HttpReader_Status_t HttpReader_ReadBody(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    int      ret;
+    uint16_t total = pRequest->headerLen + pRequest->contentLength;
+
+    if ( total > HTTP_REQUEST_MAXLEN )
+    {
+        return HTTP_READER_TOO_LARGE;
+    }
+
+    while ( pRequest->len < total )
+    {
+        ret = EthernetClient_read_buf(pClient, (uint8_t*)pRequest->buf + pRequest->len, total - pRequest->len);
+
+        if ( ret > 0 )
+        {
+            pRequest->len += ret;
+        }
+        else if ( ret == 0 )
+        {
+            return HTTP_READER_CLOSED;
+        }
+        else
+        {
+            return HTTP_READER_PENDING;
+        }
+    }
+
+    //
+    // Bytes of a pipelined request are not kept
+    //
+    pRequest->len = total;
+
+    pRequest->buf[total] = '\0';
+
+    return HTTP_READER_OK;
+}
+
+
+/*
+ * === HttpReader_GetHeader
+ * Looks up header by its name (case insensitive).
+ *
+ * Parameters:
+ *      pRequest[in]        - parsed request
+ *      pName[in]           - name of the header
+ *      pLen[out]           - length of the value
+ * Returns:
+ *      const char*         - pointer to the value (not '\0' terminated,
+ *                            leading whitespace skipped) or NULL
+ */
+const char* HttpReader_GetHeader(const HttpRequest_t* pRequest, const char* pName, uint16_t* pLen)
+{
+    const char* p    = pRequest->pHeaders;
+    const char* pEnd = pRequest->buf + pRequest->headerLen;
+    const char* pValue;
+    uint16_t    nameLen = strlen(pName);
+
+    while ( p != NULL && p + nameLen < pEnd )
+    {
+        if ( nameEquals(p, pName, nameLen) )
+        {
+            pValue = p + nameLen + 1;
+
+            while ( *pValue == ' ' || *pValue == '\t' )
+            {
+                pValue++;
+            }
+
+            p = pValue;
+
+            while ( p < pEnd && *p != '\0' && *p != '\r' && *p != '\n' )
+            {
+                p++;
+            }
+
+            *pLen = (uint16_t)(p - pValue);
+
+            return pValue;
+        }
+
+        p = memchr(p, '\n', pEnd - p);
+
+        p = p ? p + 1 : NULL;
+    }
+
+    return NULL;
+}
+
+
+
+/*
+ * === HttpReader_NextParam
+ * Iterates over "k=v&k=v" pairs of a query string or a form body.
+ * Unlike strtok() there is no hidden state, the position is kept by
+ * the caller. Pairs are split and percent-decoded ('+' is a space)
+ * in place, iteration ends at '\0' or at the end of a line.
+ *
+ * Parameters:
+ *      ppCursor[in/out]    - position in the string, advanced past the pair
+ *      ppKey[out]          - key
+ *      ppValue[out]        - value, "" when the pair has no '='
+ * Returns:
+ *      bool                - false when there are no more pairs
+ */
+bool HttpReader_NextParam(char** ppCursor, char** ppKey, char** ppValue)
+{
+    char* p      = *ppCursor;
+    char* pValue = NULL;
+
+    while ( *p == '&' ) p++;
+
+    if ( isParamEnd(*p) )
+    {
+        return false;
+    }
+
+    *ppKey = p;
+
+    while ( !isParamEnd(*p) && *p != '&' )
+    {
+        if ( *p == '=' && pValue == NULL )
+        {
+            *p = '\0';
+
+            pValue = p + 1;
+        }
+
+        p++;
+    }
+
+    *ppValue = ( pValue != NULL ) ? pValue : p;
+
+    if ( *p == '&' )
+    {
+        *p++ = '\0';
+    }
+    else
+    {
+        *p = '\0';
+    }
+
+    percentDecode(*ppKey);
+
+    percentDecode(*ppValue);
+
+    *ppCursor = p;
+
+    return true;
+}
+
+// ==============================================================================================================
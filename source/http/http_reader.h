@@ -0,0 +1,109 @@
+/*
+ * http_reader.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_HTTP_HTTP_READER_H_
+#define SOURCE_HTTP_HTTP_READER_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <source/ethernet/EthernetClient.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Whole header block has to fit in, longer
+// requests are refused (HTTP_READER_TOO_LARGE)
+//
+#define HTTP_REQUEST_MAXLEN       (1024)
+
+//
+// How long to wait for the rest of the request (or body),
+// or for the next request on a kept-alive connection,
+// in Clock ticks (Clock.tickPeriod = 10 us)
+//
+#define HTTP_READER_TIMEOUT_TICKS (200000)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef enum HttpReader_Status
+{
+    HTTP_READER_OK = 0,
+    HTTP_READER_PENDING,
+    HTTP_READER_CLOSED,
+    HTTP_READER_TIMEOUT,
+    HTTP_READER_TOO_LARGE,
+    HTTP_READER_MALFORMED
+} HttpReader_Status_t;
+
+typedef enum HttpMethod
+{
+    HTTP_METHOD_GET = 0,
+    HTTP_METHOD_POST,
+    HTTP_METHOD_HEAD,
+    HTTP_METHOD_OTHER
+} HttpMethod_t;
+
+/*
+ * === HttpRequest_t
+ * Request as read from the socket. Request line is split in place,
+ * i.e. pMethod, pPath, pQuery and pVersion are '\0' terminated strings
+ * pointing into buf (pQuery is "" when the target has no '?').
+ * Selected headers are picked up while parsing (pHost, pContentType,
+ * contentLength, bKeepAlive), values of all header lines are '\0'
+ * terminated and others can be looked up by HttpReader_GetHeader().
+ * Bytes of the body that arrived together with the header block
+ * follow it in buf (len - headerLen bytes). bKeepAlive tells whether
+ * the client wants to keep the connection open after the response
+ * (HTTP/1.1 default, Connection header).
+ */
+typedef struct HttpRequest
+{
+    char         buf[HTTP_REQUEST_MAXLEN + 1];
+    uint16_t     len;
+    uint16_t     headerLen;
+    HttpMethod_t method;
+    char*        pMethod;
+    char*        pPath;
+    char*        pQuery;
+    char*        pVersion;
+    char*        pHeaders;
+    const char*  pHost;
+    const char*  pContentType;
+    uint16_t     contentLength;
+    bool         bKeepAlive;
+} HttpRequest_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void                HttpReader_Begin(HttpRequest_t* pRequest);
+
+HttpReader_Status_t HttpReader_Read(EthernetClient* pClient, HttpRequest_t* pRequest);
+
+HttpReader_Status_t HttpReader_Parse(HttpRequest_t* pRequest);
+
+HttpReader_Status_t HttpReader_ReadBody(EthernetClient* pClient, HttpRequest_t* pRequest);
+
+const char*         HttpReader_GetHeader(const HttpRequest_t* pRequest, const char* pName, uint16_t* pLen);
+
+bool                HttpReader_NextParam(char** ppCursor, char** ppKey, char** ppValue);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_HTTP_HTTP_READER_H_ */
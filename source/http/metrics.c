@@ -0,0 +1,503 @@
+/*
+ * metrics.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include "ti_radio_config.h"
+
+#include <source/ethernet/Ethernet.h>
+
+#include <source/http/metrics.h>
+
+#include <source/html/html.h>
+
+#include <source/frame_parser/ble_parser.h>
+
+#include <source/utils/stats.h>
+
+#include <source/utils/trace.h>
+
+#include <source/utils/spi_profile.h>
+
+#include <monitor_task.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define TICKS_PER_SECOND        (100000)    // Clock.tickPeriod = 10 us
+
+//
+// Body is sent in HTTP chunks built in MTU buffer:
+// [4 hex digits][CRLF][data][CRLF]
+//
+#define CHUNK_HEADER            (6)
+#define CHUNK_TRAILER           (2)
+#define CHUNK_CAPACITY          (MTU_SIZE - CHUNK_HEADER - CHUNK_TRAILER)
+
+#define LABELS_MAXLEN           (48)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct MetricsWriter
+{
+    EthernetClient* pClient;
+    char*           pData;
+    uint16_t        len;
+} MetricsWriter_t;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint16_t appendString(char* pDst, const char* pSrc)
+{
+    uint16_t len = strlen(pSrc);
+
+    memcpy(pDst, pSrc, len);
+
+    return len;
+}
+
+/*
+ * === flush
+ * Sends collected data as one HTTP chunk. Chunk size is written with
+ * leading zeros into the space reserved in front of the data, so the
+ * whole chunk goes out in a single write.
+ */
+static void flush(MetricsWriter_t* pW)
+{
+    char* pChunk = pW->pData - CHUNK_HEADER;
+
+    if ( pW->len == 0 )
+    {
+        return;
+    }
+
+    Html_FormatHexByte(&pChunk[0], pW->len >> 8);
+    Html_FormatHexByte(&pChunk[2], pW->len & 0xFF);
+
+    pChunk[4] = '\r';
+    pChunk[5] = '\n';
+
+    pW->pData[pW->len]     = '\r';
+    pW->pData[pW->len + 1] = '\n';
+
+    EthernetClient_write(pW->pClient, (const uint8_t*)pChunk, CHUNK_HEADER + pW->len + CHUNK_TRAILER);
+
+    pW->len = 0;
+
+    return;
+}
+
+static void put(MetricsWriter_t* pW, const char* pStr, uint16_t len)
+{
+    uint16_t part;
+
+    while ( len )
+    {
+        if ( pW->len == CHUNK_CAPACITY )
+        {
+            flush(pW);
+        }
+
+        part = CHUNK_CAPACITY - pW->len;
+
+        if ( part > len )
+        {
+            part = len;
+        }
+
+        memcpy(pW->pData + pW->len, pStr, part);
+
+        pW->len += part;
+        pStr    += part;
+        len     -= part;
+    }
+
+    return;
+}
+
+static void putString(MetricsWriter_t* pW, const char* pStr)
+{
+    put(pW, pStr, strlen(pStr));
+
+    return;
+}
+
+/*
+ * === family
+ * Writes HELP and TYPE lines of a metric family.
+ */
+static void family(MetricsWriter_t* pW, const char* pName, const char* pType, const char* pHelp)
+{
+    putString(pW, "# HELP ");
+    putString(pW, pName);
+    putString(pW, " ");
+    putString(pW, pHelp);
+    putString(pW, "\n# TYPE ");
+    putString(pW, pName);
+    putString(pW, " ");
+    putString(pW, pType);
+    putString(pW, "\n");
+
+    return;
+}
+
+/*
+ * === sample
+ * Writes one sample line: name{labels} value
+ *
+ * Parameters:
+ *      pName[in]           - metric name (with _bucket, _sum, ... suffix)
+ *      pLabels[in]         - 'key="value",...' or NULL
+ *      value[in]           - value, negative ones are printed as such
+ *      bSigned[in]         - treat value as int32_t
+ */
+static void sample(MetricsWriter_t* pW, const char* pName, const char* pLabels, uint32_t value, bool bSigned)
+{
+    char tmp[12];
+
+    putString(pW, pName);
+
+    if ( pLabels != NULL )
+    {
+        putString(pW, "{");
+        putString(pW, pLabels);
+        putString(pW, "}");
+    }
+
+    putString(pW, " ");
+    put(pW, tmp, bSigned ? Html_FormatInt(tmp, (int32_t)value) : Html_FormatUint(tmp, value));
+    putString(pW, "\n");
+
+    return;
+}
+
+/*
+ * === counter
+ * Family with a single unlabelled sample.
+ */
+static void counter(MetricsWriter_t* pW, const char* pName, const char* pHelp, uint32_t value)
+{
+    family(pW, pName, "counter", pHelp);
+    sample(pW, pName, NULL, value, false);
+
+    return;
+}
+
+/*
+ * === formatLabels
+ * Builds 'key1="value1",key2="value2"' label set,
+ * pKey2 may be NULL.
+ */
+static const char* formatLabels(char* pBuf, const char* pKey1, const char* pValue1, const char* pKey2, const char* pValue2)
+{
+    uint8_t len = 0;
+
+    len += appendString(pBuf + len, pKey1);
+    len += appendString(pBuf + len, "=\"");
+    len += appendString(pBuf + len, pValue1);
+    len += appendString(pBuf + len, "\"");
+
+    if ( pKey2 != NULL )
+    {
+        len += appendString(pBuf + len, ",");
+        len += appendString(pBuf + len, pKey2);
+        len += appendString(pBuf + len, "=\"");
+        len += appendString(pBuf + len, pValue2);
+        len += appendString(pBuf + len, "\"");
+    }
+
+    pBuf[len] = '\0';
+
+    return pBuf;
+}
+
+static void writeRadio(MetricsWriter_t* pW, const Stats_Snapshot_t* pSnapshot)
+{
+    char labels[LABELS_MAXLEN];
+    char bleChannel[4];
+    char ieeeChannel[4];
+
+    Html_FormatUint(bleChannel,  RFCMD_bleGenericRX.channel);
+    Html_FormatUint(ieeeChannel, RFCMD_ieeeRX.channel);
+
+    family(pW, "multisniff_rf_rx_ok_total", "counter", "Frames received by RF Core with valid CRC.");
+    sample(pW, "multisniff_rf_rx_ok_total", formatLabels(labels, "protocol", "ble", "channel", bleChannel), pSnapshot->bleRxOk, false);
+    sample(pW, "multisniff_rf_rx_ok_total", formatLabels(labels, "protocol", "ieee802154", "channel", ieeeChannel), pSnapshot->ieeeRxOk, false);
+
+    family(pW, "multisniff_rf_rx_nok_total", "counter", "Frames received by RF Core with CRC error.");
+    sample(pW, "multisniff_rf_rx_nok_total", formatLabels(labels, "protocol", "ble", "channel", bleChannel), pSnapshot->bleRxNok, false);
+    sample(pW, "multisniff_rf_rx_nok_total", formatLabels(labels, "protocol", "ieee802154", "channel", ieeeChannel), pSnapshot->ieeeRxNok, false);
+
+    family(pW, "multisniff_rf_last_rssi_dbm", "gauge", "RSSI of the last received frame.");
+    sample(pW, "multisniff_rf_last_rssi_dbm", NULL, (uint32_t)(int32_t)pSnapshot->lastRssi, true);
+
+    return;
+}
+
+static void writeCapture(MetricsWriter_t* pW, const Stats_Snapshot_t* pSnapshot)
+{
+    char labels[LABELS_MAXLEN];
+
+    counter(pW, "multisniff_radio_queue_stored_total",    "Frames RF Core stored in the radio queue.",            pSnapshot->counters[STATS_RF_RX_OK]);
+    counter(pW, "multisniff_radio_queue_overflows_total", "Radio queue overflows, frames in the queue were lost.", pSnapshot->counters[STATS_RX_OVERFLOWS]);
+    counter(pW, "multisniff_frames_received_total",       "Frames taken from the radio queue.",                   pSnapshot->counters[STATS_RX_FRAMES]);
+    counter(pW, "multisniff_frames_forwarded_total",      "Frames forwarded to the target.",                      pSnapshot->counters[STATS_TX_DATAGRAMS]);
+
+    family(pW, "multisniff_frames_dropped_total", "counter", "Frames not forwarded, by stage.");
+    sample(pW, "multisniff_frames_dropped_total", formatLabels(labels, "stage", "queue_reset", NULL, NULL), pSnapshot->counters[STATS_QUEUE_DISCARDS], false);
+    sample(pW, "multisniff_frames_dropped_total", formatLabels(labels, "stage", "trigger", NULL, NULL),     pSnapshot->counters[STATS_TRIGGER_DROPS],  false);
+    sample(pW, "multisniff_frames_dropped_total", formatLabels(labels, "stage", "udp", NULL, NULL),         pSnapshot->counters[STATS_TX_ERRORS],      false);
+    sample(pW, "multisniff_frames_dropped_total", formatLabels(labels, "stage", "arp", NULL, NULL),         pSnapshot->counters[STATS_TX_TIMEOUTS],    false);
+
+    counter(pW, "multisniff_trigger_fires_total",            "Trigger pattern matches.",                     pSnapshot->counters[STATS_TRIGGER_FIRES]);
+    counter(pW, "multisniff_ble_records_total",              "Decoded BLE advertising records.",             BleParser_GetRecordCount());
+    counter(pW, "multisniff_ble_records_overwritten_total",  "BLE records overwritten before being sent.",    BleParser_GetOverwrittenCount());
+
+    family(pW, "multisniff_udp_datagrams_total", "counter", "UDP datagrams sent to the target, by payload.");
+    sample(pW, "multisniff_udp_datagrams_total", formatLabels(labels, "type", "frame", NULL, NULL),   pSnapshot->counters[STATS_TX_DATAGRAMS],     false);
+    sample(pW, "multisniff_udp_datagrams_total", formatLabels(labels, "type", "records", NULL, NULL), pSnapshot->counters[STATS_RECORD_DATAGRAMS], false);
+
+    counter(pW, "multisniff_udp_errors_total",        "UDP datagrams W5500 failed to send.", pSnapshot->counters[STATS_TX_ERRORS]);
+    counter(pW, "multisniff_udp_short_writes_total",  "UDP datagrams cut short, W5500 TX buffer full.", pSnapshot->counters[STATS_TX_SHORT_WRITES]);
+    counter(pW, "multisniff_spi_transactions_total",  "SPI frames exchanged with W5500.",    pSnapshot->counters[STATS_SPI_TRANSACTIONS]);
+    counter(pW, "multisniff_spi_bytes_total",         "Bytes exchanged with W5500 over SPI.", pSnapshot->counters[STATS_SPI_BYTES]);
+
+    return;
+}
+
+static void writeHistogram(MetricsWriter_t* pW, const char* pName, const char* pHelp, Stats_Histogram_t hist)
+{
+    Stats_HistogramData_t data;
+    const uint32_t*       pBounds = Stats_GetHistogramBounds(hist);
+    char                  labels[LABELS_MAXLEN];
+    char                  name[48];
+    char                  bound[11];
+    uint32_t              cumulative = 0;
+    uint8_t               nameLen;
+    uint8_t               i;
+
+    Stats_GetHistogram(hist, &data);
+
+    family(pW, pName, "histogram", pHelp);
+
+    nameLen = appendString(name, pName);
+
+    name[nameLen + appendString(name + nameLen, "_bucket")] = '\0';
+
+    for ( i = 0; i < STATS_HIST_BUCKETS; i++ )
+    {
+        cumulative += data.buckets[i];
+
+        Html_FormatUint(bound, pBounds[i]);
+
+        sample(pW, name, formatLabels(labels, "le", bound, NULL, NULL), cumulative, false);
+    }
+
+    sample(pW, name, formatLabels(labels, "le", "+Inf", NULL, NULL), data.count, false);
+
+    name[nameLen + appendString(name + nameLen, "_sum")] = '\0';
+    sample(pW, name, NULL, data.sum, false);
+
+    name[nameLen + appendString(name + nameLen, "_count")] = '\0';
+    sample(pW, name, NULL, data.count, false);
+
+    return;
+}
+
+/*
+ * === writeLatency
+ * Per-stage frame latency histograms, largest values
+ * as a gauge (bucket bounds hide the tail).
+ */
+static void writeLatency(MetricsWriter_t* pW)
+{
+    Stats_HistogramData_t data;
+    Stats_Histogram_t     hist;
+    char                  labels[LABELS_MAXLEN];
+
+    writeHistogram(pW, "multisniff_latency_queue_microseconds", "End of reception to frame taken from the radio queue.", STATS_HIST_LATENCY_QUEUE);
+    writeHistogram(pW, "multisniff_latency_spi_microseconds",   "Frame taken from the radio queue to datagram written to W5500.", STATS_HIST_LATENCY_SPI);
+    writeHistogram(pW, "multisniff_latency_send_microseconds",  "Datagram written to W5500 to SEND command issued.", STATS_HIST_LATENCY_SEND);
+    writeHistogram(pW, "multisniff_latency_total_microseconds", "End of reception to SEND command issued.", STATS_HIST_LATENCY_TOTAL);
+
+    family(pW, "multisniff_latency_max_microseconds", "gauge", "Largest latency per stage since boot.");
+
+    for ( hist = STATS_HIST_LATENCY_QUEUE; hist <= STATS_HIST_LATENCY_TOTAL; hist++ )
+    {
+        Stats_GetHistogram(hist, &data);
+
+        sample(pW, "multisniff_latency_max_microseconds", formatLabels(labels, "stage", Stats_GetHistogramName(hist), NULL, NULL), data.max, false);
+    }
+
+    return;
+}
+
+/*
+ * === writeTasks
+ * Loads and stack headroom as last sampled by the monitor task.
+ */
+static void writeTasks(MetricsWriter_t* pW)
+{
+    Monitor_Sample_t monitor;
+    char             labels[LABELS_MAXLEN];
+    uint8_t          i;
+
+    Monitor_GetSample(&monitor);
+
+    family(pW, "multisniff_cpu_load_percent", "gauge", "CPU load over the last Load window.");
+    sample(pW, "multisniff_cpu_load_percent", NULL, monitor.cpuLoad, false);
+
+    family(pW, "multisniff_hwi_cpu_load_percent", "gauge", "CPU load of all Hwis over the last Load window.");
+    sample(pW, "multisniff_hwi_cpu_load_percent", NULL, monitor.hwiLoad, false);
+
+    family(pW, "multisniff_swi_cpu_load_percent", "gauge", "CPU load of all Swis over the last Load window.");
+    sample(pW, "multisniff_swi_cpu_load_percent", NULL, monitor.swiLoad, false);
+
+    family(pW, "multisniff_task_cpu_load_percent", "gauge", "CPU load of a task over the last Load window.");
+
+    for ( i = 0; i < MONITOR_TASK_COUNT; i++ )
+    {
+        if ( monitor.stackSize[i] != 0 )
+        {
+            sample(pW, "multisniff_task_cpu_load_percent", formatLabels(labels, "task", Monitor_GetStackName(i), NULL, NULL), monitor.taskLoad[i], false);
+        }
+    }
+
+    family(pW, "multisniff_task_stack_free_bytes", "gauge", "Stack never touched by a task (headroom).");
+
+    for ( i = 0; i < MONITOR_TASK_COUNT; i++ )
+    {
+        if ( monitor.stackSize[i] != 0 )
+        {
+            sample(pW, "multisniff_task_stack_free_bytes", formatLabels(labels, "task", Monitor_GetStackName(i), NULL, NULL), monitor.stackSize[i] - monitor.stackPeak[i], false);
+        }
+    }
+
+    family(pW, "multisniff_hwi_stack_free_bytes", "gauge", "System stack (Hwi, Swi) never touched (headroom).");
+    sample(pW, "multisniff_hwi_stack_free_bytes", NULL, monitor.stackSize[MONITOR_STACK_HWI] - monitor.stackPeak[MONITOR_STACK_HWI], false);
+
+    family(pW, "multisniff_stack_alarm", "gauge", "Stack headroom fell below the alarm threshold.");
+
+    for ( i = 0; i < MONITOR_STACK_COUNT; i++ )
+    {
+        sample(pW, "multisniff_stack_alarm", formatLabels(labels, "stack", Monitor_GetStackName(i), NULL, NULL), ( monitor.alarms >> i ) & 1, false);
+    }
+
+    return;
+}
+
+/*
+ * === writeSpi
+ * SPI traffic per caller category, left out unless built with
+ * SPI_PROFILE. GET /api/spi?clear resets these counters as well.
+ */
+static void writeSpi(MetricsWriter_t* pW)
+{
+    SpiProfile_Snapshot_t snapshot;
+    SpiProfile_Category_t category;
+    char                  labels[LABELS_MAXLEN];
+
+    if ( !SpiProfile_TakeSnapshot(&snapshot, false) )
+    {
+        return;
+    }
+
+    family(pW, "multisniff_spi_caller_frames_total", "counter", "SPI frames (CS assertions) exchanged with W5500, by caller.");
+
+    for ( category = (SpiProfile_Category_t)0; category < SPI_PROFILE_CATEGORY_COUNT; category++ )
+    {
+        sample(pW, "multisniff_spi_caller_frames_total", formatLabels(labels, "caller", SpiProfile_GetName(category), NULL, NULL), snapshot.categories[category].frames, false);
+    }
+
+    family(pW, "multisniff_spi_caller_bytes_total", "counter", "Bytes exchanged with W5500 over SPI, by caller.");
+
+    for ( category = (SpiProfile_Category_t)0; category < SPI_PROFILE_CATEGORY_COUNT; category++ )
+    {
+        sample(pW, "multisniff_spi_caller_bytes_total", formatLabels(labels, "caller", SpiProfile_GetName(category), NULL, NULL), snapshot.categories[category].bytes, false);
+    }
+
+    family(pW, "multisniff_spi_caller_busy_milliseconds_total", "counter", "Time CS of W5500 was held low, by caller.");
+
+    for ( category = (SpiProfile_Category_t)0; category < SPI_PROFILE_CATEGORY_COUNT; category++ )
+    {
+        sample(pW, "multisniff_spi_caller_busy_milliseconds_total", formatLabels(labels, "caller", SpiProfile_GetName(category), NULL, NULL), (uint32_t)( snapshot.categories[category].cycles / ( TRACE_CPU_HZ / 1000 ) ), false);
+    }
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Metrics_Send
+ * Answers GET /metrics in Prometheus text exposition format.
+ * Body is never held in RAM as a whole, it is streamed with chunked
+ * transfer encoding, each chunk filling up the MTU buffer. Counters
+ * come from one Stats_TakeSnapshot(), so they are consistent with
+ * each other.
+ *
+ * Parameters:
+ *      pClient[in]         - connected client
+ *      bKeepAlive[in]      - keep the connection open afterwards
+ * Returns:
+ *      N/A
+ */
+void Metrics_Send(EthernetClient* pClient, bool bKeepAlive)
+{
+    Stats_Snapshot_t snapshot;
+    MetricsWriter_t  w;
+    const char*      pHeader = bKeepAlive
+        ? "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nTransfer-Encoding: chunked\r\nConnection: keep-alive\r\n\r\n"
+        : "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nTransfer-Encoding: chunked\r\nConnection: close\r\n\r\n";
+
+    EthernetClient_write(pClient, (const uint8_t*)pHeader, strlen(pHeader));
+
+    Stats_TakeSnapshot(&snapshot);
+
+    w.pClient = pClient;
+    w.pData   = (char*)MTU_BUF_MEM_START + CHUNK_HEADER;
+    w.len     = 0;
+
+    family(&w, "multisniff_uptime_seconds", "gauge", "Time since boot.");
+    sample(&w, "multisniff_uptime_seconds", NULL, snapshot.ticks / TICKS_PER_SECOND, false);
+
+    writeRadio(&w, &snapshot);
+
+    writeCapture(&w, &snapshot);
+
+    writeHistogram(&w, "multisniff_frame_bytes", "Length of frames taken from the radio queue.", STATS_HIST_FRAME_BYTES);
+
+    writeLatency(&w);
+
+    writeTasks(&w);
+
+    writeSpi(&w);
+
+    flush(&w);
+
+    //
+    // Last chunk
+    //
+    EthernetClient_write(pClient, (const uint8_t*)"0\r\n\r\n", 5);
+
+    return;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,33 @@
+/*
+ * metrics.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_HTTP_METRICS_H_
+#define SOURCE_HTTP_METRICS_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdbool.h>
+
+#include <source/ethernet/EthernetClient.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define METRICS_PATH            ("/metrics")
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void Metrics_Send(EthernetClient* pClient, bool bKeepAlive);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_HTTP_METRICS_H_ */
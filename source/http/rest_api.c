@@ -0,0 +1,979 @@
+/*
+ * rest_api.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <ctype.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <source/ethernet/Ethernet.h>
+
+#include <source/http/rest_api.h>
+
+#include <source/http/sse.h>
+
+#include <source/http/metrics.h>
+
+#include <source/html/html.h>
+
+#include <source/frame_parser/ble_parser.h>
+
+#include <source/utils/stats.h>
+
+#include <source/utils/warm_start.h>
+
+#include <source/utils/boot_profile.h>
+
+#include <source/utils/trace.h>
+
+#include <source/utils/spi_profile.h>
+
+#include <source/utils/handler_funcs.h>
+
+#include <source/config/config.h>
+
+#include <dashboard_task.h>
+
+#include <monitor_task.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define TICKS_PER_SECOND        (100000)    // Clock.tickPeriod = 10 us
+
+#define REST_API_MAX_FIELDS     (16)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct JsonWriter
+{
+    char*    pBuf;
+    uint16_t len;
+    uint16_t size;
+    bool     bFirst;
+} JsonWriter_t;
+
+/*
+ * === RestApi_ConfigField_t
+ * Maps name of a configuration field in JSON to the key
+ * used by dashboard (token dictionary, query string).
+ */
+typedef struct RestApi_ConfigField
+{
+    const char* pName;
+    char        key;
+    bool        bNumeric;
+} RestApi_ConfigField_t;
+
+typedef struct RestApi_Field
+{
+    char        key;
+    const char* pValue;
+} RestApi_Field_t;
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+//
+// Settings of CONFIG_FIELDS first, then
+// keys handled outside the config registry
+//
+#define CONFIG_X_REST(ID, Name, member, type, kind, token, pName, min, max, def)    { pName, token, (kind) != CONFIG_KIND_IP },
+
+static const RestApi_ConfigField_t configFields[] =
+{
+    CONFIG_FIELDS(CONFIG_X_REST)
+    { "triggerState",      'a', true  },
+    { "triggerPattern",    'b', false },
+    { "triggerOffset",     'i', true  },
+    { "triggerPostFrames", 'f', true  },
+    { "eventInterval",     'u', true  },
+};
+
+#undef CONFIG_X_REST
+
+#define REST_API_FIELD_COUNT    (sizeof(configFields) / sizeof(configFields[0]))
+
+static char body[REST_API_BODY_MAXLEN];
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static void jsonRaw(JsonWriter_t* pW, const char* pStr, uint16_t len)
+{
+    if ( pW->len + len > pW->size )
+    {
+        len = pW->size - pW->len;
+    }
+
+    memcpy(pW->pBuf + pW->len, pStr, len);
+
+    pW->len += len;
+
+    return;
+}
+
+static void jsonKey(JsonWriter_t* pW, const char* pName)
+{
+    jsonRaw(pW, pW->bFirst ? "\"" : ",\"", pW->bFirst ? 1 : 2);
+    jsonRaw(pW, pName, strlen(pName));
+    jsonRaw(pW, "\":", 2);
+
+    pW->bFirst = false;
+
+    return;
+}
+
+static void jsonUint(JsonWriter_t* pW, const char* pName, uint32_t value)
+{
+    char tmp[11];
+
+    jsonKey(pW, pName);
+    jsonRaw(pW, tmp, Html_FormatUint(tmp, value));
+
+    return;
+}
+
+static void jsonInt(JsonWriter_t* pW, const char* pName, int32_t value)
+{
+    char tmp[12];
+
+    jsonKey(pW, pName);
+    jsonRaw(pW, tmp, Html_FormatInt(tmp, value));
+
+    return;
+}
+
+static void jsonBool(JsonWriter_t* pW, const char* pName, bool bValue)
+{
+    jsonKey(pW, pName);
+    jsonRaw(pW, bValue ? "true" : "false", bValue ? 4 : 5);
+
+    return;
+}
+
+static void jsonString(JsonWriter_t* pW, const char* pName, const char* pValue, uint16_t len)
+{
+    uint16_t i;
+
+    jsonKey(pW, pName);
+    jsonRaw(pW, "\"", 1);
+
+    for ( i = 0; i < len; i++ )
+    {
+        if ( pValue[i] == '"' || pValue[i] == '\\' )
+        {
+            jsonRaw(pW, "\\", 1);
+        }
+
+        jsonRaw(pW, &pValue[i], 1);
+    }
+
+    jsonRaw(pW, "\"", 1);
+
+    return;
+}
+
+static void jsonBegin(JsonWriter_t* pW)
+{
+    pW->pBuf   = body;
+    pW->len    = 0;
+    pW->size   = REST_API_BODY_MAXLEN;
+    pW->bFirst = true;
+
+    jsonRaw(pW, "{", 1);
+
+    return;
+}
+
+static void jsonEnd(JsonWriter_t* pW)
+{
+    jsonRaw(pW, "}", 1);
+
+    return;
+}
+
+static uint16_t appendString(char* pDst, const char* pSrc)
+{
+    uint16_t len = strlen(pSrc);
+
+    memcpy(pDst, pSrc, len);
+
+    return len;
+}
+
+/*
+ * === sendResponse
+ * Sends status line, headers and body in a single write,
+ * i.e. a single W5500 SEND command for small responses.
+ */
+static void sendResponse(EthernetClient* pClient, const char* pStatus, const JsonWriter_t* pW, bool bKeepAlive)
+{
+    char*    pMtu = (char*)MTU_BUF_MEM_START;
+    uint16_t len  = 0;
+
+    len += appendString(pMtu + len, "HTTP/1.1 ");
+    len += appendString(pMtu + len, pStatus);
+    len += appendString(pMtu + len, "\r\nContent-Type: application/json\r\nContent-Length: ");
+    len += Html_FormatUint(pMtu + len, pW->len);
+    len += appendString(pMtu + len, bKeepAlive ? "\r\nConnection: keep-alive\r\n\r\n" : "\r\nConnection: close\r\n\r\n");
+
+    memcpy(pMtu + len, pW->pBuf, pW->len);
+
+    EthernetClient_write(pClient, (const uint8_t*)pMtu, len + pW->len);
+
+    return;
+}
+
+/*
+ * === jsonPercentiles
+ * "name":[p50,p99,max] of a histogram.
+ */
+static void jsonPercentiles(JsonWriter_t* pW, Stats_Histogram_t hist)
+{
+    Stats_HistogramData_t data;
+    const uint32_t*       pBounds = Stats_GetHistogramBounds(hist);
+    char                  tmp[11];
+
+    Stats_GetHistogram(hist, &data);
+
+    jsonKey(pW, Stats_GetHistogramName(hist));
+    jsonRaw(pW, "[", 1);
+    jsonRaw(pW, tmp, Html_FormatUint(tmp, Stats_GetPercentile(&data, pBounds, 500)));
+    jsonRaw(pW, ",", 1);
+    jsonRaw(pW, tmp, Html_FormatUint(tmp, Stats_GetPercentile(&data, pBounds, 990)));
+    jsonRaw(pW, ",", 1);
+    jsonRaw(pW, tmp, Html_FormatUint(tmp, data.max));
+    jsonRaw(pW, "]", 1);
+
+    return;
+}
+
+static void writeStats(JsonWriter_t* pW)
+{
+    Stats_Snapshot_t  snapshot;
+    Stats_Counter_t   counter;
+    Stats_Histogram_t hist;
+    uint32_t          micros;
+
+    Stats_TakeSnapshot(&snapshot);
+
+    jsonBegin(pW);
+
+    jsonUint(pW, "uptime",                snapshot.ticks / TICKS_PER_SECOND);
+    jsonUint(pW, "bleRxOk",               snapshot.bleRxOk);
+    jsonUint(pW, "bleRxNok",              snapshot.bleRxNok);
+    jsonUint(pW, "ieeeRxOk",              snapshot.ieeeRxOk);
+    jsonUint(pW, "ieeeRxNok",             snapshot.ieeeRxNok);
+    jsonInt (pW, "lastRssi",              snapshot.lastRssi);
+    jsonUint(pW, "bleRecords",            BleParser_GetRecordCount());
+    jsonUint(pW, "bleRecordsOverwritten", BleParser_GetOverwrittenCount());
+    jsonUint(pW, "restarts",              WarmStart_GetRestarts());
+    jsonBool(pW, "warmStart",             WarmStart_IsWarm());
+    jsonUint(pW, "restartToFirstFrameMs", BootProfile_Get(BOOT_PHASE_FIRST_FRAME, &micros) ? micros / 1000 : 0);
+
+    for ( counter = (Stats_Counter_t)0; counter < STATS_COUNT; counter++ )
+    {
+        jsonUint(pW, Stats_GetName(counter), snapshot.counters[counter]);
+    }
+
+    for ( hist = STATS_HIST_LATENCY_QUEUE; hist <= STATS_HIST_LATENCY_TOTAL; hist++ )
+    {
+        jsonPercentiles(pW, hist);
+    }
+
+    jsonEnd(pW);
+
+    return;
+}
+
+/*
+ * === writeBoot
+ * Boot phases in microseconds from the start of the init task,
+ * phases not reached yet are left out.
+ */
+static void writeBoot(JsonWriter_t* pW)
+{
+    BootProfile_Phase_t phase;
+    uint32_t            micros;
+
+    jsonBegin(pW);
+
+    jsonBool(pW, "warmStart", WarmStart_IsWarm());
+    jsonUint(pW, "restarts",  WarmStart_GetRestarts());
+
+    for ( phase = (BootProfile_Phase_t)0; phase < BOOT_PHASE_COUNT; phase++ )
+    {
+        if ( BootProfile_Get(phase, &micros) )
+        {
+            jsonUint(pW, BootProfile_GetName(phase), micros);
+        }
+    }
+
+    jsonEnd(pW);
+
+    return;
+}
+
+/*
+ * === writeMonitor
+ * Last sample of the monitor task. Every stack has
+ * [load %, stack size, high-water mark] (load of "hwi"
+ * is of all Hwis), stacks not created yet are left out.
+ */
+static void writeMonitor(JsonWriter_t* pW)
+{
+    Monitor_Sample_t monitor;
+    Monitor_Stack_t  stack;
+    char             tmp[11];
+
+    Monitor_GetSample(&monitor);
+
+    jsonBegin(pW);
+
+    jsonUint(pW, "cpuLoad",       monitor.cpuLoad);
+    jsonUint(pW, "swiLoad",       monitor.swiLoad);
+    jsonUint(pW, "alarms",        monitor.alarms);
+    jsonUint(pW, "headroomAlarm", MONITOR_HEADROOM_ALARM);
+
+    for ( stack = (Monitor_Stack_t)0; stack < MONITOR_STACK_COUNT; stack++ )
+    {
+        if ( monitor.stackSize[stack] == 0 )
+        {
+            continue;
+        }
+
+        jsonKey(pW, Monitor_GetStackName(stack));
+        jsonRaw(pW, "[", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, ( stack == MONITOR_STACK_HWI ) ? monitor.hwiLoad : monitor.taskLoad[stack]));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, monitor.stackSize[stack]));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, monitor.stackPeak[stack]));
+        jsonRaw(pW, "]", 1);
+    }
+
+    jsonEnd(pW);
+
+    return;
+}
+
+/*
+ * === writeTrace
+ * Trace ring counters. Built with TRACE_MEASURE, every event
+ * has [count, average cycles, max cycles] of its trace point.
+ */
+static void writeTrace(JsonWriter_t* pW)
+{
+    Trace_Event_t id;
+    Trace_Cost_t  cost;
+    char          tmp[11];
+
+    jsonBegin(pW);
+
+    jsonUint(pW, "level",   TRACE_LEVEL);
+    jsonUint(pW, "written", Trace_GetWritten());
+    jsonUint(pW, "dropped", Trace_GetDropped());
+
+    for ( id = (Trace_Event_t)0; id < TRACE_EVENT_COUNT; id++ )
+    {
+        if ( !Trace_GetCost(id, &cost) )
+        {
+            break;
+        }
+
+        jsonKey(pW, Trace_GetName(id));
+        jsonRaw(pW, "[", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, cost.count));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, cost.count ? cost.cycles / cost.count : 0));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, cost.maxCycles));
+        jsonRaw(pW, "]", 1);
+    }
+
+    jsonEnd(pW);
+
+    return;
+}
+
+/*
+ * === writeSpi
+ * W5500 SPI traffic per caller category since the counters were
+ * last cleared (windowMs). Every category has [frames (CS
+ * assertions), SPI transfers, bytes, busy us, longest frame us,
+ * busy permille of the window]. Built without SPI_PROFILE, only
+ * "enabled": false is sent.
+ */
+static void writeSpi(JsonWriter_t* pW, bool bClear)
+{
+    SpiProfile_Snapshot_t  snapshot;
+    SpiProfile_Category_t  category;
+    SpiProfile_Counters_t* pCounters;
+    uint64_t               windowCycles;
+    char                   tmp[11];
+
+    jsonBegin(pW);
+
+    if ( !SpiProfile_TakeSnapshot(&snapshot, bClear) )
+    {
+        jsonBool(pW, "enabled", false);
+
+        jsonEnd(pW);
+
+        return;
+    }
+
+    jsonBool(pW, "enabled",  true);
+    jsonUint(pW, "windowMs", snapshot.ticks / ( TICKS_PER_SECOND / 1000 ));
+
+    windowCycles = (uint64_t)snapshot.ticks * ( TRACE_CPU_HZ / TICKS_PER_SECOND );
+
+    for ( category = (SpiProfile_Category_t)0; category < SPI_PROFILE_CATEGORY_COUNT; category++ )
+    {
+        pCounters = &snapshot.categories[category];
+
+        jsonKey(pW, SpiProfile_GetName(category));
+        jsonRaw(pW, "[", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, pCounters->frames));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, pCounters->transfers));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, pCounters->bytes));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, (uint32_t)( pCounters->cycles / ( TRACE_CPU_HZ / 1000000 ) )));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, pCounters->maxCycles / ( TRACE_CPU_HZ / 1000000 )));
+        jsonRaw(pW, ",", 1);
+        jsonRaw(pW, tmp, Html_FormatUint(tmp, windowCycles ? (uint32_t)( pCounters->cycles * 1000 / windowCycles ) : 0));
+        jsonRaw(pW, "]", 1);
+    }
+
+    jsonEnd(pW);
+
+    return;
+}
+
+static void writeConfig(JsonWriter_t* pW)
+{
+    const char* pValue;
+    uint8_t     len;
+    uint8_t     i;
+
+    //
+    // Values are formatted for the dashboard,
+    // reuse them rather than format them twice
+    //
+    UpdateDashboardInfo();
+
+    jsonBegin(pW);
+
+    for ( i = 0; i < REST_API_FIELD_COUNT; i++ )
+    {
+        pValue = Html_GetKeyValue(configFields[i].key, &len);
+
+        if ( configFields[i].bNumeric && len )
+        {
+            jsonKey(pW, configFields[i].pName);
+            jsonRaw(pW, pValue, len);
+        }
+        else
+        {
+            jsonString(pW, configFields[i].pName, pValue, len);
+        }
+    }
+
+    jsonEnd(pW);
+
+    return;
+}
+
+/*
+ * === lookupKey
+ * Translates field name to dashboard key. Besides names
+ * from configFields, the one-letter keys are accepted too.
+ */
+static char lookupKey(const char* pName, uint16_t len)
+{
+    uint8_t i;
+
+    for ( i = 0; i < REST_API_FIELD_COUNT; i++ )
+    {
+        if ( strlen(configFields[i].pName) == len && strncmp(configFields[i].pName, pName, len) == 0 )
+        {
+            return configFields[i].key;
+        }
+
+        if ( len == 1 && *pName == configFields[i].key )
+        {
+            return configFields[i].key;
+        }
+    }
+
+    return '\0';
+}
+
+static char* skipWhitespace(char* p)
+{
+    while ( *p && isspace((unsigned char)*p) )
+    {
+        p++;
+    }
+
+    return p;
+}
+
+/*
+ * === parseJson
+ * Parses flat JSON object ({"name": "value" | number | true | false, ...})
+ * in place. Values are '\0' terminated within the body, true/false
+ * are translated to "1"/"0" as used by the dashboard.
+ *
+ * Returns:
+ *      number of fields, -1 when body is malformed or field is unknown
+ */
+static int8_t parseJson(char* p, RestApi_Field_t* pFields)
+{
+    int8_t   count = 0;
+    char*    pName;
+    uint16_t nameLen;
+    char     next;
+
+    p = skipWhitespace(p);
+
+    if ( *p++ != '{' )
+    {
+        return -1;
+    }
+
+    for (;;)
+    {
+        p = skipWhitespace(p);
+
+        if ( *p == '}' )
+        {
+            return count;
+        }
+
+        if ( *p++ != '"' || count == REST_API_MAX_FIELDS )
+        {
+            return -1;
+        }
+
+        pName = p;
+
+        while ( *p && *p != '"' ) p++;
+
+        if ( *p == '\0' )
+        {
+            return -1;
+        }
+
+        nameLen = p - pName;
+
+        pFields[count].key = lookupKey(pName, nameLen);
+
+        p = skipWhitespace(p + 1);
+
+        if ( pFields[count].key == '\0' || *p++ != ':' )
+        {
+            return -1;
+        }
+
+        p = skipWhitespace(p);
+
+        if ( *p == '"' )
+        {
+            pFields[count].pValue = ++p;
+
+            while ( *p && *p != '"' ) p++;
+
+            if ( *p == '\0' )
+            {
+                return -1;
+            }
+
+            *p = '\0';
+
+            p = skipWhitespace(p + 1);
+
+            next = *p;
+        }
+        else
+        {
+            pFields[count].pValue = p;
+
+            while ( *p && *p != ',' && *p != '}' && !isspace((unsigned char)*p) ) p++;
+
+            if ( p == pFields[count].pValue )
+            {
+                return -1;
+            }
+
+            //
+            // Terminator overwrites the delimiter, remember it
+            //
+            next = *p;
+
+            *p = '\0';
+
+            if ( isspace((unsigned char)next) )
+            {
+                p = skipWhitespace(p + 1);
+
+                next = *p;
+            }
+
+            if ( strcmp(pFields[count].pValue, "true") == 0 )
+            {
+                pFields[count].pValue = "1";
+            }
+            else if ( strcmp(pFields[count].pValue, "false") == 0 )
+            {
+                pFields[count].pValue = "0";
+            }
+        }
+
+        count++;
+
+        if ( next == '}' )
+        {
+            return count;
+        }
+
+        if ( next != ',' )
+        {
+            return -1;
+        }
+
+        p++;
+    }
+}
+
+/*
+ * === parseForm
+ * Parses "k=v&k=v" body (same keys as query string of the dashboard).
+ *
+ * Returns:
+ *      number of fields, -1 when body is malformed or key is unknown
+ */
+static int8_t parseForm(char* p, RestApi_Field_t* pFields)
+{
+    int8_t count = 0;
+    char*  pName;
+    char*  pValue;
+
+    while ( HttpReader_NextParam(&p, &pName, &pValue) )
+    {
+        if ( count == REST_API_MAX_FIELDS )
+        {
+            return -1;
+        }
+
+        pFields[count].key = lookupKey(pName, strlen(pName));
+
+        if ( pFields[count].key == '\0' )
+        {
+            return -1;
+        }
+
+        pFields[count].pValue = pValue;
+
+        count++;
+    }
+
+    return count;
+}
+
+static void handleConfigPost(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    RestApi_Field_t fields[REST_API_MAX_FIELDS];
+    JsonWriter_t    w;
+    char*           pBody;
+    int8_t          count;
+    int8_t          i;
+    Config_Id_t     id;
+    uint32_t        value;
+
+    if ( HttpReader_ReadBody(pClient, pRequest) != HTTP_READER_OK )
+    {
+        pRequest->bKeepAlive = false;
+
+        RestApi_SendError(pClient, "413 Payload Too Large", "body", false);
+
+        return;
+    }
+
+    pBody = pRequest->buf + pRequest->headerLen;
+
+    count = ( *skipWhitespace(pBody) == '{' ) ? parseJson(pBody, fields) : parseForm(pBody, fields);
+
+    if ( count < 0 )
+    {
+        RestApi_SendError(pClient, "400 Bad Request", "malformed or unknown field", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    //
+    // Settings are checked before anything is applied
+    //
+    for ( i = 0; i < count; i++ )
+    {
+        id = Config_FindToken(fields[i].key);
+
+        if ( id != CONFIG_NO_FIELD && !Config_Parse(id, fields[i].pValue, &value) )
+        {
+            RestApi_SendError(pClient, "400 Bad Request", "invalid value", pRequest->bKeepAlive);
+
+            return;
+        }
+    }
+
+    Config_BeginUpdate();
+
+    for ( i = 0; i < count; i++ )
+    {
+        SetStatusProperty(fields[i].key, fields[i].pValue);
+    }
+
+    Config_EndUpdate();
+
+    Config_Commit();
+
+    writeConfig(&w);
+
+    sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+
+    return;
+}
+
+static void handleStats(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    JsonWriter_t w;
+
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    writeStats(&w);
+
+    sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+
+    return;
+}
+
+static void handleBoot(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    JsonWriter_t w;
+
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    writeBoot(&w);
+
+    sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+
+    return;
+}
+
+static void handleMonitor(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    JsonWriter_t w;
+
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    writeMonitor(&w);
+
+    sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+
+    return;
+}
+
+static void handleTrace(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    JsonWriter_t w;
+
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    writeTrace(&w);
+
+    sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+
+    return;
+}
+
+/*
+ * === handleSpi
+ * "?clear" in the query starts a new window
+ * after the snapshot is taken.
+ */
+static void handleSpi(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    JsonWriter_t w;
+
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    writeSpi(&w, strncmp(pRequest->pQuery, "clear", 5) == 0);
+
+    sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+
+    return;
+}
+
+static void handleConfig(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    JsonWriter_t w;
+
+    if ( pRequest->method == HTTP_METHOD_POST )
+    {
+        handleConfigPost(pClient, pRequest);
+    }
+    else if ( pRequest->method == HTTP_METHOD_GET )
+    {
+        writeConfig(&w);
+
+        sendResponse(pClient, "200 OK", &w, pRequest->bKeepAlive);
+    }
+    else
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+    }
+
+    return;
+}
+
+static void handleEvents(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    pRequest->bKeepAlive = false;
+
+    Sse_Attach(pClient);
+
+    return;
+}
+
+static void handleMetrics(EthernetClient* pClient, HttpRequest_t* pRequest)
+{
+    if ( pRequest->method != HTTP_METHOD_GET )
+    {
+        RestApi_SendError(pClient, "405 Method Not Allowed", "method", pRequest->bKeepAlive);
+
+        return;
+    }
+
+    Metrics_Send(pClient, pRequest->bKeepAlive);
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === RestApi_Init
+ * Registers JSON API routes:
+ *      GET  /api/stats     - counters
+ *      GET  /api/boot      - boot phase timestamps (boot_profile.h)
+ *      GET  /api/monitor   - CPU load and stack high-water marks (monitor_task.h)
+ *      GET  /api/trace     - trace ring counters, per-point cost (trace.h)
+ *      GET  /api/spi       - W5500 SPI traffic per caller (spi_profile.h),
+ *                            "?clear" starts a new window
+ *      GET  /api/config    - configuration
+ *      POST /api/config    - change configuration, body is either a flat
+ *                            JSON object or "k=v&..." form, response
+ *                            holds updated configuration
+ *      GET  /api/events    - event stream of counter deltas, the socket
+ *                            is handed over to sse.c
+ *      GET  /metrics       - Prometheus text format (metrics.c)
+ * Responses carry Content-Length (or are chunked), so the connection
+ * can be kept open (pRequest->bKeepAlive) and reused by the client for
+ * the next request.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void RestApi_Init(void)
+{
+    HandlerFuncs_RegisterRoute("/api/stats",  &handleStats);
+
+    HandlerFuncs_RegisterRoute("/api/boot",   &handleBoot);
+
+    HandlerFuncs_RegisterRoute("/api/monitor", &handleMonitor);
+
+    HandlerFuncs_RegisterRoute("/api/trace",  &handleTrace);
+
+    HandlerFuncs_RegisterRoute("/api/spi",    &handleSpi);
+
+    HandlerFuncs_RegisterRoute("/api/config", &handleConfig);
+
+    HandlerFuncs_RegisterRoute(SSE_PATH,      &handleEvents);
+
+    HandlerFuncs_RegisterRoute(METRICS_PATH,  &handleMetrics);
+
+    return;
+}
+
+
+void RestApi_SendError(EthernetClient* pClient, const char* pStatus, const char* pMessage, bool bKeepAlive)
+{
+    JsonWriter_t w;
+
+    jsonBegin(&w);
+    jsonString(&w, "error", pMessage, strlen(pMessage));
+    jsonEnd(&w);
+
+    sendResponse(pClient, pStatus, &w, bKeepAlive);
+
+    return;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,35 @@
+/*
+ * rest_api.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_HTTP_REST_API_H_
+#define SOURCE_HTTP_REST_API_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdbool.h>
+
+#include <source/http/http_reader.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define REST_API_BODY_MAXLEN    (768)
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void RestApi_Init(void);
+
+void RestApi_SendError(EthernetClient* pClient, const char* pStatus, const char* pMessage, bool bKeepAlive);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_HTTP_REST_API_H_ */
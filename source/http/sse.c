@@ -0,0 +1,323 @@
+/*
+ * sse.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <ti/sysbios/BIOS.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <source/driverlib/w5500/w5500.h>
+
+#include <source/ethernet/Ethernet.h>
+
+#include <source/ethernet/EthernetIrq.h>
+
+#include <source/http/sse.h>
+
+#include <source/html/html.h>
+
+#include <source/utils/stats.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define TICKS_PER_MS            (100)       // Clock.tickPeriod = 10 us
+
+#define SSE_RETRY_MS            ("3000")    // browser reconnect delay
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static EthernetClient   sseClient = { ._sock = MAX_SOCK_NUM };
+
+static uint16_t         intervalMs = SSE_INTERVAL_DEFAULT_MS;
+
+/*
+ * === lastSnapshot
+ * Counters as of the last event,
+ * deltas are computed against it.
+ */
+static Stats_Snapshot_t lastSnapshot;
+
+//
+// Subscriber disconnected (DISCON/TIMEOUT interrupt)
+//
+static bool             bClosed = false;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint16_t appendString(char* pDst, const char* pSrc)
+{
+    uint16_t len = strlen(pSrc);
+
+    memcpy(pDst, pSrc, len);
+
+    return len;
+}
+
+static uint16_t appendUint(char* pDst, const char* pName, uint32_t value)
+{
+    uint16_t len = 0;
+
+    len += appendString(pDst + len, ",\"");
+    len += appendString(pDst + len, pName);
+    len += appendString(pDst + len, "\":");
+    len += Html_FormatUint(pDst + len, value);
+
+    return len;
+}
+
+/*
+ * === delta
+ * Counters only grow, unless the RF driver restarted them
+ * (protocol change). Count from zero then.
+ */
+static uint32_t delta(uint32_t current, uint32_t previous)
+{
+    return ( current >= previous ) ? current - previous : current;
+}
+
+/*
+ * === formatEvent
+ * Formats one event into MTU buffer. With pPrevious == NULL
+ * absolute values are sent ("snapshot" event), otherwise
+ * differences against pPrevious and time elapsed ("dt", ms).
+ * Field names follow GET /api/stats.
+ *
+ * Returns:
+ *      length of the event
+ */
+static uint16_t formatEvent(const Stats_Snapshot_t* pCurrent, const Stats_Snapshot_t* pPrevious)
+{
+    static const Stats_Snapshot_t zero;
+
+    char*           pMtu  = (char*)MTU_BUF_MEM_START;
+    uint16_t        len   = 0;
+    Stats_Counter_t counter;
+
+    if ( pPrevious == NULL )
+    {
+        len += appendString(pMtu + len, "event: snapshot\ndata: {\"dt\":0");
+
+        pPrevious = &zero;
+    }
+    else
+    {
+        len += appendString(pMtu + len, "data: {\"dt\":");
+        len += Html_FormatUint(pMtu + len, ( pCurrent->ticks - pPrevious->ticks ) / TICKS_PER_MS);
+    }
+
+    len += appendUint(pMtu + len, "bleRxOk",   delta(pCurrent->bleRxOk,   pPrevious->bleRxOk));
+    len += appendUint(pMtu + len, "bleRxNok",  delta(pCurrent->bleRxNok,  pPrevious->bleRxNok));
+    len += appendUint(pMtu + len, "ieeeRxOk",  delta(pCurrent->ieeeRxOk,  pPrevious->ieeeRxOk));
+    len += appendUint(pMtu + len, "ieeeRxNok", delta(pCurrent->ieeeRxNok, pPrevious->ieeeRxNok));
+
+    for ( counter = (Stats_Counter_t)0; counter < STATS_COUNT; counter++ )
+    {
+        len += appendUint(pMtu + len, Stats_GetName(counter), delta(pCurrent->counters[counter], pPrevious->counters[counter]));
+    }
+
+    len += appendString(pMtu + len, ",\"lastRssi\":");
+    len += Html_FormatInt(pMtu + len, pCurrent->lastRssi);
+    len += appendString(pMtu + len, "}\n\n");
+
+    return len;
+}
+
+static void detach(void)
+{
+    uint8_t sock = sseClient._sock;
+
+    EthernetClient_stop(&sseClient);
+
+    EthernetIrq_Unregister(sock);
+
+    bClosed = false;
+
+    return;
+}
+
+
+static void onSocketEvent(uint8_t sock, uint8_t events)
+{
+    bClosed = true;
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Sse_Attach
+ * Turns connection which requested GET /api/events into an event
+ * stream. Response headers and the first event carrying absolute
+ * counter values are sent right away, then Sse_Service() pushes
+ * counter deltas every interval.
+ *
+ * Socket is taken out of the HTTP server (Ethernet_server_port),
+ * so the server neither returns it as a new client nor closes it
+ * while accepting. Only one stream is kept, a new subscriber
+ * replaces the previous one.
+ *
+ * Parameters:
+ *      pClient[in/out]     - connected client, invalidated on return
+ *                            (socket belongs to the stream now)
+ * Returns:
+ *      N/A
+ */
+void Sse_Attach(EthernetClient* pClient)
+{
+    char*    pMtu = (char*)MTU_BUF_MEM_START;
+    uint16_t len  = 0;
+
+    if ( Sse_IsAttached() )
+    {
+        detach();
+    }
+
+    sseClient = *pClient;
+
+    pClient->_sock = MAX_SOCK_NUM;
+
+    Ethernet_server_port[sseClient._sock] = 0;
+
+    EthernetIrq_Register(sseClient._sock, ETHIRQ_DISCON | ETHIRQ_TIMEOUT, onSocketEvent);
+
+    len += appendString(pMtu + len, "HTTP/1.1 200 OK\r\nContent-Type: text/event-stream\r\nCache-Control: no-cache\r\nConnection: keep-alive\r\n\r\nretry: ");
+    len += appendString(pMtu + len, SSE_RETRY_MS);
+    len += appendString(pMtu + len, "\n");
+
+    Stats_TakeSnapshot(&lastSnapshot);
+
+    len += formatEvent(&lastSnapshot, NULL);
+
+    if ( EthernetClient_write(&sseClient, (const uint8_t*)pMtu, len) != len )
+    {
+        detach();
+    }
+
+    return;
+}
+
+
+bool Sse_IsAttached(void)
+{
+    return ( sseClient._sock != MAX_SOCK_NUM );
+}
+
+
+/*
+ * === Sse_Service
+ * Sends an event with counter deltas when the interval elapsed.
+ * Stream is dropped when the subscriber went away (reported
+ * by socket interrupt, status is not polled) or the event
+ * could not be sent.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      N/A
+ */
+void Sse_Service(void)
+{
+    Stats_Snapshot_t snapshot;
+    uint16_t         len;
+
+    if ( !Sse_IsAttached() )
+    {
+        return;
+    }
+
+    if ( bClosed )
+    {
+        detach();
+
+        return;
+    }
+
+    if ( Sse_GetPendTimeout() != 0 )
+    {
+        return;
+    }
+
+    Stats_TakeSnapshot(&snapshot);
+
+    len = formatEvent(&snapshot, &lastSnapshot);
+
+    lastSnapshot = snapshot;
+
+    if ( EthernetClient_write(&sseClient, (const uint8_t*)MTU_BUF_MEM_START, len) != len )
+    {
+        detach();
+    }
+
+    return;
+}
+
+
+/*
+ * === Sse_GetPendTimeout
+ * How long the dashboard task may block before the next event is due.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      uint32_t            - Clock ticks, 0 when the event is due,
+ *                            BIOS_WAIT_FOREVER when nobody subscribed
+ */
+uint32_t Sse_GetPendTimeout(void)
+{
+    uint32_t elapsed;
+    uint32_t interval = (uint32_t)intervalMs * TICKS_PER_MS;
+
+    if ( !Sse_IsAttached() )
+    {
+        return BIOS_WAIT_FOREVER;
+    }
+
+    elapsed = Clock_getTicks() - lastSnapshot.ticks;
+
+    return ( elapsed >= interval ) ? 0 : interval - elapsed;
+}
+
+
+void Sse_SetInterval(uint16_t ms)
+{
+    if ( ms < SSE_INTERVAL_MIN_MS )
+    {
+        ms = SSE_INTERVAL_MIN_MS;
+    }
+    else if ( ms > SSE_INTERVAL_MAX_MS )
+    {
+        ms = SSE_INTERVAL_MAX_MS;
+    }
+
+    intervalMs = ms;
+
+    return;
+}
+
+
+uint16_t Sse_GetInterval(void)
+{
+    return intervalMs;
+}
+
+// ==============================================================================================================
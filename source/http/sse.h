@@ -0,0 +1,52 @@
+/*
+ * sse.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_HTTP_SSE_H_
+#define SOURCE_HTTP_SSE_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <source/ethernet/EthernetClient.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define SSE_PATH                ("/api/events")
+
+//
+// Push interval limits, in milliseconds
+//
+#define SSE_INTERVAL_MIN_MS     (100)
+#define SSE_INTERVAL_MAX_MS     (60000)
+#define SSE_INTERVAL_DEFAULT_MS (1000)
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void     Sse_Attach(EthernetClient* pClient);
+
+bool     Sse_IsAttached(void);
+
+void     Sse_Service(void);
+
+uint32_t Sse_GetPendTimeout(void);
+
+void     Sse_SetInterval(uint16_t ms);
+
+uint16_t Sse_GetInterval(void);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_HTTP_SSE_H_ */
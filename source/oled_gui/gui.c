@@ -13,12 +13,64 @@
 
 #include <string.h>
 
+#include <ti/sysbios/BIOS.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <ti/sysbios/knl/Mailbox.h>
+
 #include <source/driverlib/ssd1306/ssd1306.h>
 
 #include <source/driverlib/ssd1306/font.h>
 
 #include <source/oled_gui/gui.h>
 
+#include <source/utils/boot_profile.h>
+
+// ==============================================================================================================
+
+// === DEFINES ==================================================================================================
+
+#define TICKS_PER_MS            (100)       // Clock.tickPeriod = 10 us
+
+#define REFRESH_PERIOD          ((1000 / GUI_REFRESH_PER_S) * TICKS_PER_MS)
+
+// ==============================================================================================================
+
+// === ENUM DEFINITIONS =========================================================================================
+
+typedef enum GUI_Field
+{
+    GUI_FIELD_DEVICE_IP = 0,
+    GUI_FIELD_TARGET_IP,
+    GUI_FIELD_PROTO,
+    GUI_FIELD_RX,
+    GUI_FIELD_CHANNEL,
+    GUI_FIELD_MONITOR,
+    GUI_FIELD_COUNT,
+    GUI_FIELD_UPDATED = GUI_FIELD_COUNT     // screen update completed, value is its status
+} GUI_Field_t;
+
+// ==============================================================================================================
+
+// === STATIC VARIABLES =========================================================================================
+
+extern Mailbox_Handle GUI_MailboxHandle;
+
+//
+// Latest change of each field not shown yet,
+// owned by the GUI task
+//
+static GUI_Message_t pending[GUI_FIELD_COUNT];
+
+static uint8_t       pendingMask;
+
+//
+// Last update failed, SSD1306 keeps
+// the pages marked for the next one
+//
+static bool          bRetry;
+
 // ==============================================================================================================
 
 // === INTERNAL FUNCTIONS =======================================================================================
@@ -43,12 +95,8 @@ static inline void ito2a(uint8_t i, char* ch)
     return;
 }
 
-// ==============================================================================================================
-
-// === PUBLISHED FUNCTIONS ======================================================================================
-
 /*
- * === GUI_Init
+ * === initScreen
  * Firstly calls SSD1306_Init() to perform SSD1306 initialization sequence.
  * Then renders basic GUI structure based on /design/ssd1306_design.xlsx.
  * Note: Does NOT update the screen (since it does not print any important
@@ -59,7 +107,7 @@ static inline void ito2a(uint8_t i, char* ch)
  * Returns:
  *      //TODO: return status?
  */
-void GUI_Init(void)
+static void initScreen(void)
 {
     SSD1306_Init();
 
@@ -97,8 +145,8 @@ void GUI_Init(void)
 }
 
 /*
- * === GUI_ChangeDeviceIp
- * Changes the `deice IP:` field in the GUI of the OLED.
+ * === drawDeviceIp
+ * Draws the `deice IP:` field in the GUI of the OLED.
  *
  * Parameters:
  *      deiceIp[in]   - pointer to new IP address
@@ -106,7 +154,7 @@ void GUI_Init(void)
  * Returns:
  *      N/A
  */
-void GUI_ChangeDeviceIp(const char *deviceIp)
+static void drawDeviceIp(const char *deviceIp)
 {
     SSD1306_SetPosition(0, 2);
 
@@ -118,14 +166,12 @@ void GUI_ChangeDeviceIp(const char *deviceIp)
 
     SSD1306_DrawLine(0, HORIZ_CHARS_TO_PIX(15), VERTI_CHARS_TO_PIX(3), VERTI_CHARS_TO_PIX(3));
 
-    SSD1306_UpdateScreen();
-
     return;
 }
 
 /*
- * === GUI_ChangeTargetIp
- * Changes the `target IP:` field in the GUI of the OLED.
+ * === drawTargetIp
+ * Draws the `target IP:` field in the GUI of the OLED.
  *
  * Parameters:
  *      targetIp[in]  - pointer to new IP address
@@ -133,7 +179,7 @@ void GUI_ChangeDeviceIp(const char *deviceIp)
  * Returns:
  *      N/A
  */
-void GUI_ChangeTargetIp(const char *targetIp)
+static void drawTargetIp(const char *targetIp)
 {
     SSD1306_SetPosition(0, 4);
 
@@ -145,14 +191,12 @@ void GUI_ChangeTargetIp(const char *targetIp)
 
     SSD1306_DrawLine(0, HORIZ_CHARS_TO_PIX(15), VERTI_CHARS_TO_PIX(5), VERTI_CHARS_TO_PIX(5));
 
-    SSD1306_UpdateScreen();
-
     return;
 }
 
 /*
- * === GUI_ChangeProto
- * Changes the `proto:` field in the GUI of the OLED.
+ * === drawProto
+ * Draws the `proto:` field in the GUI of the OLED.
  *
  * Parameters:
  *      proto[in]   - unsigned integer representing protocol
@@ -161,7 +205,7 @@ void GUI_ChangeTargetIp(const char *targetIp)
  * Returns:
  *      N/A
  */
-void GUI_ChangeProto(uint8_t proto)
+static void drawProto(uint8_t proto)
 {
     SSD1306_SetPosition(0, 6);
 
@@ -184,14 +228,12 @@ void GUI_ChangeProto(uint8_t proto)
         break;
     }
 
-    SSD1306_UpdateScreen();
-
     return;
 }
 
 /*
- * === GUI_ChangeRx
- * Changes the `RX:` field in the GUI of the OLED.
+ * === drawRx
+ * Draws the `RX:` field in the GUI of the OLED.
  *
  * Parameters:
  *      rx[in]  - bool value
@@ -202,7 +244,7 @@ void GUI_ChangeProto(uint8_t proto)
  * Returns:
  *      N/A
  */
-void GUI_ChangeRx(bool rx)
+static void drawRx(bool rx)
 {
     SSD1306_SetPosition(HORIZ_CHARS_TO_PIX(12), 5);
 
@@ -212,21 +254,19 @@ void GUI_ChangeRx(bool rx)
 
     SSD1306_DrawString((rx ? "ON" : "OFF"), !rx);
 
-    SSD1306_UpdateScreen();
-
     return;
 }
 
 /*
- * === GUI_ChangeChannel
- * Changes the `CH:` field in the GUI of the OLED.
+ * === drawChannel
+ * Draws the `CH:` field in the GUI of the OLED.
  *
  * Parameters:
  *      ch[in]   - unsigned int representing number of the channel
  * Returns:
  *      N/A
  */
-void GUI_ChangeChannel(uint8_t ch)
+static void drawChannel(uint8_t ch)
 {
     SSD1306_SetPosition(HORIZ_CHARS_TO_PIX(12), 6);
 
@@ -242,7 +282,380 @@ void GUI_ChangeChannel(uint8_t ch)
 
     SSD1306_DrawString(buf, false);
 
-    SSD1306_UpdateScreen();
+    return;
+}
+
+/*
+ * === drawMonitor
+ * Draws the `CPU` and `STK` fields right of the vertical line.
+ * Nothing is drawn when the shown values do not change.
+ *
+ * Parameters:
+ *      cpuLoad[in]     - CPU load in percent
+ *      bStackLow[in]   - a stack has little headroom, `LOW`
+ *                        is shown inverted then
+ * Returns:
+ *      N/A
+ */
+static void drawMonitor(uint8_t cpuLoad, bool bStackLow)
+{
+    static uint8_t shownLoad    = 0xFF;
+    static bool    bShownLow    = false;
+    static bool    bLabelsDrawn = false;
+
+    char buf[5];
+
+    if ( cpuLoad == shownLoad && bStackLow == bShownLow && bLabelsDrawn )
+    {
+        return;
+    }
+
+    if ( !bLabelsDrawn )
+    {
+        SSD1306_SetPosition(HORIZ_CHARS_TO_PIX(16), 1);
+
+        SSD1306_DrawString("CPU", false);
+
+        SSD1306_SetPosition(HORIZ_CHARS_TO_PIX(16), 3);
+
+        SSD1306_DrawString("STK", false);
+
+        bLabelsDrawn = true;
+    }
+
+    if ( cpuLoad >= 100 )
+    {
+        memcpy(buf, "100%", 5);
+    }
+    else
+    {
+        ito2a(cpuLoad, buf);
+
+        buf[2] = '%';
+        buf[3] = ' ';
+        buf[4] = '\0';
+    }
+
+    SSD1306_SetPosition(HORIZ_CHARS_TO_PIX(16), 2);
+
+    SSD1306_DrawString(buf, false);
+
+    SSD1306_SetPosition(HORIZ_CHARS_TO_PIX(16), 4);
+
+    SSD1306_DrawString(( bStackLow ? "LOW" : "ok " ), bStackLow);
+
+    shownLoad = cpuLoad;
+    bShownLow = bStackLow;
+
+    return;
+}
+
+/*
+ * === post
+ * Hands a change over to the GUI task. Never waits, the change is
+ * dropped when GUI_MAILBOX_DEPTH messages wait already.
+ */
+static void post(const GUI_Message_t* pMsg)
+{
+    Mailbox_post(GUI_MailboxHandle, (Ptr)pMsg, BIOS_NO_WAIT);
+
+    return;
+}
+
+/*
+ * === onUpdateDone
+ * Completion of a screen update (Swi context), wakes up the GUI task.
+ */
+static void onUpdateDone(uint8_t status)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_UPDATED, .value = status };
+
+    post(&msg);
+
+    return;
+}
+
+/*
+ * === merge
+ * Keeps the latest change of each field until it is drawn.
+ */
+static void merge(const GUI_Message_t* pMsg)
+{
+    if ( pMsg->field == GUI_FIELD_UPDATED )
+    {
+        if ( pMsg->value != SSD1306_SUCCESS )
+        {
+            bRetry = true;
+        }
+
+        return;
+    }
+
+    if ( pMsg->field < GUI_FIELD_COUNT )
+    {
+        pending[pMsg->field] = *pMsg;
+
+        pendingMask |= ( 1 << pMsg->field );
+    }
 
     return;
 }
+
+/*
+ * === drawPending
+ * Draws the fields changed since the last update into LCD buffer.
+ */
+static void drawPending(void)
+{
+    uint8_t field;
+
+    for ( field = 0; field < GUI_FIELD_COUNT; field++ )
+    {
+        if ( !( pendingMask & ( 1 << field ) ) )
+        {
+            continue;
+        }
+
+        switch ( field )
+        {
+        case GUI_FIELD_DEVICE_IP:
+            drawDeviceIp(pending[field].text);
+            break;
+
+        case GUI_FIELD_TARGET_IP:
+            drawTargetIp(pending[field].text);
+            break;
+
+        case GUI_FIELD_PROTO:
+            drawProto(pending[field].value);
+            break;
+
+        case GUI_FIELD_RX:
+            drawRx(pending[field].value != 0);
+            break;
+
+        case GUI_FIELD_CHANNEL:
+            drawChannel(pending[field].value);
+            break;
+
+        case GUI_FIELD_MONITOR:
+            drawMonitor(pending[field].value, pending[field].bFlag);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    pendingMask = 0;
+
+    return;
+}
+
+// ==============================================================================================================
+
+// === MAIN TASK FUNCTION =======================================================================================
+
+/*
+ * === GUI_Main
+ * Owns the OLED: initializes it, then takes changes posted by
+ * GUI_Change* from GUI_MailboxHandle, merges them and updates the
+ * screen at most GUI_REFRESH_PER_S times per second. A change coming
+ * after a quiet period is shown at once. I2C runs in callback mode,
+ * the task sleeps while an update is on the bus and is woken up by
+ * its completion, other tasks never wait for the OLED.
+ */
+void GUI_Main(UArg a0, UArg a1)
+{
+    GUI_Message_t msg;
+    UInt32        nextRefresh;
+    UInt32        timeout;
+    Int32         wait;
+
+    initScreen();
+
+    BootProfile_Mark(BOOT_PHASE_OLED);
+
+    nextRefresh = Clock_getTicks();
+
+    for (;;)
+    {
+        //
+        // Completion message wakes the task up during an update,
+        // the timeout covers it being dropped (mailbox full)
+        //
+        if ( SSD1306_IsUpdating() )
+        {
+            timeout = REFRESH_PERIOD;
+        }
+        else if ( pendingMask != 0 || bRetry )
+        {
+            wait    = (Int32)( nextRefresh - Clock_getTicks() );
+            timeout = ( wait > 0 ) ? (UInt32)wait : BIOS_NO_WAIT;
+        }
+        else
+        {
+            timeout = BIOS_WAIT_FOREVER;
+        }
+
+        if ( Mailbox_pend(GUI_MailboxHandle, &msg, timeout) )
+        {
+            do
+            {
+                merge(&msg);
+            }
+            while ( Mailbox_pend(GUI_MailboxHandle, &msg, BIOS_NO_WAIT) );
+        }
+
+        if ( ( pendingMask == 0 && !bRetry ) || SSD1306_IsUpdating() ||
+             (Int32)( Clock_getTicks() - nextRefresh ) < 0 )
+        {
+            continue;
+        }
+
+        drawPending();
+
+        bRetry = false;
+
+        nextRefresh = Clock_getTicks() + REFRESH_PERIOD;
+
+        SSD1306_BeginUpdate(onUpdateDone);
+    }
+}
+
+// ==============================================================================================================
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === GUI_IsIdle
+ * Returns:
+ *      true when no change waits to be shown and no screen
+ *      update is in flight
+ */
+bool GUI_IsIdle(void)
+{
+    return ( Mailbox_getNumPendingMsgs(GUI_MailboxHandle) == 0 ) && ( pendingMask == 0 ) &&
+           !bRetry && !SSD1306_IsUpdating();
+}
+
+/*
+ * === GUI_ChangeDeviceIp
+ * Changes the `deice IP:` field in the GUI of the OLED. Like all
+ * GUI_Change* it only posts the change to the GUI task and returns.
+ *
+ * Parameters:
+ *      deiceIp[in]   - pointer to new IP address
+ *                      in const char* format
+ * Returns:
+ *      N/A
+ */
+void GUI_ChangeDeviceIp(const char *deviceIp)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_DEVICE_IP };
+
+    strncpy(msg.text, deviceIp, GUI_TEXT_SIZE - 1);
+
+    post(&msg);
+
+    return;
+}
+
+/*
+ * === GUI_ChangeTargetIp
+ * Changes the `target IP:` field in the GUI of the OLED.
+ *
+ * Parameters:
+ *      targetIp[in]  - pointer to new IP address
+ *                      in const char* format
+ * Returns:
+ *      N/A
+ */
+void GUI_ChangeTargetIp(const char *targetIp)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_TARGET_IP };
+
+    strncpy(msg.text, targetIp, GUI_TEXT_SIZE - 1);
+
+    post(&msg);
+
+    return;
+}
+
+/*
+ * === GUI_ChangeProto
+ * Changes the `proto:` field in the GUI of the OLED.
+ *
+ * Parameters:
+ *      proto[in]   - unsigned integer representing protocol
+ *                    0 for BLE
+ *                    1 for IEEE
+ * Returns:
+ *      N/A
+ */
+void GUI_ChangeProto(uint8_t proto)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_PROTO, .value = proto };
+
+    post(&msg);
+
+    return;
+}
+
+/*
+ * === GUI_ChangeRx
+ * Changes the `RX:` field in the GUI of the OLED.
+ *
+ * Parameters:
+ *      rx[in]  - true = `RX:ON`, false = `RX:OFF`
+ * Returns:
+ *      N/A
+ */
+void GUI_ChangeRx(bool rx)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_RX, .value = rx };
+
+    post(&msg);
+
+    return;
+}
+
+/*
+ * === GUI_ChangeChannel
+ * Changes the `CH:` field in the GUI of the OLED.
+ *
+ * Parameters:
+ *      ch[in]   - unsigned int representing number of the channel
+ * Returns:
+ *      N/A
+ */
+void GUI_ChangeChannel(uint8_t ch)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_CHANNEL, .value = ch };
+
+    post(&msg);
+
+    return;
+}
+
+/*
+ * === GUI_ChangeMonitor
+ * Changes the `CPU` and `STK` fields right of the vertical line.
+ *
+ * Parameters:
+ *      cpuLoad[in]     - CPU load in percent
+ *      bStackLow[in]   - a stack has little headroom, `LOW`
+ *                        is shown inverted then
+ * Returns:
+ *      N/A
+ */
+void GUI_ChangeMonitor(uint8_t cpuLoad, bool bStackLow)
+{
+    GUI_Message_t msg = { .field = GUI_FIELD_MONITOR, .value = cpuLoad, .bFlag = bStackLow };
+
+    post(&msg);
+
+    return;
+}
+
+// ==============================================================================================================
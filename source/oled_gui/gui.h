@@ -5,12 +5,59 @@
  *      Author: vojtechlukas
  */
 
+#include <stdint.h>
+
 #include <stdbool.h>
 
+#include <xdc/std.h>
+
 #ifndef SOURCE_OLED_GUI_GUI_H_
 #define SOURCE_OLED_GUI_GUI_H_
 
-void GUI_Init(void);
+// === DEFINES ==================================================================================================
+
+//
+// Screen updates per second at most, changes coming
+// in between are merged into the next one
+//
+#define GUI_REFRESH_PER_S       (5)
+
+//
+// Messages GUI_MailboxHandle holds, an update is
+// dropped when the GUI task is this far behind
+//
+#define GUI_MAILBOX_DEPTH       (8)
+
+//
+// IP address or status text, 15 characters
+//
+#define GUI_TEXT_SIZE           (16)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === GUI_Message_t
+ * One field change, posted by GUI_Change* to the GUI task.
+ */
+typedef struct GUI_Message
+{
+    uint8_t field;                      // GUI_Field_t of gui.c
+    uint8_t value;                      // protocol, RX, channel, CPU load or update status
+    bool    bFlag;                      // stack low
+    char    text[GUI_TEXT_SIZE];
+} GUI_Message_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void GUI_Main(UArg, UArg);
+
+bool GUI_IsIdle(void);
 
 void GUI_ChangeDeviceIp(const char*);
 
@@ -22,4 +69,8 @@ void GUI_ChangeRx(bool);
 
 void GUI_ChangeChannel(uint8_t);
 
+void GUI_ChangeMonitor(uint8_t, bool);
+
+// ==============================================================================================================
+
 #endif /* SOURCE_OLED_GUI_GUI_H_ */
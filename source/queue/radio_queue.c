@@ -36,6 +36,10 @@
 
 // === INCLUDES =================================================================================================
 
+#include <stddef.h>
+
+#include <string.h>
+
 #include <ti/drivers/rf/RF.h>
 
 #include DeviceFamily_constructPath(driverlib/rf_data_entry.h)
@@ -49,7 +53,11 @@
 
 // === DEFINES ================================================================================================
 
-#define RF_QUEUE_DE_HEADER_SIZE     8
+//
+// Entry header before data (8 bytes on target, pNextEntry
+// is wider in the host simulation)
+//
+#define RF_QUEUE_DE_HEADER_SIZE     offsetof(rfc_dataEntryGeneral_t, data)
 
 #define RF_QUEUE_ALIGN_PADDING(length) (4-((length + RF_QUEUE_DE_HEADER_SIZE)%4))
 
@@ -194,15 +202,15 @@ bool RadioQueue_hasPacket(void)
 
 /*
  * === RadioQueue_reset
- * TBD.
+ * Returns all entries to RF Core, frames not taken yet are dropped.
  *
  * Parameters:
- *      param[in]       - description
- * Returns:
  *      N/A
+ * Returns:
+ *      uint8_t         - number of frames dropped
  *
  */
-void RadioQueue_reset(void)
+uint8_t RadioQueue_reset(void)
 {
     //TODO falls into error?
     uint8_t* firstEntry = RadioQueue_RXbuffer;
@@ -214,13 +222,19 @@ void RadioQueue_reset(void)
     // Reset status to all entries
     rfc_dataEntryGeneral_t* pEntry = RadioQueue_ReadEntry;
     uint8_t k;
+    uint8_t dropped = 0;
     for (k = 0; k < NUM_DE; k++)
     {
+        if (pEntry->status == DATA_ENTRY_FINISHED)
+        {
+            dropped++;
+        }
+
         pEntry->status = DATA_ENTRY_PENDING;
         pEntry = (rfc_dataEntryGeneral_t*)pEntry->pNextEntry;
     }
 
-    return;
+    return dropped;
 }
 
 
@@ -273,6 +287,62 @@ uint16_t RadioQueue_takePacket(uint8_t* buffer, uint16_t maxlen)
 }
 
 
+/*
+ * === RadioQueue_isFull
+ * Entry RF Core writes next still holds a frame not taken yet.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      bool            - true when a frame written now would overflow
+ */
+bool RadioQueue_isFull(void)
+{
+    return (((rfc_dataEntryGeneral_t*)RadioQueue_object.pCurrEntry)->status != DATA_ENTRY_PENDING);
+}
+
+
+/*
+ * === RadioQueue_putPacket
+ * Writes a frame into the queue the way RF Core does: length
+ * (DE_CONFIG_SIZE bytes, LE) of frame and appended bytes, frame,
+ * appended bytes. Only valid while no RX command uses the queue.
+ *
+ * Parameters:
+ *      pFrame[in]      - frame as RF Core would receive it
+ *      len[in]         - length of the frame
+ *      pAppended[in]   - RSSI, timestamp... as the RX command appends them
+ *      appendedLen[in] - length of appended bytes
+ * Returns:
+ *      bool            - false when the queue is full or the frame
+ *                        does not fit an entry
+ */
+bool RadioQueue_putPacket(const uint8_t* pFrame, uint16_t len, const uint8_t* pAppended, uint8_t appendedLen)
+{
+    rfc_dataEntryGeneral_t* pEntry = (rfc_dataEntryGeneral_t*)RadioQueue_object.pCurrEntry;
+    uint8_t*                pData  = &pEntry->data;
+    uint16_t                total  = len + appendedLen;
+
+    if ( RadioQueue_isFull() || total + DE_CONFIG_SIZE > pEntry->length )
+    {
+        return false;
+    }
+
+    pData[0] = (uint8_t)total;
+    pData[1] = (uint8_t)( total >> 8 );
+
+    memcpy(pData + DE_CONFIG_SIZE, pFrame, len);
+
+    memcpy(pData + DE_CONFIG_SIZE + len, pAppended, appendedLen);
+
+    pEntry->status = DATA_ENTRY_FINISHED;
+
+    RadioQueue_object.pCurrEntry = pEntry->pNextEntry;
+
+    return true;
+}
+
+
 
 
 
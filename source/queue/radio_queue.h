@@ -20,12 +20,16 @@ dataQueue_t*    RadioQueue_getDQpointer(void);
 
 bool            RadioQueue_hasPacket(void);
 
-void            RadioQueue_reset(void);
+uint8_t         RadioQueue_reset(void);
 
 uint16_t        RadioQueue_takePacket(uint8_t* buffer, uint16_t maxlen);
 
 void            RadioQueue_nextEntry(void);
 
+bool            RadioQueue_isFull(void);
+
+bool            RadioQueue_putPacket(const uint8_t* pFrame, uint16_t len, const uint8_t* pAppended, uint8_t appendedLen);
+
 // ==============================================================================================================
 
 #endif /* RADIO_QUEUE_H_ */
@@ -11,7 +11,7 @@
 
 #include "ti_drivers_config.h"
 
-#include <source/utils/stv.h>
+#include <source/config/config.h>
 
 #include <source/ethernet/Ethernet.h>
 
@@ -19,7 +19,9 @@
 
 #include <source/queue/radio_queue.h>
 
-#include <source/utils/log.h>
+#include <source/utils/trace.h>
+
+#include <source/utils/stats.h>
 
 #include <source/radio_api/radio_api.h>
 
@@ -30,6 +32,20 @@
 
 #define MAX_PACKET_LEN (2047)
 
+#define BLE_WHITENING_INIT(ch)  (0x40 | (ch))   // Core spec Vol 6, Part B, 3.2
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+//
+// Posted for every frame RF Core stores, see Radio_SetRxNotify()
+//
+static Event_Handle rxNotifyEvent = NULL;
+
+static UInt         rxNotifyId;
+
 // ==============================================================================================================
 
 
@@ -146,9 +162,7 @@ RF_EventMask Radio_setFrequencySynthesizer(RF_Handle *pHandle,  RF_Protocol_t pr
 
     RF_EventMask retVal = RF_postCmd(*pHandle, pFsCmd, RF_PriorityNormal, NULL, 0);
 
-    Log_print("SetFrequencySynthesizer: ", &retVal, RfEvent);
-
-    Log_print("SetFSCmd: ", pFsCmd, CmdStatus);
+    TRACE(RADIO_SET_FS, retVal, pFsCmd->status);
 
     return retVal;
 
@@ -173,11 +187,12 @@ void Radio_initRXCmd(rfc_bleGenericRxOutput_t* bleStats, rfc_ieeeRxOutput_t* iee
     RFCMD_bleGenericRX.pParams->rxConfig.bAutoFlushCrcErr = 1;
     RFCMD_bleGenericRX.pParams->rxConfig.bIncludeLenByte  = 1;
     RFCMD_bleGenericRX.pParams->rxConfig.bIncludeCrc      = 1;
-    RFCMD_bleGenericRX.pParams->rxConfig.bAppendRssi      = 0;
+    RFCMD_bleGenericRX.pParams->rxConfig.bAppendRssi      = 1; // stripped in HandleIncomingRfPacket
     RFCMD_bleGenericRX.pParams->rxConfig.bAppendStatus    = 0;
-    RFCMD_bleGenericRX.whitening.init                     = 0x65;
+    RFCMD_bleGenericRX.pParams->rxConfig.bAppendTimestamp = 1; // stripped in HandleIncomingRfPacket
+    RFCMD_bleGenericRX.whitening.init                     = BLE_WHITENING_INIT(RADIO_BLE_DEFAULT_CHANNEL);
     RFCMD_bleGenericRX.pOutput                            = bleStats; //todo: stats
-    RFCMD_bleGenericRX.channel                            = 0x66; //todo: initial channel
+    RFCMD_bleGenericRX.channel                            = RADIO_BLE_DEFAULT_CHANNEL;
 
     //RFCMD_ieeeRX.status                                     = 0x0;
     RFCMD_ieeeRX.pRxQ                                       = RadioQueue_getDQpointer();
@@ -188,7 +203,7 @@ void Radio_initRXCmd(rfc_bleGenericRxOutput_t* bleStats, rfc_ieeeRxOutput_t* iee
     RFCMD_ieeeRX.rxConfig.bAppendRssi                       = 0;
     RFCMD_ieeeRX.rxConfig.bAppendCorrCrc                    = 0;
     RFCMD_ieeeRX.rxConfig.bAppendSrcInd                     = 0;
-    RFCMD_ieeeRX.rxConfig.bAppendTimestamp                  = 0;
+    RFCMD_ieeeRX.rxConfig.bAppendTimestamp                  = 1; // stripped in HandleIncomingRfPacket
     RFCMD_ieeeRX.pOutput                                    = ieeeStats;
     RFCMD_ieeeRX.channel                                    = 0;
 
@@ -219,7 +234,7 @@ RF_CmdHandle Radio_beginRX(RF_Handle pHandle, RF_Protocol_t proto, void* callbac
 
     retVal = RF_postCmd(pHandle, pRXCmd, RF_PriorityNormal, callbackFunction, events);
 
-    Log_print("BeginRX: ", pRXCmd, CmdStatus);
+    TRACE(RADIO_BEGIN_RX, retVal, pRXCmd->status);
 
     return retVal;
 
@@ -240,11 +255,7 @@ RF_Stat Radio_stopRX(RF_Handle pHandle)
 {
     RF_Stat retVal = RF_flushCmd(pHandle, RF_CMDHANDLE_FLUSH_ALL, 1);
 
-    Log_print("StopAllStat: ", &retVal, RfStat);
-
-    Log_print("StopAll[BLE]: ", getRXCmdByProto(BluetoothLowEnergy), CmdStatus);
-
-    Log_print("StopAll[IEEE]: ", getRXCmdByProto(IEEE_802_15_4), CmdStatus);
+    TRACE(RADIO_STOP_RX, retVal, ( (uint32_t)getRXCmdByProto(IEEE_802_15_4)->status << 16 ) | getRXCmdByProto(BluetoothLowEnergy)->status);
 
     RF_close(pHandle);
 
@@ -252,6 +263,22 @@ RF_Stat Radio_stopRX(RF_Handle pHandle)
 }
 
 
+/*
+ * === Radio_suspendRX
+ * Aborts the RX command but keeps Radio Core open, RF Core then
+ * leaves the radio queue alone until Radio_beginRX() is called.
+ *
+ * Parameters:
+ *      pHandle[in]             - handle to Radio Core
+ * Returns:
+ *      RF_Stat                 - Enum signaling successful completition
+ */
+RF_Stat Radio_suspendRX(RF_Handle pHandle)
+{
+    return RF_flushCmd(pHandle, RF_CMDHANDLE_FLUSH_ALL, 0);
+}
+
+
 /*
  * === TODO
  * Stops listening to RF frames.
@@ -264,38 +291,185 @@ RF_Stat Radio_stopRX(RF_Handle pHandle)
  */
 RF_Protocol_t Radio_GetCurrentProtocol()
 {
-    if ( STV_ReadFromAddress(STVW_RF_PROTOCOL) == STV_RF_PROTO_BLE )
+    return (RF_Protocol_t)Config_GetProtocol();
+}
+
+/*
+ * === Radio_HandleRxEvent
+ * Callback of RX commands (Swi), RADIO_RX_EVENTS. A stored frame
+ * posts the event given to Radio_SetRxNotify(). Full radio queue
+ * ends RX, the queue is reset and RX is posted again.
+ *
+ * Parameters:
+ *      rfHnd[in]               - handle to Radio Core
+ *      rfCmdHnd[in]            - the RX command
+ *      eventMsk[in]            - events that occurred
+ * Returns:
+ *      N/A
+ */
+void Radio_HandleRxEvent(RF_Handle rfHnd, RF_CmdHandle rfCmdHnd, RF_EventMask eventMsk)
+{
+    if ( ( eventMsk & RF_EventRxEntryDone ) && rxNotifyEvent != NULL )
     {
-        return BluetoothLowEnergy;
+        Event_post(rxNotifyEvent, rxNotifyId);
     }
 
-    if ( STV_ReadFromAddress(STVW_RF_PROTOCOL) == STV_RF_PROTO_IEEE )
+    if ( !( eventMsk & RF_EventRxBufFull ) )
     {
-        return IEEE_802_15_4;
+        return;
     }
 
-    return 0;
+    Stats_Increment(STATS_RX_OVERFLOWS);
+
+    TRACE(RADIO_OVERFLOW, Stats_Get(STATS_RX_OVERFLOWS), 0);
+
+    Stats_Add(STATS_QUEUE_DISCARDS, RadioQueue_reset());
+
+    Radio_beginRX(rfHnd, Radio_GetCurrentProtocol(), &Radio_HandleRxEvent, RADIO_RX_EVENTS);
+
+    return;
 }
 
+
 /*
- * === TODO
- * Stops listening to RF frames.
- * Main purpose is to shadow TI's API for better readability
+ * === Radio_SetRxNotify
+ * Event posted for every frame stored in the radio queue, so that
+ * the task taking frames may sleep while the queue is empty.
+ *
+ * Parameters:
+ *      event[in]               - event object, NULL for none
+ *      eventId[in]             - Event_Id_xx to post
+ * Returns:
+ *      N/A
+ */
+void Radio_SetRxNotify(Event_Handle event, UInt eventId)
+{
+    rxNotifyId    = eventId;
+    rxNotifyEvent = event;
+
+    return;
+}
+
+
+/*
+ * === Radio_isValidChannel
+ * BLE channels are given by channel index (0..39, 37..39 being
+ * advertising channels), IEEE 802.15.4 channels by number (11..26).
+ */
+bool Radio_isValidChannel(RF_Protocol_t proto, uint8_t channel)
+{
+    if ( proto == BluetoothLowEnergy )
+    {
+        return ( channel <= RADIO_BLE_MAX_CHANNEL );
+    }
+
+    if ( proto == IEEE_802_15_4 )
+    {
+        return ( channel >= RADIO_IEEE_MIN_CHANNEL && channel <= RADIO_IEEE_MAX_CHANNEL );
+    }
+
+    return false;
+}
+
+
+/*
+ * === Radio_setChannel
+ * Retunes running RX to another channel without closing Radio Core.
+ * RX command is aborted (frame being received is lost), channel is
+ * changed in the command and the command is posted again, RF Core
+ * programs the synthesizer itself. Queued frames are kept.
  *
  * Parameters:
  *      pHandle[in]             - handle to Radio Core
+ *      proto[in]               - protocol the radio listens to
+ *      channel[in]             - see Radio_isValidChannel
  * Returns:
- *      RF_Stat                 - Enum signaling successful completition
+ *      bool                    - false when channel is not valid,
+ *                                RX is left untouched then
  */
-void Radio_HandleQueueOverflow(RF_Handle rfHnd, RF_CmdHandle rfCmdHnd, RF_EventMask eventMsk)
+bool Radio_setChannel(RF_Handle pHandle, RF_Protocol_t proto, uint8_t channel)
 {
-    // TODO increment nRxBufFull
+    if ( !Radio_isValidChannel(proto, channel) )
+    {
+        return false;
+    }
 
-    RadioQueue_reset();
+    RF_flushCmd(pHandle, RF_CMDHANDLE_FLUSH_ALL, 0);
 
-    Radio_beginRX(rfHnd, BluetoothLowEnergy, &Radio_HandleQueueOverflow, RF_EventRxBufFull);
+    if ( proto == BluetoothLowEnergy )
+    {
+        RFCMD_bleGenericRX.channel        = channel;
+        RFCMD_bleGenericRX.whitening.init = BLE_WHITENING_INIT(channel);
+    }
+    else
+    {
+        RFCMD_ieeeRX.channel = channel;
+    }
 
-    return;
+    //
+    // Posted directly, Radio_beginRX logs
+    // and this path is timing sensitive
+    //
+    RF_postCmd(pHandle, getRXCmdByProto(proto), RF_PriorityNormal, &Radio_HandleRxEvent, RADIO_RX_EVENTS);
+
+    return true;
+}
+
+
+/*
+ * === Radio_GetChannel
+ * Returns:
+ *      uint8_t                 - channel RX command of proto uses,
+ *                                0 for IEEE means the frequency set
+ *                                by frequency synthesizer command
+ */
+uint8_t Radio_GetChannel(RF_Protocol_t proto)
+{
+    if ( proto == BluetoothLowEnergy )
+    {
+        return RFCMD_bleGenericRX.channel;
+    }
+
+    return RFCMD_ieeeRX.channel;
+}
+
+
+/*
+ * === Radio_GetAirtimeMicros
+ * Time from the RAT timestamp (BLE access address, 802.15.4 SFD)
+ * to the end of a frame: BLE 1M takes 8 us per byte, 802.15.4
+ * (O-QPSK) 32 us per byte of PHY header and MPDU.
+ *
+ * Parameters:
+ *      proto[in]               - protocol the frame was received with
+ *      frameLen[in]            - frame length without appended bytes
+ * Returns:
+ *      uint32_t                - microseconds
+ */
+uint32_t Radio_GetAirtimeMicros(RF_Protocol_t proto, uint16_t frameLen)
+{
+    return ( proto == BluetoothLowEnergy ) ? ( 4 + frameLen ) * 8 : ( 1 + frameLen ) * 32;
+}
+
+
+/*
+ * === Radio_GetMicrosSinceRxEnd
+ * Age of a received frame. RF Core timestamps the start of the frame,
+ * its end is estimated from the length, see Radio_GetAirtimeMicros.
+ *
+ * Parameters:
+ *      proto[in]               - protocol the frame was received with
+ *      ratStart[in]            - appended RAT timestamp
+ *      frameLen[in]            - frame length without appended bytes
+ * Returns:
+ *      uint32_t                - microseconds since the end of reception
+ */
+uint32_t Radio_GetMicrosSinceRxEnd(RF_Protocol_t proto, uint32_t ratStart, uint16_t frameLen)
+{
+    uint32_t airtime = Radio_GetAirtimeMicros(proto, frameLen);
+    uint32_t age     = ( RF_getCurrentTime() - ratStart ) / RADIO_RAT_TICKS_PER_US;
+
+    return ( age > airtime ) ? age - airtime : 0;
 }
 
 
@@ -8,10 +8,40 @@
 #ifndef RADIO_API_H_
 #define RADIO_API_H_
 
+#include <stdbool.h>
+
+#include <ti/sysbios/knl/Event.h>
+
 #include <source/ethernet/EthernetUdp.h>
 
 #include "ti_radio_config.h"
 
+// === DEFINES ==================================================================================================
+
+#define RADIO_BLE_MAX_CHANNEL       (39)
+
+#define RADIO_BLE_DEFAULT_CHANNEL   (37)    // 2402 MHz, first advertising channel
+
+#define RADIO_IEEE_MIN_CHANNEL      (11)
+
+#define RADIO_IEEE_MAX_CHANNEL      (26)
+
+//
+// RF Core appends RAT timestamp (start of the frame, 4 MHz)
+// as the last bytes of every queue entry
+//
+#define RADIO_TIMESTAMP_LEN         (4)
+
+#define RADIO_RAT_TICKS_PER_US      (4)
+
+//
+// Events of RX commands handled by Radio_HandleRxEvent: frame
+// stored (Radio_SetRxNotify) and radio queue full
+//
+#define RADIO_RX_EVENTS             ( RF_EventRxEntryDone | RF_EventRxBufFull )
+
+// ==============================================================================================================
+
 // === ENUM DEFINITIONS =========================================================================================
 
 typedef enum RF_Protocol {
@@ -33,9 +63,23 @@ RF_CmdHandle  Radio_beginRX                 (RF_Handle pHandle, RF_Protocol_t pr
 
 RF_Stat       Radio_stopRX                  (RF_Handle pHandle);
 
+RF_Stat       Radio_suspendRX               (RF_Handle pHandle);
+
 RF_Protocol_t Radio_GetCurrentProtocol      (void);
 
-void          Radio_HandleQueueOverflow     (RF_Handle rfHnd, RF_CmdHandle rfCmdHnd, RF_EventMask eventMsk);
+void          Radio_HandleRxEvent           (RF_Handle rfHnd, RF_CmdHandle rfCmdHnd, RF_EventMask eventMsk);
+
+void          Radio_SetRxNotify             (Event_Handle event, UInt eventId);
+
+bool          Radio_isValidChannel          (RF_Protocol_t proto, uint8_t channel);
+
+bool          Radio_setChannel              (RF_Handle pHandle, RF_Protocol_t proto, uint8_t channel);
+
+uint8_t       Radio_GetChannel              (RF_Protocol_t proto);
+
+uint32_t      Radio_GetAirtimeMicros        (RF_Protocol_t proto, uint16_t frameLen);
+
+uint32_t      Radio_GetMicrosSinceRxEnd     (RF_Protocol_t proto, uint32_t ratStart, uint16_t frameLen);
 
 // ==============================================================================================================
 
@@ -0,0 +1,421 @@
+/*
+ * replay.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <source/replay/replay.h>
+
+#include <source/queue/radio_queue.h>
+
+#include <source/ethernet/EthernetUdp.h>
+
+#include <source/ethernet/EthernetIrq.h>
+
+#include <source/utils/stats.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// First socket tried for the replay port, control
+// port takes 4
+//
+#define REPLAY_SOCKET_PREF      (5)
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+#ifdef REPLAY_INJECT
+
+static EthernetUDP replayUdp;
+
+//
+// RECV interrupt came, datagrams may be waiting
+//
+static bool        bPending = false;
+
+//
+// Datagram being injected, frames are taken from readPos
+// while the radio queue has room, the next datagram is
+// read only after the last frame
+//
+static uint8_t     datagram[REPLAY_MAX_DATAGRAM];
+
+static uint16_t    datagramLen;
+
+static uint16_t    readPos;
+
+static uint8_t     framesLeft;
+
+//
+// Sender of the session, reports go there
+//
+static IPAddress   remoteIp;
+
+static uint16_t    remotePort;
+
+///////////////////////////
+// Session: RX suspended from the first
+// frame until END and all frames taken
+//
+static bool        bSuspended;
+
+static bool        bEnding;
+
+static uint32_t    nextSequence;
+
+static uint32_t    injected;
+
+static uint32_t    lost;
+
+static uint32_t    rejected;
+
+#endif
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+#ifdef REPLAY_INJECT
+
+static void onSocketEvent(uint8_t sock, uint8_t events)
+{
+    bPending = true;
+
+    return;
+}
+
+
+static void putLe32(uint8_t* pDst, uint32_t value)
+{
+    pDst[0] = (uint8_t)value;
+    pDst[1] = (uint8_t)( value >> 8 );
+    pDst[2] = (uint8_t)( value >> 16 );
+    pDst[3] = (uint8_t)( value >> 24 );
+
+    return;
+}
+
+
+static void sendReport(uint8_t flags, Replay_Status_t status)
+{
+    uint8_t report[REPLAY_REPORT_SIZE];
+
+    report[0] = REPLAY_VERSION;
+    report[1] = flags | REPLAY_FLAG_REPORT;
+    putLe32(&report[2], nextSequence);
+    report[6] = 0;
+    report[7] = (uint8_t)status;
+    putLe32(&report[8],  injected);
+    putLe32(&report[12], lost);
+    putLe32(&report[16], rejected);
+
+    EthernetUDP_beginPacket_ip(&replayUdp, remoteIp, remotePort);
+
+    EthernetUDP_write(&replayUdp, report, sizeof(report));
+
+    EthernetUDP_endPacket(&replayUdp);
+
+    return;
+}
+
+
+static void reject(uint32_t count)
+{
+    rejected += count;
+
+    Stats_Add(STATS_REPLAY_REJECTED, count);
+
+    return;
+}
+
+
+/*
+ * === injectFrame
+ * Writes the next frame of the datagram into the radio queue with
+ * the bytes the RX command appends: BLE RSSI and RAT timestamp,
+ * IEEE RAT timestamp. Timestamp puts the end of the frame to now,
+ * so queue latency starts when the frame is written.
+ */
+static void injectFrame(RF_Protocol_t proto)
+{
+    uint8_t  appended[1 + RADIO_TIMESTAMP_LEN];
+    uint8_t  appendedLen = 0;
+    uint16_t len;
+    uint8_t  rssi;
+    uint32_t ratStart;
+
+    if ( readPos + REPLAY_FRAME_HEADER_SIZE > datagramLen )
+    {
+        reject(framesLeft);
+
+        framesLeft = 0;
+
+        return;
+    }
+
+    len  = datagram[readPos] | ( (uint16_t)datagram[readPos + 1] << 8 );
+    rssi = datagram[readPos + 2];
+
+    if ( readPos + REPLAY_FRAME_HEADER_SIZE + len > datagramLen )
+    {
+        reject(framesLeft);
+
+        framesLeft = 0;
+
+        return;
+    }
+
+    ratStart = RF_getCurrentTime() - Radio_GetAirtimeMicros(proto, len) * RADIO_RAT_TICKS_PER_US;
+
+    if ( proto == BluetoothLowEnergy )
+    {
+        appended[appendedLen++] = rssi;
+    }
+
+    putLe32(&appended[appendedLen], ratStart);
+    appendedLen += RADIO_TIMESTAMP_LEN;
+
+    if ( RadioQueue_putPacket(&datagram[readPos + REPLAY_FRAME_HEADER_SIZE], len, appended, appendedLen) )
+    {
+        injected++;
+
+        Stats_Increment(STATS_REPLAY_FRAMES);
+    }
+    else
+    {
+        reject(1);
+    }
+
+    readPos += REPLAY_FRAME_HEADER_SIZE + len;
+
+    framesLeft--;
+
+    return;
+}
+
+
+/*
+ * === receive
+ * Reads one datagram and starts injecting its frames. Frames of
+ * the other protocol are rejected as a whole, so are datagrams
+ * of an unknown version. Frames missing between the expected
+ * and received sequence are counted as lost.
+ *
+ * Parameters:
+ *      rfHnd[in]       - handle to Radio Core
+ *      proto[in]       - protocol the radio listens to
+ * Returns:
+ *      bool            - false when no datagram is waiting
+ */
+static bool receive(RF_Handle rfHnd, RF_Protocol_t proto)
+{
+    uint8_t  flags;
+    uint8_t  count;
+    uint32_t sequence;
+    int      len = EthernetUDP_parsePacket(&replayUdp);
+
+    if ( len <= 0 )
+    {
+        bPending = false;
+
+        return false;
+    }
+
+    if ( len < REPLAY_HEADER_SIZE || len > REPLAY_MAX_DATAGRAM )
+    {
+        return true;
+    }
+
+    remoteIp   = EthernetUDP_remoteIP(&replayUdp);
+    remotePort = EthernetUDP_remotePort(&replayUdp);
+
+    EthernetUDP_read_buf(&replayUdp, datagram, len);
+
+    flags    = datagram[1];
+    sequence = datagram[2] | ( (uint32_t)datagram[3] << 8 ) | ( (uint32_t)datagram[4] << 16 ) | ( (uint32_t)datagram[5] << 24 );
+    count    = datagram[6];
+
+    if ( datagram[0] != REPLAY_VERSION )
+    {
+        sendReport(flags, REPLAY_BAD_VERSION);
+
+        return true;
+    }
+
+    if ( flags & REPLAY_FLAG_START )
+    {
+        nextSequence = sequence;
+        injected     = 0;
+        lost         = 0;
+        rejected     = 0;
+        bEnding      = false;
+    }
+
+    if ( ( ( flags & REPLAY_FLAG_IEEE ) != 0 ) != ( proto == IEEE_802_15_4 ) )
+    {
+        reject(count);
+
+        if ( flags & ( REPLAY_FLAG_START | REPLAY_FLAG_END ) )
+        {
+            sendReport(flags, REPLAY_WRONG_PROTOCOL);
+        }
+
+        return true;
+    }
+
+    ///////////////////////////
+    // Frames: RX is suspended again for every datagram,
+    // a channel change in between posts RX again
+    //
+    if ( count > 0 || ( flags & REPLAY_FLAG_START ) )
+    {
+        Radio_suspendRX(rfHnd);
+
+        bSuspended = true;
+    }
+
+    //
+    // END carries the sequence after the last frame,
+    // so frames lost at the end are counted too
+    //
+    if ( count > 0 || ( flags & REPLAY_FLAG_END ) )
+    {
+        if ( (int32_t)( sequence - nextSequence ) > 0 )
+        {
+            lost += sequence - nextSequence;
+
+            Stats_Add(STATS_REPLAY_LOST, sequence - nextSequence);
+        }
+
+        if ( (int32_t)( sequence + count - nextSequence ) > 0 )
+        {
+            nextSequence = sequence + count;
+        }
+    }
+
+    if ( count > 0 )
+    {
+        datagramLen = len;
+        readPos     = REPLAY_HEADER_SIZE;
+        framesLeft  = count;
+    }
+
+    if ( flags & REPLAY_FLAG_END )
+    {
+        bEnding = true;
+    }
+    else if ( flags & REPLAY_FLAG_START )
+    {
+        sendReport(flags, REPLAY_OK);
+    }
+
+    return true;
+}
+
+#endif
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Replay_Init
+ * Opens the replay port and enables its RECV interrupt.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      bool            - false when no socket is free or
+ *                        built without REPLAY_INJECT
+ */
+bool Replay_Init(void)
+{
+#ifdef REPLAY_INJECT
+
+    EthernetUDP_begin_init(&replayUdp);
+
+    if ( !EthernetUDP_begin(&replayUdp, REPLAY_PORT, REPLAY_SOCKET_PREF) )
+    {
+        return false;
+    }
+
+    EthernetIrq_Register(replayUdp._sock, ETHIRQ_RECV, onSocketEvent);
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+
+/*
+ * === Replay_Service
+ * Called by the sniffing task between frames. Fills free entries of
+ * the radio queue with frames of the current datagram, then reads the
+ * next one. After END and its last frame RX is resumed and the session
+ * is reported. No SPI access unless RECV came.
+ *
+ * Parameters:
+ *      rfHnd[in]       - handle to Radio Core
+ *      proto[in]       - protocol the radio listens to
+ * Returns:
+ *      N/A
+ */
+void Replay_Service(RF_Handle rfHnd, RF_Protocol_t proto)
+{
+#ifdef REPLAY_INJECT
+
+    for (;;)
+    {
+        while ( framesLeft > 0 && !RadioQueue_isFull() )
+        {
+            injectFrame(proto);
+        }
+
+        if ( framesLeft > 0 )
+        {
+            break;
+        }
+
+        if ( bEnding )
+        {
+            bEnding = false;
+
+            if ( bSuspended )
+            {
+                Radio_beginRX(rfHnd, proto, &Radio_HandleRxEvent, RADIO_RX_EVENTS);
+
+                bSuspended = false;
+            }
+
+            sendReport(REPLAY_FLAG_END | ( ( proto == IEEE_802_15_4 ) ? REPLAY_FLAG_IEEE : 0 ), REPLAY_OK);
+        }
+
+        if ( !bPending || !receive(rfHnd, proto) )
+        {
+            break;
+        }
+    }
+
+#endif
+
+    return;
+}
+
+// ==============================================================================================================
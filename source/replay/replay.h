@@ -0,0 +1,88 @@
+/*
+ * replay.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_REPLAY_REPLAY_H_
+#define SOURCE_REPLAY_REPLAY_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <ti/drivers/rf/RF.h>
+
+#include <source/radio_api/radio_api.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Build flag:
+//      REPLAY_INJECT   - test build, frames received on REPLAY_PORT
+//                        are written into the radio queue as if
+//                        RF Core received them (tools/pcap_replay.py);
+//                        without it Replay_Init() and Replay_Service()
+//                        do nothing
+//
+// Replay protocol, one datagram per batch of frames.
+// Request:  [version][flags][sequence of the first frame, LE32][count][0]
+//           then count times [length, LE16][RSSI][frame]
+// Report:   [version][flags | REPLAY_FLAG_REPORT][next sequence, LE32][0][status]
+//           [injected, LE32][lost, LE32][rejected, LE32]
+//
+// BLE frames are the PDU with header, length and CRC (as RF Core
+// stores them with bIncludeLenByte and bIncludeCrc), IEEE frames
+// the MPDU with FCS. START opens a session (counters cleared, RX
+// suspended), END carries the sequence after the last frame and
+// closes the session, RX is resumed once all frames were taken.
+// Both are answered with a report, every time they come, so they
+// can be repeated until the report arrives.
+//
+#define REPLAY_PORT                 (2017)
+
+#define REPLAY_VERSION              (1)
+
+#define REPLAY_HEADER_SIZE          (8)
+
+#define REPLAY_FRAME_HEADER_SIZE    (3)
+
+#define REPLAY_REPORT_SIZE          (REPLAY_HEADER_SIZE + 12)
+
+#define REPLAY_MAX_DATAGRAM         (1024)
+
+#define REPLAY_FLAG_IEEE            (0x01)  // frames are IEEE 802.15.4, else BLE
+#define REPLAY_FLAG_REPORT          (0x20)
+#define REPLAY_FLAG_START           (0x40)
+#define REPLAY_FLAG_END             (0x80)
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+typedef enum Replay_Status
+{
+    REPLAY_OK = 0,
+    REPLAY_WRONG_PROTOCOL,              // radio listens to the other protocol
+    REPLAY_BAD_VERSION
+} Replay_Status_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+bool Replay_Init(void);
+
+void Replay_Service(RF_Handle rfHnd, RF_Protocol_t proto);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_REPLAY_REPLAY_H_ */
@@ -0,0 +1,422 @@
+/*
+ * trigger.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <source/trigger/trigger.h>
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+/*
+ * === history
+ * Pre-trigger history ring. Frames are stored back to back as
+ * [length lo][length hi][frame], an entry may wrap around the end
+ * of the buffer. When a new frame does not fit, the oldest frames
+ * are evicted, so the ring always holds the most recent traffic.
+ */
+static uint8_t         history[TRIGGER_HISTORY_SIZE];
+
+static uint16_t        historyHead;
+
+static uint16_t        historyTail;
+
+static uint16_t        historyUsed;
+
+/*
+ * === pattern
+ * Trigger pattern compared against frame bytes starting at
+ * patternOffset. A bit cleared in patternMask is "don't care".
+ */
+static uint8_t         patternValue[TRIGGER_PATTERN_MAXLEN];
+
+static uint8_t         patternMask[TRIGGER_PATTERN_MAXLEN];
+
+static uint8_t         patternLen;
+
+static char            patternText[2 * TRIGGER_PATTERN_MAXLEN + 1];
+
+static uint16_t        patternOffset;
+
+static uint8_t         postFrames;
+
+static uint8_t         postRemaining;
+
+static Trigger_State_t state = TRIGGER_OFF;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static void writeHistory(const uint8_t* pSrc, uint16_t len)
+{
+    uint16_t chunk = TRIGGER_HISTORY_SIZE - historyHead;
+
+    if ( chunk > len )
+    {
+        chunk = len;
+    }
+
+    memcpy(&history[historyHead], pSrc, chunk);
+    memcpy(history, pSrc + chunk, len - chunk);
+
+    historyHead = (historyHead + len) % TRIGGER_HISTORY_SIZE;
+
+    return;
+}
+
+static void readHistory(uint8_t* pDst, uint16_t len)
+{
+    uint16_t chunk = TRIGGER_HISTORY_SIZE - historyTail;
+
+    if ( chunk > len )
+    {
+        chunk = len;
+    }
+
+    memcpy(pDst, &history[historyTail], chunk);
+    memcpy(pDst + chunk, history, len - chunk);
+
+    historyTail = (historyTail + len) % TRIGGER_HISTORY_SIZE;
+
+    return;
+}
+
+static uint16_t readEntryLength(void)
+{
+    uint8_t hdr[TRIGGER_ENTRY_HDR_SIZE];
+
+    readHistory(hdr, TRIGGER_ENTRY_HDR_SIZE);
+
+    return (uint16_t)hdr[0] | ((uint16_t)hdr[1] << 8);
+}
+
+static void resetHistory(void)
+{
+    historyHead = 0;
+    historyTail = 0;
+    historyUsed = 0;
+
+    return;
+}
+
+static int8_t hexNibble(char c)
+{
+    if ( c >= '0' && c <= '9' ) return c - '0';
+    if ( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+    if ( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+    if ( c == 'x' || c == 'X' ) return -1;
+
+    return -2;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Trigger_SetPattern
+ * Sets trigger pattern from its textual form, i.e. hexadecimal
+ * bytes where any nibble may be replaced by 'x' as a wildcard,
+ * e.g. "41x8" matches 0x41 followed by 0x08, 0x18, ..., 0xF8.
+ * Empty pattern matches every frame.
+ *
+ * Parameters:
+ *      pPattern[in]    - textual pattern
+ * Returns:
+ *      bool            - false when pattern is malformed or too long,
+ *                        previous pattern is kept then
+ */
+bool Trigger_SetPattern(const char* pPattern)
+{
+    uint8_t value[TRIGGER_PATTERN_MAXLEN];
+    uint8_t mask[TRIGGER_PATTERN_MAXLEN];
+    uint8_t i, len = strlen(pPattern);
+    int8_t  hi, lo;
+
+    if ( !Trigger_IsValidPattern(pPattern) )
+    {
+        return false;
+    }
+
+    for ( i = 0; i < len / 2; i++ )
+    {
+        hi = hexNibble(pPattern[2 * i]);
+        lo = hexNibble(pPattern[2 * i + 1]);
+
+        value[i] = (hi < 0 ? 0 : hi << 4) | (lo < 0 ? 0 : lo);
+        mask[i]  = (hi < 0 ? 0 : 0xF0)    | (lo < 0 ? 0 : 0x0F);
+    }
+
+    memcpy(patternValue, value, len / 2);
+    memcpy(patternMask, mask, len / 2);
+    memcpy(patternText, pPattern, len + 1);
+
+    patternLen = len / 2;
+
+    return true;
+}
+
+
+/*
+ * === Trigger_IsValidPattern
+ * Checks textual pattern without setting it,
+ * so that it can be validated with other settings.
+ */
+bool Trigger_IsValidPattern(const char* pPattern)
+{
+    size_t len = strlen(pPattern);
+    size_t i;
+
+    if ( (len & 1) || len > 2 * TRIGGER_PATTERN_MAXLEN )
+    {
+        return false;
+    }
+
+    for ( i = 0; i < len; i++ )
+    {
+        if ( hexNibble(pPattern[i]) == -2 )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+const char* Trigger_GetPattern(void)
+{
+    return patternText;
+}
+
+
+void Trigger_SetOffset(uint16_t offset)
+{
+    patternOffset = offset;
+
+    return;
+}
+
+
+uint16_t Trigger_GetOffset(void)
+{
+    return patternOffset;
+}
+
+
+void Trigger_SetPostFrames(uint8_t count)
+{
+    postFrames = count;
+
+    return;
+}
+
+
+uint8_t Trigger_GetPostFrames(void)
+{
+    return postFrames;
+}
+
+
+/*
+ * === Trigger_Arm
+ * Arms (or re-arms) the trigger, history ring is emptied so that
+ * only traffic captured after arming is flushed. Disarming returns
+ * sniffing to plain streaming.
+ *
+ * Parameters:
+ *      bArm[in]        - true to arm, false to disarm
+ * Returns:
+ *      N/A
+ */
+void Trigger_Arm(bool bArm)
+{
+    resetHistory();
+
+    state = bArm ? TRIGGER_ARMED : TRIGGER_OFF;
+
+    return;
+}
+
+
+Trigger_State_t Trigger_GetState(void)
+{
+    return state;
+}
+
+
+/*
+ * === Trigger_Match
+ * Compares frame against trigger pattern.
+ *
+ * Parameters:
+ *      pFrame[in]      - frame as taken from the radio queue
+ *      len[in]         - length of the frame
+ * Returns:
+ *      bool            - true when frame matches the pattern
+ */
+bool Trigger_Match(const uint8_t* pFrame, uint16_t len)
+{
+    uint8_t i;
+
+    if ( patternOffset + patternLen > len )
+    {
+        return false;
+    }
+
+    pFrame += patternOffset;
+
+    for ( i = 0; i < patternLen; i++ )
+    {
+        if ( (pFrame[i] & patternMask[i]) != patternValue[i] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+/*
+ * === Trigger_PushHistory
+ * Stores frame into the history ring, evicting the oldest
+ * frames until there is enough space for it.
+ *
+ * Parameters:
+ *      pFrame[in]      - frame to be stored
+ *      len[in]         - length of the frame
+ * Returns:
+ *      N/A
+ */
+void Trigger_PushHistory(const uint8_t* pFrame, uint16_t len)
+{
+    uint8_t  hdr[TRIGGER_ENTRY_HDR_SIZE] = { len & 0xFF, len >> 8 };
+    uint16_t need = len + TRIGGER_ENTRY_HDR_SIZE;
+    uint16_t evicted;
+
+    if ( need > TRIGGER_HISTORY_SIZE )
+    {
+        return;
+    }
+
+    while ( TRIGGER_HISTORY_SIZE - historyUsed < need )
+    {
+        evicted = readEntryLength();
+
+        historyTail  = (historyTail + evicted) % TRIGGER_HISTORY_SIZE;
+        historyUsed -= TRIGGER_ENTRY_HDR_SIZE + evicted;
+    }
+
+    writeHistory(hdr, TRIGGER_ENTRY_HDR_SIZE);
+    writeHistory(pFrame, len);
+
+    historyUsed += need;
+
+    return;
+}
+
+
+/*
+ * === Trigger_PopHistory
+ * Takes the oldest frame out of the history ring.
+ *
+ * Parameters:
+ *      pFrame[out]     - buffer for the frame
+ *      maxlen[in]      - size of the buffer
+ * Returns:
+ *      uint16_t        - length of the frame, 0 when ring is empty
+ *                        (frames longer than maxlen are dropped)
+ */
+uint16_t Trigger_PopHistory(uint8_t* pFrame, uint16_t maxlen)
+{
+    uint16_t len;
+
+    while ( historyUsed )
+    {
+        len = readEntryLength();
+
+        historyUsed -= TRIGGER_ENTRY_HDR_SIZE + len;
+
+        if ( len <= maxlen )
+        {
+            readHistory(pFrame, len);
+
+            return len;
+        }
+
+        historyTail = (historyTail + len) % TRIGGER_HISTORY_SIZE;
+    }
+
+    return 0;
+}
+
+
+/*
+ * === Trigger_ProcessFrame
+ * Handles frame received while the trigger is armed. Frame is kept
+ * in history and compared against the pattern. On match the trigger
+ * leaves TRIGGER_ARMED and the caller is expected to flush history
+ * (the matching frame is the last one in it) by Trigger_PopHistory().
+ *
+ * Parameters:
+ *      pFrame[in]      - frame as taken from the radio queue
+ *      len[in]         - length of the frame
+ * Returns:
+ *      bool            - true when the trigger fired
+ */
+bool Trigger_ProcessFrame(const uint8_t* pFrame, uint16_t len)
+{
+    Trigger_PushHistory(pFrame, len);
+
+    if ( !Trigger_Match(pFrame, len) )
+    {
+        return false;
+    }
+
+    postRemaining = postFrames;
+
+    state = postFrames ? TRIGGER_POST : TRIGGER_DONE;
+
+    return true;
+}
+
+
+/*
+ * === Trigger_CountPostFrame
+ * Counts one frame of the post-trigger window. Once the window
+ * elapses, the trigger stays in TRIGGER_DONE until re-armed.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      bool            - true when the frame belongs to the window
+ *                        and should be forwarded
+ */
+bool Trigger_CountPostFrame(void)
+{
+    if ( state != TRIGGER_POST )
+    {
+        return false;
+    }
+
+    if ( --postRemaining == 0 )
+    {
+        state = TRIGGER_DONE;
+    }
+
+    return true;
+}
+
+// ==============================================================================================================
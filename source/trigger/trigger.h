@@ -0,0 +1,95 @@
+/*
+ * trigger.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_TRIGGER_TRIGGER_H_
+#define SOURCE_TRIGGER_TRIGGER_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Size of pre-trigger history ring in bytes. Every frame
+// occupies its length + TRIGGER_ENTRY_HDR_SIZE bytes.
+//
+#define TRIGGER_HISTORY_SIZE      (4096)
+
+#define TRIGGER_ENTRY_HDR_SIZE    (2)
+
+//
+// Pattern is limited so that its textual form
+// fits into one dashboard token (MAXLEN)
+//
+#define TRIGGER_PATTERN_MAXLEN    (8)
+
+#define TRIGGER_POST_FRAMES_MAX   (255)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === Trigger_State_t
+ * TRIGGER_OFF        - trigger not used, frames are streamed as usual
+ * TRIGGER_ARMED      - frames are kept in history ring, pattern is evaluated
+ * TRIGGER_POST       - pattern matched, history was flushed, post-trigger
+ *                      frames are being forwarded
+ * TRIGGER_DONE       - post-trigger window elapsed, frames are dropped
+ *                      until the trigger is re-armed or disarmed
+ */
+typedef enum Trigger_State
+{
+    TRIGGER_OFF = 0,
+    TRIGGER_ARMED,
+    TRIGGER_POST,
+    TRIGGER_DONE
+} Trigger_State_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+bool            Trigger_SetPattern(const char* pPattern);
+
+bool            Trigger_IsValidPattern(const char* pPattern);
+
+const char*     Trigger_GetPattern(void);
+
+void            Trigger_SetOffset(uint16_t offset);
+
+uint16_t        Trigger_GetOffset(void);
+
+void            Trigger_SetPostFrames(uint8_t count);
+
+uint8_t         Trigger_GetPostFrames(void);
+
+void            Trigger_Arm(bool bArm);
+
+Trigger_State_t Trigger_GetState(void);
+
+bool            Trigger_Match(const uint8_t* pFrame, uint16_t len);
+
+void            Trigger_PushHistory(const uint8_t* pFrame, uint16_t len);
+
+uint16_t        Trigger_PopHistory(uint8_t* pFrame, uint16_t maxlen);
+
+bool            Trigger_ProcessFrame(const uint8_t* pFrame, uint16_t len);
+
+bool            Trigger_CountPostFrame(void);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_TRIGGER_TRIGGER_H_ */
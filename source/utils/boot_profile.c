@@ -0,0 +1,98 @@
+/*
+ * boot_profile.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <ti/sysbios/runtime/Timestamp.h>
+
+#include <source/utils/boot_profile.h>
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+static uint32_t stamps[BOOT_PHASE_COUNT];
+
+//
+// Bit per phase, set by the first mark
+//
+static uint16_t marked;
+
+static const char* const phaseNames[BOOT_PHASE_COUNT] =
+{
+    [BOOT_PHASE_INIT]        = "init",
+    [BOOT_PHASE_CONFIG]      = "config",
+    [BOOT_PHASE_RADIO_RX]    = "radioRx",
+    [BOOT_PHASE_OLED]        = "oled",
+    [BOOT_PHASE_NETWORK]     = "network",
+    [BOOT_PHASE_CAPTURE]     = "capture",
+    [BOOT_PHASE_DASHBOARD]   = "dashboard",
+    [BOOT_PHASE_FIRST_FRAME] = "firstFrame"
+};
+
+_Static_assert(BOOT_PHASE_COUNT <= 16, "marked has a bit per phase");
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === BootProfile_Mark
+ * Timestamps the phase, only the first mark of a phase counts,
+ * so it can be called on a path taken repeatedly (every frame).
+ *
+ * Parameters:
+ *      phase[in]       - phase reached
+ * Returns:
+ *      N/A
+ */
+void BootProfile_Mark(BootProfile_Phase_t phase)
+{
+    if ( marked & ( 1 << phase ) )
+    {
+        return;
+    }
+
+    stamps[phase] = Timestamp_get32();
+
+    marked |= ( 1 << phase );
+
+    return;
+}
+
+/*
+ * === BootProfile_Get
+ * Parameters:
+ *      phase[in]       - phase
+ *      pMicros[out]    - microseconds from BOOT_PHASE_INIT
+ * Returns:
+ *      false when the phase (or init) was not reached yet
+ */
+bool BootProfile_Get(BootProfile_Phase_t phase, uint32_t* pMicros)
+{
+    Types_FreqHz freq;
+
+    if ( phase >= BOOT_PHASE_COUNT || !( marked & ( 1 << phase ) ) || !( marked & ( 1 << BOOT_PHASE_INIT ) ) )
+    {
+        return false;
+    }
+
+    Timestamp_getFreq(&freq);
+
+    *pMicros = (uint32_t)( (uint64_t)( stamps[phase] - stamps[BOOT_PHASE_INIT] ) * 1000000 / freq.lo );
+
+    return true;
+}
+
+const char* BootProfile_GetName(BootProfile_Phase_t phase)
+{
+    return phaseNames[phase];
+}
+
+// ==============================================================================================================
@@ -0,0 +1,54 @@
+/*
+ * boot_profile.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_UTILS_BOOT_PROFILE_H_
+#define SOURCE_UTILS_BOOT_PROFILE_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+/*
+ * === BootProfile_Phase_t
+ * Milestones of the start, in the order they are usually reached.
+ * Radio, OLED and network come up in parallel (sniffing, GUI and
+ * init task), so RADIO_RX, OLED and NETWORK may come in any order.
+ */
+typedef enum BootProfile_Phase
+{
+    BOOT_PHASE_INIT = 0,        // init task started (BIOS running), time base
+    BOOT_PHASE_CONFIG,          // settings loaded
+    BOOT_PHASE_RADIO_RX,        // Radio Core open, frames buffered in radio queue
+    BOOT_PHASE_OLED,            // SSD1306 initialized
+    BOOT_PHASE_NETWORK,         // W5500 configured (static, DHCP or warm restart)
+    BOOT_PHASE_CAPTURE,         // sniffing task forwards frames
+    BOOT_PHASE_DASHBOARD,       // HTTP server listens
+    BOOT_PHASE_FIRST_FRAME,     // first frame taken from the radio queue
+    BOOT_PHASE_COUNT
+} BootProfile_Phase_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void        BootProfile_Mark(BootProfile_Phase_t phase);
+
+bool        BootProfile_Get(BootProfile_Phase_t phase, uint32_t* pMicros);
+
+const char* BootProfile_GetName(BootProfile_Phase_t phase);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_UTILS_BOOT_PROFILE_H_ */
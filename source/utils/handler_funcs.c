@@ -11,11 +11,24 @@
 
 #include <stdint.h>
 
+#include <string.h>
+
 #include <source/utils/handler_funcs.h>
 
 // ==============================================================================================================
 
 
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct HttpRoute
+{
+    const char*        pPath;
+    HttpRouteHandler_t handler;
+} HttpRoute_t;
+
+// ==============================================================================================================
+
+
 // === PUBLIC VARIABLES =========================================================================================
 
 HttpHandlerFunction_t httpHandlerFunctions[26];
@@ -23,10 +36,43 @@ HttpHandlerFunction_t httpHandlerFunctions[26];
 // ==============================================================================================================
 
 
+// === STATIC VARIABLES =========================================================================================
+
+/*
+ * === httpRoutes
+ * Open addressing hash table of request paths,
+ * free slots have pPath == NULL.
+ */
+static HttpRoute_t httpRoutes[HANDLER_FUNCS_ROUTE_SLOTS];
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+/*
+ * === hashPath
+ * FNV-1a of the path folded to the table size.
+ */
+static uint8_t hashPath(const char* pPath)
+{
+    uint32_t hash = 2166136261u;
+
+    while ( *pPath )
+    {
+        hash ^= (uint8_t)*pPath++;
+        hash *= 16777619u;
+    }
+
+    return (uint8_t)(( hash ^ ( hash >> 16 )) & ( HANDLER_FUNCS_ROUTE_SLOTS - 1 ));
+}
+
+// ==============================================================================================================
+
 
 // === FUNCTION DECLARATIONS ====================================================================================
 
-void HandlerFuncs_RegisterHandlerFunction(char key, void* handlerFunction)
+void HandlerFuncs_RegisterHandlerFunction(char key, bool (*handlerFunction)(const char*))
 {
     httpHandlerFunctions[CHAR_KEY(key)].handlerFunc = handlerFunction;
 
@@ -40,3 +86,87 @@ void HandlerFuncs_UnregisterHandlerFunction(char key)
 
     return;
 }
+
+
+/*
+ * === HandlerFuncs_CallHandlerFunction
+ * Dispatches value of a dashboard key to its handler.
+ *
+ * Parameters:
+ *      key[in]             - 'a'..'z'
+ *      pValue[in]          - value
+ * Returns:
+ *      bool                - false when no handler is registered
+ *                            or the handler refused the value
+ */
+bool HandlerFuncs_CallHandlerFunction(char key, const char* pValue)
+{
+    if ( key < 'a' || key > 'z' || httpHandlerFunctions[CHAR_KEY(key)].handlerFunc == NULL )
+    {
+        return false;
+    }
+
+    return httpHandlerFunctions[CHAR_KEY(key)].handlerFunc(pValue);
+}
+
+
+/*
+ * === HandlerFuncs_RegisterRoute
+ * Adds request path to the route table, registering
+ * the same path again replaces its handler.
+ *
+ * Parameters:
+ *      pPath[in]           - path without query, has to stay valid
+ *      handler[in]         - handler
+ * Returns:
+ *      bool                - false when the table is full
+ */
+bool HandlerFuncs_RegisterRoute(const char* pPath, HttpRouteHandler_t handler)
+{
+    uint8_t slot = hashPath(pPath);
+    uint8_t i;
+
+    for ( i = 0; i < HANDLER_FUNCS_ROUTE_SLOTS; i++ )
+    {
+        if ( httpRoutes[slot].pPath == NULL || strcmp(httpRoutes[slot].pPath, pPath) == 0 )
+        {
+            httpRoutes[slot].pPath   = pPath;
+            httpRoutes[slot].handler = handler;
+
+            return true;
+        }
+
+        slot = ( slot + 1 ) & ( HANDLER_FUNCS_ROUTE_SLOTS - 1 );
+    }
+
+    return false;
+}
+
+
+/*
+ * === HandlerFuncs_LookupRoute
+ * Finds handler of a request path. With the table kept sparse,
+ * the lookup is one hash and (usually) one string compare.
+ *
+ * Parameters:
+ *      pPath[in]           - path without query
+ * Returns:
+ *      HttpRouteHandler_t  - handler or NULL
+ */
+HttpRouteHandler_t HandlerFuncs_LookupRoute(const char* pPath)
+{
+    uint8_t slot = hashPath(pPath);
+    uint8_t i;
+
+    for ( i = 0; i < HANDLER_FUNCS_ROUTE_SLOTS && httpRoutes[slot].pPath != NULL; i++ )
+    {
+        if ( strcmp(httpRoutes[slot].pPath, pPath) == 0 )
+        {
+            return httpRoutes[slot].handler;
+        }
+
+        slot = ( slot + 1 ) & ( HANDLER_FUNCS_ROUTE_SLOTS - 1 );
+    }
+
+    return NULL;
+}
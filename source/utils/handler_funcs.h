@@ -8,17 +8,46 @@
 #ifndef SOURCE_UTILS_HANDLER_FUNCS_H_
 #define SOURCE_UTILS_HANDLER_FUNCS_H_
 
+#include <stdbool.h>
+
+#include <source/http/http_reader.h>
+
 #define CHAR_KEY(key)    ((key) - 'a')
 
+//
+// Route table slots, has to be a power of two
+// and well above the number of routes
+//
+#define HANDLER_FUNCS_ROUTE_SLOTS   (16)
+
+/*
+ * === HttpHandlerFunction_t
+ * Handler of a dashboard key ('a'..'z'), gets the value from
+ * query string / API. Returns false when the value is invalid,
+ * nothing is applied then.
+ */
 typedef struct HttpHandlerFunction
 {
-    void* (*handlerFunc)();
+    bool (*handlerFunc)(const char* pValue);
 } HttpHandlerFunction_t;
 
-void HandlerFuncs_RegisterHandlerFunction(char, void*);
+/*
+ * === HttpRouteHandler_t
+ * Handler of a request path. Checks the method on its own
+ * and always sends a response.
+ */
+typedef void (*HttpRouteHandler_t)(EthernetClient* pClient, HttpRequest_t* pRequest);
+
+void HandlerFuncs_RegisterHandlerFunction(char, bool (*)(const char*));
 
 void HandlerFuncs_UnregisterHandlerFunction(char);
 
+bool HandlerFuncs_CallHandlerFunction(char, const char*);
+
+bool HandlerFuncs_RegisterRoute(const char*, HttpRouteHandler_t);
+
+HttpRouteHandler_t HandlerFuncs_LookupRoute(const char*);
+
 
 
 #endif /* SOURCE_UTILS_HANDLER_FUNCS_H_ */
@@ -1,14 +1,18 @@
 .global RestartMCU
 .global _c_int00
 .global __stack
+.global WarmStart_Suspend
 
 /* === RestartMCU
 /* Short routine to perform MCU restart by zeroing R0..R12 registers
 /* and setting Stack Pointer register to the start address of stack
-/* ('__stack' symbol)
+/* ('__stack' symbol). State of W5500 is saved to retained RAM first
+/* (WarmStart_Suspend), so that init can take it over.
 /*/
 RestartMCU:
 
+	BL		WarmStart_Suspend	/* Save W5500 state to retained RAM */
+
 	LDR		SP,=__stack		/* Set Stack Pointer to the beginning of the stack memory */
 
 	MOV		R0,#0			/* Zero out R0.. R12 registers */
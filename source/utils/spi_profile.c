@@ -0,0 +1,262 @@
+/*
+ * spi_profile.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <ti/sysbios/knl/Task.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <source/utils/trace.h>
+
+#include <source/utils/spi_profile.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// W5500 control byte: [block select, 5 bits][RWB][OM, 2 bits]
+//
+#define CB_WRITE                (0x04)
+#define CB_BLOCK(cb)            ( (cb) >> 3 )
+#define BLOCK_COMMON            (0x00)
+#define BLOCK_IS_SOCKET_REG(b)  ( ( (b) & 0x03 ) == 0x01 )     // socket n: n * 4 + 1
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+extern Task_Handle sniffingTaskHandle;
+
+extern Task_Handle dashboardTaskHandle;
+
+SpiProfile_Frame_t SpiProfile_frame;
+
+#ifdef SPI_PROFILE
+
+static SpiProfile_Counters_t categories[SPI_PROFILE_CATEGORY_COUNT];
+
+static uint32_t              clearTicks;
+
+//
+// Task with an open DHCP/DNS scope, NULL if none. The
+// scope blocks (DHCP waits for the server) and the other
+// tasks keep their own category meanwhile.
+//
+static Task_Handle           scopeTask;
+
+static SpiProfile_Category_t scopeCategory;
+
+#endif
+
+static const char* const categoryNames[SPI_PROFILE_CATEGORY_COUNT] =
+{
+    [SPI_PROFILE_CAPTURE]  = "capture",
+    [SPI_PROFILE_HTTP]     = "http",
+    [SPI_PROFILE_DHCP_DNS] = "dhcpDns",
+    [SPI_PROFILE_POLL]     = "poll",
+    [SPI_PROFILE_OTHER]    = "other"
+};
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+#ifdef SPI_PROFILE
+
+/*
+ * === isPoll
+ * Reads of the registers which are polled for
+ * status: interrupts, PHY link, socket command
+ * completion, state and buffer fill.
+ */
+static bool isPoll(uint16_t addr, uint8_t controlByte)
+{
+    uint8_t block = CB_BLOCK(controlByte);
+
+    if ( controlByte & CB_WRITE )
+    {
+        return false;
+    }
+
+    if ( block == BLOCK_COMMON )
+    {
+        return ( addr == 0x0015 ) || ( addr == 0x0017 ) || ( addr == 0x002E );     // IR, SIR, PHYCFGR
+    }
+
+    if ( BLOCK_IS_SOCKET_REG(block) )
+    {
+        return ( addr >= 0x0001 && addr <= 0x0003 )                                 // Sn_CR, Sn_IR, Sn_SR
+            || ( ( addr & ~1 ) == 0x0020 )                                          // Sn_TX_FSR
+            || ( ( addr & ~1 ) == 0x0026 );                                         // Sn_RX_RSR
+    }
+
+    return false;
+}
+
+static SpiProfile_Category_t categoryOfTask(void)
+{
+    Task_Handle self = Task_self();
+
+    if ( self == scopeTask )
+    {
+        return scopeCategory;
+    }
+
+    if ( self == sniffingTaskHandle )
+    {
+        return SPI_PROFILE_CAPTURE;
+    }
+
+    if ( self == dashboardTaskHandle )
+    {
+        return SPI_PROFILE_HTTP;
+    }
+
+    return SPI_PROFILE_OTHER;
+}
+
+#endif
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === SpiProfile_BeginFrame
+ * Called by SPI_PROFILE_FRAME() before a W5500 frame. SPI is used
+ * by tasks only and a frame never blocks (single byte transfers are
+ * polled by the SPI driver), so one frame is in flight at a time.
+ *
+ * Parameters:
+ *      addr[in]        - W5500 register or buffer address
+ *      controlByte[in] - block select, read/write
+ * Returns:
+ *      N/A
+ */
+void SpiProfile_BeginFrame(uint16_t addr, uint8_t controlByte)
+{
+#ifdef SPI_PROFILE
+
+    SpiProfile_frame.category  = isPoll(addr, controlByte) ? SPI_PROFILE_POLL : categoryOfTask();
+    SpiProfile_frame.transfers = 0;
+    SpiProfile_frame.bytes     = 0;
+
+#endif
+
+    return;
+}
+
+/*
+ * === SpiProfile_EndFrame
+ * Called by SPI_PROFILE_CS_HIGH(), adds the frame to its category.
+ */
+void SpiProfile_EndFrame(void)
+{
+#ifdef SPI_PROFILE
+
+    SpiProfile_Counters_t* pCounters = &categories[SpiProfile_frame.category];
+    uint32_t               cycles    = TRACE_CYCLES() - SpiProfile_frame.start;
+
+    pCounters->frames++;
+    pCounters->transfers += SpiProfile_frame.transfers;
+    pCounters->bytes     += SpiProfile_frame.bytes;
+    pCounters->cycles    += cycles;
+
+    if ( cycles > pCounters->maxCycles )
+    {
+        pCounters->maxCycles = cycles;
+    }
+
+#endif
+
+    return;
+}
+
+/*
+ * === SpiProfile_Enter
+ * Opens a scope of the calling task, its frames other than
+ * polling go to category until SpiProfile_Leave(). Scopes do
+ * not nest, a single task at a time holds one.
+ */
+void SpiProfile_Enter(SpiProfile_Category_t category)
+{
+#ifdef SPI_PROFILE
+
+    scopeCategory = category;
+
+    scopeTask     = Task_self();
+
+#endif
+
+    return;
+}
+
+void SpiProfile_Leave(void)
+{
+#ifdef SPI_PROFILE
+
+    scopeTask = NULL;
+
+#endif
+
+    return;
+}
+
+/*
+ * === SpiProfile_TakeSnapshot
+ * Copies the counters of all categories, optionally clears them
+ * so that the next snapshot covers a new window. Called by a task,
+ * frames are never half accounted then.
+ *
+ * Parameters:
+ *      pSnapshot[out]  - counters and length of the window
+ *      bClear[in]      - start a new window
+ * Returns:
+ *      false when built without SPI_PROFILE
+ */
+bool SpiProfile_TakeSnapshot(SpiProfile_Snapshot_t* pSnapshot, bool bClear)
+{
+#ifdef SPI_PROFILE
+
+    uint32_t now = Clock_getTicks();
+
+    pSnapshot->ticks = now - clearTicks;
+
+    memcpy(pSnapshot->categories, categories, sizeof(categories));
+
+    if ( bClear )
+    {
+        memset(categories, 0, sizeof(categories));
+
+        clearTicks = now;
+    }
+
+    return true;
+
+#else
+
+    memset(pSnapshot, 0, sizeof(*pSnapshot));
+
+    return false;
+
+#endif
+}
+
+const char* SpiProfile_GetName(SpiProfile_Category_t category)
+{
+    return categoryNames[category];
+}
+
+// ==============================================================================================================
@@ -0,0 +1,156 @@
+/*
+ * spi_profile.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_UTILS_SPI_PROFILE_H_
+#define SOURCE_UTILS_SPI_PROFILE_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+//
+// Build flag:
+//      SPI_PROFILE     - W5500 SPI traffic is accounted per caller
+//                        category; without it every hook below
+//                        expands to nothing
+//
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+/*
+ * === SpiProfile_Category_t
+ * Who a W5500 SPI frame is accounted to. Reads of status registers
+ * (IR, SIR, PHYCFGR, Sn_CR, Sn_IR, Sn_SR, Sn_TX_FSR, Sn_RX_RSR) are
+ * polling whoever reads them, other frames go to the DHCP/DNS scope
+ * when one is open in the calling task, else to the calling task.
+ */
+typedef enum SpiProfile_Category
+{
+    SPI_PROFILE_CAPTURE = 0,        // sniffing task: frames, records, trace, control
+    SPI_PROFILE_HTTP,               // dashboard task: pages, REST, SSE, metrics
+    SPI_PROFILE_DHCP_DNS,           // lease requests and renewals, host lookups
+    SPI_PROFILE_POLL,               // status register reads
+    SPI_PROFILE_OTHER,              // init and monitor task, chip setup
+    SPI_PROFILE_CATEGORY_COUNT
+} SpiProfile_Category_t;
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+typedef struct SpiProfile_Counters
+{
+    uint32_t frames;                // CS assertions
+    uint32_t transfers;             // SPI_transfer() calls
+    uint32_t bytes;                 // clocked in both directions at once
+    uint64_t cycles;                // CS held low, TRACE_CYCLES()
+    uint32_t maxCycles;             // longest frame
+} SpiProfile_Counters_t;
+
+typedef struct SpiProfile_Snapshot
+{
+    uint32_t              ticks;    // Clock ticks since the counters were cleared
+    SpiProfile_Counters_t categories[SPI_PROFILE_CATEGORY_COUNT];
+} SpiProfile_Snapshot_t;
+
+/*
+ * === SpiProfile_Frame_t
+ * Frame being clocked, folded into its category
+ * when CS goes high. Written by the hooks only.
+ */
+typedef struct SpiProfile_Frame
+{
+    SpiProfile_Category_t category;
+    uint32_t              start;
+    uint16_t              transfers;
+    uint16_t              bytes;
+} SpiProfile_Frame_t;
+
+extern SpiProfile_Frame_t SpiProfile_frame;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void        SpiProfile_BeginFrame(uint16_t addr, uint8_t controlByte);
+
+void        SpiProfile_EndFrame(void);
+
+void        SpiProfile_Enter(SpiProfile_Category_t category);
+
+void        SpiProfile_Leave(void);
+
+bool        SpiProfile_TakeSnapshot(SpiProfile_Snapshot_t* pSnapshot, bool bClear);
+
+const char* SpiProfile_GetName(SpiProfile_Category_t category);
+
+// ==============================================================================================================
+
+
+// === PROFILING HOOKS ==========================================================================================
+
+/*
+ * === SPI_PROFILE_*
+ * FRAME   - w5500.c, before CS goes low: register address and control
+ *           byte select the category
+ * CS_LOW  - setSS(), starts timing the frame
+ * XFER    - SPI_transf(), every SPI_transfer() of count bytes
+ * CS_HIGH - resetSS(), adds the frame to its category
+ * ENTER / LEAVE - around DHCP and DNS calls
+ */
+#ifdef SPI_PROFILE
+
+#include <source/utils/trace.h>
+
+#define SPI_PROFILE_FRAME(addr, cb)     SpiProfile_BeginFrame((addr), (cb))
+
+#define SPI_PROFILE_CS_LOW()            ( SpiProfile_frame.start = TRACE_CYCLES() )
+
+#define SPI_PROFILE_XFER(count)                                                     \
+    do                                                                              \
+    {                                                                               \
+        SpiProfile_frame.transfers++;                                               \
+        SpiProfile_frame.bytes += (count);                                          \
+    } while ( 0 )
+
+#define SPI_PROFILE_CS_HIGH()           SpiProfile_EndFrame()
+
+#define SPI_PROFILE_ENTER(category)     SpiProfile_Enter(category)
+
+#define SPI_PROFILE_LEAVE()             SpiProfile_Leave()
+
+#else
+
+#define SPI_PROFILE_FRAME(addr, cb)     ((void)0)
+
+#define SPI_PROFILE_CS_LOW()            ((void)0)
+
+#define SPI_PROFILE_XFER(count)         ((void)0)
+
+#define SPI_PROFILE_CS_HIGH()           ((void)0)
+
+#define SPI_PROFILE_ENTER(category)     ((void)0)
+
+#define SPI_PROFILE_LEAVE()             ((void)0)
+
+#endif
+
+// ==============================================================================================================
+
+#endif /* SOURCE_UTILS_SPI_PROFILE_H_ */
@@ -0,0 +1,276 @@
+/*
+ * stats.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include "ti_radio_config.h"
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <source/radio_api/radio_api.h>
+
+#include <source/utils/stats.h>
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+extern rfc_bleGenericRxOutput_t bleStats;
+
+extern rfc_ieeeRxOutput_t       ieeeStats;
+
+static uint32_t counters[STATS_COUNT];
+
+//
+// RF Core frame counter and protocol at the last Stats_SampleRadio()
+//
+static uint16_t      lastRfRxOk;
+
+static RF_Protocol_t lastRfProto = BluetoothLowEnergy;
+
+/*
+ * === counterNames
+ * Names under which counters are published (JSON API).
+ * Order has to follow Stats_Counter_t.
+ */
+static const char* const counterNames[STATS_COUNT] =
+{
+    "rxFrames",
+    "txDatagrams",
+    "txErrors",
+    "recordDatagrams",
+    "triggerFires",
+    "rxOverflows",
+    "triggerDrops",
+    "spiTransactions",
+    "spiBytes",
+    "replayFrames",
+    "replayLost",
+    "replayRejected",
+    "rfRxOk",
+    "queueDiscards",
+    "rxFiltered",
+    "txFrames",
+    "txShortWrites",
+    "txTimeouts"
+};
+
+static Stats_HistogramData_t histograms[STATS_HIST_COUNT];
+
+static const uint32_t histogramBounds[STATS_HIST_COUNT][STATS_HIST_BUCKETS] =
+{
+    { 16, 32, 64, 128, 256, 512, 1024, 2047 },              // STATS_HIST_FRAME_BYTES
+    { 50, 100, 250, 500, 1000, 2500, 5000, 10000 },         // STATS_HIST_LATENCY_QUEUE
+    { 20, 50, 100, 200, 400, 800, 1600, 3200 },             // STATS_HIST_LATENCY_SPI
+    { 5, 10, 20, 50, 100, 200, 500, 1000 },                 // STATS_HIST_LATENCY_SEND
+    { 100, 250, 500, 1000, 2500, 5000, 10000, 25000 }       // STATS_HIST_LATENCY_TOTAL
+};
+
+/*
+ * === histogramNames
+ * Names under which histograms are published (JSON API).
+ * Order has to follow Stats_Histogram_t.
+ */
+static const char* const histogramNames[STATS_HIST_COUNT] =
+{
+    "frameBytes",
+    "latencyQueueUs",
+    "latencySpiUs",
+    "latencySendUs",
+    "latencyTotalUs"
+};
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void Stats_Increment(Stats_Counter_t counter)
+{
+    counters[counter]++;
+
+    return;
+}
+
+
+void Stats_Add(Stats_Counter_t counter, uint32_t value)
+{
+    counters[counter] += value;
+
+    return;
+}
+
+
+uint32_t Stats_Get(Stats_Counter_t counter)
+{
+    return counters[counter];
+}
+
+
+const char* Stats_GetName(Stats_Counter_t counter)
+{
+    return counterNames[counter];
+}
+
+
+/*
+ * === Stats_TakeSnapshot
+ * Copies RF Core counters (bleStats/ieeeStats) and capture path
+ * counters to caller's buffer.
+ *
+ * Parameters:
+ *      pSnapshot[out]      - snapshot to be filled
+ * Returns:
+ *      N/A
+ */
+void Stats_TakeSnapshot(Stats_Snapshot_t* pSnapshot)
+{
+    pSnapshot->ticks     = Clock_getTicks();
+    pSnapshot->bleRxOk   = bleStats.nRxOk;
+    pSnapshot->bleRxNok  = bleStats.nRxNok;
+    pSnapshot->ieeeRxOk  = ieeeStats.nRxData + ieeeStats.nRxBeacon + ieeeStats.nRxMacCmd;
+    pSnapshot->ieeeRxNok = ieeeStats.nRxNok;
+    pSnapshot->lastRssi  = ( Radio_GetCurrentProtocol() == BluetoothLowEnergy ) ? bleStats.lastRssi : ieeeStats.lastRssi;
+
+    memcpy(pSnapshot->counters, counters, sizeof(counters));
+
+    return;
+}
+
+
+/*
+ * === Stats_SampleRadio
+ * Adds frames RF Core received since the last call to STATS_RF_RX_OK,
+ * extending its 16 bit (BLE) or 8 bit (IEEE) counter. A counter lower
+ * than the last sample is taken as restarted by a new RX command, so
+ * it has to be called more often than RF Core receives 256 frames.
+ * After a protocol change the first sample only sets the baseline.
+ * Frames RF Core could not store are STATS_RX_OVERFLOWS.
+ *
+ * Parameters:
+ *      proto[in]           - protocol the radio listens to
+ * Returns:
+ *      N/A
+ */
+void Stats_SampleRadio(RF_Protocol_t proto)
+{
+    uint16_t rxOk;
+
+    if ( proto == BluetoothLowEnergy )
+    {
+        rxOk = bleStats.nRxOk;
+    }
+    else
+    {
+        rxOk = (uint8_t)( ieeeStats.nRxData + ieeeStats.nRxBeacon + ieeeStats.nRxMacCmd + ieeeStats.nRxAck + ieeeStats.nRxReserved );
+    }
+
+    if ( proto == lastRfProto )
+    {
+        counters[STATS_RF_RX_OK] += ( rxOk >= lastRfRxOk ) ? (uint16_t)( rxOk - lastRfRxOk ) : rxOk;
+    }
+
+    lastRfRxOk  = rxOk;
+    lastRfProto = proto;
+
+    return;
+}
+
+
+/*
+ * === Stats_Observe
+ * Adds a value to the histogram.
+ *
+ * Parameters:
+ *      hist[in]            - histogram
+ *      value[in]           - observed value
+ * Returns:
+ *      N/A
+ */
+void Stats_Observe(Stats_Histogram_t hist, uint32_t value)
+{
+    Stats_HistogramData_t* pHist = &histograms[hist];
+    uint8_t                i;
+
+    for ( i = 0; i < STATS_HIST_BUCKETS; i++ )
+    {
+        if ( value <= histogramBounds[hist][i] )
+        {
+            pHist->buckets[i]++;
+
+            break;
+        }
+    }
+
+    pHist->count++;
+    pHist->sum += value;
+
+    if ( value > pHist->max )
+    {
+        pHist->max = value;
+    }
+
+    return;
+}
+
+
+void Stats_GetHistogram(Stats_Histogram_t hist, Stats_HistogramData_t* pData)
+{
+    *pData = histograms[hist];
+
+    return;
+}
+
+
+const uint32_t* Stats_GetHistogramBounds(Stats_Histogram_t hist)
+{
+    return histogramBounds[hist];
+}
+
+
+const char* Stats_GetHistogramName(Stats_Histogram_t hist)
+{
+    return histogramNames[hist];
+}
+
+
+/*
+ * === Stats_GetPercentile
+ * Estimates a percentile as the upper bound of the bucket it falls
+ * into, never above the largest value observed. Values above the
+ * last bound are estimated by the largest value.
+ *
+ * Parameters:
+ *      pData[in]           - histogram (Stats_GetHistogram)
+ *      pBounds[in]         - its bounds (Stats_GetHistogramBounds)
+ *      permille[in]        - percentile * 10 (500 = p50, 990 = p99)
+ * Returns:
+ *      uint32_t            - estimate, 0 for an empty histogram
+ */
+uint32_t Stats_GetPercentile(const Stats_HistogramData_t* pData, const uint32_t* pBounds, uint16_t permille)
+{
+    uint32_t rank       = (uint32_t)( ( (uint64_t)pData->count * permille + 999 ) / 1000 );
+    uint32_t cumulative = 0;
+    uint8_t  i;
+
+    for ( i = 0; i < STATS_HIST_BUCKETS; i++ )
+    {
+        cumulative += pData->buckets[i];
+
+        if ( cumulative >= rank )
+        {
+            return ( pBounds[i] < pData->max ) ? pBounds[i] : pData->max;
+        }
+    }
+
+    return pData->max;
+}
+
+// ==============================================================================================================
@@ -0,0 +1,137 @@
+/*
+ * stats.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_UTILS_STATS_H_
+#define SOURCE_UTILS_STATS_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <source/radio_api/radio_api.h>
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+/*
+ * === Stats_Counter_t
+ * Capture path counters. RF Core counters (nRxOk, ...) are kept
+ * by RF driver in bleStats/ieeeStats, these count what the
+ * firmware does with the frames afterwards.
+ */
+typedef enum Stats_Counter
+{
+    STATS_RX_FRAMES = 0,        // frames taken from the radio queue
+    STATS_TX_DATAGRAMS,         // datagrams sent to the target
+    STATS_TX_ERRORS,            // datagrams W5500 failed to send
+    STATS_RECORD_DATAGRAMS,     // datagrams carrying BLE records
+    STATS_TRIGGER_FIRES,        // trigger pattern matches
+    STATS_RX_OVERFLOWS,         // radio queue overflows (frames dropped)
+    STATS_TRIGGER_DROPS,        // frames discarded by trigger (window over)
+    STATS_SPI_TRANSACTIONS,     // W5500 SPI frames (one per CS assertion)
+    STATS_SPI_BYTES,            // bytes clocked over SPI to/from W5500
+    STATS_REPLAY_FRAMES,        // frames written into the radio queue by replay (REPLAY_INJECT)
+    STATS_REPLAY_LOST,          // replay frames missing in the sequence (lost on the way in)
+    STATS_REPLAY_REJECTED,      // replay frames of the other protocol or too long
+    STATS_RF_RX_OK,             // frames RF Core received and stored, see Stats_SampleRadio
+    STATS_QUEUE_DISCARDS,       // frames dropped from the radio queue by RadioQueue_reset()
+    STATS_RX_FILTERED,          // frames taken but not forwarded on purpose (records-only, trigger)
+    STATS_TX_FRAMES,            // frames written into a datagram to the target
+    STATS_TX_SHORT_WRITES,      // capture datagrams cut short, no room in W5500 TX buffer
+    STATS_TX_TIMEOUTS,          // capture datagrams W5500 dropped, ARP of the target timed out
+    STATS_COUNT
+} Stats_Counter_t;
+
+/*
+ * === Stats_Histogram_t
+ * Distributions, each with STATS_HIST_BUCKETS upper
+ * bounds (see histogramBounds in stats.c).
+ */
+typedef enum Stats_Histogram
+{
+    STATS_HIST_FRAME_BYTES = 0, // length of frames taken from the radio queue
+    STATS_HIST_LATENCY_QUEUE,   // us, end of reception -> taken from the radio queue
+    STATS_HIST_LATENCY_SPI,     // us, taken -> datagram written to W5500 over SPI
+    STATS_HIST_LATENCY_SEND,    // us, written -> Sock_SEND issued
+    STATS_HIST_LATENCY_TOTAL,   // us, end of reception -> Sock_SEND issued
+    STATS_HIST_COUNT
+} Stats_Histogram_t;
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define STATS_HIST_BUCKETS      (8)
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === Stats_Snapshot_t
+ * All counters taken at one point in time, so that consumers
+ * (JSON API, event stream) report and subtract consistent values
+ * instead of reading live counters one by one.
+ */
+typedef struct Stats_Snapshot
+{
+    uint32_t ticks;                     // Clock ticks when taken
+    uint32_t bleRxOk;
+    uint32_t bleRxNok;
+    uint32_t ieeeRxOk;
+    uint32_t ieeeRxNok;
+    int8_t   lastRssi;                  // of the current protocol
+    uint32_t counters[STATS_COUNT];
+} Stats_Snapshot_t;
+
+/*
+ * === Stats_HistogramData_t
+ * buckets[i] counts values v with bounds[i - 1] < v <= bounds[i],
+ * values above the last bound are only in count (and sum).
+ */
+typedef struct Stats_HistogramData
+{
+    uint32_t buckets[STATS_HIST_BUCKETS];
+    uint32_t count;
+    uint32_t sum;
+    uint32_t max;
+} Stats_HistogramData_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void        Stats_Increment(Stats_Counter_t counter);
+
+void        Stats_Add(Stats_Counter_t counter, uint32_t value);
+
+uint32_t    Stats_Get(Stats_Counter_t counter);
+
+const char* Stats_GetName(Stats_Counter_t counter);
+
+void        Stats_TakeSnapshot(Stats_Snapshot_t* pSnapshot);
+
+void        Stats_SampleRadio(RF_Protocol_t proto);
+
+void        Stats_Observe(Stats_Histogram_t hist, uint32_t value);
+
+void        Stats_GetHistogram(Stats_Histogram_t hist, Stats_HistogramData_t* pData);
+
+const uint32_t* Stats_GetHistogramBounds(Stats_Histogram_t hist);
+
+const char* Stats_GetHistogramName(Stats_Histogram_t hist);
+
+uint32_t    Stats_GetPercentile(const Stats_HistogramData_t* pData, const uint32_t* pBounds, uint16_t permille);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_UTILS_STATS_H_ */
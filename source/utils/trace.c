@@ -0,0 +1,370 @@
+/*
+ * trace.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <string.h>
+
+#include <ti/sysbios/BIOS.h>
+
+#include <ti/sysbios/knl/Clock.h>
+
+#include <source/utils/trace.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define TRACE_DATAGRAM_VERSION  (1)
+
+//
+// Datagram: [magic 'T'][version][record count][reserved]
+//           [Clock ticks, u32][TRACE_CYCLES(), u32][dropped, u32]
+//           [Trace_Record_t * count]
+// The tick/cycle pair taken at drain time lets the host turn record
+// cycles into time (cycle counter wraps every ~89 s at 48 MHz).
+//
+#define TRACE_HEADER_SIZE       (16)
+
+#define TRACE_MAX_RECORDS       (TRACE_RING_SIZE)
+
+//
+// Drained at most every 10 ms (Clock.tickPeriod = 10 us)
+//
+#define TRACE_DRAIN_TICKS       (1000)
+
+#define DWT_CTRL                ( *(volatile uint32_t*)0xE0001000 )
+#define DWT_CTRL_CYCCNTENA      (0x00000001)
+#define DEMCR                   ( *(volatile uint32_t*)0xE000EDFC )
+#define DEMCR_TRCENA            (0x01000000)
+
+#define BARRIER()               __asm volatile ("" ::: "memory")
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === Trace_Ring_t
+ * head is written by the producer only, after the record,
+ * tail by the drain only. Records older than head - TRACE_RING_SIZE
+ * are overwritten, the producer never waits.
+ */
+typedef struct Trace_Ring
+{
+    volatile uint32_t head;
+    uint32_t          tail;
+    Trace_Record_t    records[TRACE_RING_SIZE];
+} Trace_Ring_t;
+
+_Static_assert(( TRACE_RING_SIZE & ( TRACE_RING_SIZE - 1 ) ) == 0, "TRACE_RING_SIZE must be a power of 2");
+
+_Static_assert(sizeof(Trace_Record_t) == 16, "Trace_Record_t is the wire format");
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+//
+// Not static, so the debugger can dump the rings
+// (tools/trace_decode.py dump)
+//
+Trace_Ring_t Trace_rings[TRACE_CONTEXT_COUNT];
+
+static uint32_t dropped;
+
+static uint32_t lastDrain;
+
+static uint8_t  datagram[TRACE_HEADER_SIZE + TRACE_MAX_RECORDS * sizeof(Trace_Record_t)];
+
+#define TRACE_X_NAME(ID, level, format)     #ID,
+
+static const char* const eventNames[TRACE_EVENT_COUNT] =
+{
+    TRACE_EVENTS(TRACE_X_NAME)
+};
+
+#undef TRACE_X_NAME
+
+#ifdef TRACE_MEASURE
+
+static Trace_Cost_t costs[TRACE_EVENT_COUNT];
+
+#endif
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static inline Trace_Context_t currentContext(void)
+{
+    BIOS_ThreadType type = BIOS_getThreadType();
+
+    if ( type == BIOS_ThreadType_Hwi )
+    {
+        return TRACE_CONTEXT_HWI;
+    }
+
+    if ( type == BIOS_ThreadType_Swi )
+    {
+        return TRACE_CONTEXT_SWI;
+    }
+
+    return TRACE_CONTEXT_TASK;
+}
+
+static void putU32(uint8_t* pDst, uint32_t value)
+{
+    pDst[0] = (uint8_t)value;
+    pDst[1] = (uint8_t)( value >> 8 );
+    pDst[2] = (uint8_t)( value >> 16 );
+    pDst[3] = (uint8_t)( value >> 24 );
+
+    return;
+}
+
+/*
+ * === collect
+ * Copies new records of a ring into the datagram. A producer
+ * (Swi, Hwi) may overwrite records while they are copied, head is
+ * read again afterwards and copies which were overwritten meanwhile
+ * are dropped.
+ *
+ * Returns:
+ *      number of records in the datagram
+ */
+static uint16_t collect(Trace_Context_t context, uint16_t count)
+{
+    Trace_Ring_t*   pRing = &Trace_rings[context];
+    Trace_Record_t* pDst  = (Trace_Record_t*)&datagram[TRACE_HEADER_SIZE];
+    uint32_t        head  = pRing->head;
+    uint32_t        start = pRing->tail;
+    uint32_t        from;
+    uint32_t        oldest;
+    uint16_t        first = count;
+    uint16_t        torn;
+
+    BARRIER();
+
+    if ( head - start > TRACE_RING_SIZE )
+    {
+        dropped += head - start - TRACE_RING_SIZE;
+
+        start = head - TRACE_RING_SIZE;
+    }
+
+    for ( from = start; from != head && count < TRACE_MAX_RECORDS; from++, count++ )
+    {
+        pDst[count] = pRing->records[from & ( TRACE_RING_SIZE - 1 )];
+
+        pDst[count].context = context;
+    }
+
+    BARRIER();
+
+    ///////////////////////////
+    // Records older than oldest were
+    // overwritten, maybe during the copy
+    //
+    oldest = pRing->head - TRACE_RING_SIZE;
+
+    if ( (int32_t)( oldest - start ) > 0 )
+    {
+        torn = ( oldest - start < (uint32_t)( count - first ) ) ? (uint16_t)( oldest - start ) : ( count - first );
+
+        memmove(&pDst[first], &pDst[first + torn], ( count - first - torn ) * sizeof(Trace_Record_t));
+
+        dropped += torn;
+
+        count -= torn;
+    }
+
+    pRing->tail = from;
+
+    return count;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === Trace_Init
+ * Starts the DWT cycle counter used as trace timestamp.
+ */
+void Trace_Init(void)
+{
+    DEMCR    |= DEMCR_TRCENA;
+
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+
+    return;
+}
+
+/*
+ * === Trace_Write
+ * Called by TRACE(). Writes the record into the ring of the calling
+ * context and publishes it by advancing head, no lock, no formatting.
+ *
+ * Parameters:
+ *      id[in]          - event
+ *      arg0, arg1[in]  - raw arguments
+ * Returns:
+ *      N/A
+ */
+void Trace_Write(Trace_Event_t id, uint32_t arg0, uint32_t arg1)
+{
+    Trace_Ring_t*   pRing = &Trace_rings[currentContext()];
+    uint32_t        head  = pRing->head;
+    Trace_Record_t* pRec  = &pRing->records[head & ( TRACE_RING_SIZE - 1 )];
+
+    pRec->cycles = TRACE_CYCLES();
+    pRec->id     = id;
+    pRec->arg0   = arg0;
+    pRec->arg1   = arg1;
+
+    BARRIER();
+
+    pRing->head = head + 1;
+
+    return;
+}
+
+/*
+ * === Trace_Account
+ * Called by TRACE() built with TRACE_MEASURE, adds cycles spent in one
+ * trace point. Counters are shared by the contexts and not locked, a
+ * rare lost update only skews the statistics.
+ */
+void Trace_Account(Trace_Event_t id, uint32_t cycles)
+{
+#ifdef TRACE_MEASURE
+
+    costs[id].count++;
+
+    costs[id].cycles += cycles;
+
+    if ( cycles > costs[id].maxCycles )
+    {
+        costs[id].maxCycles = cycles;
+    }
+
+#endif
+
+    return;
+}
+
+/*
+ * === Trace_Drain
+ * Sends new records of all rings to targetIp:TRACE_PORT, one datagram
+ * (up to TRACE_MAX_RECORDS). Returns right away when there is nothing
+ * new or the last drain was less than TRACE_DRAIN_TICKS ago.
+ *
+ * Parameters:
+ *      pUdp[in]        - open UDP socket to send from
+ *      targetIp[in]    - receiver (trace_decode.py udp)
+ * Returns:
+ *      N/A
+ */
+void Trace_Drain(EthernetUDP* pUdp, IPAddress targetIp)
+{
+    Trace_Context_t context;
+    uint16_t        count = 0;
+    uint32_t        now   = Clock_getTicks();
+
+    if ( now - lastDrain < TRACE_DRAIN_TICKS )
+    {
+        return;
+    }
+
+    for ( context = (Trace_Context_t)0; context < TRACE_CONTEXT_COUNT; context++ )
+    {
+        if ( Trace_rings[context].head != Trace_rings[context].tail )
+        {
+            break;
+        }
+    }
+
+    if ( context == TRACE_CONTEXT_COUNT )
+    {
+        return;
+    }
+
+    lastDrain = now;
+
+    for ( context = (Trace_Context_t)0; context < TRACE_CONTEXT_COUNT; context++ )
+    {
+        count = collect(context, count);
+    }
+
+    datagram[0] = 'T';
+    datagram[1] = TRACE_DATAGRAM_VERSION;
+    datagram[2] = (uint8_t)count;
+    datagram[3] = 0;
+
+    putU32(&datagram[4],  now);
+    putU32(&datagram[8],  TRACE_CYCLES());
+    putU32(&datagram[12], dropped);
+
+    EthernetUDP_beginPacket_ip(pUdp, targetIp, TRACE_PORT);
+
+    EthernetUDP_write(pUdp, datagram, TRACE_HEADER_SIZE + count * sizeof(Trace_Record_t));
+
+    EthernetUDP_endPacket(pUdp);
+
+    return;
+}
+
+uint32_t Trace_GetWritten(void)
+{
+    Trace_Context_t context;
+    uint32_t        written = 0;
+
+    for ( context = (Trace_Context_t)0; context < TRACE_CONTEXT_COUNT; context++ )
+    {
+        written += Trace_rings[context].head;
+    }
+
+    return written;
+}
+
+uint32_t Trace_GetDropped(void)
+{
+    return dropped;
+}
+
+const char* Trace_GetName(Trace_Event_t id)
+{
+    return eventNames[id];
+}
+
+/*
+ * === Trace_GetCost
+ * Returns:
+ *      false when built without TRACE_MEASURE
+ */
+bool Trace_GetCost(Trace_Event_t id, Trace_Cost_t* pCost)
+{
+#ifdef TRACE_MEASURE
+
+    *pCost = costs[id];
+
+    return true;
+
+#else
+
+    return false;
+
+#endif
+}
+
+// ==============================================================================================================
@@ -0,0 +1,200 @@
+/*
+ * trace.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_UTILS_TRACE_H_
+#define SOURCE_UTILS_TRACE_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+#include <source/ethernet/EthernetUdp.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define TRACE_LEVEL_OFF         (0)
+#define TRACE_LEVEL_ERROR       (1)
+#define TRACE_LEVEL_INFO        (2)
+#define TRACE_LEVEL_DEBUG       (3)
+
+//
+// Build flags:
+//      TRACE_LEVEL     - trace points above the level are compiled out
+//      TRACE_MEASURE   - counts CPU cycles spent in every trace point
+//
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL             TRACE_LEVEL_INFO
+#endif
+
+//
+// Drained records go to the target IP, this UDP port
+//
+#define TRACE_PORT              (2016)
+
+//
+// Records per ring (power of 2), one ring per context
+//
+#define TRACE_RING_SIZE         (32)
+
+#define TRACE_CPU_HZ            (48000000)
+
+//
+// DWT cycle counter, enabled by Trace_Init(). The host
+// simulation provides its own (sim/Makefile).
+//
+#ifndef TRACE_CYCLES
+#define TRACE_CYCLES()          ( *(volatile uint32_t*)0xE0001004 )
+#endif
+
+/*
+ * === TRACE_EVENTS
+ * Every trace point has its line here:
+ *
+ *   X(ID, level, "format")
+ *
+ * Format is a Python str.format() of the two raw arguments ({0}, {1}),
+ * records are formatted on the host by tools/trace_decode.py, which
+ * parses this table. Ids go over the wire, append new events only.
+ */
+#define TRACE_EVENTS(X) \
+    X(RADIO_SET_FS,     TRACE_LEVEL_DEBUG, "FS command posted, handle {0}, status 0x{1:04x}") \
+    X(RADIO_BEGIN_RX,   TRACE_LEVEL_DEBUG, "RX command posted, handle {0}, status 0x{1:04x}") \
+    X(RADIO_STOP_RX,    TRACE_LEVEL_INFO,  "RX stopped, RF_Stat {0}, status 0x{1:08x} (IEEE << 16 | BLE)") \
+    X(RADIO_OVERFLOW,   TRACE_LEVEL_INFO,  "radio queue overflow #{0}") \
+    X(DASHBOARD_PARAM,  TRACE_LEVEL_DEBUG, "dashboard param '{0:c}', value of {1} chars") \
+    X(MONITOR_STACK_LOW, TRACE_LEVEL_ERROR, "stack #{0} (Monitor_Stack_t) headroom {1} bytes")
+
+// ==============================================================================================================
+
+
+// === ENUM DEFINITIONS =========================================================================================
+
+#define TRACE_X_ID(ID, level, format)       TRACE_##ID,
+
+typedef enum Trace_Event
+{
+    TRACE_EVENTS(TRACE_X_ID)
+    TRACE_EVENT_COUNT
+} Trace_Event_t;
+
+#undef TRACE_X_ID
+
+#define TRACE_X_LEVEL(ID, level, format)    TRACE_LEVEL_OF_##ID = (level),
+
+enum
+{
+    TRACE_EVENTS(TRACE_X_LEVEL)
+};
+
+#undef TRACE_X_LEVEL
+
+/*
+ * === Trace_Context_t
+ * Every context writes its own ring, so a ring
+ * has a single producer and needs no lock.
+ */
+typedef enum Trace_Context
+{
+    TRACE_CONTEXT_TASK = 0,     // tasks and main(), below priority 3 with Task_disable()
+    TRACE_CONTEXT_SWI,          // RF driver callbacks, Clock functions
+    TRACE_CONTEXT_HWI,          // GPIO callbacks (not nested)
+    TRACE_CONTEXT_COUNT
+} Trace_Context_t;
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === Trace_Record_t
+ * Also the wire format of a drained record (little-endian).
+ * context is filled in by Trace_Drain().
+ */
+typedef struct Trace_Record
+{
+    uint32_t cycles;            // TRACE_CYCLES() when written
+    uint16_t id;                // Trace_Event_t
+    uint8_t  context;           // Trace_Context_t
+    uint8_t  reserved;
+    uint32_t arg0;
+    uint32_t arg1;
+} Trace_Record_t;
+
+typedef struct Trace_Cost
+{
+    uint32_t count;
+    uint32_t cycles;            // sum
+    uint32_t maxCycles;
+} Trace_Cost_t;
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+void        Trace_Init(void);
+
+void        Trace_Write(Trace_Event_t id, uint32_t arg0, uint32_t arg1);
+
+void        Trace_Account(Trace_Event_t id, uint32_t cycles);
+
+void        Trace_Drain(EthernetUDP* pUdp, IPAddress targetIp);
+
+uint32_t    Trace_GetWritten(void);
+
+uint32_t    Trace_GetDropped(void);
+
+const char* Trace_GetName(Trace_Event_t id);
+
+bool        Trace_GetCost(Trace_Event_t id, Trace_Cost_t* pCost);
+
+// ==============================================================================================================
+
+
+// === TRACE POINT ==============================================================================================
+
+/*
+ * === TRACE
+ * Records event ID (TRACE_EVENTS) with two raw arguments, compiled
+ * out when the level of the event is above TRACE_LEVEL. Arguments
+ * are not evaluated then.
+ */
+#ifdef TRACE_MEASURE
+
+#define TRACE(ID, arg0, arg1)                                                       \
+    do                                                                              \
+    {                                                                               \
+        if ( TRACE_LEVEL_OF_##ID <= TRACE_LEVEL )                                   \
+        {                                                                           \
+            uint32_t traceStart = TRACE_CYCLES();                                   \
+            Trace_Write(TRACE_##ID, (uint32_t)(arg0), (uint32_t)(arg1));            \
+            Trace_Account(TRACE_##ID, TRACE_CYCLES() - traceStart);                 \
+        }                                                                           \
+    } while ( 0 )
+
+#else
+
+#define TRACE(ID, arg0, arg1)                                                       \
+    do                                                                              \
+    {                                                                               \
+        if ( TRACE_LEVEL_OF_##ID <= TRACE_LEVEL )                                   \
+        {                                                                           \
+            Trace_Write(TRACE_##ID, (uint32_t)(arg0), (uint32_t)(arg1));            \
+        }                                                                           \
+    } while ( 0 )
+
+#endif
+
+// ==============================================================================================================
+
+#endif /* SOURCE_UTILS_TRACE_H_ */
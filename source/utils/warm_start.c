@@ -0,0 +1,319 @@
+/*
+ * warm_start.c
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+// === INCLUDES =================================================================================================
+
+#include <stddef.h>
+
+#include <string.h>
+
+#include <source/ethernet/Ethernet.h>
+
+#include <source/ethernet/socket.h>
+
+#include <source/config/config.h>
+
+#include <source/utils/warm_start.h>
+
+// ==============================================================================================================
+
+
+// === DEFINES ==================================================================================================
+
+#define WARM_START_MAGIC        (0x4D524157)    // "WARM"
+
+//
+// Size of the warm_start section (WARM_START in the linker command file)
+//
+#define RETAINED_SIZE           (0x100)
+
+//
+// W5500 registers not covered by w5500.h accessors
+//
+#define W5500_VERSIONR          (0x0039)
+#define W5500_VERSION           (0x04)
+#define W5500_Sn_RXBUF_SIZE     (0x001E)
+#define W5500_Sn_TXBUF_SIZE     (0x001F)
+#define W5500_CB_SOCKET_READ(s) ( ( (s) << 5 ) + 0x08 )
+
+// ==============================================================================================================
+
+
+// === TYPE DEFINITIONS =========================================================================================
+
+/*
+ * === WarmStart_Record_t
+ * State of the network taken by RestartMCU(). W5500 is not reset by
+ * a soft restart, so as long as its registers still match the record,
+ * the chip, its link and the DHCP lease are taken over as they are.
+ */
+typedef struct WarmStart_Record
+{
+    uint32_t  magic;
+    uint32_t  restarts;                 // soft restarts since cold boot
+    uint8_t   bNetValid;                // network was up at restart
+    uint8_t   bDhcp;                    // address is leased (lease is valid)
+    uint8_t   rxBufSize[MAX_SOCK_NUM];  // socket layout (Sn_RXBUF_SIZE, kB)
+    uint8_t   txBufSize[MAX_SOCK_NUM];  // socket layout (Sn_TXBUF_SIZE, kB)
+    uint8_t   mac[6];
+    IPAddress localIp;
+    IPAddress gatewayIp;
+    IPAddress subnetMask;
+    IPAddress dnsIp;
+    DHCP      lease;
+    uint32_t  checksum;
+} WarmStart_Record_t;
+
+_Static_assert(sizeof(WarmStart_Record_t) <= RETAINED_SIZE, "WarmStart_Record_t does not fit retained RAM");
+
+// ==============================================================================================================
+
+
+// === STATIC VARIABLES =========================================================================================
+
+//
+// Retained RAM (warm_start section, NOLOAD), not touched by cinit
+//
+static WarmStart_Record_t record __attribute__((section("warm_start")));
+
+static bool     bNetworkUp;
+
+static bool     bWarm;
+
+static uint32_t restarts;
+
+// ==============================================================================================================
+
+
+// === INTERNAL FUNCTIONS =======================================================================================
+
+static uint32_t checksum(const WarmStart_Record_t* pRecord)
+{
+    const uint32_t* pWord = (const uint32_t*)pRecord;
+    uint32_t        sum   = 0;
+    uint16_t        i;
+
+    for ( i = 0; i < offsetof(WarmStart_Record_t, checksum) / sizeof(uint32_t); i++ )
+    {
+        sum = ( ( sum << 5 ) | ( sum >> 27 ) ) ^ pWord[i];
+    }
+
+    return sum;
+}
+
+/*
+ * === chipMatches
+ * Checks that W5500 was not reset (or power cycled) on its own since
+ * the record was taken: common registers and socket layout must be
+ * the same as when RestartMCU() was called.
+ */
+static bool chipMatches(void)
+{
+    uint8_t   mac[6];
+    IPAddress ip;
+    SOCKET    s;
+
+    if ( W5500_read(W5500_VERSIONR, 0x00) != W5500_VERSION )
+    {
+        return false;
+    }
+
+    W5500_getMACAddress(mac);
+
+    if ( memcmp(mac, record.mac, sizeof(mac)) != 0 || memcmp(mac, (const void*)CONFIG_FACTORY_MAC, sizeof(mac)) != 0 )
+    {
+        return false;
+    }
+
+    W5500_getIPAddress(ip.bytes);
+
+    if ( ip.dword != record.localIp.dword )
+    {
+        return false;
+    }
+
+    for ( s = 0; s < MAX_SOCK_NUM; s++ )
+    {
+        if ( W5500_read(W5500_Sn_RXBUF_SIZE, W5500_CB_SOCKET_READ(s)) != record.rxBufSize[s] ||
+             W5500_read(W5500_Sn_TXBUF_SIZE, W5500_CB_SOCKET_READ(s)) != record.txBufSize[s] )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * === applyStatic
+ * Static address: reprograms only registers whose value
+ * differs from the config (e.g. netmask changed on the dashboard).
+ */
+static void applyStatic(void)
+{
+    IPAddress ip;
+
+    ip = Config_GetDeviceIp();
+
+    if ( ip.dword != record.localIp.dword )
+    {
+        W5500_setIPAddress(ip.bytes);
+    }
+
+    ip = Config_GetGatewayIp();
+
+    if ( ip.dword != record.gatewayIp.dword )
+    {
+        W5500_setGatewayIp(ip.bytes);
+    }
+
+    ip = Config_GetNetmask();
+
+    if ( ip.dword != record.subnetMask.dword )
+    {
+        W5500_setSubnetMask(ip.bytes);
+    }
+
+    return;
+}
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+/*
+ * === WarmStart_Resume
+ * Called by the init task instead of Ethernet_begin_*(). After a soft
+ * restart with a valid record, W5500 is taken over without a chip
+ * reset: sockets left open by the previous run are closed (their owners
+ * open them again), static addresses that changed are rewritten and
+ * a leased address keeps its lease (renewed by Ethernet_maintain()).
+ * The record is consumed, so it is never used twice.
+ *
+ * Parameters:
+ *      N/A
+ * Returns:
+ *      true when W5500 was taken over, false when it has to be
+ *      initialized (cold boot, DHCP setting changed, lease over, ...)
+ */
+bool WarmStart_Resume(void)
+{
+    SOCKET s;
+
+    ///////////////////////////
+    // Record is valid only when
+    // written by RestartMCU()
+    //
+    if ( record.magic != WARM_START_MAGIC || record.checksum != checksum(&record) )
+    {
+        return false;
+    }
+
+    record.magic = 0;
+
+    restarts = record.restarts;
+
+    if ( !record.bNetValid || record.bDhcp != Config_GetDhcp() || !chipMatches() )
+    {
+        return false;
+    }
+
+    if ( record.bDhcp )
+    {
+        if ( record.lease._dhcp_state != STATE_DHCP_LEASED || record.lease._rebindInSec <= 0 )
+        {
+            return false;
+        }
+    }
+    else
+    {
+        applyStatic();
+    }
+
+    ///////////////////////////
+    // Sockets of the previous run
+    //
+    for ( s = 0; s < MAX_SOCK_NUM; s++ )
+    {
+        if ( W5500_readSnSR(s) != SnSR_CLOSED )
+        {
+            close(s);
+        }
+    }
+
+    W5500_writeIR(0xF0);
+
+    Ethernet_resume(record.dnsIp, record.bDhcp ? &record.lease : NULL);
+
+    bWarm = true;
+
+    return true;
+}
+
+/*
+ * === WarmStart_NetworkUp
+ * Marks W5500 as configured, from now on RestartMCU() may keep it.
+ */
+void WarmStart_NetworkUp(void)
+{
+    bNetworkUp = true;
+
+    return;
+}
+
+/*
+ * === WarmStart_Suspend
+ * Called by RestartMCU() (restart.asm) right before the jump
+ * to _c_int00. Takes the network state into the record.
+ */
+void WarmStart_Suspend(void)
+{
+    SOCKET s;
+
+    record.magic     = WARM_START_MAGIC;
+    record.restarts  = restarts + 1;
+    record.bNetValid = bNetworkUp;
+    record.bDhcp     = bNetworkUp && Ethernet._dhcp != NULL;
+
+    if ( bNetworkUp )
+    {
+        W5500_getMACAddress(record.mac);
+        W5500_getIPAddress(record.localIp.bytes);
+        W5500_getGatewayIp(record.gatewayIp.bytes);
+        W5500_getSubnetMask(record.subnetMask.bytes);
+
+        record.dnsIp = Ethernet._dnsServerAddress;
+
+        for ( s = 0; s < MAX_SOCK_NUM; s++ )
+        {
+            record.rxBufSize[s] = W5500_read(W5500_Sn_RXBUF_SIZE, W5500_CB_SOCKET_READ(s));
+            record.txBufSize[s] = W5500_read(W5500_Sn_TXBUF_SIZE, W5500_CB_SOCKET_READ(s));
+        }
+
+        if ( record.bDhcp )
+        {
+            record.lease = *Ethernet._dhcp;
+        }
+    }
+
+    record.checksum = checksum(&record);
+
+    return;
+}
+
+bool WarmStart_IsWarm(void)
+{
+    return bWarm;
+}
+
+uint32_t WarmStart_GetRestarts(void)
+{
+    return restarts;
+}
+
+// ==============================================================================================================
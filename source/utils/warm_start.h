@@ -0,0 +1,34 @@
+/*
+ * warm_start.h
+ *
+ *  Created on: 18. 10. 2026
+ *      Author: vojtechlukas
+ */
+
+#ifndef SOURCE_UTILS_WARM_START_H_
+#define SOURCE_UTILS_WARM_START_H_
+
+// === INCLUDES =================================================================================================
+
+#include <stdint.h>
+
+#include <stdbool.h>
+
+// ==============================================================================================================
+
+
+// === PUBLISHED FUNCTIONS ======================================================================================
+
+bool     WarmStart_Resume(void);
+
+void     WarmStart_NetworkUp(void);
+
+void     WarmStart_Suspend(void);
+
+bool     WarmStart_IsWarm(void);
+
+uint32_t WarmStart_GetRestarts(void);
+
+// ==============================================================================================================
+
+#endif /* SOURCE_UTILS_WARM_START_H_ */
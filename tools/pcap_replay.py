@@ -0,0 +1,356 @@
+#!/usr/bin/env python3
+# Replays recorded frames (pcap) into the radio queue of multiSniff and
+# compares what it forwards with what was replayed: loss, reordering and
+# latency. Needs a firmware built with REPLAY_INJECT (the host simulation
+# is, see sim/Makefile).
+#
+#   replay (UDP 2017):
+#     request: uint8 version, uint8 flags, uint32 sequence of the first frame,
+#              uint8 count, uint8 0, then count times
+#              uint16 length, int8 RSSI, frame
+#     report:  uint8 version, uint8 flags | 0x20, uint32 next sequence,
+#              uint8 0, uint8 status, uint32 injected, uint32 lost, uint32 rejected
+#   flags: 0x01 IEEE 802.15.4 frames, 0x40 START, 0x80 END
+#
+# See source/replay/replay.h for the matching definitions. Settings are
+# changed through the control protocol (sniffctl.py) for the run: raw
+# output to this host, then put back.
+#
+# Supported pcap link types: BLUETOOTH_LE_LL (251), BLUETOOTH_LE_LL_WITH_PHDR
+# (256), IEEE802_15_4_WITHFCS (195), IEEE802_15_4_NOFCS (230, FCS is added).
+#
+# Examples:
+#   pcap_replay.py 192.168.5.11 adv.pcap                 original timing
+#   pcap_replay.py 192.168.5.11 zigbee.pcap --speed 20   20 times faster
+#   pcap_replay.py 192.168.5.11 zigbee.pcap --rate 2000  2000 frames/s
+#   pcap_replay.py 127.0.0.1 adv.pcap --http 127.0.0.1:8080   (make -C sim bridge)
+import argparse
+import collections
+import json
+import socket
+import struct
+import sys
+import threading
+import time
+import urllib.request
+
+from sniffctl import Client, ControlError
+
+PORT            = 2017
+SNIFF_PORT      = 2014
+VERSION         = 1
+HEADER_SIZE     = 8
+FRAME_HEADER    = 3
+MAX_DATAGRAM    = 1024
+
+FLAG_IEEE       = 0x01
+FLAG_REPORT     = 0x20
+FLAG_START      = 0x40
+FLAG_END        = 0x80
+
+STATUS = ["ok", "wrong protocol", "bad version"]
+
+# sniffing_task.h
+TYPE_MASK       = 0x0F
+FLAG_SUMMARY    = 0x80
+FLAG_LATENCY    = 0x40
+FLAG_SEQUENCE   = 0x20
+LATENCY_UNKNOWN = 0xFFFFFFFF
+BLE_AA_LEN      = 4
+
+LINKTYPE_BLE_LL           = 251
+LINKTYPE_BLE_LL_WITH_PHDR = 256
+LINKTYPE_IEEE_WITHFCS     = 195
+LINKTYPE_IEEE_NOFCS       = 230
+
+PROTOCOLS = {0: "ble", 1: "ieee"}
+
+
+def crc16_kermit(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = (crc >> 1) ^ 0x8408 if crc & 1 else crc >> 1
+    return crc
+
+
+#
+# Returns (protocol, [(timestamp in seconds, frame, rssi)]), frames the
+# way RF Core stores them: BLE PDU with header, length and CRC, IEEE
+# MPDU with FCS.
+#
+def read_pcap(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    magic = data[:4]
+    if magic in (b"\xd4\xc3\xb2\xa1", b"\x4d\x3c\xb2\xa1"):
+        endian = "<"
+    elif magic in (b"\xa1\xb2\xc3\xd4", b"\xa1\xb2\x3c\x4d"):
+        endian = ">"
+    else:
+        raise ValueError("%s: not a pcap file (pcapng is not supported)" % path)
+    scale = 1e-9 if magic in (b"\x4d\x3c\xb2\xa1", b"\xa1\xb2\x3c\x4d") else 1e-6
+
+    linktype = struct.unpack(endian + "I", data[20:24])[0] & 0x0FFFFFFF
+    if linktype in (LINKTYPE_BLE_LL, LINKTYPE_BLE_LL_WITH_PHDR):
+        protocol = 0
+    elif linktype in (LINKTYPE_IEEE_WITHFCS, LINKTYPE_IEEE_NOFCS):
+        protocol = 1
+    else:
+        raise ValueError("%s: link type %d is not supported" % (path, linktype))
+
+    frames = []
+    pos = 24
+    while pos + 16 <= len(data):
+        sec, frac, caplen, _ = struct.unpack(endian + "IIII", data[pos:pos + 16])
+        packet = data[pos + 16:pos + 16 + caplen]
+        pos += 16 + caplen
+        rssi = 0
+
+        if linktype == LINKTYPE_BLE_LL_WITH_PHDR:
+            if len(packet) < 10:
+                continue
+            flags = struct.unpack("<H", packet[8:10])[0]
+            if flags & 0x0004:
+                rssi = struct.unpack("b", packet[1:2])[0]
+            packet = packet[10:]
+        if protocol == 0:
+            packet = packet[BLE_AA_LEN:]
+        elif linktype == LINKTYPE_IEEE_NOFCS:
+            packet += struct.pack("<H", crc16_kermit(packet))
+
+        if 0 < len(packet) <= MAX_DATAGRAM - HEADER_SIZE - FRAME_HEADER:
+            frames.append((sec + frac * scale, packet, rssi))
+
+    return protocol, frames
+
+
+#
+# Groups frames into datagrams: frames due within window seconds of
+# the first one of the datagram, as long as they fit. Returns
+# [(send time, first index, count, payload)].
+#
+def build_batches(frames, times, window):
+    batches = []
+    i = 0
+    while i < len(frames):
+        first = i
+        payload = b""
+        while (i < len(frames) and i - first < 255 and times[i] - times[first] <= window and
+               HEADER_SIZE + len(payload) + FRAME_HEADER + len(frames[i][1]) <= MAX_DATAGRAM):
+            _, frame, rssi = frames[i]
+            payload += struct.pack("<Hb", len(frame), rssi) + frame
+            i += 1
+        batches.append((times[first], first, i - first, payload))
+    return batches
+
+
+class Receiver(threading.Thread):
+    #
+    # Collects forwarded frames: (time received, frame, device age in us or None)
+    #
+    def __init__(self, port):
+        super().__init__(daemon=True)
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 << 20)
+        self.sock.bind(("", port))
+        self.received = []
+        self.other    = 0
+
+    def run(self):
+        while True:
+            data = self.sock.recv(4096)
+            now  = time.perf_counter()
+            if not data:
+                continue
+            kind = data[0]
+            pos  = 3 if kind & FLAG_SEQUENCE else 1
+            age  = None
+            if kind & FLAG_LATENCY:
+                age  = struct.unpack("<I", data[pos:pos + 4])[0]
+                age  = None if age == LATENCY_UNKNOWN else age
+                pos += 4
+            if kind & FLAG_SUMMARY or (kind & TYPE_MASK) not in PROTOCOLS:
+                self.other += 1
+                continue
+            if kind & TYPE_MASK == 0:
+                pos += BLE_AA_LEN
+            self.received.append((now, data[pos:], age))
+
+
+class Replay:
+    def __init__(self, host, protocol, timeout=0.5, retries=10):
+        self.addr     = (host, PORT)
+        self.flags    = FLAG_IEEE if protocol == 1 else 0
+        self.retries  = retries
+        self.sock     = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.settimeout(timeout)
+
+    def send(self, sequence, count, payload=b"", flags=0):
+        self.sock.sendto(struct.pack("<BBIBB", VERSION, self.flags | flags, sequence, count, 0) + payload, self.addr)
+
+    #
+    # Sends START or END until the report comes, returns
+    # (status, next sequence, injected, lost, rejected)
+    #
+    def session(self, flag, sequence):
+        for _ in range(self.retries):
+            self.send(sequence, 0, flags=flag)
+            try:
+                while True:
+                    data, _ = self.sock.recvfrom(256)
+                    if len(data) < HEADER_SIZE + 12:
+                        continue
+                    _, flags, next_seq, _, status, injected, lost, rejected = struct.unpack("<BBIBBIII", data[:20])
+                    if flags & FLAG_REPORT and flags & flag:
+                        return status, next_seq, injected, lost, rejected
+            except socket.timeout:
+                continue
+
+        raise ControlError("no replay report from %s:%d (built with REPLAY_INJECT?)" % self.addr)
+
+
+def fetch_stats(address):
+    try:
+        with urllib.request.urlopen("http://%s/api/stats" % address, timeout=2) as response:
+            return json.loads(response.read())
+    except (OSError, ValueError):
+        return None
+
+
+def local_ip(host):
+    probe = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    probe.connect((host, PORT))
+    address = probe.getsockname()[0]
+    probe.close()
+    return address
+
+
+def percentiles(values):
+    values = sorted(values)
+    if not values:
+        return "-"
+    pick = lambda p: values[min(len(values) - 1, int(len(values) * p))]
+    return "p50 %8.0f  p99 %8.0f  max %8.0f" % (pick(0.5), pick(0.99), values[-1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="multiSniff pcap replay")
+    parser.add_argument("host")
+    parser.add_argument("pcap")
+    parser.add_argument("--speed", type=float, default=1.0, help="time scale of the original timing, 10 = ten times faster")
+    parser.add_argument("--rate", type=float, default=0, help="fixed rate in frames/s instead of the original timing")
+    parser.add_argument("--window", type=float, default=0.001, help="seconds of frames sent in one datagram")
+    parser.add_argument("--drain", type=float, default=0.5, help="seconds to wait for forwarded frames after the end")
+    parser.add_argument("--http", help="address of the dashboard for per-stage latency, default host:80")
+    parser.add_argument("--listen-port", type=int, default=SNIFF_PORT)
+    args = parser.parse_args()
+
+    protocol, frames = read_pcap(args.pcap)
+    if not frames:
+        parser.error("no frames in %s" % args.pcap)
+
+    if args.rate > 0:
+        times = [i / args.rate for i in range(len(frames))]
+    else:
+        times = [(ts - frames[0][0]) / args.speed for ts, _, _ in frames]
+    batches = build_batches(frames, times, args.window)
+
+    client   = Client(args.host)
+    replay   = Replay(args.host, protocol)
+    receiver = Receiver(args.listen_port)
+    http     = args.http or "%s:80" % args.host
+    sent     = [0.0] * len(frames)
+    saved    = None
+
+    try:
+        saved = client.get()
+        client.set(protocol=PROTOCOLS[protocol], target=local_ip(args.host), output_mode=0,
+                   ieee_decode=0, trigger=0, running=1)
+        receiver.start()
+        stats_before = fetch_stats(http)
+
+        status = replay.session(FLAG_START, 0)[0]
+        if status != 0:
+            raise ControlError("replay refused: %s" % (STATUS[status] if status < len(STATUS) else status))
+
+        start = time.perf_counter()
+        for due, first, count, payload in batches:
+            delay = start + due - time.perf_counter()
+            if delay > 0:
+                time.sleep(delay)
+            now = time.perf_counter()
+            replay.send(first, count, payload)
+            sent[first:first + count] = [now] * count
+        duration = time.perf_counter() - start
+
+        status, _, injected, lost, rejected = replay.session(FLAG_END, len(frames))
+        time.sleep(args.drain)
+        stats_after = fetch_stats(http)
+    except ControlError as e:
+        print("error: %s" % e, file=sys.stderr)
+        sys.exit(1)
+    except KeyboardInterrupt:
+        sys.exit(1)
+    finally:
+        if saved is not None:
+            try:
+                client.set(**{name: saved[name] for name in ("protocol", "target", "output_mode", "ieee_decode", "running")})
+            except ControlError:
+                print("warning: settings were not put back", file=sys.stderr)
+
+    #
+    # Forwarded frames are matched to replayed ones by content,
+    # duplicates in order of replay
+    #
+    unmatched = collections.defaultdict(collections.deque)
+    for i, (_, frame, _) in enumerate(frames):
+        unmatched[frame].append(i)
+
+    latencies = []
+    ages      = []
+    extra     = 0
+    reordered = 0
+    highest   = -1
+    for received, frame, age in list(receiver.received):
+        if not unmatched[frame]:
+            extra += 1
+            continue
+        i = unmatched[frame].popleft()
+        if i < highest:
+            reordered += 1
+        highest = max(highest, i)
+        latencies.append((received - sent[i]) * 1e6)
+        if age is not None:
+            ages.append(age)
+
+    forwarded = len(latencies)
+    print("replayed      %d %s frames in %.3f s (%.0f frames/s, %d datagrams)" %
+          (len(frames), PROTOCOLS[protocol], duration, len(frames) / duration if duration else 0, len(batches)))
+    print("injected      %d, lost on the way in %d, rejected %d%s" %
+          (injected, lost, rejected, "" if status == 0 else " (%s)" % STATUS[status]))
+    print("forwarded     %d, lost in the sniffer %d, unexpected %d, other datagrams %d" %
+          (forwarded, max(injected - forwarded, 0), extra, receiver.other))
+    print("reordered     %d" % reordered)
+    print("latency us    replay sent -> forwarded frame received   %s" % percentiles(latencies))
+    if ages:
+        print("              frame age at SEND (latency header)     %s" % percentiles(ages))
+
+    if stats_after is None:
+        print("stages        not available (no dashboard at %s)" % http)
+        return
+
+    if stats_before is not None:
+        print("device        replayFrames %+d, replayLost %+d, replayRejected %+d, rxOverflows %+d" %
+              tuple(stats_after.get(name, 0) - stats_before.get(name, 0)
+                    for name in ("replayFrames", "replayLost", "replayRejected", "rxOverflows")))
+    for name, label in (("latencyQueueUs", "queue"), ("latencySpiUs", "SPI write"),
+                        ("latencySendUs", "SEND"), ("latencyTotalUs", "total")):
+        p50, p99, top = stats_after.get(name, [0, 0, 0])
+        print("stage us      %-10s (since boot)  p50 %8d  p99 %8d  max %8d" % (label, p50, p99, top))
+
+
+if __name__ == "__main__":
+    main()
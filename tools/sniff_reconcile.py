@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+# Listens to the capture stream of multiSniff (UDP 2014) and reconciles
+# what arrived with the counters the firmware sends in it, so that lost
+# frames are put to the stage which lost them.
+#
+#   every datagram: uint8 type | flags, uint16 sequence, ...
+#   stats (type 3): uint8 count, count times uint32 (Sniff_StatsField_t)
+#   flags: 0x80 IEEE summary, 0x40 frame age follows, 0x20 sequence follows
+#
+# Sequence numbers are given to every datagram on the capture port, a gap
+# is a datagram lost after the firmware sent it: dropped by W5500 (ARP
+# timeout, counted by the firmware) or by the network and the host. Stats
+# datagrams come every second while capture is running, each interval
+# between two of them is reported:
+#
+#   rf       frames RF Core stored in the radio queue (+ replayed frames)
+#   overflow frames RF Core could not store, radio queue full
+#   reset    stored frames dropped when the radio queue was reset
+#   taken    frames the sniffing task took from the radio queue
+#   filtered frames not forwarded on purpose (records-only, trigger)
+#   fwd      frames written into a datagram
+#   short    datagrams cut short, W5500 TX buffer full
+#   arp      datagrams W5500 dropped, target did not answer ARP
+#   net      datagrams the firmware sent and this host did not receive
+#
+# See sniffing_task.h for the matching definitions. Target IP of the
+# firmware has to be this host (sniffctl.py set --target ...).
+#
+# Examples:
+#   sniff_reconcile.py                       per second until Ctrl-C
+#   sniff_reconcile.py --duration 60 --quiet totals after a minute
+import argparse
+import socket
+import struct
+import sys
+import time
+
+PORT            = 2014
+
+# sniffing_task.h
+TYPE_MASK       = 0x0F
+TYPE_STATS      = 0x03
+FLAG_SEQUENCE   = 0x20
+
+#
+# Sniff_StatsField_t
+#
+FIELDS = ["uptime_ms", "rf", "overflow", "reset", "replay", "taken", "filtered",
+          "fwd", "short", "arp", "sequence"]
+
+
+class Stream:
+    #
+    # Extends 16-bit sequence numbers to those of the stats datagrams
+    # and keeps what arrived since the last stats datagram
+    #
+    def __init__(self):
+        self.last        = None
+        self.highest     = None
+        self.reordered   = 0
+        self.unsequenced = 0
+
+    def extend(self, seq16):
+        if self.last is None:
+            return seq16
+        delta = (seq16 - self.last) & 0xFFFF
+        if delta >= 0x8000:
+            delta -= 0x10000
+        return self.last + delta
+
+    def add(self, seq):
+        if self.highest is not None and seq < self.highest:
+            self.reordered += 1
+        self.highest = seq if self.highest is None else max(self.highest, seq)
+        self.last    = seq
+
+
+def parse_stats(data):
+    if len(data) < 4:
+        return None
+    count  = data[3]
+    count  = min(count, (len(data) - 4) // 4)
+    values = struct.unpack("<%dI" % count, data[4:4 + 4 * count])
+    if count < len(FIELDS):
+        return None
+    return dict(zip(FIELDS, values))
+
+
+def interval(prev, curr, received):
+    d = {name: (curr[name] - prev[name]) & 0xFFFFFFFF for name in FIELDS}
+    d["sent"]     = d["sequence"]
+    d["received"] = received
+    d["missing"]  = max(d["sent"] - received, 0)
+    d["net"]      = max(d["missing"] - d["arp"], 0)
+    #
+    # Frames still in the radio queue or trigger history at the end
+    # of the interval show here, they even out over time
+    #
+    d["queued"]   = d["rf"] + d["replay"] - d["reset"] - d["taken"]
+    d["held"]     = d["taken"] - d["filtered"] - d["fwd"]
+    return d
+
+
+def print_interval(d, curr):
+    print("%8.1fs  rf %6d  overflow %4d  reset %4d  | taken %6d  filtered %6d  fwd %6d  | "
+          "short %3d  arp %3d  net %4d  (datagrams %d/%d)"
+          % (curr["uptime_ms"] / 1000.0, d["rf"] + d["replay"], d["overflow"], d["reset"],
+             d["taken"], d["filtered"], d["fwd"], d["short"], d["arp"], d["net"],
+             d["received"], d["sent"]))
+
+
+def print_total(total, stream):
+    if total is None:
+        print("no stats datagram received (capture running, target IP this host?)", file=sys.stderr)
+        return
+
+    print()
+    print("frames")
+    print("  stored by RF Core       %8d" % total["rf"])
+    if total["replay"]:
+        print("  replayed                %8d" % total["replay"])
+    print("  taken from radio queue  %8d" % total["taken"])
+    print("  left in radio queue     %8d" % total["queued"])
+    print("  filtered                %8d" % total["filtered"])
+    print("  forwarded               %8d" % total["fwd"])
+    print("  left in trigger history %8d" % total["held"])
+    print("datagrams")
+    print("  sent                    %8d" % total["sent"])
+    print("  received                %8d" % total["received"])
+    print("  reordered               %8d" % stream.reordered)
+    print("lost")
+    print("  radio queue overflow    %8d frames" % total["overflow"])
+    print("  radio queue reset       %8d frames" % total["reset"])
+    print("  W5500 TX buffer full    %8d datagrams cut short" % total["short"])
+    print("  W5500 ARP timeout       %8d datagrams" % total["arp"])
+    print("  network / host          %8d datagrams" % total["net"])
+    if stream.unsequenced:
+        print("(%d datagrams without sequence, firmware older than the stream format)" % stream.unsequenced)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="multiSniff capture loss accounting")
+    parser.add_argument("--port", type=int, default=PORT)
+    parser.add_argument("--duration", type=float, default=0, help="seconds, 0 = until Ctrl-C")
+    parser.add_argument("--quiet", action="store_true", help="print totals only")
+    args = parser.parse_args()
+
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4 << 20)
+    sock.bind(("", args.port))
+    sock.settimeout(0.5)
+
+    stream   = Stream()
+    previous = None
+    total    = None
+    received = 0
+    deadline = time.monotonic() + args.duration if args.duration else None
+
+    try:
+        while deadline is None or time.monotonic() < deadline:
+            try:
+                data = sock.recv(4096)
+            except socket.timeout:
+                continue
+            if len(data) < 3 or not data[0] & FLAG_SEQUENCE:
+                stream.unsequenced += 1
+                continue
+
+            seq = stream.extend(data[1] | data[2] << 8)
+
+            if data[0] & TYPE_MASK != TYPE_STATS:
+                stream.add(seq)
+                received += 1
+                continue
+
+            stats = parse_stats(data)
+            if stats is None:
+                continue
+
+            #
+            # Stats carry the full sequence, the stream is
+            # resynchronised to it (also after a restart)
+            #
+            seq = stats["sequence"]
+            if previous is not None and seq < previous["sequence"]:
+                print("firmware restarted, counters start over", file=sys.stderr)
+                previous       = None
+                stream.highest = None
+
+            stream.add(seq)
+
+            if previous is not None:
+                d = interval(previous, stats, received)
+                if not args.quiet:
+                    print_interval(d, stats)
+                if total is None:
+                    total = dict(d)
+                else:
+                    for name in d:
+                        total[name] += d[name]
+
+            previous = stats
+            received = 1
+    except KeyboardInterrupt:
+        pass
+
+    print_total(total, stream)
+
+
+if __name__ == "__main__":
+    main()
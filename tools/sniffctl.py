@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+# Command line client of the multiSniff binary control protocol (UDP 2015).
+#
+#   request:  uint8 version, uint8 opcode, uint16 request id, fields...
+#   response: uint8 version, uint8 opcode | 0x80, uint16 request id,
+#             uint8 status, uint8 index of offending field, fields...
+#   field:    uint8 key, uint8 length, value (little-endian)
+#
+# See source/control/control.h for the matching definitions.
+#
+# Examples:
+#   sniffctl.py 192.168.5.11 get
+#   sniffctl.py 192.168.5.11 boot
+#   sniffctl.py 192.168.5.11 set --protocol ieee --channel 15 --running 1
+#   sniffctl.py 192.168.5.11 hop --channels 37,38,39 --dwell 0.1 --count 300
+import argparse
+import random
+import socket
+import struct
+import sys
+import time
+
+PORT            = 2015
+VERSION         = 1
+OP_SET          = 0x01
+OP_GET          = 0x02
+OP_BOOT         = 0x03
+OP_ACK          = 0x80
+NO_INDEX        = 0xFF
+
+KEY_CHANNEL         = 0x01
+KEY_PROTOCOL        = 0x02
+KEY_TARGET_IP       = 0x03
+KEY_RUNNING         = 0x04
+KEY_IEEE_DECODE     = 0x05
+KEY_IEEE_SNAPLEN    = 0x06
+KEY_OUTPUT_MODE     = 0x07
+KEY_TRIGGER_STATE   = 0x08
+KEY_TRIGGER_PATTERN = 0x09
+KEY_TRIGGER_OFFSET  = 0x0A
+KEY_TRIGGER_POST    = 0x0B
+
+STATUS = ["ok", "bad version", "bad opcode", "bad field", "bad value", "radio error"]
+
+PROTOCOLS = {"ble": 0, "ieee": 1}
+
+# BootProfile_Phase_t (source/utils/boot_profile.h), key of BOOT response fields
+BOOT_PHASES = ["init", "config", "radioRx", "oled", "network", "capture", "dashboard", "firstFrame"]
+
+#
+# name: (key, encode, decode)
+#
+u8 = (lambda v: struct.pack("<B", int(v)), lambda b: b[0])
+
+FIELDS = {
+    "channel":        (KEY_CHANNEL,         *u8),
+    "protocol":       (KEY_PROTOCOL,        lambda v: bytes([PROTOCOLS[v]]),
+                                            lambda b: {0: "ble", 1: "ieee"}.get(b[0], b[0])),
+    "target":         (KEY_TARGET_IP,       socket.inet_aton, socket.inet_ntoa),
+    "running":        (KEY_RUNNING,         *u8),
+    "ieee_decode":    (KEY_IEEE_DECODE,     *u8),
+    "ieee_snaplen":   (KEY_IEEE_SNAPLEN,    *u8),
+    "output_mode":    (KEY_OUTPUT_MODE,     *u8),
+    "trigger":        (KEY_TRIGGER_STATE,   *u8),
+    "trigger_pattern":(KEY_TRIGGER_PATTERN, lambda v: v.encode("ascii"), lambda b: b.decode("ascii")),
+    "trigger_offset": (KEY_TRIGGER_OFFSET,  lambda v: struct.pack("<H", int(v)), lambda b: struct.unpack("<H", b)[0]),
+    "trigger_post":   (KEY_TRIGGER_POST,    *u8),
+}
+
+
+class ControlError(Exception):
+    pass
+
+
+class Client:
+    def __init__(self, host, port=PORT, timeout=0.2, retries=3):
+        self.addr    = (host, port)
+        self.retries = retries
+        self.sock    = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.settimeout(timeout)
+        self.next_id = random.randrange(0x10000)
+
+    #
+    # Sends request and waits for the response with the same id,
+    # stale responses of earlier (retried) requests are skipped.
+    # Returns (status, index, fields, round trip in seconds).
+    #
+    def request(self, opcode, fields=b""):
+        request_id   = self.next_id
+        self.next_id = (self.next_id + 1) & 0xFFFF
+        datagram     = struct.pack("<BBH", VERSION, opcode, request_id) + fields
+
+        for _ in range(self.retries):
+            start = time.perf_counter()
+            self.sock.sendto(datagram, self.addr)
+            try:
+                while True:
+                    data, _ = self.sock.recvfrom(256)
+                    rtt = time.perf_counter() - start
+                    if len(data) < 6:
+                        continue
+                    version, op, rid, status, index = struct.unpack("<BBHBB", data[:6])
+                    if rid == request_id and op == opcode | OP_ACK:
+                        return status, index, data[6:], rtt
+            except socket.timeout:
+                continue
+
+        raise ControlError("no response from %s:%d" % self.addr)
+
+    def set(self, **values):
+        fields = b""
+        for name, value in values.items():
+            key, encode, _ = FIELDS[name]
+            raw     = encode(value)
+            fields += struct.pack("<BB", key, len(raw)) + raw
+
+        status, index, _, rtt = self.request(OP_SET, fields)
+        if status != 0:
+            where = "" if index == NO_INDEX else " (field %s)" % list(values)[index]
+            raise ControlError(STATUS[status] + where if status < len(STATUS) else str(status))
+        return rtt
+
+    def get(self):
+        status, _, data, _ = self.request(OP_GET)
+        if status != 0:
+            raise ControlError(STATUS[status] if status < len(STATUS) else str(status))
+
+        by_key = {key: (name, decode) for name, (key, _, decode) in FIELDS.items()}
+        result = {}
+        i = 0
+        while i + 2 <= len(data):
+            key, length = data[i], data[i + 1]
+            value = data[i + 2:i + 2 + length]
+            if key in by_key:
+                name, decode = by_key[key]
+                result[name] = decode(value)
+            i += 2 + length
+        return result
+
+    # Boot phases reached, {name: microseconds from start of the init task}
+    def boot(self):
+        status, _, data, _ = self.request(OP_BOOT)
+        if status != 0:
+            raise ControlError(STATUS[status] if status < len(STATUS) else str(status))
+
+        result = {}
+        i = 0
+        while i + 2 <= len(data):
+            key, length = data[i], data[i + 1]
+            if length == 4:
+                name = BOOT_PHASES[key] if key < len(BOOT_PHASES) else str(key)
+                result[name] = struct.unpack("<I", data[i + 2:i + 6])[0]
+            i += 2 + length
+        return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description="multiSniff control client")
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=PORT)
+    parser.add_argument("--timeout", type=float, default=0.2, help="seconds per attempt")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    sub.add_parser("get", help="print current settings")
+
+    sub.add_parser("boot", help="print boot phase timestamps")
+
+    set_parser = sub.add_parser("set", help="apply settings as one batch")
+    for name in FIELDS:
+        set_parser.add_argument("--" + name.replace("_", "-"), dest=name,
+                                choices=list(PROTOCOLS) if name == "protocol" else None)
+
+    hop_parser = sub.add_parser("hop", help="cycle channels, report round trip times")
+    hop_parser.add_argument("--channels", required=True, help="comma separated, e.g. 37,38,39")
+    hop_parser.add_argument("--dwell", type=float, default=0.1, help="seconds on each channel")
+    hop_parser.add_argument("--count", type=int, default=0, help="number of hops, 0 = forever")
+
+    args   = parser.parse_args()
+    client = Client(args.host, args.port, args.timeout)
+
+    try:
+        if args.command == "get":
+            for name, value in client.get().items():
+                print("%-16s %s" % (name, value))
+
+        elif args.command == "boot":
+            for name, micros in sorted(client.boot().items(), key=lambda item: item[1]):
+                print("%-16s %10.3f ms" % (name, micros / 1000))
+
+        elif args.command == "set":
+            values = {name: getattr(args, name) for name in FIELDS if getattr(args, name) is not None}
+            if not values:
+                parser.error("nothing to set")
+            print("applied in %.3f ms" % (client.set(**values) * 1000))
+
+        elif args.command == "hop":
+            channels = [int(c) for c in args.channels.split(",")]
+            rtts = []
+            hop = 0
+            while args.count == 0 or hop < args.count:
+                channel = channels[hop % len(channels)]
+                rtts.append(client.set(channel=channel))
+                print("channel %3d  %.3f ms" % (channel, rtts[-1] * 1000))
+                hop += 1
+                time.sleep(args.dwell)
+    except KeyboardInterrupt:
+        pass
+    except ControlError as e:
+        print("error: %s" % e, file=sys.stderr)
+        sys.exit(1)
+
+    if args.command == "hop" and rtts:
+        rtts.sort()
+        print("hops %d, round trip min %.3f / median %.3f / max %.3f ms" %
+              (len(rtts), rtts[0] * 1000, rtts[len(rtts) // 2] * 1000, rtts[-1] * 1000))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+# Decoder of multiSniff binary trace records (source/utils/trace.h).
+#
+#   datagram: uint8 'T', uint8 version, uint8 record count, uint8 reserved,
+#             uint32 Clock ticks, uint32 cycle counter, uint32 dropped,
+#             records...
+#   record:   uint32 cycles, uint16 event id, uint8 context, uint8 reserved,
+#             uint32 arg0, uint32 arg1 (little-endian)
+#
+# Event names and formats are read from the TRACE_EVENTS table of trace.h,
+# so the firmware and the decoder must come from the same tree.
+#
+# Examples:
+#   trace_decode.py udp                   (listen on TRACE_PORT, 2016)
+#   trace_decode.py dump trace_rings.bin  (memory of Trace_rings saved
+#                                          by the debugger)
+import argparse
+import os
+import re
+import socket
+import struct
+import sys
+
+TRACE_H  = os.path.join(os.path.dirname(__file__), "..", "source", "utils", "trace.h")
+
+PORT     = 2016
+VERSION  = 1
+CPU_HZ   = 48000000
+RING_SIZE = 32
+
+HEADER   = struct.Struct("<BBBBIII")
+RECORD   = struct.Struct("<IHBBII")
+
+CONTEXTS = ["task", "swi", "hwi"]
+
+
+def load_events(path):
+    """[(name, format)] indexed by event id."""
+    with open(path) as f:
+        text = f.read()
+
+    table = text[text.index("#define TRACE_EVENTS(X)"):]
+    table = table[:table.index("\n\n")]
+
+    return [(m.group(1), m.group(2))
+            for m in re.finditer(r'X\(\s*(\w+)\s*,\s*\w+\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)', table)]
+
+
+def format_record(events, id, arg0, arg1):
+    if id >= len(events):
+        return "?", "unknown event {0}, args {1} {2}".format(id, arg0, arg1)
+
+    name, fmt = events[id]
+
+    try:
+        return name, fmt.format(arg0, arg1)
+    except (ValueError, IndexError, OverflowError):
+        return name, "args {0} {1}".format(arg0, arg1)
+
+
+def print_record(events, seconds, context, id, arg0, arg1):
+    name, message = format_record(events, id, arg0, arg1)
+
+    context = CONTEXTS[context] if context < len(CONTEXTS) else str(context)
+
+    print("{0:12.6f}  {1:4}  {2:16}  {3}".format(seconds, context, name, message))
+
+
+def decode_datagram(events, data, ticks_base):
+    """Records are timed from the cycle counter read at drain time,
+    which is paired with the Clock tick (10 us) of the same moment."""
+    if len(data) < HEADER.size or data[0] != ord("T") or data[1] != VERSION:
+        print("not a trace datagram ({0} bytes)".format(len(data)), file=sys.stderr)
+        return ticks_base
+
+    _, _, count, _, ticks, anchor, dropped = HEADER.unpack_from(data)
+
+    if ticks_base is None:
+        ticks_base = ticks
+
+    now = ( ticks - ticks_base ) / 100000.0
+
+    records = [RECORD.unpack_from(data, HEADER.size + i * RECORD.size) for i in range(count)]
+
+    for cycles, id, context, _, arg0, arg1 in sorted(records, key=lambda r: -( ( anchor - r[0] ) & 0xFFFFFFFF )):
+        print_record(events, now - ( ( anchor - cycles ) & 0xFFFFFFFF ) / CPU_HZ, context, id, arg0, arg1)
+
+    if dropped:
+        print("{0:12.6f}  dropped {1} records so far".format(now, dropped))
+
+    return ticks_base
+
+
+def listen(events, port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", port))
+
+    ticks_base = None
+
+    while True:
+        data, _ = sock.recvfrom(2048)
+        ticks_base = decode_datagram(events, data, ticks_base)
+        sys.stdout.flush()
+
+
+def dump(events, path):
+    """Trace_rings: per context uint32 head, uint32 tail, records.
+    Time is relative to the newest record of all rings."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    ring_size = 8 + RING_SIZE * RECORD.size
+    records   = []
+
+    for context in range(min(len(CONTEXTS), len(data) // ring_size)):
+        base = context * ring_size
+        head, _ = struct.unpack_from("<II", data, base)
+
+        for index in range(max(0, head - RING_SIZE), head):
+            cycles, id, _, _, arg0, arg1 = RECORD.unpack_from(data, base + 8 + ( index % RING_SIZE ) * RECORD.size)
+            records.append((cycles, id, context, arg0, arg1))
+
+    if not records:
+        return
+
+    newest = max(records, key=lambda r: r[0])[0]
+
+    for cycles, id, context, arg0, arg1 in sorted(records, key=lambda r: -( ( newest - r[0] ) & 0xFFFFFFFF )):
+        print_record(events, -( ( newest - cycles ) & 0xFFFFFFFF ) / CPU_HZ, context, id, arg0, arg1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="multiSniff trace decoder")
+    parser.add_argument("--trace-h", default=TRACE_H, help="trace.h with the TRACE_EVENTS table")
+
+    sub = parser.add_subparsers(dest="mode", required=True)
+
+    p = sub.add_parser("udp", help="decode datagrams sent by Trace_Drain()")
+    p.add_argument("--port", type=int, default=PORT)
+
+    p = sub.add_parser("dump", help="decode a memory dump of Trace_rings")
+    p.add_argument("file")
+
+    args   = parser.parse_args()
+    events = load_events(args.trace_h)
+
+    try:
+        if args.mode == "udp":
+            listen(events, args.port)
+        else:
+            dump(events, args.file)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()